@@ -14,6 +14,7 @@
 #include "evm.hpp"
 #include "version.hpp"
 #include "loader.hpp"
+#include "lazy_deployer.hpp"
 #include "events.hpp"
 
 namespace dcn
@@ -171,6 +172,30 @@ namespace dcn
      */
     asio::awaitable<http::Response> GET_formats(const http::Request & request, std::vector<server::RouteArg> route_args, server::QueryArgsList query_args, registry::Registry & registry);
 
+    /**
+     * @brief Handles a OPTIONS request to /formats/search?labels=<string>&limit=<uint>&min_shared=<~uint>
+     *
+     * @param request The incoming HTTP request
+     * @param route_args Route arguments
+     * @param query_args Query arguments
+     * @return An HTTP response
+     */
+    asio::awaitable<http::Response> OPTIONS_formatsSearch(const http::Request & request, std::vector<server::RouteArg> route_args, server::QueryArgsList query_args);
+
+    /**
+     * @brief Handles a GET request to /formats/search?labels=<string>&limit=<uint>&min_shared=<~uint>
+     *
+     * Returns formats sharing at least `min_shared` (default: all) of the comma-separated
+     * `scalar:tail_id` labels, ranked by shared labels and then by fewest extra labels.
+     *
+     * @param request The incoming HTTP request
+     * @param route_args Route arguments
+     * @param query_args Query arguments
+     * @param registry Registry instance
+     * @return An HTTP response
+     */
+    asio::awaitable<http::Response> GET_formatsSearch(const http::Request & request, std::vector<server::RouteArg> route_args, server::QueryArgsList query_args, registry::Registry & registry);
+
     /**
      * @brief Handles a OPTIONS request to /format/<hash>?limit=<uint>&after=<~string>
      *
@@ -454,12 +479,14 @@ namespace dcn
      * @brief Handles POST requests for the execute endpoint.
      *
      * Verifies the access token, then executes a runner transaction.
+     * Responds 503 with Retry-After while a dependency of the connector is still being deployed.
      *
      * @param request The incoming HTTP request
      * @param route_args Route arguments
      * @param query_args Query arguments
      * @param auth_manager Authentication manager instance for verifying access tokens
      * @param evm EVM instance
+     * @param deployer Deploys the connector and its dependencies on first use
      * @return An HTTP response
      */
     asio::awaitable<http::Response> POST_execute(
@@ -469,5 +496,6 @@ namespace dcn
         const auth::AuthManager & auth_manager,
         registry::Registry & registry,
         evm::EVM & evm,
+        loader::LazyDeployer & deployer,
         const config::Config & config);
 }
@@ -9,6 +9,12 @@
 
 namespace dcn
 {
+    namespace
+    {
+        // Typical time for solc to build one connector closure.
+        constexpr unsigned int RETRY_AFTER_SECONDS = 2;
+    }
+
     asio::awaitable<http::Response> OPTIONS_execute(const http::Request & request, std::vector<server::RouteArg>, server::QueryArgsList)
     {
         http::Response response;
@@ -30,6 +36,7 @@ namespace dcn
         const auth::AuthManager & auth_manager,
         registry::Registry & registry,
         evm::EVM & evm,
+        loader::LazyDeployer & deployer,
         const config::Config & config)
     {
         http::Response response;
@@ -88,11 +95,19 @@ namespace dcn
             co_return response;
         }
 
-        if(!co_await loader::ensureConnectorDeployed(
-            evm,
-            registry,
-            execute_request.connector_name(),
-            config.storage_path))
+        deployer.recordAccess(execute_request.connector_name());
+
+        const loader::ConnectorReadiness readiness = co_await deployer.ensureConnector(execute_request.connector_name());
+        if(readiness == loader::ConnectorReadiness::DEPLOYING)
+        {
+            response.setCode(http::Code::ServiceUnavailable)
+                .setHeader(http::Header::RetryAfter, std::to_string(RETRY_AFTER_SECONDS))
+                .setBodyWithContentLength(json{
+                    {"message", "Connector dependencies are still being deployed"}
+                }.dump());
+            co_return response;
+        }
+        if(readiness == loader::ConnectorReadiness::FAILED)
         {
             response.setCode(http::Code::InternalServerError)
                 .setBodyWithContentLength(json{
@@ -163,7 +178,7 @@ namespace dcn
         // execute call to runner
         co_await evm.setGas(address, evm::DEFAULT_GAS_LIMIT);
         co_await evm.setGas(evm.getRunnerAddress(), evm::DEFAULT_GAS_LIMIT);
-        const auto exec_result = co_await evm.execute(address, evm.getRunnerAddress(), input_data, evm::DEFAULT_GAS_LIMIT, 0);
+        const auto exec_result = co_await evm.execute(address, evm.getRunnerAddress(), input_data, evm::DEFAULT_GAS_LIMIT, 0, true);
 
         // check execution status
         if(!exec_result)
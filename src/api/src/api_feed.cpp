@@ -4,6 +4,7 @@
 #include <chrono>
 #include <format>
 #include <limits>
+#include <string_view>
 #include <utility>
 
 namespace dcn
@@ -12,6 +13,23 @@ namespace dcn
     {
         constexpr std::size_t MAX_FEED_LIMIT = 256;
         constexpr std::size_t MAX_STREAM_LIMIT = 2048;
+
+        // Appends `"key":<raw_json>` as the last member of a dumped JSON object, so stored
+        // payloads reach the wire without a parse/dump round trip.
+        std::string appendRawMember(std::string object_json, std::string_view key, std::string_view raw_json)
+        {
+            object_json.pop_back();
+            if(object_json.size() > 1)
+            {
+                object_json += ',';
+            }
+            object_json += '"';
+            object_json += key;
+            object_json += "\":";
+            object_json += raw_json;
+            object_json += '}';
+            return object_json;
+        }
     }
 
     asio::awaitable<http::Response> OPTIONS_feed(const http::Request &, std::vector<server::RouteArg>, server::QueryArgsList)
@@ -136,10 +154,14 @@ namespace dcn
         output["cursor"]["next_before"] = page.next_before_cursor.has_value()
             ? json(*page.next_before_cursor)
             : json(nullptr);
-        output["items"] = json::array();
+        std::string items_json = "[";
         for(const events::FeedItem & item : page.items)
         {
-            output["items"].push_back(json{
+            if(items_json.size() > 1)
+            {
+                items_json += ',';
+            }
+            items_json += appendRawMember(json{
                 {"feed_id", item.feed_id},
                 {"event_type", item.event_type},
                 {"status", item.status},
@@ -151,13 +173,13 @@ namespace dcn
                 {"history_cursor", item.history_cursor},
                 {"created_at_ms", item.created_at_ms},
                 {"updated_at_ms", item.updated_at_ms},
-                {"projector_version", item.projector_version},
-                {"payload", item.payload}
-            });
+                {"projector_version", item.projector_version}
+            }.dump(), "payload", item.payload_json);
         }
+        items_json += ']';
 
         response.setCode(http::Code::OK)
-            .setBodyWithContentLength(output.dump());
+            .setBodyWithContentLength(appendRawMember(output.dump(), "items", items_json));
         co_return response;
     }
 
@@ -188,14 +210,15 @@ namespace dcn
                 {"status", delta.status},
                 {"feed_id", delta.feed_id},
                 {"history_cursor", delta.history_cursor},
-                {"created_at_ms", delta.created_at_ms},
-                {"payload", delta.payload}
+                {"created_at_ms", delta.created_at_ms}
             };
             std::string out;
             out.reserve(256);
             out += std::format("id: {}\n", delta.stream_seq);
             out += std::format("event: {}\n", delta.event_type.empty() ? "unknown" : delta.event_type);
-            out += std::format("data: {}\n\n", data.dump());
+            out += "data: ";
+            out += appendRawMember(data.dump(), "payload", delta.payload_json);
+            out += "\n\n";
             return out;
         }
 
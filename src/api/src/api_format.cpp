@@ -1,7 +1,9 @@
 #include "api.hpp"
 
 #include <algorithm>
+#include <cctype>
 #include <format>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -10,6 +12,36 @@ namespace dcn
     namespace
     {
         constexpr std::size_t MAX_LIMIT = 256;
+        constexpr std::size_t MAX_SEARCH_LABELS = 64;
+
+        // Splits `scalar:tail_id,scalar:tail_id,...`; empty or malformed entries reject the whole list.
+        static std::optional<std::vector<std::string>> parseScalarLabelList(const std::string & labels_arg)
+        {
+            std::vector<std::string> labels;
+            std::size_t begin = 0;
+            while(begin <= labels_arg.size())
+            {
+                const std::size_t end = std::min(labels_arg.find(',', begin), labels_arg.size());
+                const std::string label = labels_arg.substr(begin, end - begin);
+
+                const std::size_t colon = label.rfind(':');
+                if(colon == std::string::npos || colon == 0 || colon + 1 == label.size())
+                {
+                    return std::nullopt;
+                }
+                if(!std::all_of(label.begin() + colon + 1, label.end(), [](unsigned char c) { return std::isdigit(c) != 0; }))
+                {
+                    return std::nullopt;
+                }
+
+                labels.push_back(label);
+                begin = end + 1;
+            }
+
+            std::sort(labels.begin(), labels.end());
+            labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+            return labels;
+        }
     }
 
     asio::awaitable<http::Response> OPTIONS_formats(const http::Request &, std::vector<server::RouteArg>, server::QueryArgsList)
@@ -173,6 +205,118 @@ namespace dcn
         co_return response;
     }
 
+    asio::awaitable<http::Response> OPTIONS_formatsSearch(const http::Request &, std::vector<server::RouteArg>, server::QueryArgsList)
+    {
+        http::Response response;
+        response.setCode(http::Code::NoContent)
+                .setVersion("HTTP/1.1")
+                .setHeader(http::Header::AccessControlAllowOrigin, "*")
+                .setHeader(http::Header::AccessControlAllowMethods, "GET, OPTIONS")
+                .setHeader(http::Header::AccessControlAllowHeaders, "Content-Type")
+                .setHeader(http::Header::AccessControlMaxAge, "600")
+                .setHeader(http::Header::Connection, "close");
+
+        co_return response;
+    }
+
+    asio::awaitable<http::Response> GET_formatsSearch(
+        const http::Request &,
+        std::vector<server::RouteArg> args,
+        server::QueryArgsList query_args,
+        registry::Registry & registry)
+    {
+        http::Response response;
+        response.setCode(http::Code::Unknown)
+                .setVersion("HTTP/1.1")
+                .setHeader(http::Header::AccessControlAllowOrigin, "*")
+                .setHeader(http::Header::Connection, "close")
+                .setHeader(http::Header::ContentType, "application/json");
+
+        if(!args.empty())
+        {
+            response.setCode(http::Code::BadRequest)
+                .setBodyWithContentLength(json{
+                    {"message", "Invalid number of arguments"}
+                }.dump());
+            co_return response;
+        }
+
+        if(query_args.contains("labels") == false || query_args.contains("limit") == false)
+        {
+            response.setCode(http::Code::BadRequest)
+                .setBodyWithContentLength(json{
+                    {"message", "Missing argument labels or limit"}
+                }.dump());
+            co_return response;
+        }
+
+        const auto labels_arg = parse::parseRouteArgAs<std::string>(query_args.at("labels"));
+        const auto labels = labels_arg ? parseScalarLabelList(*labels_arg) : std::nullopt;
+        if(!labels.has_value() || labels->size() > MAX_SEARCH_LABELS)
+        {
+            response.setCode(http::Code::BadRequest)
+                .setBodyWithContentLength(json{
+                    {"message", std::format("Invalid argument labels. Expected up to {} comma-separated scalar:tail_id entries.", MAX_SEARCH_LABELS)}
+                }.dump());
+            co_return response;
+        }
+
+        auto limit_res = parse::parseRouteArgAs<std::size_t>(query_args.at("limit"));
+        if(limit_res && limit_res.value() > MAX_LIMIT)
+        {
+            limit_res = std::unexpected(parse::ParseError{parse::ParseError::Kind::OUT_OF_RANGE});
+        }
+
+        if(!limit_res)
+        {
+            std::string msg_str = "Invalid argument limit.";
+            msg_str += std::format(" limit error: {}.", limit_res.error().kind);
+
+            response.setCode(http::Code::BadRequest)
+                .setBodyWithContentLength(json{
+                    {"message", msg_str}
+                }.dump());
+            co_return response;
+        }
+
+        std::size_t min_shared = labels->size();
+        if(query_args.contains("min_shared"))
+        {
+            const auto min_shared_res = parse::parseRouteArgAs<std::size_t>(query_args.at("min_shared"));
+            if(!min_shared_res || *min_shared_res == 0 || *min_shared_res > labels->size())
+            {
+                response.setCode(http::Code::BadRequest)
+                    .setBodyWithContentLength(json{
+                        {"message", "Invalid argument min_shared. Expected 1..number of labels."}
+                    }.dump());
+                co_return response;
+            }
+            min_shared = *min_shared_res;
+        }
+
+        const std::size_t limit = *limit_res;
+        const registry::FormatSearchResult result = co_await registry.searchFormatsByScalarLabels(*labels, min_shared, limit);
+
+        json json_output;
+        json_output["labels"] = *labels;
+        json_output["min_shared"] = min_shared;
+        json_output["limit"] = limit;
+        json_output["total_matches"] = result.total_matches;
+        json_output["formats"] = json::array();
+        for(const registry::FormatMatch & match : result.matches)
+        {
+            json_output["formats"].push_back(json{
+                {"format_hash", evmc::hex(match.format_hash)},
+                {"shared_labels", match.shared_labels},
+                {"format_labels", match.format_labels}
+            });
+        }
+
+        response.setCode(http::Code::OK)
+            .setBodyWithContentLength(json_output.dump());
+        co_return response;
+    }
+
     asio::awaitable<http::Response> OPTIONS_format(const http::Request &, std::vector<server::RouteArg>, server::QueryArgsList)
     {
         http::Response response;
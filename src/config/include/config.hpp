@@ -34,18 +34,37 @@ namespace dcn::config
         unsigned int loader_batch_connectors;
         unsigned int loader_batch_transformations;
         unsigned int loader_batch_conditions;
+        unsigned int loader_batch_compile = 128;
+        unsigned int loader_scan_threads = 0;
+
+        unsigned int solc_max_jobs = 0;
+        unsigned int solc_timeout_ms = 120000;
+        unsigned int solc_cache_mb = 512;
+        std::filesystem::path solc_cache_dir;
+
+        std::filesystem::path evm_snapshot_path;
+        unsigned int evm_snapshot_interval_ms = 300000;
+        unsigned int evm_executors = 0;
+
+        bool lazy_start = false;
 
         IngestionConfig chain_ingestion;
 
         unsigned int registry_wal_sync_ms;
+        unsigned int registry_cache_mb = 96;
+        unsigned int registry_group_commit_window_us = 2000;
+        unsigned int registry_group_commit_max_batch = 64;
         std::filesystem::path registry_db;
+        std::filesystem::path registry_snapshot_import;
+        std::filesystem::path registry_snapshot_export;
 
         std::filesystem::path events_db;
         std::filesystem::path events_archive_root;
         unsigned int events_chain_id = 1;
         unsigned int events_hot_window_days = 90;
-        unsigned int events_projector_interval_ms = 200;
+        unsigned int events_projection_grace_ms = 5000;
         unsigned int events_archive_interval_ms = 30000;
+        unsigned int events_archive_export_threads = 2;
         unsigned int events_reorg_window_blocks = 2048;
         unsigned int events_outbox_retention_days = 7;
     };
@@ -2,9 +2,62 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
 
 namespace dcn::events
 {
+    constexpr std::size_t DEFAULT_ARCHIVE_PRUNE_BATCH_SIZE = 1024;
+
+    // Position of a prune pass in (block_time, tx_hash, log_index) order; the next batch scans from after it.
+    struct ArchivePruneCursor
+    {
+        std::int64_t block_time = 0;
+        std::string tx_hash;
+        std::int64_t log_index = 0;
+    };
+
+    struct NormalizedHotKey
+    {
+        int chain_id = 1;
+        std::string block_hash;
+        std::int64_t log_index = 0;
+        int projected_version = 0;
+        std::int64_t updated_at_ms = 0;
+    };
+
+    struct FeedHotKey
+    {
+        int chain_id = 1;
+        std::string feed_id;
+        int projector_version = 0;
+        std::int64_t updated_at_ms = 0;
+        std::string history_cursor;
+        std::string payload_json;
+    };
+
+    // A month shard written from a read snapshot, waiting for its catalog flip on the hot write connection.
+    struct ArchiveShardExport
+    {
+        int chain_id = 1;
+        std::string month_token;
+        std::filesystem::path archive_path;
+
+        std::vector<NormalizedHotKey> normalized_hot_keys;
+        std::vector<FeedHotKey> feed_hot_keys;
+
+        std::size_t normalized_rows = 0;
+        std::size_t feed_rows = 0;
+        std::size_t shard_bytes = 0;
+        std::int64_t elapsed_ms = 0;
+
+        bool empty() const
+        {
+            return normalized_hot_keys.empty() && feed_hot_keys.empty();
+        }
+    };
+
     class IArchiveManager
     {
         public:
@@ -42,7 +42,11 @@ namespace dcn::events
         std::int64_t created_at_ms = 0;
         std::int64_t updated_at_ms = 0;
         int projector_version = 1;
-        nlohmann::json payload;
+
+        // Stored payload object, kept as serialized JSON so responses can splice it in verbatim.
+        std::string payload_json = "{}";
+
+        nlohmann::json payload() const;
     };
 
     struct FeedQuery
@@ -74,7 +78,11 @@ namespace dcn::events
         std::string feed_id;
         std::string history_cursor;
         std::int64_t created_at_ms = 0;
-        nlohmann::json payload;
+
+        // See FeedItem::payload_json.
+        std::string payload_json = "{}";
+
+        nlohmann::json payload() const;
     };
 
     struct StreamPage
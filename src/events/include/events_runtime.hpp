@@ -51,12 +51,23 @@ namespace dcn::events
         std::size_t reorg_window_blocks = 2048;
         std::int64_t outbox_retention_ms = 7LL * 24 * 60 * 60 * 1000;
 
-        unsigned int projector_interval_ms = 200;
+        unsigned int projection_job_grace_ms = 5000;
         unsigned int archive_interval_ms = 30 * 1000;
+        unsigned int archive_export_threads = 2;
         unsigned int wal_checkpoint_interval_ms = 15 * 1000;
         std::string chain_namespace;
     };
 
+    struct ArchiveExportMetrics
+    {
+        std::uint64_t shards_exported = 0;
+        std::uint64_t shards_failed = 0;
+        std::uint64_t rows_exported = 0;
+        std::uint64_t bytes_written = 0;
+        std::uint64_t export_time_ms = 0;
+        std::size_t exports_in_flight = 0;
+    };
+
     class EventRuntime final : public IFeedRepository, public storage::sqlite::IWalStore
     {
         public:
@@ -76,6 +87,7 @@ namespace dcn::events
             bool ingestionEnabled() const;
             bool blockingTransportObservedOnHotWriteStrand() const;
             std::uint64_t rpcTransportCallCount() const;
+            ArchiveExportMetrics archiveExportMetrics() const;
 
             FeedPage getFeedPage(const FeedQuery & query) const override;
             StreamPage getStreamPage(const StreamQuery & query) const override;
@@ -107,8 +119,20 @@ namespace dcn::events
                 FinalityHeights heights,
                 std::int64_t now_ms,
                 std::size_t reorg_window_blocks) const;
-            asio::awaitable<std::size_t> _storeProjectBatch(std::size_t limit, std::int64_t now_ms) const;
-            asio::awaitable<bool> _storeRunArchiveCycle(int chain_id, std::size_t hot_window_days, std::int64_t now_ms) const;
+            asio::awaitable<std::size_t> _storeProjectBatch(
+                std::size_t limit,
+                std::int64_t now_ms,
+                std::optional<ProjectionRange> range = std::nullopt) const;
+            asio::awaitable<ProjectionSweepStats> _storeSweepProjectionJobs(std::int64_t older_than_ms) const;
+            asio::awaitable<std::vector<ProjectionRange>> _awaitProjectionRanges() const;
+            void _notifyProjector() const;
+            asio::awaitable<bool> _storeCommitArchiveShard(ArchiveShardExport shard, std::int64_t now_ms) const;
+            asio::awaitable<std::optional<std::size_t>> _storePruneArchivedBatch(
+                int chain_id,
+                std::size_t hot_window_days,
+                std::int64_t now_ms,
+                std::size_t limit,
+                std::optional<ArchivePruneCursor> & cursor) const;
 
             asio::awaitable<FinalityHeights> _resolveFinality(const std::int64_t head) const;
 
@@ -116,6 +140,9 @@ namespace dcn::events
             asio::awaitable<void> _runIngestionLoop();
             asio::awaitable<void> _runProjectorLoop();
             asio::awaitable<void> _runArchiveLoop();
+            asio::awaitable<std::optional<std::vector<std::string>>> _archiveLoadPendingMonths(int chain_id) const;
+            asio::awaitable<std::optional<ArchiveShardExport>> _archiveExportShard(int chain_id, std::string month_token) const;
+            asio::awaitable<void> _exportArchiveMonth(int chain_id, std::string month_token);
             asio::awaitable<void> _runMaintenanceLoop();
             asio::awaitable<void> _waitForLoops();
 
@@ -123,6 +150,8 @@ namespace dcn::events
             asio::io_context & _io_context;
             EventRuntimeConfig _config;
             asio::strand<asio::io_context::executor_type> _write_strand;
+            // Parked projector wait; cancelled on the write strand whenever new projection ranges are published.
+            mutable asio::steady_timer _projector_wakeup;
             std::shared_ptr<RpcClient> _rpc_client;
             
             std::shared_ptr<SQLiteHotStore> _store;
@@ -134,5 +163,14 @@ namespace dcn::events
             mutable std::atomic<bool> _blocking_transport_on_hot_write_strand{false};
 
             std::atomic<std::size_t> _active_loop_count{0};
+
+            // Shard exports read from their own snapshot connections here; only catalog flips use the write strand.
+            mutable asio::thread_pool _archive_pool;
+            std::atomic<std::size_t> _archive_exports_in_flight{0};
+            std::atomic<std::uint64_t> _archive_shards_exported{0};
+            std::atomic<std::uint64_t> _archive_shards_failed{0};
+            std::atomic<std::uint64_t> _archive_rows_exported{0};
+            std::atomic<std::uint64_t> _archive_bytes_written{0};
+            std::atomic<std::uint64_t> _archive_export_time_ms{0};
     };
 }
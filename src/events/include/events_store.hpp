@@ -37,6 +37,19 @@ namespace dcn::events
         std::int64_t seen_at_ms = 0;
     };
 
+    struct ProjectionRange
+    {
+        int chain_id = 1;
+        std::int64_t from_block = 0;
+        std::int64_t to_block = 0;
+    };
+
+    struct ProjectionSweepStats
+    {
+        std::size_t removed_orphans = 0;
+        std::size_t stale_jobs = 0;
+    };
+
     class IHotEventStore
     {
         public:
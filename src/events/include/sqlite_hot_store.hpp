@@ -2,9 +2,12 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -66,6 +69,13 @@ namespace dcn::events
                     const std::size_t reorg_window_blocks) override;
                 
             std::size_t projectBatch(const std::size_t limit, const std::int64_t now_ms) override;
+            std::size_t projectBatch(const std::size_t limit, const std::int64_t now_ms, const ProjectionRange & range);
+
+            // Block ranges with projection jobs queued by committed ingest/finality writes since the last call.
+            std::vector<ProjectionRange> takeProjectionRanges();
+
+            // Drops orphaned jobs older than `older_than_ms` and re-announces the ranges of stale live jobs.
+            ProjectionSweepStats sweepProjectionJobs(const std::int64_t older_than_ms);
                 
             bool runArchiveCycle(
                     const int chain_id,
@@ -73,9 +83,39 @@ namespace dcn::events
                     const std::int64_t now_ms) override;
                 
             bool runCycle(const int chain_id, const std::size_t hot_window_days, const std::int64_t now_ms) override;
+
+            // Export phase of an archive cycle: writes pending finalized months to their shards.
+            bool exportArchiveMonths(const int chain_id, const std::int64_t now_ms);
+
+            // Prune phase of an archive cycle, bounded to `limit` events per transaction.
+            // Returns the number of events pruned, or nullopt when the transaction failed.
+            std::optional<std::size_t> pruneArchivedBatch(
+                    const int chain_id,
+                    const std::size_t hot_window_days,
+                    const std::int64_t now_ms,
+                    const std::size_t limit);
+
+            // Same, continuing a pass from `cursor`, which is advanced past the scanned events. Events skipped
+            // as not yet prunable are not rescanned by later batches of the pass; start a pass with nullopt.
+            std::optional<std::size_t> pruneArchivedBatch(
+                    const int chain_id,
+                    const std::size_t hot_window_days,
+                    const std::int64_t now_ms,
+                    const std::size_t limit,
+                    std::optional<ArchivePruneCursor> & cursor);
+
+            // Write side of an off-strand export: marks the snapshot rows exported and flips the shard_catalog entry.
+            bool commitArchiveShard(const ArchiveShardExport & shard, const std::int64_t now_ms);
                 
             storage::sqlite::WalCheckpointStats checkpointWal(storage::sqlite::WalCheckpointMode mode);
 
+            // ---- archive export / thread-safe, each call opens its own snapshot reader ----
+
+            std::optional<std::vector<std::string>> pendingArchiveMonths(const int chain_id) const;
+
+            // Reads one month from a WAL snapshot and writes + fsyncs its shard; does not touch the hot DB.
+            std::optional<ArchiveShardExport> exportArchiveShard(const int chain_id, const std::string & month_token) const;
+
             // ---- read side / synchronous ----
 
             FeedPage getFeedPage(const FeedQuery & query) const;
@@ -86,7 +126,19 @@ namespace dcn::events
         private:
             bool _initializeHotSchema();
             bool _initializeArchiveSchema(sqlite3 * archive_db) const;
+            bool _compactArchiveShard(sqlite3 * archive_db) const;
+
+            // Cached read-only, mmap-backed connection per READY shard; shards are append-only once cataloged.
+            // Only the most recently used shards keep one, and an evicted connection closes with its last reader.
+            std::shared_ptr<sqlite3> _archiveReader(const std::filesystem::path & archive_path) const;
             
+            std::size_t _projectBatch(
+                const std::size_t limit,
+                const std::int64_t now_ms,
+                const std::optional<ProjectionRange> & range);
+
+            void _publishProjectionRange(const ProjectionRange & range);
+
             bool _exportMonth(const int chain_id, const std::string& month_token, const std::int64_t now_ms);
 
             std::vector<std::filesystem::path> _candidateArchivePaths(const std::optional<CursorKey> & before_key) const;
@@ -109,6 +161,13 @@ namespace dcn::events
             sqlite3 * _read_db = nullptr;
             std::unique_ptr<IEventShardRouter> _shard_router;
 
+            std::vector<ProjectionRange> _projection_ranges;
+
+            mutable std::mutex _archive_readers_mutex;
+            // Most recently used first.
+            mutable std::list<std::pair<std::string, std::shared_ptr<sqlite3>>> _archive_readers;
+            mutable std::unordered_map<std::string, decltype(_archive_readers)::iterator> _archive_reader_index;
+
             int _default_chain_id = 1;
             std::string _default_chain_namespace = "eth";
     };
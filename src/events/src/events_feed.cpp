@@ -1,5 +1,27 @@
 #include "events_feed.hpp"
 
+namespace dcn::events
+{
+    static nlohmann::json _parsePayloadObject(const std::string & payload_json)
+    {
+        nlohmann::json payload = nlohmann::json::parse(payload_json, nullptr, false);
+        if(payload.is_discarded())
+        {
+            return nlohmann::json::object();
+        }
+        return payload;
+    }
+
+    nlohmann::json FeedItem::payload() const
+    {
+        return _parsePayloadObject(payload_json);
+    }
+
+    nlohmann::json StreamDelta::payload() const
+    {
+        return _parsePayloadObject(payload_json);
+    }
+}
 
 namespace dcn::parse
 {
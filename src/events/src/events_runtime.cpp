@@ -7,6 +7,10 @@
 #include <tuple>
 #include <variant>
 #include <set>
+#include <vector>
+
+#include <asio/experimental/parallel_group.hpp>
+
 
 #include "events.hpp"
 #include "async.hpp"
@@ -127,6 +131,7 @@ namespace dcn::events
         : _io_context(io_context)
         , _config(std::move(cfg))
         , _write_strand(asio::make_strand(io_context))
+        , _projector_wakeup(_write_strand)
         , _rpc_client(std::make_shared<RpcClient>(_config.rpc_url, _config.rpc_timeout_ms))
         , _store(std::make_shared<SQLiteHotStore>(
             _config.hot_db_path,
@@ -135,6 +140,7 @@ namespace dcn::events
             _config.chain_id,
             _resolveChainNamespace(_config)))
         , _decoder(std::make_unique<PTEventDecoder>())
+        , _archive_pool(std::max<std::size_t>(1, _config.archive_export_threads))
     {
     }
 
@@ -196,6 +202,14 @@ namespace dcn::events
         }
 
         _running.store(false, std::memory_order_release);
+
+        if(_active_loop_count.load(std::memory_order_acquire) > 0)
+        {
+            asio::post(_write_strand, [this]()
+            {
+                _projector_wakeup.cancel();
+            });
+        }
     }
 
     asio::awaitable<void> EventRuntime::stop()
@@ -240,6 +254,18 @@ namespace dcn::events
         return _rpc_client->callCount();
     }
 
+    ArchiveExportMetrics EventRuntime::archiveExportMetrics() const
+    {
+        return ArchiveExportMetrics{
+            .shards_exported = _archive_shards_exported.load(std::memory_order_acquire),
+            .shards_failed = _archive_shards_failed.load(std::memory_order_acquire),
+            .rows_exported = _archive_rows_exported.load(std::memory_order_acquire),
+            .bytes_written = _archive_bytes_written.load(std::memory_order_acquire),
+            .export_time_ms = _archive_export_time_ms.load(std::memory_order_acquire),
+            .exports_in_flight = _archive_exports_in_flight.load(std::memory_order_acquire)
+        };
+    }
+
     FeedPage EventRuntime::getFeedPage(const FeedQuery & query) const
     {
         return _store->getFeedPage(query);
@@ -331,7 +357,7 @@ namespace dcn::events
         const std::optional<std::uint64_t> next_local_seq) const
     {
         co_await async::ensureOnStrand(_write_strand);
-        co_return _store->ingestBatch(
+        const bool ingested = _store->ingestBatch(
             chain_id,
             raw_events,
             decoded_events,
@@ -339,6 +365,11 @@ namespace dcn::events
             next_from_block,
             now_ms,
             next_local_seq);
+        if(ingested)
+        {
+            _notifyProjector();
+        }
+        co_return ingested;
     }
 
     asio::awaitable<bool> EventRuntime::_storeApplyFinality(
@@ -348,22 +379,78 @@ namespace dcn::events
         const std::size_t reorg_window_blocks) const
     {
         co_await async::ensureOnStrand(_write_strand);
-        co_return _store->applyFinality(chain_id, heights, now_ms, reorg_window_blocks);
+        const bool applied = _store->applyFinality(chain_id, heights, now_ms, reorg_window_blocks);
+        if(applied)
+        {
+            _notifyProjector();
+        }
+        co_return applied;
     }
 
-    asio::awaitable<std::size_t> EventRuntime::_storeProjectBatch(const std::size_t limit, const std::int64_t now_ms) const
+    asio::awaitable<std::size_t> EventRuntime::_storeProjectBatch(
+        const std::size_t limit,
+        const std::int64_t now_ms,
+        const std::optional<ProjectionRange> range) const
     {
         co_await async::ensureOnStrand(_write_strand);
+        if(range.has_value())
+        {
+            co_return _store->projectBatch(limit, now_ms, *range);
+        }
         co_return _store->projectBatch(limit, now_ms);
     }
 
-    asio::awaitable<bool> EventRuntime::_storeRunArchiveCycle(
+    asio::awaitable<ProjectionSweepStats> EventRuntime::_storeSweepProjectionJobs(const std::int64_t older_than_ms) const
+    {
+        co_await async::ensureOnStrand(_write_strand);
+        co_return _store->sweepProjectionJobs(older_than_ms);
+    }
+
+    asio::awaitable<std::vector<ProjectionRange>> EventRuntime::_awaitProjectionRanges() const
+    {
+        while(!_stop_requested.load(std::memory_order_acquire))
+        {
+            co_await async::ensureOnStrand(_write_strand);
+
+            std::vector<ProjectionRange> ranges = _store->takeProjectionRanges();
+            if(!ranges.empty())
+            {
+                co_return ranges;
+            }
+
+            if(_stop_requested.load(std::memory_order_acquire))
+            {
+                break;
+            }
+
+            // Checked and parked on the write strand, so a publish cannot slip in between.
+            _projector_wakeup.expires_at(asio::steady_timer::time_point::max());
+            std::error_code ec;
+            co_await _projector_wakeup.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+        }
+        co_return std::vector<ProjectionRange>{};
+    }
+
+    void EventRuntime::_notifyProjector() const
+    {
+        _projector_wakeup.cancel();
+    }
+
+    asio::awaitable<bool> EventRuntime::_storeCommitArchiveShard(ArchiveShardExport shard, const std::int64_t now_ms) const
+    {
+        co_await async::ensureOnStrand(_write_strand);
+        co_return _store->commitArchiveShard(shard, now_ms);
+    }
+
+    asio::awaitable<std::optional<std::size_t>> EventRuntime::_storePruneArchivedBatch(
         const int chain_id,
         const std::size_t hot_window_days,
-        const std::int64_t now_ms) const
+        const std::int64_t now_ms,
+        const std::size_t limit,
+        std::optional<ArchivePruneCursor> & cursor) const
     {
         co_await async::ensureOnStrand(_write_strand);
-        co_return _store->runArchiveCycle(chain_id, hot_window_days, now_ms);
+        co_return _store->pruneArchivedBatch(chain_id, hot_window_days, now_ms, limit, cursor);
     }
 
     asio::awaitable<storage::sqlite::WalCheckpointStats> EventRuntime::checkpointWal(storage::sqlite::WalCheckpointMode mode) const
@@ -939,13 +1026,33 @@ namespace dcn::events
     {
         spdlog::info("Events projector loop started");
 
+        // Drain whatever was queued before this process started; afterwards only announced ranges are scanned.
         while(!_stop_requested.load(std::memory_order_acquire))
         {
             const std::size_t projected = co_await _storeProjectBatch(DEFAULT_PROJECT_BATCH_SIZE, utils::nowMs());
+            if(projected < DEFAULT_PROJECT_BATCH_SIZE)
+            {
+                break;
+            }
+        }
+
+        while(!_stop_requested.load(std::memory_order_acquire))
+        {
+            const std::vector<ProjectionRange> ranges = co_await _awaitProjectionRanges();
 
-            if(projected == 0)
+            for(const ProjectionRange & range : ranges)
             {
-                co_await _sleepFor(_config.projector_interval_ms);
+                while(!_stop_requested.load(std::memory_order_acquire))
+                {
+                    const std::size_t projected = co_await _storeProjectBatch(
+                        DEFAULT_PROJECT_BATCH_SIZE,
+                        utils::nowMs(),
+                        range);
+                    if(projected < DEFAULT_PROJECT_BATCH_SIZE)
+                    {
+                        break;
+                    }
+                }
             }
         }
 
@@ -965,13 +1072,126 @@ namespace dcn::events
                 break;
             }
 
-            (void)co_await _storeRunArchiveCycle(_config.chain_id, _config.hot_window_days, utils::nowMs());
+            const std::optional<std::vector<std::string>> months =
+                co_await _archiveLoadPendingMonths(_config.chain_id);
+            if(!months.has_value())
+            {
+                continue;
+            }
+
+            // Months export in parallel on the archive pool; wait for the whole batch so no month is in flight twice.
+            using ExportOperation = decltype(asio::co_spawn(_io_context, _exportArchiveMonth(0, {}), asio::deferred));
+            std::vector<ExportOperation> exports;
+            exports.reserve(months->size());
+            for(const std::string & month : *months)
+            {
+                exports.push_back(asio::co_spawn(_io_context, _exportArchiveMonth(_config.chain_id, month), asio::deferred));
+            }
+
+            if(!exports.empty())
+            {
+                _archive_exports_in_flight.fetch_add(exports.size(), std::memory_order_acq_rel);
+                const auto [completion_order, exceptions] = co_await asio::experimental::make_parallel_group(std::move(exports))
+                    .async_wait(asio::experimental::wait_for_all(), asio::use_awaitable);
+                _archive_exports_in_flight.fetch_sub(completion_order.size(), std::memory_order_acq_rel);
+
+                for(const std::exception_ptr & e : exceptions)
+                {
+                    if(e)
+                    {
+                        utils::logException(e, "events archive export failed");
+                        _archive_shards_failed.fetch_add(1, std::memory_order_acq_rel);
+                    }
+                }
+            }
+
+            const std::int64_t cycle_now_ms = utils::nowMs();
+
+            // Each prune batch is its own strand hop so ingest and projection interleave with long prunes;
+            // the cursor keeps later batches from rescanning events the earlier ones skipped.
+            std::optional<ArchivePruneCursor> prune_cursor;
+            while(!_stop_requested.load(std::memory_order_acquire))
+            {
+                const std::optional<std::size_t> pruned = co_await _storePruneArchivedBatch(
+                    _config.chain_id,
+                    _config.hot_window_days,
+                    cycle_now_ms,
+                    DEFAULT_ARCHIVE_PRUNE_BATCH_SIZE,
+                    prune_cursor);
+                if(!pruned.has_value() || *pruned < DEFAULT_ARCHIVE_PRUNE_BATCH_SIZE)
+                {
+                    break;
+                }
+            }
         }
 
         spdlog::info("Events archive loop stopped");
         co_return;
     }
 
+    asio::awaitable<std::optional<std::vector<std::string>>> EventRuntime::_archiveLoadPendingMonths(const int chain_id) const
+    {
+        co_return co_await asio::co_spawn(
+            _archive_pool,
+            [this, chain_id]() -> asio::awaitable<std::optional<std::vector<std::string>>>
+            {
+                co_return _store->pendingArchiveMonths(chain_id);
+            },
+            asio::use_awaitable);
+    }
+
+    asio::awaitable<std::optional<ArchiveShardExport>> EventRuntime::_archiveExportShard(
+        const int chain_id,
+        std::string month_token) const
+    {
+        co_return co_await asio::co_spawn(
+            _archive_pool,
+            [this, chain_id, month_token = std::move(month_token)]() -> asio::awaitable<std::optional<ArchiveShardExport>>
+            {
+                co_return _store->exportArchiveShard(chain_id, month_token);
+            },
+            asio::use_awaitable);
+    }
+
+    asio::awaitable<void> EventRuntime::_exportArchiveMonth(const int chain_id, std::string month_token)
+    {
+        std::optional<ArchiveShardExport> shard = co_await _archiveExportShard(chain_id, month_token);
+        if(!shard.has_value())
+        {
+            _archive_shards_failed.fetch_add(1, std::memory_order_acq_rel);
+            co_return;
+        }
+
+        if(shard->empty())
+        {
+            co_return;
+        }
+
+        const std::size_t rows = shard->normalized_rows + shard->feed_rows;
+        const std::size_t shard_bytes = shard->shard_bytes;
+        const std::int64_t elapsed_ms = shard->elapsed_ms;
+
+        if(!co_await _storeCommitArchiveShard(std::move(*shard), utils::nowMs()))
+        {
+            _archive_shards_failed.fetch_add(1, std::memory_order_acq_rel);
+            co_return;
+        }
+
+        _archive_shards_exported.fetch_add(1, std::memory_order_acq_rel);
+        _archive_rows_exported.fetch_add(rows, std::memory_order_acq_rel);
+        _archive_bytes_written.fetch_add(shard_bytes, std::memory_order_acq_rel);
+        _archive_export_time_ms.fetch_add(static_cast<std::uint64_t>(std::max<std::int64_t>(0, elapsed_ms)), std::memory_order_acq_rel);
+
+        spdlog::info(
+            "Events archive shard {} exported rows={} bytes={} in {} ms ({:.0f} rows/s)",
+            month_token,
+            rows,
+            shard_bytes,
+            elapsed_ms,
+            (elapsed_ms > 0) ? (static_cast<double>(rows) * 1000.0 / static_cast<double>(elapsed_ms)) : static_cast<double>(rows));
+        co_return;
+    }
+
     asio::awaitable<void> EventRuntime::_runMaintenanceLoop()
     {
         spdlog::info("Events maintenance loop started");
@@ -984,6 +1204,14 @@ namespace dcn::events
                 break;
             }
 
+            const std::int64_t sweep_before_ms =
+                utils::nowMs() - static_cast<std::int64_t>(_config.projection_job_grace_ms);
+            const ProjectionSweepStats sweep = co_await _storeSweepProjectionJobs(sweep_before_ms);
+            if(sweep.stale_jobs > 0)
+            {
+                _notifyProjector();
+            }
+
             (void)co_await checkpointWal(storage::sqlite::WalCheckpointMode::PASSIVE);
         }
 
@@ -3,6 +3,7 @@
 #include <ranges>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <format>
 
 #include <spdlog/spdlog.h>
@@ -16,6 +17,8 @@
 namespace dcn::events
 {
     constexpr int CURRENT_PROJECTOR_VERSION = 1;
+    constexpr std::int64_t ARCHIVE_READER_MMAP_BYTES = 256LL * 1024 * 1024;
+    constexpr std::size_t ARCHIVE_READER_CACHE_SIZE = 16;
 
     static bool _usesLogicalFeedIdentity(const std::string_view event_type)
     {
@@ -101,6 +104,26 @@ namespace dcn::events
         return std::string(reinterpret_cast<const char *>(txt));
     }
 
+    // Rows are written from dumped JSON, so a SAX accept pass (no DOM) is enough to keep a
+    // corrupted row from breaking the response it gets spliced into.
+    static std::string _validatedPayloadJson(sqlite3_stmt * stmt, const int index)
+    {
+        const unsigned char * txt = sqlite3_column_text(stmt, index);
+        if (txt == nullptr)
+        {
+            return "{}";
+        }
+
+        std::string payload_json(
+            reinterpret_cast<const char*>(txt),
+            static_cast<std::size_t>(sqlite3_column_bytes(stmt, index)));
+        if (!json::accept(payload_json))
+        {
+            return "{}";
+        }
+        return payload_json;
+    }
+
     static int _bindOptionalInt64(sqlite3_stmt * stmt, int index, const std::optional<std::int64_t> & value)
     {
         if(!value.has_value())
@@ -119,6 +142,22 @@ namespace dcn::events
         return sqlite3_bind_text(stmt, index, value->c_str(), static_cast<int>(value->size()), SQLITE_TRANSIENT);
     }
 
+    static void _extendProjectionRange(
+        std::optional<ProjectionRange> & range,
+        const int chain_id,
+        const std::int64_t from_block,
+        const std::int64_t to_block)
+    {
+        if (!range.has_value())
+        {
+            range = ProjectionRange{.chain_id = chain_id, .from_block = from_block, .to_block = to_block};
+            return;
+        }
+
+        range->from_block = std::min(range->from_block, from_block);
+        range->to_block = std::max(range->to_block, to_block);
+    }
+
     static bool _feedDescComparator(const FeedItem & lhs, const FeedItem & rhs)
     {
         if(lhs.created_at_ms != rhs.created_at_ms)
@@ -213,25 +252,6 @@ namespace dcn::events
         int projector_version = 1;
     };
 
-    struct NormalizedHotKey
-    {
-        int chain_id = 1;
-        std::string block_hash;
-        std::int64_t log_index = 0;
-        int projected_version = 0;
-        std::int64_t updated_at_ms = 0;
-    };
-
-    struct FeedHotKey
-    {
-        int chain_id = 1;
-        std::string feed_id;
-        int projector_version = 0;
-        std::int64_t updated_at_ms = 0;
-        std::string history_cursor;
-        std::string payload_json;
-    };
-
     struct MonthBounds
     {
         int year = 0;
@@ -280,6 +300,34 @@ namespace dcn::events
         return bounds;
     }
     
+    static sqlite3 * _openSnapshotReader(const std::filesystem::path & hot_db_path)
+    {
+        sqlite3 * db = nullptr;
+        const int open_rc = sqlite3_open_v2(hot_db_path.string().c_str(),
+                                            &db,
+                                            SQLITE_OPEN_READONLY | SQLITE_OPEN_FULLMUTEX,
+                                            nullptr);
+        if (open_rc != SQLITE_OK)
+        {
+            const std::string err = (db == nullptr) ? "sqlite open failed" : sqlite3_errmsg(db);
+            if (db != nullptr)
+            {
+                sqlite3_close(db);
+            }
+            spdlog::error("Failed to open events snapshot reader '{}': {}", hot_db_path.string(), err);
+            return nullptr;
+        }
+
+        sqlite3_busy_timeout(db, 10'000);
+        if (!storage::sqlite::exec(db, "PRAGMA temp_store=MEMORY;") ||
+            !storage::sqlite::exec(db, "PRAGMA query_only=ON;"))
+        {
+            sqlite3_close(db);
+            return nullptr;
+        }
+        return db;
+    }
+    
     SQLiteHotStore::SQLiteHotStore(const std::filesystem::path& hot_db_path,
                                    const std::filesystem::path& archive_root,
                                    const std::int64_t outbox_retention_ms,
@@ -383,6 +431,9 @@ namespace dcn::events
 
     SQLiteHotStore::~SQLiteHotStore()
     {
+        _archive_reader_index.clear();
+        _archive_readers.clear();
+
         if (_read_db != nullptr)
         {
             sqlite3_close(_read_db);
@@ -563,6 +614,8 @@ namespace dcn::events
             return false;
         }
 
+        std::optional<ProjectionRange> queued_range = std::nullopt;
+
         try
         {
             std::unordered_map<EventKey, const DecodedEvent*, EventKeyHash> decoded_by_key;
@@ -640,6 +693,10 @@ namespace dcn::events
                 {
                     throw std::runtime_error(sqlite3_errmsg(_write_db));
                 }
+                if (sqlite3_changes(_write_db) > 0)
+                {
+                    _extendProjectionRange(queued_range, block_info.chain_id, block_info.block_number, block_info.block_number);
+                }
                 sqlite3_reset(queue_reorg_removed_jobs_stmt.get());
                 sqlite3_clear_bindings(queue_reorg_removed_jobs_stmt.get());
 
@@ -924,6 +981,8 @@ namespace dcn::events
                             }
                             sqlite3_reset(job_stmt.get());
                             sqlite3_clear_bindings(job_stmt.get());
+
+                            _extendProjectionRange(queued_range, chain_id, raw_event.block_number, raw_event.block_number);
                         }
 
                         sqlite3_bind_int(clear_decode_failure_stmt.get(), 1, chain_id);
@@ -1109,6 +1168,8 @@ namespace dcn::events
 
                 sqlite3_reset(job_stmt.get());
                 sqlite3_clear_bindings(job_stmt.get());
+
+                _extendProjectionRange(queued_range, chain_id, decoded->raw.block_number, decoded->raw.block_number);
             }
 
             storage::sqlite::Statement resume_stmt(
@@ -1151,6 +1212,11 @@ namespace dcn::events
                 throw std::runtime_error("commit failed");
             }
 
+            if (queued_range.has_value())
+            {
+                _publishProjectionRange(*queued_range);
+            }
+
             return true;
         }
         catch (const std::exception& e)
@@ -1223,6 +1289,42 @@ namespace dcn::events
                 throw std::runtime_error(sqlite3_errmsg(_write_db));
             }
 
+            std::optional<ProjectionRange> queued_range = std::nullopt;
+
+            storage::sqlite::Statement min_queued_block_stmt(
+                _write_db,
+                "SELECT MIN(block_number) FROM normalized_events_hot "
+                "WHERE chain_id=?1 AND state=?2 AND block_number <= ?3;");
+
+            const auto extend_queued_range = [&](const std::string_view state, const std::int64_t to_block)
+            {
+                sqlite3_bind_int(min_queued_block_stmt.get(), 1, chain_id);
+                sqlite3_bind_text(
+                    min_queued_block_stmt.get(),
+                    2,
+                    state.data(),
+                    static_cast<int>(state.size()),
+                    SQLITE_TRANSIENT);
+                sqlite3_bind_int64(min_queued_block_stmt.get(), 3, static_cast<sqlite3_int64>(to_block));
+
+                const int min_rc = min_queued_block_stmt.step();
+                if (min_rc == SQLITE_ROW && sqlite3_column_type(min_queued_block_stmt.get(), 0) != SQLITE_NULL)
+                {
+                    _extendProjectionRange(
+                        queued_range,
+                        chain_id,
+                        static_cast<std::int64_t>(sqlite3_column_int64(min_queued_block_stmt.get(), 0)),
+                        to_block);
+                }
+                else if (min_rc != SQLITE_ROW && min_rc != SQLITE_DONE)
+                {
+                    throw std::runtime_error(sqlite3_errmsg(_write_db));
+                }
+
+                sqlite3_reset(min_queued_block_stmt.get());
+                sqlite3_clear_bindings(min_queued_block_stmt.get());
+            };
+
             storage::sqlite::Statement queue_observed_to_safe(
                 _write_db,
                 "INSERT OR IGNORE INTO projection_jobs(chain_id, block_hash, log_index, created_at_ms) "
@@ -1238,6 +1340,10 @@ namespace dcn::events
             {
                 throw std::runtime_error(sqlite3_errmsg(_write_db));
             }
+            if (sqlite3_changes(_write_db) > 0)
+            {
+                extend_queued_range(OBSERVED_STATE, effective_safe);
+            }
 
             storage::sqlite::Statement update_observed_to_safe_norm(
                 _write_db,
@@ -1283,6 +1389,10 @@ namespace dcn::events
             {
                 throw std::runtime_error(sqlite3_errmsg(_write_db));
             }
+            if (sqlite3_changes(_write_db) > 0)
+            {
+                extend_queued_range(SAFE_STATE, effective_finalized);
+            }
 
             storage::sqlite::Statement update_safe_to_finalized_norm(
                 _write_db,
@@ -1335,6 +1445,11 @@ namespace dcn::events
                 throw std::runtime_error("commit failed");
             }
 
+            if (queued_range.has_value())
+            {
+                _publishProjectionRange(*queued_range);
+            }
+
             return true;
         }
         catch (const std::exception& e)
@@ -1347,42 +1462,159 @@ namespace dcn::events
 
     std::size_t SQLiteHotStore::projectBatch(const std::size_t limit, const std::int64_t now_ms)
     {
+        return _projectBatch(limit, now_ms, std::nullopt);
+    }
+
+    std::size_t SQLiteHotStore::projectBatch(
+        const std::size_t limit,
+        const std::int64_t now_ms,
+        const ProjectionRange & range)
+    {
+        return _projectBatch(limit, now_ms, range);
+    }
+
+    std::vector<ProjectionRange> SQLiteHotStore::takeProjectionRanges()
+    {
+        return std::exchange(_projection_ranges, {});
+    }
+
+    void SQLiteHotStore::_publishProjectionRange(const ProjectionRange & range)
+    {
+        for (ProjectionRange & pending : _projection_ranges)
+        {
+            if (pending.chain_id == range.chain_id)
+            {
+                pending.from_block = std::min(pending.from_block, range.from_block);
+                pending.to_block = std::max(pending.to_block, range.to_block);
+                return;
+            }
+        }
+
+        _projection_ranges.push_back(range);
+    }
+
+    ProjectionSweepStats SQLiteHotStore::sweepProjectionJobs(const std::int64_t older_than_ms)
+    {
+        ProjectionSweepStats stats{};
+
         if (!storage::sqlite::exec(_write_db, "BEGIN IMMEDIATE TRANSACTION;"))
         {
-            return 0;
+            return stats;
         }
 
-        std::size_t projected_count = 0;
+        std::vector<ProjectionRange> stale_ranges;
 
         try
         {
-            storage::sqlite::Statement cleanup_orphan_jobs(
+            storage::sqlite::Statement delete_orphan_jobs(
                 _write_db,
                 "DELETE FROM projection_jobs "
-                "WHERE NOT EXISTS ("
+                "WHERE created_at_ms < ?1 "
+                "AND NOT EXISTS ("
                 "SELECT 1 FROM normalized_events_hot n "
                 "WHERE n.chain_id=projection_jobs.chain_id "
                 "AND n.block_hash=projection_jobs.block_hash "
                 "AND n.log_index=projection_jobs.log_index"
                 ");");
 
-            if (cleanup_orphan_jobs.step() != SQLITE_DONE)
+            sqlite3_bind_int64(delete_orphan_jobs.get(), 1, static_cast<sqlite3_int64>(older_than_ms));
+
+            if (delete_orphan_jobs.step() != SQLITE_DONE)
             {
                 throw std::runtime_error(sqlite3_errmsg(_write_db));
             }
+            stats.removed_orphans = static_cast<std::size_t>(sqlite3_changes(_write_db));
 
-            storage::sqlite::Statement select_jobs(
+            storage::sqlite::Statement stale_ranges_stmt(
                 _write_db,
+                "SELECT n.chain_id, MIN(n.block_number), MAX(n.block_number), COUNT(1) "
+                "FROM projection_jobs j "
+                "JOIN normalized_events_hot n "
+                "ON n.chain_id=j.chain_id AND n.block_hash=j.block_hash AND n.log_index=j.log_index "
+                "WHERE j.created_at_ms < ?1 "
+                "GROUP BY n.chain_id;");
+
+            sqlite3_bind_int64(stale_ranges_stmt.get(), 1, static_cast<sqlite3_int64>(older_than_ms));
+
+            int stale_rc = SQLITE_OK;
+            while ((stale_rc = stale_ranges_stmt.step()) == SQLITE_ROW)
+            {
+                stale_ranges.push_back(ProjectionRange{
+                    .chain_id = sqlite3_column_int(stale_ranges_stmt.get(), 0),
+                    .from_block = static_cast<std::int64_t>(sqlite3_column_int64(stale_ranges_stmt.get(), 1)),
+                    .to_block = static_cast<std::int64_t>(sqlite3_column_int64(stale_ranges_stmt.get(), 2))
+                });
+                stats.stale_jobs += static_cast<std::size_t>(sqlite3_column_int64(stale_ranges_stmt.get(), 3));
+            }
+            if (stale_rc != SQLITE_DONE)
+            {
+                throw std::runtime_error(sqlite3_errmsg(_write_db));
+            }
+
+            if (!storage::sqlite::exec(_write_db, "COMMIT;"))
+            {
+                throw std::runtime_error("commit failed");
+            }
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("Events sweepProjectionJobs failed: {}", e.what());
+            (void)storage::sqlite::exec(_write_db, "ROLLBACK;");
+            return ProjectionSweepStats{};
+        }
+
+        for (const ProjectionRange & range : stale_ranges)
+        {
+            _publishProjectionRange(range);
+        }
+
+        if (stats.removed_orphans > 0 || stats.stale_jobs > 0)
+        {
+            spdlog::debug(
+                "Events projection sweep removed_orphans={} stale_jobs={}",
+                stats.removed_orphans,
+                stats.stale_jobs);
+        }
+
+        return stats;
+    }
+
+    std::size_t SQLiteHotStore::_projectBatch(
+        const std::size_t limit,
+        const std::int64_t now_ms,
+        const std::optional<ProjectionRange> & range)
+    {
+        if (!storage::sqlite::exec(_write_db, "BEGIN IMMEDIATE TRANSACTION;"))
+        {
+            return 0;
+        }
+
+        std::size_t projected_count = 0;
+
+        try
+        {
+            std::string select_jobs_sql =
                 "SELECT "
                 "n.chain_id, n.block_hash, n.log_index, n.tx_hash, n.block_number, n.tx_index, n.block_time, "
                 "n.event_type, n.name, n.owner, n.state "
                 "FROM projection_jobs j "
                 "JOIN normalized_events_hot n "
-                "ON n.chain_id=j.chain_id AND n.block_hash=j.block_hash AND n.log_index=j.log_index "
-                "ORDER BY n.block_number ASC, n.tx_index ASC, n.log_index ASC "
-                "LIMIT ?1;");
+                "ON n.chain_id=j.chain_id AND n.block_hash=j.block_hash AND n.log_index=j.log_index ";
+            if (range.has_value())
+            {
+                select_jobs_sql += "WHERE n.chain_id=?2 AND n.block_number>=?3 AND n.block_number<=?4 ";
+            }
+            select_jobs_sql += "ORDER BY n.block_number ASC, n.tx_index ASC, n.log_index ASC LIMIT ?1;";
+
+            storage::sqlite::Statement select_jobs(_write_db, select_jobs_sql.c_str());
 
             sqlite3_bind_int64(select_jobs.get(), 1, static_cast<sqlite3_int64>(limit));
+            if (range.has_value())
+            {
+                sqlite3_bind_int(select_jobs.get(), 2, range->chain_id);
+                sqlite3_bind_int64(select_jobs.get(), 3, static_cast<sqlite3_int64>(range->from_block));
+                sqlite3_bind_int64(select_jobs.get(), 4, static_cast<sqlite3_int64>(range->to_block));
+            }
 
             struct ProjectionJobRow
             {
@@ -1782,208 +2014,313 @@ namespace dcn::events
 
     bool SQLiteHotStore::runArchiveCycle(const int chain_id, const std::size_t hot_window_days, const std::int64_t now_ms)
     {
+        if (!exportArchiveMonths(chain_id, now_ms))
+        {
+            return false;
+        }
+
+        std::optional<ArchivePruneCursor> cursor;
+        while (true)
+        {
+            const std::optional<std::size_t> pruned =
+                pruneArchivedBatch(chain_id, hot_window_days, now_ms, DEFAULT_ARCHIVE_PRUNE_BATCH_SIZE, cursor);
+            if (!pruned.has_value())
+            {
+                return false;
+            }
+            if (*pruned < DEFAULT_ARCHIVE_PRUNE_BATCH_SIZE)
+            {
+                return true;
+            }
+        }
+    }
+
+    bool SQLiteHotStore::exportArchiveMonths(const int chain_id, const std::int64_t now_ms)
+    {
+        const std::optional<std::vector<std::string>> months = pendingArchiveMonths(chain_id);
+        if (!months.has_value())
+        {
+            return false;
+        }
+
+        for (const std::string& month : *months)
+        {
+            if (!_exportMonth(chain_id, month, now_ms))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    std::optional<std::vector<std::string>> SQLiteHotStore::pendingArchiveMonths(const int chain_id) const
+    {
+        sqlite3 * reader_db = _openSnapshotReader(_hot_db_path);
+        if (reader_db == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        std::vector<std::string> months;
         try
         {
-            std::vector<std::string> months;
+            storage::sqlite::Statement months_stmt(
+                reader_db,
+                "SELECT month_token FROM ("
+                "SELECT DISTINCT strftime('%Y-%m', block_time, 'unixepoch') AS month_token "
+                "FROM normalized_events_hot n "
+                "WHERE n.chain_id=?1 AND n.state='finalized' AND n.projected_version>=?2 "
+                "AND n.exported=0 AND n.block_time IS NOT NULL "
+                "AND EXISTS ("
+                "SELECT 1 FROM feed_items_hot f "
+                "WHERE f.chain_id=n.chain_id AND f.tx_hash=n.tx_hash AND f.log_index=n.log_index"
+                ") "
+                "AND NOT EXISTS ("
+                "SELECT 1 FROM projection_jobs j "
+                "WHERE j.chain_id=n.chain_id AND j.block_hash=n.block_hash AND j.log_index=n.log_index"
+                ") "
+                "UNION "
+                "SELECT DISTINCT strftime('%Y-%m', block_time, 'unixepoch') AS month_token "
+                "FROM feed_items_hot f "
+                "WHERE f.chain_id=?1 AND f.status='finalized' AND f.exported=0 AND f.block_time IS NOT NULL "
+                "AND EXISTS ("
+                "SELECT 1 FROM normalized_events_hot n "
+                "WHERE n.chain_id=f.chain_id AND n.tx_hash=f.tx_hash AND n.log_index=f.log_index "
+                "AND n.projected_version>=?2"
+                ") "
+                "AND NOT EXISTS ("
+                "SELECT 1 "
+                "FROM normalized_events_hot n "
+                "JOIN projection_jobs j "
+                "ON j.chain_id=n.chain_id AND j.block_hash=n.block_hash AND j.log_index=n.log_index "
+                "WHERE n.chain_id=f.chain_id AND n.tx_hash=f.tx_hash AND n.log_index=f.log_index"
+                ")"
+                ") "
+                "WHERE month_token IS NOT NULL "
+                "ORDER BY month_token ASC "
+                "LIMIT 8;");
+
+            sqlite3_bind_int(months_stmt.get(), 1, chain_id);
+            sqlite3_bind_int(months_stmt.get(), 2, CURRENT_PROJECTOR_VERSION);
+
+            int months_rc = SQLITE_OK;
+            while ((months_rc = months_stmt.step()) == SQLITE_ROW)
             {
-                storage::sqlite::Statement months_stmt(
-                    _write_db,
-                    "SELECT month_token FROM ("
-                    "SELECT DISTINCT strftime('%Y-%m', block_time, 'unixepoch') AS month_token "
-                    "FROM normalized_events_hot n "
-                    "WHERE n.chain_id=?1 AND n.state='finalized' AND n.projected_version>=?2 "
-                    "AND n.exported=0 AND n.block_time IS NOT NULL "
-                    "AND EXISTS ("
-                    "SELECT 1 FROM feed_items_hot f "
-                    "WHERE f.chain_id=n.chain_id AND f.tx_hash=n.tx_hash AND f.log_index=n.log_index"
-                    ") "
-                    "AND NOT EXISTS ("
-                    "SELECT 1 FROM projection_jobs j "
-                    "WHERE j.chain_id=n.chain_id AND j.block_hash=n.block_hash AND j.log_index=n.log_index"
-                    ") "
-                    "UNION "
-                    "SELECT DISTINCT strftime('%Y-%m', block_time, 'unixepoch') AS month_token "
-                    "FROM feed_items_hot f "
-                    "WHERE f.chain_id=?1 AND f.status='finalized' AND f.exported=0 AND f.block_time IS NOT NULL "
-                    "AND EXISTS ("
-                    "SELECT 1 FROM normalized_events_hot n "
-                    "WHERE n.chain_id=f.chain_id AND n.tx_hash=f.tx_hash AND n.log_index=f.log_index "
-                    "AND n.projected_version>=?2"
-                    ") "
-                    "AND NOT EXISTS ("
-                    "SELECT 1 "
-                    "FROM normalized_events_hot n "
-                    "JOIN projection_jobs j "
-                    "ON j.chain_id=n.chain_id AND j.block_hash=n.block_hash AND j.log_index=n.log_index "
-                    "WHERE n.chain_id=f.chain_id AND n.tx_hash=f.tx_hash AND n.log_index=f.log_index"
-                    ")"
-                    ") "
-                    "WHERE month_token IS NOT NULL "
-                    "ORDER BY month_token ASC "
-                    "LIMIT 8;");
-
-                sqlite3_bind_int(months_stmt.get(), 1, chain_id);
-                sqlite3_bind_int(months_stmt.get(), 2, CURRENT_PROJECTOR_VERSION);
-
-                int months_rc = SQLITE_OK;
-                while ((months_rc = months_stmt.step()) == SQLITE_ROW)
+                const unsigned char* month = sqlite3_column_text(months_stmt.get(), 0);
+                if (month != nullptr)
                 {
-                    const unsigned char* month = sqlite3_column_text(months_stmt.get(), 0);
-                    if (month != nullptr)
-                    {
-                        months.emplace_back(reinterpret_cast<const char*>(month));
-                    }
-                }
-                if (months_rc != SQLITE_DONE)
-                {
-                    throw std::runtime_error(sqlite3_errmsg(_write_db));
+                    months.emplace_back(reinterpret_cast<const char*>(month));
                 }
             }
+            if (months_rc != SQLITE_DONE)
+            {
+                throw std::runtime_error(sqlite3_errmsg(reader_db));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("Events pendingArchiveMonths failed: {}", e.what());
+            sqlite3_close(reader_db);
+            return std::nullopt;
+        }
+
+        sqlite3_close(reader_db);
+        return months;
+    }
+
+    std::optional<std::size_t> SQLiteHotStore::pruneArchivedBatch(
+        const int chain_id,
+        const std::size_t hot_window_days,
+        const std::int64_t now_ms,
+        const std::size_t limit)
+    {
+        std::optional<ArchivePruneCursor> cursor;
+        return pruneArchivedBatch(chain_id, hot_window_days, now_ms, limit, cursor);
+    }
+
+    std::optional<std::size_t> SQLiteHotStore::pruneArchivedBatch(
+        const int chain_id,
+        const std::size_t hot_window_days,
+        const std::int64_t now_ms,
+        const std::size_t limit,
+        std::optional<ArchivePruneCursor> & cursor)
+    {
+        const std::int64_t cutoff_seconds =
+            static_cast<std::int64_t>(now_ms / 1000) -
+            static_cast<std::int64_t>(hot_window_days) * 24 * 60 * 60;
+
+        if (!storage::sqlite::exec(_write_db, "BEGIN IMMEDIATE TRANSACTION;"))
+        {
+            return std::nullopt;
+        }
+
+        try
+        {
+            if (!storage::sqlite::exec(_write_db, "DROP TABLE IF EXISTS temp.prune_keys;"))
+            {
+                throw std::runtime_error(sqlite3_errmsg(_write_db));
+            }
 
-            for (const std::string& month : months)
+            std::string create_prune_keys_sql =
+                "CREATE TEMP TABLE prune_keys AS "
+                "SELECT chain_id, tx_hash, log_index, block_hash, block_time "
+                "FROM normalized_events_hot "
+                "WHERE chain_id=?1 AND state='finalized' AND projected_version>=?2 AND exported=1 "
+                "AND block_time IS NOT NULL AND block_time < ?3 ";
+            if (cursor.has_value())
             {
-                if (!_exportMonth(chain_id, month, now_ms))
-                {
-                    return false;
-                }
+                create_prune_keys_sql +=
+                    "AND (block_time > ?5 "
+                    "OR (block_time = ?5 AND tx_hash > ?6) "
+                    "OR (block_time = ?5 AND tx_hash = ?6 AND log_index > ?7)) ";
+            }
+            create_prune_keys_sql +=
+                "AND NOT EXISTS ("
+                "SELECT 1 FROM projection_jobs j "
+                "WHERE j.chain_id=normalized_events_hot.chain_id "
+                "AND j.block_hash=normalized_events_hot.block_hash "
+                "AND j.log_index=normalized_events_hot.log_index"
+                ") "
+                "AND EXISTS ("
+                "SELECT 1 FROM feed_items_hot f "
+                "WHERE f.chain_id=normalized_events_hot.chain_id "
+                "AND f.tx_hash=normalized_events_hot.tx_hash "
+                "AND f.log_index=normalized_events_hot.log_index "
+                "AND f.status='finalized' AND f.exported=1"
+                ") "
+                "ORDER BY block_time ASC, tx_hash ASC, log_index ASC "
+                "LIMIT ?4;";
+
+            storage::sqlite::Statement create_prune_keys(_write_db, create_prune_keys_sql.c_str());
+
+            sqlite3_bind_int(create_prune_keys.get(), 1, chain_id);
+            sqlite3_bind_int(create_prune_keys.get(), 2, CURRENT_PROJECTOR_VERSION);
+            sqlite3_bind_int64(create_prune_keys.get(), 3, static_cast<sqlite3_int64>(cutoff_seconds));
+            sqlite3_bind_int64(create_prune_keys.get(), 4, static_cast<sqlite3_int64>(limit));
+            if (cursor.has_value())
+            {
+                sqlite3_bind_int64(create_prune_keys.get(), 5, static_cast<sqlite3_int64>(cursor->block_time));
+                sqlite3_bind_text(create_prune_keys.get(), 6, cursor->tx_hash.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int64(create_prune_keys.get(), 7, static_cast<sqlite3_int64>(cursor->log_index));
             }
 
-            const std::int64_t cutoff_seconds =
-                static_cast<std::int64_t>(now_ms / 1000) -
-                static_cast<std::int64_t>(hot_window_days) * 24 * 60 * 60;
+            if (create_prune_keys.step() != SQLITE_DONE)
+            {
+                throw std::runtime_error(sqlite3_errmsg(_write_db));
+            }
 
+            std::size_t pruned_count = 0;
             {
-                if (!storage::sqlite::exec(_write_db, "BEGIN IMMEDIATE TRANSACTION;"))
+                storage::sqlite::Statement count_prune_keys(_write_db, "SELECT COUNT(1) FROM temp.prune_keys;");
+                if (count_prune_keys.step() != SQLITE_ROW)
                 {
-                    return false;
+                    throw std::runtime_error(sqlite3_errmsg(_write_db));
                 }
+                pruned_count = static_cast<std::size_t>(sqlite3_column_int64(count_prune_keys.get(), 0));
+            }
 
-                try
+            std::optional<ArchivePruneCursor> next_cursor = cursor;
+            if (pruned_count > 0)
+            {
+                storage::sqlite::Statement last_prune_key(
+                    _write_db,
+                    "SELECT block_time, tx_hash, log_index FROM temp.prune_keys "
+                    "ORDER BY block_time DESC, tx_hash DESC, log_index DESC LIMIT 1;");
+                if (last_prune_key.step() != SQLITE_ROW)
                 {
-                    if (!storage::sqlite::exec(_write_db, "DROP TABLE IF EXISTS temp.prune_keys;"))
-                    {
-                        throw std::runtime_error(sqlite3_errmsg(_write_db));
-                    }
-
-                    storage::sqlite::Statement create_prune_keys(
-                        _write_db,
-                        "CREATE TEMP TABLE prune_keys AS "
-                        "SELECT chain_id, tx_hash, log_index, block_hash "
-                        "FROM normalized_events_hot "
-                        "WHERE chain_id=?1 AND state='finalized' AND projected_version>=?2 AND exported=1 "
-                        "AND block_time IS NOT NULL AND block_time < ?3 "
-                        "AND NOT EXISTS ("
-                        "SELECT 1 FROM projection_jobs j "
-                        "WHERE j.chain_id=normalized_events_hot.chain_id "
-                        "AND j.block_hash=normalized_events_hot.block_hash "
-                        "AND j.log_index=normalized_events_hot.log_index"
-                        ") "
-                        "AND EXISTS ("
-                        "SELECT 1 FROM feed_items_hot f "
-                        "WHERE f.chain_id=normalized_events_hot.chain_id "
-                        "AND f.tx_hash=normalized_events_hot.tx_hash "
-                        "AND f.log_index=normalized_events_hot.log_index "
-                        "AND f.status='finalized' AND f.exported=1"
-                        ");");
-
-                    sqlite3_bind_int(create_prune_keys.get(), 1, chain_id);
-                    sqlite3_bind_int(create_prune_keys.get(), 2, CURRENT_PROJECTOR_VERSION);
-                    sqlite3_bind_int64(create_prune_keys.get(), 3, static_cast<sqlite3_int64>(cutoff_seconds));
-
-                    if (create_prune_keys.step() != SQLITE_DONE)
-                    {
-                        throw std::runtime_error(sqlite3_errmsg(_write_db));
-                    }
-
-                    if (!storage::sqlite::exec(
-                            _write_db,
-                            "CREATE INDEX IF NOT EXISTS temp.idx_prune_keys_block_log "
-                            "ON prune_keys(chain_id, block_hash, log_index);"))
-                    {
-                        throw std::runtime_error(sqlite3_errmsg(_write_db));
-                    }
-
-                    if (!storage::sqlite::exec(
-                            _write_db,
-                            "CREATE INDEX IF NOT EXISTS temp.idx_prune_keys_tx_log "
-                            "ON prune_keys(chain_id, tx_hash, log_index);"))
-                    {
-                        throw std::runtime_error(sqlite3_errmsg(_write_db));
-                    }
+                    throw std::runtime_error(sqlite3_errmsg(_write_db));
+                }
+                next_cursor = ArchivePruneCursor{
+                    .block_time = sqlite3_column_int64(last_prune_key.get(), 0),
+                    .tx_hash = reinterpret_cast<const char*>(sqlite3_column_text(last_prune_key.get(), 1)),
+                    .log_index = sqlite3_column_int64(last_prune_key.get(), 2)
+                };
 
-                    storage::sqlite::Statement prune_feed(
+                if (!storage::sqlite::exec(
                         _write_db,
-                        "DELETE FROM feed_items_hot "
-                        "WHERE feed_items_hot.exported=1 "
-                        "AND EXISTS ("
-                        "SELECT 1 FROM temp.prune_keys k "
-                        "WHERE k.chain_id=feed_items_hot.chain_id "
-                        "AND k.tx_hash=feed_items_hot.tx_hash "
-                        "AND k.log_index=feed_items_hot.log_index"
-                        ");");
-
-                    if (prune_feed.step() != SQLITE_DONE)
-                    {
-                        throw std::runtime_error(sqlite3_errmsg(_write_db));
-                    }
+                        "CREATE INDEX IF NOT EXISTS temp.idx_prune_keys_block_log "
+                        "ON prune_keys(chain_id, block_hash, log_index);"))
+                {
+                    throw std::runtime_error(sqlite3_errmsg(_write_db));
+                }
 
-                    storage::sqlite::Statement prune_raw(
+                if (!storage::sqlite::exec(
                         _write_db,
-                        "DELETE FROM raw_events_hot "
-                        "WHERE EXISTS ("
-                        "SELECT 1 FROM temp.prune_keys k "
-                        "WHERE k.chain_id=raw_events_hot.chain_id "
-                        "AND k.block_hash=raw_events_hot.block_hash "
-                        "AND k.log_index=raw_events_hot.log_index"
-                        ");");
-
-                    if (prune_raw.step() != SQLITE_DONE)
-                    {
-                        throw std::runtime_error(sqlite3_errmsg(_write_db));
-                    }
+                        "CREATE INDEX IF NOT EXISTS temp.idx_prune_keys_tx_log "
+                        "ON prune_keys(chain_id, tx_hash, log_index);"))
+                {
+                    throw std::runtime_error(sqlite3_errmsg(_write_db));
+                }
 
-                    storage::sqlite::Statement prune_norm(
-                        _write_db,
-                        "DELETE FROM normalized_events_hot "
-                        "WHERE EXISTS ("
-                        "SELECT 1 "
-                        "FROM temp.prune_keys k "
-                        "WHERE k.chain_id=normalized_events_hot.chain_id "
-                        "AND k.block_hash=normalized_events_hot.block_hash "
-                        "AND k.log_index=normalized_events_hot.log_index"
-                        ");");
-
-                    if (prune_norm.step() != SQLITE_DONE)
-                    {
-                        throw std::runtime_error(sqlite3_errmsg(_write_db));
-                    }
+                storage::sqlite::Statement prune_feed(
+                    _write_db,
+                    "DELETE FROM feed_items_hot "
+                    "WHERE feed_items_hot.exported=1 "
+                    "AND EXISTS ("
+                    "SELECT 1 FROM temp.prune_keys k "
+                    "WHERE k.chain_id=feed_items_hot.chain_id "
+                    "AND k.tx_hash=feed_items_hot.tx_hash "
+                    "AND k.log_index=feed_items_hot.log_index"
+                    ");");
 
-                    if (!storage::sqlite::exec(_write_db, "DROP TABLE IF EXISTS temp.prune_keys;"))
-                    {
-                        throw std::runtime_error(sqlite3_errmsg(_write_db));
-                    }
+                if (prune_feed.step() != SQLITE_DONE)
+                {
+                    throw std::runtime_error(sqlite3_errmsg(_write_db));
+                }
 
-                    if (!storage::sqlite::exec(_write_db, "COMMIT;"))
-                    {
-                        throw std::runtime_error("commit failed");
-                    }
+                storage::sqlite::Statement prune_raw(
+                    _write_db,
+                    "DELETE FROM raw_events_hot "
+                    "WHERE EXISTS ("
+                    "SELECT 1 FROM temp.prune_keys k "
+                    "WHERE k.chain_id=raw_events_hot.chain_id "
+                    "AND k.block_hash=raw_events_hot.block_hash "
+                    "AND k.log_index=raw_events_hot.log_index"
+                    ");");
 
-                    return true;
+                if (prune_raw.step() != SQLITE_DONE)
+                {
+                    throw std::runtime_error(sqlite3_errmsg(_write_db));
                 }
-                catch (const std::exception& e)
+
+                storage::sqlite::Statement prune_norm(
+                    _write_db,
+                    "DELETE FROM normalized_events_hot "
+                    "WHERE EXISTS ("
+                    "SELECT 1 "
+                    "FROM temp.prune_keys k "
+                    "WHERE k.chain_id=normalized_events_hot.chain_id "
+                    "AND k.block_hash=normalized_events_hot.block_hash "
+                    "AND k.log_index=normalized_events_hot.log_index"
+                    ");");
+
+                if (prune_norm.step() != SQLITE_DONE)
                 {
-                    spdlog::error("Events runArchiveCycle prune phase failed: {}", e.what());
-                    (void)storage::sqlite::exec(_write_db, "ROLLBACK;");
-                    return false;
+                    throw std::runtime_error(sqlite3_errmsg(_write_db));
                 }
             }
+
+            if (!storage::sqlite::exec(_write_db, "DROP TABLE IF EXISTS temp.prune_keys;"))
+            {
+                throw std::runtime_error(sqlite3_errmsg(_write_db));
+            }
+
+            if (!storage::sqlite::exec(_write_db, "COMMIT;"))
+            {
+                throw std::runtime_error("commit failed");
+            }
+
+            cursor = std::move(next_cursor);
+            return pruned_count;
         }
         catch (const std::exception& e)
         {
-            spdlog::error("Events runArchiveCycle failed: {}", e.what());
-            return false;
+            spdlog::error("Events pruneArchivedBatch failed: {}", e.what());
+            (void)storage::sqlite::exec(_write_db, "ROLLBACK;");
+            return std::nullopt;
         }
-    } 
+    }
 
     bool SQLiteHotStore::runCycle(const int chain_id, const std::size_t hot_window_days, const std::int64_t now_ms)
     {
@@ -2033,35 +2370,20 @@ namespace dcn::events
 
         for (const auto& archive_path : archive_paths)
         {
-            sqlite3* archive_db = nullptr;
-            const int open_rc = sqlite3_open_v2(
-                archive_path.string().c_str(),
-                &archive_db,
-                SQLITE_OPEN_READONLY | SQLITE_OPEN_FULLMUTEX,
-                nullptr);
-
-            if (open_rc != SQLITE_OK)
+            const std::shared_ptr<sqlite3> archive_db = _archiveReader(archive_path);
+            if (archive_db == nullptr)
             {
-                if (archive_db != nullptr)
-                {
-                    sqlite3_close(archive_db);
-                }
                 continue;
             }
 
-            sqlite3_busy_timeout(archive_db, 10'000);
-
             _appendFeedRowsFromDatabase(
-                archive_db,
+                archive_db.get(),
                 "feed_items_archive",
                 query,
                 before_key,
                 limit + 1,
                 all_items,
                 seen_feed_ids);
-
-            sqlite3_close(archive_db);
-            archive_db = nullptr;
         }
 
         std::ranges::sort(all_items, _feedDescComparator);
@@ -2155,17 +2477,12 @@ namespace dcn::events
             delta.status = reinterpret_cast<const char*>(sqlite3_column_text(stream_stmt.get(), 1));
             delta.feed_id = reinterpret_cast<const char*>(sqlite3_column_text(stream_stmt.get(), 2));
             delta.history_cursor = reinterpret_cast<const char*>(sqlite3_column_text(stream_stmt.get(), 3));
-            const std::string payload_json = reinterpret_cast<const char*>(sqlite3_column_text(stream_stmt.get(), 4));
+            delta.payload_json = _validatedPayloadJson(stream_stmt.get(), 4);
             delta.created_at_ms = static_cast<std::int64_t>(sqlite3_column_int64(stream_stmt.get(), 5));
             const unsigned char * event_type_txt = sqlite3_column_text(stream_stmt.get(), 6);
             delta.event_type = (event_type_txt == nullptr)
                 ? std::string{}
                 : std::string(reinterpret_cast<const char *>(event_type_txt));
-            delta.payload = json::parse(payload_json, nullptr, false);
-            if (delta.payload.is_discarded())
-            {
-                delta.payload = json::object();
-            }
             page.deltas.push_back(std::move(delta));
         }
         if (stream_rc != SQLITE_DONE)
@@ -2392,6 +2709,8 @@ namespace dcn::events
                     "last_export_ms INTEGER NOT NULL,"
                     "PRIMARY KEY(chain_id, archive_month)"
                     ");") &&
+               storage::sqlite::exec(_write_db,
+                    "CREATE INDEX IF NOT EXISTS idx_projection_jobs_created ON projection_jobs(created_at_ms);") &&
                storage::sqlite::exec(_write_db,
                     "CREATE INDEX IF NOT EXISTS idx_raw_chain_tx_log ON raw_events_hot(chain_id, tx_hash, log_index);") &&
                storage::sqlite::exec(_write_db, "CREATE INDEX IF NOT EXISTS idx_raw_block ON raw_events_hot(chain_id, block_number);") &&
@@ -2450,7 +2769,9 @@ namespace dcn::events
 
     bool SQLiteHotStore::_initializeArchiveSchema(sqlite3* archive_db) const
     {
-        return storage::sqlite::exec(archive_db,
+        // Incremental auto-vacuum only takes effect on a fresh shard; older shards are compacted by VACUUM below.
+        return storage::sqlite::exec(archive_db, "PRAGMA auto_vacuum=INCREMENTAL;") &&
+               storage::sqlite::exec(archive_db,
                     "CREATE TABLE IF NOT EXISTS normalized_events_archive ("
                     "chain_id INTEGER NOT NULL,"
                     "block_hash TEXT NOT NULL,"
@@ -2489,20 +2810,6 @@ namespace dcn::events
                     "updated_at_ms INTEGER NOT NULL,"
                     "projector_version INTEGER NOT NULL"
                     ");") &&
-               storage::sqlite::exec(archive_db,
-                    "CREATE INDEX IF NOT EXISTS idx_archive_feed_visible_order ON feed_items_archive(block_number DESC, "
-                    "tx_index DESC, log_index DESC, feed_id DESC) WHERE visible=1;") &&
-               storage::sqlite::exec(archive_db,
-                    "CREATE INDEX IF NOT EXISTS idx_archive_feed_chain_visible_order "
-                    "ON feed_items_archive(chain_id, block_number DESC, tx_index DESC, log_index DESC, feed_id DESC) "
-                    "WHERE visible=1;") &&
-               storage::sqlite::exec(archive_db,
-                    "CREATE INDEX IF NOT EXISTS idx_archive_feed_type_order ON feed_items_archive(event_type, block_number "
-                    "DESC, tx_index DESC, log_index DESC, feed_id DESC);") &&
-               storage::sqlite::exec(archive_db,
-                    "CREATE INDEX IF NOT EXISTS idx_archive_feed_visible_updated_order "
-                    "ON feed_items_archive(created_at_ms DESC, block_number DESC, tx_index DESC, "
-                    "feed_id DESC) WHERE visible=1;") &&
                storage::sqlite::exec(archive_db,
                     "CREATE INDEX IF NOT EXISTS idx_archive_feed_chain_visible_updated_order "
                     "ON feed_items_archive(chain_id, created_at_ms DESC, block_number DESC, tx_index DESC, "
@@ -2513,161 +2820,290 @@ namespace dcn::events
                     "feed_id DESC);");
     }
 
+    bool SQLiteHotStore::_compactArchiveShard(sqlite3* archive_db) const
+    {
+        // Shards are read only through the feed page order, plain or filtered by event type, so the
+        // block-order indexes of older shard layouts are dead weight on disk.
+        static constexpr const char* LEGACY_ARCHIVE_INDEXES[] = {
+            "idx_archive_feed_visible_order",
+            "idx_archive_feed_chain_visible_order",
+            "idx_archive_feed_type_order",
+            "idx_archive_feed_visible_updated_order",
+        };
+
+        std::size_t dropped_indexes = 0;
+        for (const char* index_name : LEGACY_ARCHIVE_INDEXES)
+        {
+            storage::sqlite::Statement exists_stmt(
+                archive_db, "SELECT 1 FROM sqlite_master WHERE type='index' AND name=?1;");
+            sqlite3_bind_text(exists_stmt.get(), 1, index_name, -1, SQLITE_STATIC);
+            if (exists_stmt.step() != SQLITE_ROW)
+            {
+                continue;
+            }
+
+            if (!storage::sqlite::exec(archive_db, std::format("DROP INDEX IF EXISTS {};", index_name).c_str()))
+            {
+                return false;
+            }
+            ++dropped_indexes;
+        }
+
+        if (dropped_indexes > 0)
+        {
+            return storage::sqlite::exec(archive_db, "VACUUM;");
+        }
+
+        return storage::sqlite::exec(archive_db, "PRAGMA incremental_vacuum;");
+    }
+
+    std::shared_ptr<sqlite3> SQLiteHotStore::_archiveReader(const std::filesystem::path& archive_path) const
+    {
+        const std::string key = archive_path.string();
+
+        std::lock_guard lock(_archive_readers_mutex);
+        if (const auto it = _archive_reader_index.find(key); it != _archive_reader_index.end())
+        {
+            _archive_readers.splice(_archive_readers.begin(), _archive_readers, it->second);
+            return it->second->second;
+        }
+
+        sqlite3* archive_db = nullptr;
+        const int open_rc = sqlite3_open_v2(
+            key.c_str(),
+            &archive_db,
+            SQLITE_OPEN_READONLY | SQLITE_OPEN_FULLMUTEX,
+            nullptr);
+
+        if (open_rc != SQLITE_OK)
+        {
+            if (archive_db != nullptr)
+            {
+                sqlite3_close(archive_db);
+            }
+            return nullptr;
+        }
+
+        sqlite3_busy_timeout(archive_db, 10'000);
+        (void)storage::sqlite::exec(archive_db, "PRAGMA query_only=ON;");
+        (void)storage::sqlite::exec(archive_db, std::format("PRAGMA mmap_size={};", ARCHIVE_READER_MMAP_BYTES).c_str());
+
+        std::shared_ptr<sqlite3> reader(archive_db, sqlite3_close);
+        _archive_readers.emplace_front(key, reader);
+        _archive_reader_index.emplace(key, _archive_readers.begin());
+
+        // Pages still reading an evicted shard hold their own reference to its connection.
+        while (_archive_readers.size() > ARCHIVE_READER_CACHE_SIZE)
+        {
+            _archive_reader_index.erase(_archive_readers.back().first);
+            _archive_readers.pop_back();
+        }
+        return reader;
+    }
+
 
     bool SQLiteHotStore::_exportMonth(
         const int chain_id,
         const std::string& month_token,
         const std::int64_t now_ms)
     {
-        
+        const std::optional<ArchiveShardExport> shard = exportArchiveShard(chain_id, month_token);
+        if (!shard.has_value())
+        {
+            return false;
+        }
 
+        if (shard->empty())
+        {
+            return true;
+        }
+
+        return commitArchiveShard(*shard, now_ms);
+    }
+
+    std::optional<ArchiveShardExport> SQLiteHotStore::exportArchiveShard(
+        const int chain_id,
+        const std::string& month_token) const
+    {
         const auto month_bounds = parseMonthBounds(month_token);
         if (!month_bounds.has_value())
         {
-            return false;
+            return std::nullopt;
         }
 
+        const auto started_at = std::chrono::steady_clock::now();
+
         EventShardId shard_id{.chain_id = chain_id, .year = month_bounds->year, .month = month_bounds->month};
         const std::filesystem::path archive_path = _shard_router->filenameFor(shard_id);
 
+        ArchiveShardExport shard{};
+        shard.chain_id = chain_id;
+        shard.month_token = month_token;
+        shard.archive_path = archive_path;
+
+        sqlite3 * reader_db = _openSnapshotReader(_hot_db_path);
+        if (reader_db == nullptr)
+        {
+            return std::nullopt;
+        }
+
         std::vector<NormalizedArchiveRow> normalized_rows;
-        std::vector<NormalizedHotKey> normalized_hot_keys;
+        std::vector<NormalizedHotKey> & normalized_hot_keys = shard.normalized_hot_keys;
         std::vector<FeedArchiveRow> feed_rows;
-        std::vector<FeedHotKey> feed_hot_keys;
-        {
-            {
-                storage::sqlite::Statement select_norm(_write_db,
-                                      "SELECT "
-                                      "chain_id, block_hash, log_index, tx_hash, block_number, tx_index, block_time, "
-                                      "event_type, name, caller, owner, entity_address, args_count, format_hash, "
-                                      "state, seen_at_ms, updated_at_ms, projected_version "
-                                      "FROM normalized_events_hot n "
-                                      "WHERE n.chain_id=?1 AND n.state='finalized' AND n.projected_version>=?2 AND n.exported=0 "
-                                      "AND n.block_time IS NOT NULL AND n.block_time>=?3 AND n.block_time<?4 "
-                                      "AND EXISTS ("
-                                      "SELECT 1 FROM feed_items_hot f "
-                                      "WHERE f.chain_id=n.chain_id AND f.tx_hash=n.tx_hash AND f.log_index=n.log_index"
-                                      ") "
-                                      "AND NOT EXISTS ("
-                                      "SELECT 1 FROM projection_jobs j "
-                                      "WHERE j.chain_id=n.chain_id AND j.block_hash=n.block_hash AND j.log_index=n.log_index"
-                                      ");");
-
-                sqlite3_bind_int(select_norm.get(), 1, chain_id);
-                sqlite3_bind_int(select_norm.get(), 2, CURRENT_PROJECTOR_VERSION);
-                sqlite3_bind_int64(select_norm.get(), 3, static_cast<sqlite3_int64>(month_bounds->start_block_time));
-                sqlite3_bind_int64(select_norm.get(), 4, static_cast<sqlite3_int64>(month_bounds->end_block_time));
-
-                int select_norm_rc = SQLITE_OK;
-                while ((select_norm_rc = select_norm.step()) == SQLITE_ROW)
-                {
-                    NormalizedArchiveRow row{};
-                    row.chain_id = sqlite3_column_int(select_norm.get(), 0);
-                    row.block_hash = reinterpret_cast<const char*>(sqlite3_column_text(select_norm.get(), 1));
-                    row.log_index = static_cast<std::int64_t>(sqlite3_column_int64(select_norm.get(), 2));
-                    row.tx_hash = reinterpret_cast<const char*>(sqlite3_column_text(select_norm.get(), 3));
-                    row.block_number = static_cast<std::int64_t>(sqlite3_column_int64(select_norm.get(), 4));
-                    row.tx_index = static_cast<std::int64_t>(sqlite3_column_int64(select_norm.get(), 5));
-                    row.block_time = _columnInt64Optional(select_norm.get(), 6);
-                    row.event_type = reinterpret_cast<const char*>(sqlite3_column_text(select_norm.get(), 7));
-                    row.name = reinterpret_cast<const char*>(sqlite3_column_text(select_norm.get(), 8));
-                    row.caller = reinterpret_cast<const char*>(sqlite3_column_text(select_norm.get(), 9));
-                    row.owner = reinterpret_cast<const char*>(sqlite3_column_text(select_norm.get(), 10));
-                    row.entity_address = reinterpret_cast<const char*>(sqlite3_column_text(select_norm.get(), 11));
-                    row.args_count = _columnInt64Optional(select_norm.get(), 12);
-                    row.format_hash = _columnTextOptional(select_norm.get(), 13);
-                    row.state = reinterpret_cast<const char*>(sqlite3_column_text(select_norm.get(), 14));
-                    row.seen_at_ms = static_cast<std::int64_t>(sqlite3_column_int64(select_norm.get(), 15));
-                    row.updated_at_ms = static_cast<std::int64_t>(sqlite3_column_int64(select_norm.get(), 16));
-                    const int selected_projected_version = sqlite3_column_int(select_norm.get(), 17);
-                    normalized_hot_keys.push_back(NormalizedHotKey{
-                        .chain_id = row.chain_id,
-                        .block_hash = row.block_hash,
-                        .log_index = row.log_index,
-                        .projected_version = selected_projected_version,
-                        .updated_at_ms = row.updated_at_ms
-                        });
-                    normalized_rows.push_back(std::move(row));
-                }
-                if (select_norm_rc != SQLITE_DONE)
-                {
-                    throw std::runtime_error(sqlite3_errmsg(_write_db));
-                }
+        std::vector<FeedHotKey> & feed_hot_keys = shard.feed_hot_keys;
+        try
+        {
+            // Both selects read one WAL snapshot; the write strand re-validates every key on commit.
+            if (!storage::sqlite::exec(reader_db, "BEGIN;"))
+            {
+                throw std::runtime_error(sqlite3_errmsg(reader_db));
             }
 
             {
-                storage::sqlite::Statement select_feed(_write_db,
-                                      "SELECT "
-                                      "feed_id, chain_id, tx_hash, log_index, block_number, tx_index, block_time, "
-                                      "event_type, status, visible, history_cursor, payload_json, "
-                                      "created_at_ms, updated_at_ms, projector_version "
-                                      "FROM feed_items_hot f "
-                                      "WHERE f.chain_id=?1 AND f.status='finalized' AND f.exported=0 "
-                                      "AND f.block_time IS NOT NULL AND f.block_time>=?2 AND f.block_time<?3 "
-                                      "AND EXISTS ("
-                                      "SELECT 1 FROM normalized_events_hot n2 "
-                                      "WHERE n2.chain_id=f.chain_id AND n2.tx_hash=f.tx_hash AND n2.log_index=f.log_index "
-                                      "AND n2.projected_version>=?4"
-                                      ") "
-                                      "AND NOT EXISTS ("
-                                      "SELECT 1 "
-                                      "FROM normalized_events_hot n "
-                                      "JOIN projection_jobs j "
-                                      "ON j.chain_id=n.chain_id AND j.block_hash=n.block_hash AND j.log_index=n.log_index "
-                                      "WHERE n.chain_id=f.chain_id AND n.tx_hash=f.tx_hash AND n.log_index=f.log_index"
-                                      ");");
-
-                sqlite3_bind_int(select_feed.get(), 1, chain_id);
-                sqlite3_bind_int64(select_feed.get(), 2, static_cast<sqlite3_int64>(month_bounds->start_block_time));
-                sqlite3_bind_int64(select_feed.get(), 3, static_cast<sqlite3_int64>(month_bounds->end_block_time));
-                sqlite3_bind_int(select_feed.get(), 4, CURRENT_PROJECTOR_VERSION);
-
-                int select_feed_rc = SQLITE_OK;
-                while ((select_feed_rc = select_feed.step()) == SQLITE_ROW)
                 {
-                    FeedArchiveRow row{};
-                    row.feed_id = reinterpret_cast<const char*>(sqlite3_column_text(select_feed.get(), 0));
-                    row.chain_id = sqlite3_column_int(select_feed.get(), 1);
-                    row.tx_hash = reinterpret_cast<const char*>(sqlite3_column_text(select_feed.get(), 2));
-                    row.log_index = static_cast<std::int64_t>(sqlite3_column_int64(select_feed.get(), 3));
-                    row.block_number = static_cast<std::int64_t>(sqlite3_column_int64(select_feed.get(), 4));
-                    row.tx_index = static_cast<std::int64_t>(sqlite3_column_int64(select_feed.get(), 5));
-                    row.block_time = _columnInt64Optional(select_feed.get(), 6);
-                    row.event_type = reinterpret_cast<const char*>(sqlite3_column_text(select_feed.get(), 7));
-                    row.status = reinterpret_cast<const char*>(sqlite3_column_text(select_feed.get(), 8));
-                    row.visible = sqlite3_column_int(select_feed.get(), 9) != 0;
-                    row.history_cursor = reinterpret_cast<const char*>(sqlite3_column_text(select_feed.get(), 10));
-                    row.payload_json = reinterpret_cast<const char*>(sqlite3_column_text(select_feed.get(), 11));
-                    row.created_at_ms = static_cast<std::int64_t>(sqlite3_column_int64(select_feed.get(), 12));
-                    row.updated_at_ms = static_cast<std::int64_t>(sqlite3_column_int64(select_feed.get(), 13));
-                    row.projector_version = sqlite3_column_int(select_feed.get(), 14);
-                    feed_hot_keys.push_back(FeedHotKey{
-                        .chain_id = row.chain_id,
-                        .feed_id = row.feed_id,
-                        .projector_version = row.projector_version,
-                        .updated_at_ms = row.updated_at_ms,
-                        .history_cursor = row.history_cursor,
-                        .payload_json = row.payload_json});
-                    feed_rows.push_back(std::move(row));
+                    storage::sqlite::Statement select_norm(reader_db,
+                                          "SELECT "
+                                          "chain_id, block_hash, log_index, tx_hash, block_number, tx_index, block_time, "
+                                          "event_type, name, caller, owner, entity_address, args_count, format_hash, "
+                                          "state, seen_at_ms, updated_at_ms, projected_version "
+                                          "FROM normalized_events_hot n "
+                                          "WHERE n.chain_id=?1 AND n.state='finalized' AND n.projected_version>=?2 AND n.exported=0 "
+                                          "AND n.block_time IS NOT NULL AND n.block_time>=?3 AND n.block_time<?4 "
+                                          "AND EXISTS ("
+                                          "SELECT 1 FROM feed_items_hot f "
+                                          "WHERE f.chain_id=n.chain_id AND f.tx_hash=n.tx_hash AND f.log_index=n.log_index"
+                                          ") "
+                                          "AND NOT EXISTS ("
+                                          "SELECT 1 FROM projection_jobs j "
+                                          "WHERE j.chain_id=n.chain_id AND j.block_hash=n.block_hash AND j.log_index=n.log_index"
+                                          ");");
+
+                    sqlite3_bind_int(select_norm.get(), 1, chain_id);
+                    sqlite3_bind_int(select_norm.get(), 2, CURRENT_PROJECTOR_VERSION);
+                    sqlite3_bind_int64(select_norm.get(), 3, static_cast<sqlite3_int64>(month_bounds->start_block_time));
+                    sqlite3_bind_int64(select_norm.get(), 4, static_cast<sqlite3_int64>(month_bounds->end_block_time));
+
+                    int select_norm_rc = SQLITE_OK;
+                    while ((select_norm_rc = select_norm.step()) == SQLITE_ROW)
+                    {
+                        NormalizedArchiveRow row{};
+                        row.chain_id = sqlite3_column_int(select_norm.get(), 0);
+                        row.block_hash = reinterpret_cast<const char*>(sqlite3_column_text(select_norm.get(), 1));
+                        row.log_index = static_cast<std::int64_t>(sqlite3_column_int64(select_norm.get(), 2));
+                        row.tx_hash = reinterpret_cast<const char*>(sqlite3_column_text(select_norm.get(), 3));
+                        row.block_number = static_cast<std::int64_t>(sqlite3_column_int64(select_norm.get(), 4));
+                        row.tx_index = static_cast<std::int64_t>(sqlite3_column_int64(select_norm.get(), 5));
+                        row.block_time = _columnInt64Optional(select_norm.get(), 6);
+                        row.event_type = reinterpret_cast<const char*>(sqlite3_column_text(select_norm.get(), 7));
+                        row.name = reinterpret_cast<const char*>(sqlite3_column_text(select_norm.get(), 8));
+                        row.caller = reinterpret_cast<const char*>(sqlite3_column_text(select_norm.get(), 9));
+                        row.owner = reinterpret_cast<const char*>(sqlite3_column_text(select_norm.get(), 10));
+                        row.entity_address = reinterpret_cast<const char*>(sqlite3_column_text(select_norm.get(), 11));
+                        row.args_count = _columnInt64Optional(select_norm.get(), 12);
+                        row.format_hash = _columnTextOptional(select_norm.get(), 13);
+                        row.state = reinterpret_cast<const char*>(sqlite3_column_text(select_norm.get(), 14));
+                        row.seen_at_ms = static_cast<std::int64_t>(sqlite3_column_int64(select_norm.get(), 15));
+                        row.updated_at_ms = static_cast<std::int64_t>(sqlite3_column_int64(select_norm.get(), 16));
+                        const int selected_projected_version = sqlite3_column_int(select_norm.get(), 17);
+                        normalized_hot_keys.push_back(NormalizedHotKey{
+                            .chain_id = row.chain_id,
+                            .block_hash = row.block_hash,
+                            .log_index = row.log_index,
+                            .projected_version = selected_projected_version,
+                            .updated_at_ms = row.updated_at_ms
+                            });
+                        normalized_rows.push_back(std::move(row));
+                    }
+                    if (select_norm_rc != SQLITE_DONE)
+                    {
+                        throw std::runtime_error(sqlite3_errmsg(reader_db));
+                    }
                 }
-                if (select_feed_rc != SQLITE_DONE)
+
                 {
-                    throw std::runtime_error(sqlite3_errmsg(_write_db));
+                    storage::sqlite::Statement select_feed(reader_db,
+                                          "SELECT "
+                                          "feed_id, chain_id, tx_hash, log_index, block_number, tx_index, block_time, "
+                                          "event_type, status, visible, history_cursor, payload_json, "
+                                          "created_at_ms, updated_at_ms, projector_version "
+                                          "FROM feed_items_hot f "
+                                          "WHERE f.chain_id=?1 AND f.status='finalized' AND f.exported=0 "
+                                          "AND f.block_time IS NOT NULL AND f.block_time>=?2 AND f.block_time<?3 "
+                                          "AND EXISTS ("
+                                          "SELECT 1 FROM normalized_events_hot n2 "
+                                          "WHERE n2.chain_id=f.chain_id AND n2.tx_hash=f.tx_hash AND n2.log_index=f.log_index "
+                                          "AND n2.projected_version>=?4"
+                                          ") "
+                                          "AND NOT EXISTS ("
+                                          "SELECT 1 "
+                                          "FROM normalized_events_hot n "
+                                          "JOIN projection_jobs j "
+                                          "ON j.chain_id=n.chain_id AND j.block_hash=n.block_hash AND j.log_index=n.log_index "
+                                          "WHERE n.chain_id=f.chain_id AND n.tx_hash=f.tx_hash AND n.log_index=f.log_index"
+                                          ");");
+
+                    sqlite3_bind_int(select_feed.get(), 1, chain_id);
+                    sqlite3_bind_int64(select_feed.get(), 2, static_cast<sqlite3_int64>(month_bounds->start_block_time));
+                    sqlite3_bind_int64(select_feed.get(), 3, static_cast<sqlite3_int64>(month_bounds->end_block_time));
+                    sqlite3_bind_int(select_feed.get(), 4, CURRENT_PROJECTOR_VERSION);
+
+                    int select_feed_rc = SQLITE_OK;
+                    while ((select_feed_rc = select_feed.step()) == SQLITE_ROW)
+                    {
+                        FeedArchiveRow row{};
+                        row.feed_id = reinterpret_cast<const char*>(sqlite3_column_text(select_feed.get(), 0));
+                        row.chain_id = sqlite3_column_int(select_feed.get(), 1);
+                        row.tx_hash = reinterpret_cast<const char*>(sqlite3_column_text(select_feed.get(), 2));
+                        row.log_index = static_cast<std::int64_t>(sqlite3_column_int64(select_feed.get(), 3));
+                        row.block_number = static_cast<std::int64_t>(sqlite3_column_int64(select_feed.get(), 4));
+                        row.tx_index = static_cast<std::int64_t>(sqlite3_column_int64(select_feed.get(), 5));
+                        row.block_time = _columnInt64Optional(select_feed.get(), 6);
+                        row.event_type = reinterpret_cast<const char*>(sqlite3_column_text(select_feed.get(), 7));
+                        row.status = reinterpret_cast<const char*>(sqlite3_column_text(select_feed.get(), 8));
+                        row.visible = sqlite3_column_int(select_feed.get(), 9) != 0;
+                        row.history_cursor = reinterpret_cast<const char*>(sqlite3_column_text(select_feed.get(), 10));
+                        row.payload_json = reinterpret_cast<const char*>(sqlite3_column_text(select_feed.get(), 11));
+                        row.created_at_ms = static_cast<std::int64_t>(sqlite3_column_int64(select_feed.get(), 12));
+                        row.updated_at_ms = static_cast<std::int64_t>(sqlite3_column_int64(select_feed.get(), 13));
+                        row.projector_version = sqlite3_column_int(select_feed.get(), 14);
+                        feed_hot_keys.push_back(FeedHotKey{
+                            .chain_id = row.chain_id,
+                            .feed_id = row.feed_id,
+                            .projector_version = row.projector_version,
+                            .updated_at_ms = row.updated_at_ms,
+                            .history_cursor = row.history_cursor,
+                            .payload_json = row.payload_json});
+                        feed_rows.push_back(std::move(row));
+                    }
+                    if (select_feed_rc != SQLITE_DONE)
+                    {
+                        throw std::runtime_error(sqlite3_errmsg(reader_db));
+                    }
                 }
             }
+
+            (void)storage::sqlite::exec(reader_db, "COMMIT;");
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("Archive export snapshot failed for month {}: {}", month_token, e.what());
+            (void)storage::sqlite::exec(reader_db, "ROLLBACK;");
+            sqlite3_close(reader_db);
+            return std::nullopt;
         }
+        sqlite3_close(reader_db);
 
         if (normalized_rows.empty() && feed_rows.empty())
         {
-            return true;
+            return shard;
         }
 
         const bool archive_write_ok =
             [this,
              month_token,
              archive_path,
-             normalized_rows = std::move(normalized_rows),
-             feed_rows = std::move(feed_rows)]() mutable -> bool
+             &normalized_rows,
+             &feed_rows]() -> bool
             {
                 std::error_code dir_ec;
                 std::filesystem::create_directories(archive_path.parent_path(), dir_ec);
@@ -2700,7 +3136,7 @@ namespace dcn::events
                 sqlite3_busy_timeout(archive_db, 10'000);
 
                 if (!storage::sqlite::exec(archive_db, "PRAGMA journal_mode=WAL;") 
-                    || !storage::sqlite::exec(archive_db, "PRAGMA synchronous=NORMAL;") 
+                    || !storage::sqlite::exec(archive_db, "PRAGMA synchronous=FULL;") 
                     || !storage::sqlite::exec(archive_db, "PRAGMA temp_store=MEMORY;") 
                     || !storage::sqlite::exec(archive_db, "PRAGMA foreign_keys=OFF;"))
                 {
@@ -2853,12 +3289,51 @@ namespace dcn::events
                     return false;
                 }
 
+                if (!_compactArchiveShard(archive_db))
+                {
+                    spdlog::error("Archive shard compaction failed for month {}: {}", month_token, sqlite3_errmsg(archive_db));
+                    sqlite3_close(archive_db);
+                    archive_db = nullptr;
+                    return false;
+                }
+
+                // Fold the WAL back into the shard file so the fsynced main file is self-contained
+                // before the catalog starts pointing readers at it.
+                if (!storage::sqlite::exec(archive_db, "PRAGMA wal_checkpoint(TRUNCATE);"))
+                {
+                    spdlog::error("Archive shard checkpoint failed for month {}", month_token);
+                    sqlite3_close(archive_db);
+                    archive_db = nullptr;
+                    return false;
+                }
+
                 sqlite3_close(archive_db);
                 archive_db = nullptr;
                 return true;
             }();
 
         if (!archive_write_ok)
+        {
+            return std::nullopt;
+        }
+
+        std::error_code size_ec;
+        shard.shard_bytes = static_cast<std::size_t>(std::filesystem::file_size(archive_path, size_ec));
+        if (size_ec)
+        {
+            shard.shard_bytes = 0;
+        }
+        shard.normalized_rows = normalized_rows.size();
+        shard.feed_rows = feed_rows.size();
+        shard.elapsed_ms = static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - started_at).count());
+        return shard;
+    }
+
+    bool SQLiteHotStore::commitArchiveShard(const ArchiveShardExport & shard, const std::int64_t now_ms)
+    {
+        const auto month_bounds = parseMonthBounds(shard.month_token);
+        if (!month_bounds.has_value())
         {
             return false;
         }
@@ -2885,7 +3360,7 @@ namespace dcn::events
                     ");");
 
                 std::size_t normalized_snapshot_mismatch = 0;
-                for (const auto& key : normalized_hot_keys)
+                for (const auto& key : shard.normalized_hot_keys)
                 {
                     sqlite3_bind_int64(mark_norm_exported.get(), 1, static_cast<sqlite3_int64>(now_ms));
                     sqlite3_bind_int(mark_norm_exported.get(), 2, key.chain_id);
@@ -2916,8 +3391,8 @@ namespace dcn::events
                         "Archive export finalization: {}/{} normalized rows had snapshot mismatches for month {}; "
                         "leaving them unexported for next cycle",
                         normalized_snapshot_mismatch,
-                        normalized_hot_keys.size(),
-                        month_token);
+                        shard.normalized_hot_keys.size(),
+                        shard.month_token);
                 }
 
                 storage::sqlite::Statement mark_feed_exported(
@@ -2928,7 +3403,7 @@ namespace dcn::events
                     "AND history_cursor=?6 AND payload_json=?7 AND exported=0;");
 
                 std::size_t feed_snapshot_mismatch = 0;
-                for (const auto& key : feed_hot_keys)
+                for (const auto& key : shard.feed_hot_keys)
                 {
                     sqlite3_bind_int64(mark_feed_exported.get(), 1, static_cast<sqlite3_int64>(now_ms));
                     sqlite3_bind_text(mark_feed_exported.get(),
@@ -2967,8 +3442,8 @@ namespace dcn::events
                         "Archive export finalization: {}/{} feed rows had snapshot mismatches for month {}; "
                         "leaving them unexported for next cycle",
                         feed_snapshot_mismatch,
-                        feed_hot_keys.size(),
-                        month_token);
+                        shard.feed_hot_keys.size(),
+                        shard.month_token);
                 }
 
                 std::int64_t min_block = 0;
@@ -2980,7 +3455,7 @@ namespace dcn::events
                                          "FROM normalized_events_hot "
                                          "WHERE chain_id=?1 AND state='finalized' AND projected_version>=?2 AND exported=1 "
                                          "AND block_time IS NOT NULL AND block_time>=?3 AND block_time<?4;");
-                    sqlite3_bind_int(stats_stmt.get(), 1, chain_id);
+                    sqlite3_bind_int(stats_stmt.get(), 1, shard.chain_id);
                     sqlite3_bind_int(stats_stmt.get(), 2, CURRENT_PROJECTOR_VERSION);
                     sqlite3_bind_int64(stats_stmt.get(), 3, static_cast<sqlite3_int64>(month_bounds->start_block_time));
                     sqlite3_bind_int64(stats_stmt.get(), 4, static_cast<sqlite3_int64>(month_bounds->end_block_time));
@@ -3007,10 +3482,10 @@ namespace dcn::events
                     "path=excluded.path, state='READY', min_block=excluded.min_block, max_block=excluded.max_block, "
                     "row_count=excluded.row_count, last_export_ms=excluded.last_export_ms;");
 
-                sqlite3_bind_int(catalog_stmt.get(), 1, chain_id);
-                sqlite3_bind_text(catalog_stmt.get(), 2, month_token.c_str(), static_cast<int>(month_token.size()), SQLITE_TRANSIENT);
+                sqlite3_bind_int(catalog_stmt.get(), 1, shard.chain_id);
+                sqlite3_bind_text(catalog_stmt.get(), 2, shard.month_token.c_str(), static_cast<int>(shard.month_token.size()), SQLITE_TRANSIENT);
 
-                const std::string archive_path_str = archive_path.string();
+                const std::string archive_path_str = shard.archive_path.string();
                 sqlite3_bind_text(catalog_stmt.get(),
                                   3,
                                   archive_path_str.c_str(),
@@ -3034,7 +3509,7 @@ namespace dcn::events
             }
             catch (const std::exception& e)
             {
-                spdlog::error("Archive export finalization failed for month {}: {}", month_token, e.what());
+                spdlog::error("Archive export finalization failed for month {}: {}", shard.month_token, e.what());
                 (void)storage::sqlite::exec(_write_db, "ROLLBACK;");
                 return false;
             }
@@ -3189,17 +3664,10 @@ namespace dcn::events
             item.tx_index = static_cast<std::int64_t>(sqlite3_column_int64(stmt.get(), 6));
             item.log_index = static_cast<std::int64_t>(sqlite3_column_int64(stmt.get(), 7));
             item.history_cursor = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 8));
-            const std::string payload_json = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 9));
+            item.payload_json = _validatedPayloadJson(stmt.get(), 9);
             item.created_at_ms = static_cast<std::int64_t>(sqlite3_column_int64(stmt.get(), 10));
             item.updated_at_ms = static_cast<std::int64_t>(sqlite3_column_int64(stmt.get(), 11));
             item.projector_version = sqlite3_column_int(stmt.get(), 12);
-            item.payload = json::parse(payload_json, nullptr, false);
-
-            if (item.payload.is_discarded())
-            {
-                item.payload = json::object();
-            }
-
             if (before_key.has_value() && !_cursorLessInDescOrder(item, *before_key))
             {
                 continue;
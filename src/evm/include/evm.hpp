@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -11,6 +12,7 @@
 #include <fstream>
 #include <istream>
 #include <optional>
+#include <mutex>
 
 // Undefine the conflicting macro
 #ifdef interface
@@ -38,15 +40,41 @@
 
 #include "evm_storage.hpp"
 #include "evm_formatter.hpp"
+#include "evm_compile_service.hpp"
+#include "evm_compile_cache.hpp"
+#include "evm_snapshot.hpp"
+#include "evm_execution_pool.hpp"
 
 namespace dcn::evm
 {
+    struct SoliditySource
+    {
+        // Compiled as the source unit `<name>.sol`; artifacts are written per contract as `<contract>.bin/.abi`.
+        std::string name;
+        std::string code;
+    };
+
+    struct DeployRequest
+    {
+        // Hex bytecode as written by `solc --bin`.
+        std::filesystem::path code_path;
+        // The same, already in memory; takes precedence over `code_path` when set.
+        std::string code_hex;
+        chain::Address sender{};
+        std::vector<std::uint8_t> constructor_args;
+        std::uint64_t gas_limit = 0;
+        std::uint64_t value = 0;
+    };
+
     class EVM
     {
     public:
         using EmittedLogRecord = EVMStorage::EmittedLogRecord;
 
-        EVM(asio::io_context & io_context, evmc_revision rev, std::filesystem::path solc_path, std::filesystem::path pt_path);
+        // With a snapshot configured, startup restores the state saved under a matching tag instead of deploying PT.
+        EVM(asio::io_context & io_context, evmc_revision rev, std::filesystem::path solc_path, std::filesystem::path pt_path,
+            CompileServiceConfig compile_config = {}, CompileCacheConfig cache_config = {},
+            StateSnapshotConfig snapshot_config = {}, ExecutionPoolConfig execution_config = {});
         ~EVM() = default;
 
         EVM(const EVM&) = delete;
@@ -58,10 +86,19 @@ namespace dcn::evm
         asio::awaitable<bool> addAccount(chain::Address address, std::uint64_t initial_gas) noexcept;
         asio::awaitable<bool> setGas(chain::Address address, std::uint64_t gas) noexcept;
 
+        // Runs on the compile service, never on the EVM strand, so execution keeps going during builds.
+        // Sources seen before are served from the compile cache without starting solc.
         asio::awaitable<bool> compile(std::filesystem::path code_path,
                 std::filesystem::path out_dir,
                 std::filesystem::path base_path = {},
-                std::filesystem::path includes = {}) const noexcept;
+                std::filesystem::path includes = {}) noexcept;
+
+        // Compiles all `sources` in one `solc --standard-json` run sharing import resolution, writing only the
+        // artifacts of contracts defined in them. Reports per source whether its artifacts are in `out_dir`.
+        asio::awaitable<std::vector<bool>> compileBatch(std::vector<SoliditySource> sources,
+                std::filesystem::path out_dir,
+                std::filesystem::path base_path = {},
+                std::filesystem::path includes = {}) noexcept;
 
         asio::awaitable<std::expected<chain::Address, chain::DeployError>> deploy(  
                     std::istream & code_stream, 
@@ -77,12 +114,22 @@ namespace dcn::evm
                     std::uint64_t gas_limit,
                     std::uint64_t value) noexcept;
 
+        // Deploys every request in a single visit to the EVM strand. Like a per-object deploy, each sender
+        // account is created if needed and funded with the request's gas limit first.
+        asio::awaitable<std::vector<std::expected<chain::Address, chain::DeployError>>> deployBatch(
+                    std::vector<DeployRequest> requests) noexcept;
+
+        // With `pooled` and an execution pool, runs on an overlay over the shared state in parallel with other
+        // calls; a call that turns out to write state runs again on the strand, so its effects land exactly once.
+        // Publishing the shared state copies every account written since the last one, so internal calls that
+        // follow deploys stay on the strand.
         asio::awaitable<std::expected<std::vector<std::uint8_t>, chain::ExecuteError>> execute(
                     chain::Address sender,
                     chain::Address recipient, 
                     std::vector<std::uint8_t> input_bytes,
                     std::uint64_t gas_limit,
-                    std::uint64_t value) noexcept;
+                    std::uint64_t value,
+                    bool pooled = false) noexcept;
 
         asio::awaitable<std::vector<EmittedLogRecord>> getLogsSince(std::uint64_t after_seq, std::size_t limit) noexcept;
         asio::awaitable<std::int64_t> getHeadBlockNumber() noexcept;
@@ -93,10 +140,43 @@ namespace dcn::evm
         const std::filesystem::path & getSolcPath() const;
         const std::filesystem::path & getPTPath() const;
 
+        CompileServiceStats getCompileStats() const;
+        CompileCacheStats getCompileCacheStats() const;
+        ExecutionPoolStats getExecutionStats() const;
+
+        // Completes once PT is loaded or restored from the snapshot; nothing should deploy before that.
+        asio::awaitable<void> waitReady();
+        bool isReady() const noexcept;
+
+        // Copies the state on the strand and writes it to the snapshot file off it. Does nothing before PT is loaded.
+        asio::awaitable<bool> saveSnapshot() noexcept;
+
+        // Stops periodic snapshots and writes a final one if the state changed since the last.
+        asio::awaitable<bool> close() noexcept;
+
     protected:
         asio::awaitable<bool> loadPT();
 
     private:
+        // Restores the snapshot or loads PT, then starts periodic snapshots.
+        asio::awaitable<bool> _start();
+        asio::awaitable<bool> _loadSnapshot();
+        asio::awaitable<void> _runSnapshots();
+        asio::awaitable<std::string> _snapshotTag();
+
+        asio::awaitable<std::optional<std::string>> _solcVersion() noexcept;
+
+        static std::expected<std::vector<std::uint8_t>, chain::DeployError> _makeDeploymentInput(
+                    const std::string & code_hex,
+                    const std::vector<std::uint8_t> & constructor_args);
+
+        // Must run on `_strand`.
+        std::expected<chain::Address, chain::DeployError> _createOnStrand(
+                    const std::vector<std::uint8_t> & deployment_input,
+                    const chain::Address & sender,
+                    std::uint64_t gas_limit,
+                    std::uint64_t value);
+
         asio::strand<asio::io_context::executor_type> _strand;
         
         evmc::VM _vm;
@@ -105,13 +185,35 @@ namespace dcn::evm
         std::filesystem::path _solc_path;
         std::filesystem::path _pt_path;
 
+        CompileService _compile_service;
+        CompileCache _compile_cache;
+
+        std::mutex _solc_version_mutex;
+        std::optional<std::string> _solc_version;
+
         EVMStorage _storage;
+        ExecutionPool _execution_pool;
         
         chain::Address _genesis_address;
         chain::Address _console_log_address;
 
         chain::Address _registry_address;
         chain::Address _runner_address;
+
+        StateSnapshotConfig _snapshot_config;
+        // Strand state
+        asio::steady_timer _snapshot_timer;
+        asio::steady_timer _ready_timer;
+        bool _closed = false;
+
+        // Written on the strand, read anywhere through isReady.
+        std::atomic<bool> _ready = false;
+
+        // Serializes snapshot writes; the version tells whether a newer state was written already.
+        std::mutex _snapshot_write_mutex;
+        std::optional<std::uint64_t> _snapshot_written_version;
+        // Writes and syncs snapshot files off the strand.
+        asio::thread_pool _snapshot_pool{1};
     };
 
     asio::awaitable<std::expected<std::vector<std::uint8_t>, chain::ExecuteError>> fetchOwner(EVM & evm, const chain::Address & address);
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+namespace dcn::evm
+{
+    struct CompileCacheConfig
+    {
+        // Artifact directory, safe to share between nodes over a mounted volume; empty disables the cache.
+        std::filesystem::path root;
+        // Least recently used entries are evicted once the artifacts exceed this size.
+        std::uint64_t max_bytes = 512ull * 1024 * 1024;
+    };
+
+    struct CompileCacheStats
+    {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t stores = 0;
+        std::uint64_t evictions = 0;
+
+        std::size_t entries = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    // Content-addressed store of solc output directories. An entry lives under
+    // `<root>/objects/<key[0:2]>/<key>` and is published with a single rename, so readers on other
+    // nodes either see a complete entry or none. Directory mtimes double as the shared LRU clock.
+    class CompileCache
+    {
+        public:
+            explicit CompileCache(CompileCacheConfig config = {});
+
+            CompileCache(const CompileCache&) = delete;
+            CompileCache& operator=(const CompileCache&) = delete;
+
+            bool enabled() const;
+
+            // Hex keccak256 over everything that decides the artifacts solc writes for a source. The source's file
+            // or unit name is left out: artifacts are named after the contracts in the source, so equal sources
+            // share one entry whatever they are called.
+            static std::string makeKey(
+                std::string_view source,
+                std::string_view compiler_version,
+                const std::vector<std::string> & flags,
+                std::string_view include_tree_hash);
+
+            // Hash of every .sol file under `roots`. Memoized, as the import trees do not change while running.
+            std::string includeTreeHash(const std::vector<std::filesystem::path> & roots);
+
+            // Copies the artifacts of `key` into `out_dir`; false on a miss.
+            bool fetch(const std::string & key, const std::filesystem::path & out_dir);
+
+            // Fresh directory for solc to write into before the outputs are published with `store`.
+            std::filesystem::path makeStagingDir(const std::string & key) const;
+
+            // Copies the artifacts in `staging_dir` into `out_dir` and publishes them as the entry for `key`.
+            // `staging_dir` is consumed either way.
+            bool store(const std::string & key, const std::filesystem::path & staging_dir, const std::filesystem::path & out_dir);
+
+            CompileCacheStats stats() const;
+
+        private:
+            struct Entry
+            {
+                std::uint64_t bytes = 0;
+                std::filesystem::file_time_type last_used{};
+            };
+
+            std::filesystem::path _entryPath(const std::string & key) const;
+
+            void _scan();
+            // Drops least recently used entries until the budget holds and returns their directories,
+            // which the caller deletes once the mutex is released.
+            std::vector<std::filesystem::path> _evictLocked();
+            static void _removeEvicted(const std::vector<std::filesystem::path> & evicted);
+
+            CompileCacheConfig _config;
+
+            mutable std::mutex _mutex;
+            absl::flat_hash_map<std::string, Entry> _entries;
+            absl::flat_hash_map<std::string, std::string> _include_tree_hashes;
+            CompileCacheStats _stats;
+    };
+}
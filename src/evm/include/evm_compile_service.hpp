@@ -0,0 +1,129 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <absl/container/flat_hash_set.h>
+
+#include "async.hpp"
+
+namespace dcn::evm
+{
+    struct CompileServiceConfig
+    {
+        // Upper bound on solc processes running at once; 0 picks half of the hardware threads.
+        std::size_t max_concurrent_jobs = 0;
+        // Jobs waiting for a worker beyond this depth are rejected instead of queued.
+        std::size_t max_queued_jobs = 256;
+        // A solc run exceeding this is killed; zero disables the limit.
+        std::chrono::milliseconds job_timeout{std::chrono::minutes(2)};
+        // Output past this is drained but not kept; --standard-json batches return every artifact on stdout.
+        std::size_t max_output_bytes = 256 * 1024 * 1024;
+    };
+
+    enum class CompileStatus
+    {
+        OK,
+        FAILED,
+        TIMED_OUT,
+        CANCELLED,
+        REJECTED,
+        SPAWN_FAILED
+    };
+
+    struct CompileOutcome
+    {
+        CompileStatus status = CompileStatus::FAILED;
+        int exit_code = -1;
+        std::string output;
+        std::chrono::microseconds queue_wait{0};
+        std::chrono::microseconds run_time{0};
+    };
+
+    struct CompileServiceStats
+    {
+        std::size_t queued = 0;
+        std::size_t running = 0;
+        std::size_t peak_running = 0;
+
+        std::uint64_t completed = 0;
+        std::uint64_t failed = 0;
+        std::uint64_t timed_out = 0;
+        std::uint64_t cancelled = 0;
+        std::uint64_t rejected = 0;
+
+        std::uint64_t total_queue_wait_us = 0;
+        std::uint64_t max_queue_wait_us = 0;
+        std::uint64_t total_run_us = 0;
+    };
+
+    // Runs solc as asynchronous child processes on its own strand, at most `max_concurrent_jobs` at a
+    // time, so a long `--via-ir` build never occupies the EVM strand or blocks an io thread.
+    class CompileService
+    {
+        public:
+            CompileService(asio::io_context & io_context, std::filesystem::path solc_path, CompileServiceConfig config = {});
+            ~CompileService();
+
+            CompileService(const CompileService&) = delete;
+            CompileService& operator=(const CompileService&) = delete;
+
+            CompileService(CompileService&&) = delete;
+            CompileService& operator=(CompileService&&) = delete;
+
+            // Runs solc with `args` once a worker is free; the timeout is granted per compiled source in
+            // `sources`. Terminal cancellation of the awaiting coroutine drops a queued job or kills its process.
+            asio::awaitable<CompileOutcome> run(std::vector<std::string> args, std::size_t sources = 1);
+
+            // Rejects new jobs, drops queued ones and kills the running processes.
+            void shutdown();
+
+            CompileServiceStats stats() const;
+
+            const std::filesystem::path & getSolcPath() const;
+
+        private:
+            struct SlotWaiter
+            {
+                explicit SlotWaiter(const asio::strand<asio::io_context::executor_type> & strand)
+                    : wakeup(strand)
+                {
+                }
+
+                asio::steady_timer wakeup;
+                bool granted = false;
+            };
+
+            asio::awaitable<bool> _acquireSlot();
+            void _releaseSlot();
+
+            asio::awaitable<CompileOutcome> _runProcess(std::vector<std::string> args, std::chrono::milliseconds timeout);
+
+            void _recordOutcome(const CompileOutcome & outcome);
+
+            asio::strand<asio::io_context::executor_type> _strand;
+            std::filesystem::path _solc_path;
+            CompileServiceConfig _config;
+
+            // Strand state
+            std::size_t _running = 0;
+            std::deque<std::shared_ptr<SlotWaiter>> _slot_waiters;
+            absl::flat_hash_set<int> _running_pids;
+            bool _shutdown = false;
+
+#if defined(WIN32)
+            // Windows has no asynchronous child pipe support in native, so solc runs blocking here instead.
+            asio::thread_pool _blocking_pool;
+#endif
+
+            mutable std::mutex _stats_mutex;
+            CompileServiceStats _stats;
+    };
+}
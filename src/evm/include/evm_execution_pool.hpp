@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "async.hpp"
+
+#include "evm_storage.hpp"
+
+namespace dcn::evm
+{
+    struct ExecutionPoolConfig
+    {
+        // Threads running calls in parallel, each with its own VM and overlay; 0 runs every call on the EVM strand.
+        std::size_t executors = 0;
+    };
+
+    struct ExecutionPoolStats
+    {
+        std::size_t executors = 0;
+        // Calls answered from an overlay.
+        std::uint64_t completed = 0;
+        // Calls that wrote state on the overlay and had to run again on the shared storage.
+        std::uint64_t rejected = 0;
+        // Most calls seen running on the pool at the same time.
+        std::size_t peak_running = 0;
+    };
+
+    // Runs calls against an immutable shared state on a pool of execution contexts, off the EVM strand.
+    // Writes only land in the context's overlay, so a call that made any is reported back for the caller
+    // to repeat on the real storage, where its effects and logs belong.
+    class ExecutionPool
+    {
+        public:
+            ExecutionPool(evmc_revision rev, ExecutionPoolConfig config = {});
+            ~ExecutionPool();
+
+            ExecutionPool(const ExecutionPool&) = delete;
+            ExecutionPool& operator=(const ExecutionPool&) = delete;
+
+            bool enabled() const noexcept;
+
+            // Resumes the caller on its own executor. Returns nothing if the call wrote persistent state.
+            // `msg` and the input it points to must outlive the call.
+            asio::awaitable<std::optional<evmc::Result>> execute(
+                    std::shared_ptr<const EVMStorage::SharedState> base,
+                    EVMStorage::ReservedBlock block,
+                    const evmc_message & msg);
+
+            ExecutionPoolStats stats() const;
+
+        private:
+            struct Context
+            {
+                explicit Context(evmc_revision rev);
+
+                evmc::VM vm;
+                EVMStorage storage;
+            };
+
+            // Body of execute, spawned onto the pool.
+            asio::awaitable<std::optional<evmc::Result>> _run(
+                    std::shared_ptr<const EVMStorage::SharedState> base,
+                    EVMStorage::ReservedBlock block,
+                    const evmc_message & msg);
+
+            std::unique_ptr<Context> _acquire();
+            void _release(std::unique_ptr<Context> context);
+
+            evmc_revision _rev;
+            ExecutionPoolConfig _config;
+            std::unique_ptr<asio::thread_pool> _pool;
+
+            mutable std::mutex _mutex;
+            std::vector<std::unique_ptr<Context>> _idle;
+            std::size_t _running = 0;
+            ExecutionPoolStats _stats;
+    };
+}
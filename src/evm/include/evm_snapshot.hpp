@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "native.h"
+#include "async.hpp"
+#include "chain.hpp"
+
+namespace dcn::evm
+{
+    struct StateSnapshotConfig
+    {
+        // Snapshot of the whole EVM state; empty disables snapshots, so PT is deployed on every start.
+        std::filesystem::path path;
+        // While the state keeps changing a snapshot is written this often; zero writes only on `EVM::close`.
+        std::chrono::milliseconds interval{0};
+        // Describes what the state was built from, such as the PT build version and the registry contents.
+        // A snapshot saved under another tag is discarded at startup. Unset means an empty tag.
+        std::function<asio::awaitable<std::string>()> tag;
+    };
+
+    struct StateSnapshotHeader
+    {
+        std::string tag;
+        chain::Address registry_address{};
+        chain::Address runner_address{};
+    };
+
+    // A validated snapshot file; `payload` points into the mapping and lives as long as `file`.
+    struct StateSnapshot
+    {
+        StateSnapshotHeader header;
+        native::MappedFile file;
+        std::span<const std::uint8_t> payload;
+    };
+
+    // Writes header and payload to a temporary file next to `path`, syncs it and renames it into place, so a crash
+    // leaves either the previous snapshot or the new one.
+    bool writeStateSnapshot(const std::filesystem::path & path, const StateSnapshotHeader & header, std::string_view payload);
+
+    // Maps the snapshot at `path` and checks its magic, format version and payload checksum.
+    std::optional<StateSnapshot> readStateSnapshot(const std::filesystem::path & path);
+}
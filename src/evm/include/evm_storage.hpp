@@ -1,8 +1,11 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <string>
 #include <cstring>
+#include <memory>
+#include <span>
 #include <vector>
 #include <format>
 #include <stack>
@@ -22,11 +25,22 @@
 
 #include <spdlog/spdlog.h>
 #include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
 
 #include "keccak256.hpp"
 
 #include "evm_formatter.hpp"
 
+// Found by argument-dependent lookup only from the namespace of the address type itself.
+namespace evmc
+{
+    template <typename H>
+    inline H AbslHashValue(H h, const evmc::address & addr)
+    {
+        return H::combine_contiguous(std::move(h), addr.bytes, sizeof(addr.bytes));
+    }
+}
+
 namespace dcn::evm
 {
     const std::uint64_t DEFAULT_GAS_LIMIT = 100'000'000;
@@ -61,32 +75,27 @@ namespace dcn::evm
             uint64_t timestamp = 0;
         };
 
-        EVMStorage(evmc::VM & vm, evmc_revision rev);
+        // Immutable copy of the persistent state that overlays execute against, shared by every thread reading it.
+        struct SharedState
+        {
+            absl::flat_hash_map<evmc::address, std::shared_ptr<const Account>> accounts;
+            absl::flat_hash_map<evmc::address, std::uint64_t> create_nonce;
+            std::uint64_t version = 0;
+        };
 
-        bool add_account(const evmc::address& addr)
+        // Block and transaction taken from the head for a call that runs on an overlay.
+        struct ReservedBlock
         {
-            if(account_exists(addr) == true)
-            {
-                spdlog::error(std::format("add_account: Account {} already exists", addr));
-                return false;
-            }
-            _accounts.emplace(to_key(addr), Account{});
-            return true;
-        }
-
-        void set_balance(const evmc::address& addr, std::uint64_t x) noexcept
-        {   
-            if(account_exists(addr) == false)
-            {
-                spdlog::error(std::format("set_balance : Account {} does not exist", addr));
-                return;
-            }
-            Account & acc = _accounts.at(to_key(addr));
-
-            acc.balance = evmc::uint256be{};
-            for (std::size_t i = 0; i < sizeof(x); ++i)
-                acc.balance.bytes[sizeof(acc.balance) - 1 - i] = static_cast<uint8_t>(x >> (8 * i));
-        }
+            std::int64_t number = 0;
+            evmc::bytes32 parent_hash{};
+            std::uint64_t tx_id = 0;
+        };
+
+        EVMStorage(evmc::VM & vm, evmc_revision rev);
+
+        bool add_account(const evmc::address& addr);
+
+        void set_balance(const evmc::address& addr, std::uint64_t x) noexcept;
 
         bool account_exists(const evmc::address& addr) const noexcept override;
 
@@ -132,9 +141,35 @@ namespace dcn::evm
         std::vector<EmittedLogRecord> get_logs_since(std::uint64_t after_seq, std::size_t limit) const;
         std::int64_t head_block_number() const noexcept;
 
-    protected:
-        std::string to_key(const evmc::address& addr) const;
+        // Appends the persistent host state to `out`: accounts with code and storage, creation nonces and the
+        // block, transaction and log counters. Emitted logs stay out; only their sequence carries over.
+        void serialize_state(std::string & out) const;
+
+        // Replaces the host state with one written by serialize_state. Malformed input leaves the state untouched.
+        bool deserialize_state(std::span<const std::uint8_t> bytes);
+
+        // Changes with every write to persistent state, so an unchanged state need not be saved again.
+        std::uint64_t state_version() const noexcept;
+
+        // The current state as an immutable copy; accounts untouched since the previous one are shared with it.
+        // Returns the previous copy itself while the state is unchanged.
+        std::shared_ptr<const SharedState> shared_state();
 
+        // Block and transaction the next top-level call would run in, leaving the head where it is.
+        ReservedBlock next_block() const noexcept;
+        // Advances the head as a top-level call would, without running one.
+        ReservedBlock reserve_block() noexcept;
+        // Hands `block` back if it is still the head, so a call that runs again elsewhere takes the same numbers.
+        // Returns false once anything advanced the head past it.
+        bool release_block(const ReservedBlock & block) noexcept;
+
+        // Turns this storage into a copy-on-write overlay over `base`: reads fall through to it, writes stay
+        // here and count towards state_version, which starts from zero. The next top-level call runs in `block`.
+        void begin_overlay(std::shared_ptr<const SharedState> base, const ReservedBlock & block);
+        // Drops every overlay write and the reference to the base.
+        void end_overlay();
+
+    protected:
         evmc_address derive_create_address(const evmc::address& sender, std::uint64_t nonce);
 
         evmc_address derive_create2_address(const evmc::address& sender, const evmc::bytes32& salt, const std::vector<std::uint8_t>& code);
@@ -158,10 +193,21 @@ namespace dcn::evm
             std::uint64_t value_b,
             std::uint64_t value_c) const;
 
+        // One hash lookup at most; repeated lookups within a top-level call are answered by the account cache.
+        const Account * find_account(const evmc::address& addr) const;
+        // Copies an account of the base into the overlay before its first write.
+        Account * find_mutable_account(const evmc::address& addr);
+        const Account * find_base_account(const evmc::address& addr) const;
+        evmc::bytes32 load_slot(const evmc::address& addr, const Account & account, const evmc::bytes32 & slot) const;
+        // Must follow every insertion into and erasure from `_accounts`, which move the cached accounts.
+        void invalidate_account_cache() const noexcept;
+        std::uint64_t & create_nonce_of(const evmc::address & sender);
+        void mark_dirty(const evmc::address& addr);
+
         evmc::VM & _vm;
         evmc_revision _revision;
 
-        absl::flat_hash_map<std::string, Account> _accounts;
+        absl::flat_hash_map<evmc::address, Account> _accounts;
         absl::flat_hash_map<evmc::address, std::uint64_t> _create_nonce;
 
         std::stack<evmc::address> _sender_stack;
@@ -171,12 +217,28 @@ namespace dcn::evm
         evmc::bytes32 _head_block_hash{};
         std::uint64_t _next_tx_id = 1;
         std::uint64_t _next_log_seq = 1;
+
+        std::uint64_t _state_version = 0;
+
+        struct CachedAccount
+        {
+            evmc::address address{};
+            const Account * account = nullptr;
+        };
+        static constexpr std::size_t ACCOUNT_CACHE_SIZE = 8;
+        // Accounts found since the current top-level call began, slotted by the last byte of their address.
+        mutable std::array<CachedAccount, ACCOUNT_CACHE_SIZE> _account_cache{};
+
+        // Last published shared state and the accounts written since.
+        std::shared_ptr<const SharedState> _shared_state;
+        absl::flat_hash_set<evmc::address> _dirty_accounts;
+
+        // Overlay state
+        std::shared_ptr<const SharedState> _base;
+        // Accounts copied from `_base` whose slots not written here are read from it.
+        absl::flat_hash_set<evmc::address> _inherited_storage;
+        absl::flat_hash_set<evmc::address> _destroyed_accounts;
     };
 
-    template <typename H>
-    inline H AbslHashValue(H h, const evmc::address & addr)
-    {
-        return H::combine(std::move(h), addr.bytes);
-    }
 }
  
@@ -1,6 +1,11 @@
 #include <exception>
 #include <limits>
+#include <random>
 #include <string_view>
+#include <system_error>
+
+#include <absl/container/flat_hash_set.h>
+#include <nlohmann/json.hpp>
 
 #include "evm.hpp"
 #include "utils.hpp"
@@ -18,6 +23,139 @@ namespace dcn::evm
 
             return std::vector<std::uint8_t>(result.output_data, result.output_data + result.output_size);
         }
+
+        const std::vector<std::string> STANDARD_JSON_CACHE_FLAGS = {
+            "--standard-json", "--evm-version", "shanghai", "--via-ir", "--optimize"
+        };
+
+        struct StandardJsonOutput
+        {
+            nlohmann::json contracts;
+            // Source units named by an error; solc generates no code for any unit of such a batch.
+            absl::flat_hash_set<std::string> failed_units;
+            bool unattributed_error = false;
+        };
+
+        std::string sourceUnitName(const SoliditySource & source)
+        {
+            return source.name + ".sol";
+        }
+
+        bool writeContractArtifacts(const nlohmann::json & unit_contracts, const std::filesystem::path & dir)
+        {
+            for(const auto & [contract_name, contract] : unit_contracts.items())
+            {
+                std::ofstream bin(dir / (contract_name + ".bin"), std::ios::binary);
+                bin << contract.value(nlohmann::json::json_pointer("/evm/bytecode/object"), std::string{});
+
+                std::ofstream abi(dir / (contract_name + ".abi"), std::ios::binary);
+                abi << contract.value("abi", nlohmann::json::array()).dump();
+
+                if(!bin.good() || !abi.good())
+                {
+                    spdlog::error("Failed to write artifacts of contract {} into {}", contract_name, dir.string());
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        asio::awaitable<std::optional<StandardJsonOutput>> runStandardJson(
+            CompileService & compile_service,
+            const std::vector<SoliditySource> & sources,
+            const std::vector<std::size_t> & selected,
+            const std::filesystem::path & base_path,
+            const std::filesystem::path & includes)
+        {
+            nlohmann::json input;
+            input["language"] = "Solidity";
+            input["settings"] = {
+                {"evmVersion", "shanghai"},
+                {"viaIR", true},
+                {"optimizer", {{"enabled", true}}}
+            };
+
+            nlohmann::json & output_selection = input["settings"]["outputSelection"];
+            for(const std::size_t i : selected)
+            {
+                const std::string unit = sourceUnitName(sources[i]);
+                input["sources"][unit]["content"] = sources[i].code;
+                output_selection[unit]["*"] = {"abi", "evm.bytecode.object"};
+            }
+
+            static thread_local std::mt19937_64 rng{std::random_device{}()};
+            const std::filesystem::path input_path =
+                std::filesystem::temp_directory_path() / std::format("dcn-solc-batch-{:016x}.json", rng());
+            {
+                std::ofstream input_file(input_path, std::ios::binary);
+                input_file << input.dump();
+                if(!input_file.good())
+                {
+                    spdlog::error("Failed to write solc standard JSON input {}", input_path.string());
+                    co_return std::nullopt;
+                }
+            }
+
+            std::vector<std::string> args = {"--standard-json", input_path.string()};
+            if(!base_path.empty())
+            {
+                args.emplace_back("--base-path");
+                args.emplace_back(base_path.string());
+            }
+            if(!includes.empty())
+            {
+                args.emplace_back("--include-path");
+                args.emplace_back(includes.string());
+            }
+
+            const CompileOutcome outcome = co_await compile_service.run(std::move(args), selected.size());
+
+            std::error_code ec;
+            std::filesystem::remove(input_path, ec);
+
+            if(outcome.status != CompileStatus::OK)
+            {
+                spdlog::error("Solc batch of {} sources did not complete: status={} exit={}\n{}",
+                    selected.size(), static_cast<int>(outcome.status), outcome.exit_code, outcome.output);
+                co_return std::nullopt;
+            }
+
+            nlohmann::json output = nlohmann::json::parse(outcome.output, nullptr, false);
+            if(output.is_discarded() || !output.is_object())
+            {
+                spdlog::error("Cannot parse solc standard JSON output:\n{}", outcome.output);
+                co_return std::nullopt;
+            }
+
+            StandardJsonOutput result;
+            for(const auto & error : output.value("errors", nlohmann::json::array()))
+            {
+                if(error.value("severity", std::string{}) != "error")
+                {
+                    continue;
+                }
+
+                spdlog::error("Solc batch error: {}", error.value("formattedMessage", error.value("message", std::string{})));
+
+                const std::string file = error.value(nlohmann::json::json_pointer("/sourceLocation/file"), std::string{});
+                const bool is_batch_unit = std::ranges::any_of(selected,
+                    [&](std::size_t i) { return sourceUnitName(sources[i]) == file; });
+                if(is_batch_unit)
+                {
+                    result.failed_units.insert(file);
+                }
+                else
+                {
+                    result.unattributed_error = true;
+                }
+            }
+
+            if(output.contains("contracts"))
+            {
+                result.contracts = std::move(output["contracts"]);
+            }
+            co_return result;
+        }
     }
 
     template<>
@@ -183,13 +321,21 @@ namespace dcn::evm
         co_return co_await evm.execute(evm.getRegistryAddress(), address, input_data, 1'000'000, 0);
     }
 
-    EVM::EVM(asio::io_context & io_context, evmc_revision rev, std::filesystem::path solc_path, std::filesystem::path pt_path)
+    EVM::EVM(asio::io_context & io_context, evmc_revision rev, std::filesystem::path solc_path, std::filesystem::path pt_path,
+        CompileServiceConfig compile_config, CompileCacheConfig cache_config, StateSnapshotConfig snapshot_config,
+        ExecutionPoolConfig execution_config)
     :   _vm(evmc_create_evmone()),
         _rev(rev),
         _strand(asio::make_strand(io_context)),
         _solc_path(std::move(solc_path)),
         _pt_path(std::move(pt_path)),
-        _storage(_vm, _rev)
+        _compile_service(io_context, _solc_path, std::move(compile_config)),
+        _compile_cache(std::move(cache_config)),
+        _storage(_vm, _rev),
+        _execution_pool(_rev, std::move(execution_config)),
+        _snapshot_config(std::move(snapshot_config)),
+        _snapshot_timer(_strand),
+        _ready_timer(_strand, asio::steady_timer::time_point::max())
     {
         if (!_vm)
         {
@@ -209,7 +355,7 @@ namespace dcn::evm
 
         co_spawn(
             io_context,
-            loadPT(),
+            _start(),
             [&io_context](std::exception_ptr exception_ptr, bool loaded_ok)
             {
                 if(exception_ptr)
@@ -249,6 +395,21 @@ namespace dcn::evm
         return _pt_path;
     }
 
+    CompileServiceStats EVM::getCompileStats() const
+    {
+        return _compile_service.stats();
+    }
+
+    CompileCacheStats EVM::getCompileCacheStats() const
+    {
+        return _compile_cache.stats();
+    }
+
+    ExecutionPoolStats EVM::getExecutionStats() const
+    {
+        return _execution_pool.stats();
+    }
+
     asio::awaitable<bool> EVM::addAccount(chain::Address address, std::uint64_t initial_gas) noexcept
     {
         co_await async::ensureOnStrand(_strand);
@@ -285,30 +446,80 @@ namespace dcn::evm
         co_return true;
     }
 
-    asio::awaitable<bool> EVM::compile(std::filesystem::path code_path, std::filesystem::path out_dir, std::filesystem::path base_path, std::filesystem::path includes) const noexcept
+    asio::awaitable<std::optional<std::string>> EVM::_solcVersion() noexcept
     {
-        co_await async::ensureOnStrand(_strand);
+        {
+            std::lock_guard lock(_solc_version_mutex);
+            if(_solc_version.has_value())
+            {
+                co_return _solc_version;
+            }
+        }
 
+        const CompileOutcome outcome = co_await _compile_service.run({"--version"});
+        if(outcome.status != CompileStatus::OK)
+        {
+            spdlog::warn("Cannot read solc version, compile cache is bypassed");
+            co_return std::nullopt;
+        }
+
+        std::lock_guard lock(_solc_version_mutex);
+        _solc_version = outcome.output;
+        co_return _solc_version;
+    }
+
+    asio::awaitable<bool> EVM::compile(std::filesystem::path code_path, std::filesystem::path out_dir, std::filesystem::path base_path, std::filesystem::path includes) noexcept
+    {
         if(!std::filesystem::exists(code_path))
         {
             spdlog::error(std::format("File {} does not exist", code_path.string()));
             co_return false;
         }
 
-        std::vector<std::string> args = {
+        if(!includes.empty() && base_path.empty())
+        {
+            spdlog::error("Base path must be specified if includes are specified");
+            co_return false;
+        }
+
+        const std::vector<std::string> flags = {
             "--evm-version", "shanghai",
-            "--overwrite", "-o", out_dir.string(),
             "--via-ir", "--optimize", "--bin",
-            "--abi",
-            code_path.string()
+            "--abi"
         };
 
-        if(!includes.empty() && base_path.empty())
+        std::optional<std::string> cache_key;
+        if(_compile_cache.enabled())
         {
-            spdlog::error("Base path must be specified if includes are specified");
-            co_return false;
+            if(const auto solc_version = co_await _solcVersion())
+            {
+                std::ifstream source_file(code_path, std::ios::binary);
+                const std::string source{std::istreambuf_iterator<char>(source_file), std::istreambuf_iterator<char>()};
+
+                std::vector<std::filesystem::path> include_roots;
+                if(!base_path.empty()) include_roots.push_back(base_path);
+                if(!includes.empty()) include_roots.push_back(includes);
+
+                cache_key = CompileCache::makeKey(
+                    source,
+                    *solc_version,
+                    flags,
+                    _compile_cache.includeTreeHash(include_roots));
+
+                if(_compile_cache.fetch(*cache_key, out_dir))
+                {
+                    spdlog::debug("Compile cache hit for {} ({})", code_path.string(), *cache_key);
+                    co_return true;
+                }
+            }
         }
 
+        // On a cacheable miss solc writes into a private staging directory that is published afterwards.
+        const std::filesystem::path solc_out_dir = cache_key ? _compile_cache.makeStagingDir(*cache_key) : out_dir;
+
+        std::vector<std::string> args = flags;
+        args.insert(args.end(), {"--overwrite", "-o", solc_out_dir.string(), code_path.string()});
+
         if (!base_path.empty()) 
         {
             args.emplace_back("--base-path");
@@ -321,31 +532,162 @@ namespace dcn::evm
             args.emplace_back(includes.string());
         }
 
-        const auto [exit_code, compile_result] = dcn::native::runProcess(_solc_path.string(), std::move(args));
+        const CompileOutcome outcome = co_await _compile_service.run(std::move(args));
 
-        spdlog::info("Solc exited with code {},\n{}\n{}", exit_code, code_path.string(), compile_result);
+        if(outcome.status != CompileStatus::OK && cache_key)
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(solc_out_dir, ec);
+        }
 
-        if(exit_code != 0)
+        if(outcome.status == CompileStatus::TIMED_OUT)
         {
+            spdlog::error("Solc timed out after {}ms: {}", outcome.run_time.count() / 1000, code_path.string());
             co_return false;
         }
-        
+
+        if(outcome.status != CompileStatus::OK && outcome.status != CompileStatus::FAILED)
+        {
+            spdlog::error("Solc job for {} did not run to completion: status={}", code_path.string(), static_cast<int>(outcome.status));
+            co_return false;
+        }
+
+        spdlog::info("Solc exited with code {},\n{}\n{}", outcome.exit_code, code_path.string(), outcome.output);
+
+        if(outcome.status != CompileStatus::OK)
+        {
+            co_return false;
+        }
+
+        if(cache_key && !_compile_cache.store(*cache_key, solc_out_dir, out_dir))
+        {
+            spdlog::error("Failed to copy solc outputs for {} into {}", code_path.string(), out_dir.string());
+            co_return false;
+        }
+
         co_return true;
     }
 
-    asio::awaitable<std::expected<chain::Address, chain::DeployError>> EVM::deploy(
-                        std::istream & code_stream,
-                        chain::Address sender,
-                        std::vector<std::uint8_t> constructor_args, 
-                        std::uint64_t gas_limit,
-                        std::uint64_t value) noexcept
+    asio::awaitable<std::vector<bool>> EVM::compileBatch(std::vector<SoliditySource> sources, std::filesystem::path out_dir, std::filesystem::path base_path, std::filesystem::path includes) noexcept
+    {
+        std::vector<bool> compiled(sources.size(), false);
+        if(sources.empty())
+        {
+            co_return compiled;
+        }
+
+        if(!includes.empty() && base_path.empty())
+        {
+            spdlog::error("Base path must be specified if includes are specified");
+            co_return compiled;
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(out_dir, ec);
+        if(ec)
+        {
+            spdlog::error("Failed to create directory {}: {}", out_dir.string(), ec.message());
+            co_return compiled;
+        }
+
+        std::vector<std::optional<std::string>> cache_keys(sources.size());
+        if(_compile_cache.enabled())
+        {
+            if(const auto solc_version = co_await _solcVersion())
+            {
+                std::vector<std::filesystem::path> include_roots;
+                if(!base_path.empty()) include_roots.push_back(base_path);
+                if(!includes.empty()) include_roots.push_back(includes);
+                const std::string include_tree_hash = _compile_cache.includeTreeHash(include_roots);
+
+                for(std::size_t i = 0; i < sources.size(); ++i)
+                {
+                    cache_keys[i] = CompileCache::makeKey(
+                        sources[i].code,
+                        *solc_version,
+                        STANDARD_JSON_CACHE_FLAGS,
+                        include_tree_hash);
+                    compiled[i] = _compile_cache.fetch(*cache_keys[i], out_dir);
+                }
+            }
+        }
+
+        std::vector<std::size_t> pending;
+        for(std::size_t i = 0; i < sources.size(); ++i)
+        {
+            if(!compiled[i])
+            {
+                pending.push_back(i);
+            }
+        }
+
+        const std::size_t cache_hits = sources.size() - pending.size();
+
+        // An error in one source stops code generation for the whole batch, so the sources that were
+        // only collateral damage get a second run without the failing ones.
+        for(int attempt = 0; attempt < 2 && !pending.empty(); ++attempt)
+        {
+            const auto output = co_await runStandardJson(_compile_service, sources, pending, base_path, includes);
+            if(!output)
+            {
+                break;
+            }
+
+            std::vector<std::size_t> retry;
+            for(const std::size_t i : pending)
+            {
+                const std::string unit = sourceUnitName(sources[i]);
+                if(output->failed_units.contains(unit))
+                {
+                    continue;
+                }
+
+                if(!output->contracts.contains(unit))
+                {
+                    retry.push_back(i);
+                    continue;
+                }
+
+                if(cache_keys[i])
+                {
+                    const std::filesystem::path staging_dir = _compile_cache.makeStagingDir(*cache_keys[i]);
+                    compiled[i] = writeContractArtifacts(output->contracts[unit], staging_dir) &&
+                        _compile_cache.store(*cache_keys[i], staging_dir, out_dir);
+                    if(!compiled[i])
+                    {
+                        std::filesystem::remove_all(staging_dir, ec);
+                    }
+                }
+                else
+                {
+                    compiled[i] = writeContractArtifacts(output->contracts[unit], out_dir);
+                }
+            }
+
+            if(output->unattributed_error || output->failed_units.empty())
+            {
+                break;
+            }
+            pending = std::move(retry);
+        }
+
+        spdlog::info(
+            "Solc batch compiled {}/{} sources ({} from cache)",
+            std::ranges::count(compiled, true),
+            sources.size(),
+            cache_hits);
+        co_return compiled;
+    }
+
+    std::expected<std::vector<std::uint8_t>, chain::DeployError> EVM::_makeDeploymentInput(
+                        const std::string & code_hex,
+                        const std::vector<std::uint8_t> & constructor_args)
     {
-        const std::string code_hex = std::string(std::istreambuf_iterator<char>(code_stream), std::istreambuf_iterator<char>());
         const std::optional<evmc::bytes> bytecode_result = evmc::from_hex(code_hex);
         if(!bytecode_result)
         {
             spdlog::error("Cannot parse bytecode");
-            co_return std::unexpected(chain::DeployError{
+            return std::unexpected(chain::DeployError{
                 .kind = chain::DeployError::Kind::INVALID_INPUT,
                 .message = "Cannot parse bytecode"
             });
@@ -355,7 +697,7 @@ namespace dcn::evm
         if(bytecode.size() == 0)
         {
             spdlog::error("Empty bytecode");
-            co_return std::unexpected(chain::DeployError{
+            return std::unexpected(chain::DeployError{
                 .kind = chain::DeployError::Kind::INVALID_INPUT,
                 .message = "Empty bytecode"
             });
@@ -376,7 +718,15 @@ namespace dcn::evm
         deployment_input.reserve(bytecode.size() + constructor_args.size());
         deployment_input.insert(deployment_input.end(), bytecode.begin(), bytecode.end());
         deployment_input.insert(deployment_input.end(), constructor_args.begin(), constructor_args.end());
+        return deployment_input;
+    }
 
+    std::expected<chain::Address, chain::DeployError> EVM::_createOnStrand(
+                        const std::vector<std::uint8_t> & deployment_input,
+                        const chain::Address & sender,
+                        std::uint64_t gas_limit,
+                        std::uint64_t value)
+    {
         evmc_message create_msg{};
         create_msg.kind       = EVMC_CREATE;
         create_msg.sender     = sender;
@@ -391,8 +741,6 @@ namespace dcn::evm
         std::memcpy(&value256.bytes[24], &value, sizeof(value));  // Big endian: last 8 bytes hold the value
         create_msg.value = value256;
 
-        co_await async::ensureOnStrand(_strand);
-
         const evmc::Result result = _storage.call(create_msg);        
 
         if (result.status_code != EVMC_SUCCESS)
@@ -412,7 +760,7 @@ namespace dcn::evm
             }
 
             spdlog::error(std::format("Failed to deploy contract: {}, error: {} {}", result.status_code, error.kind, output_hex));
-            co_return std::unexpected(error);
+            return std::unexpected(error);
         }
 
         // Display result
@@ -423,7 +771,25 @@ namespace dcn::evm
             spdlog::debug("Output size: {}", result.output_size);
         }
 
-        co_return result.create_address;
+        return result.create_address;
+    }
+
+    asio::awaitable<std::expected<chain::Address, chain::DeployError>> EVM::deploy(
+                        std::istream & code_stream,
+                        chain::Address sender,
+                        std::vector<std::uint8_t> constructor_args, 
+                        std::uint64_t gas_limit,
+                        std::uint64_t value) noexcept
+    {
+        const std::string code_hex = std::string(std::istreambuf_iterator<char>(code_stream), std::istreambuf_iterator<char>());
+        const auto deployment_input = _makeDeploymentInput(code_hex, constructor_args);
+        if(!deployment_input)
+        {
+            co_return std::unexpected(deployment_input.error());
+        }
+
+        co_await async::ensureOnStrand(_strand);
+        co_return _createOnStrand(*deployment_input, sender, gas_limit, value);
      }
 
     asio::awaitable<std::expected<chain::Address, chain::DeployError>> EVM::deploy(
@@ -438,12 +804,58 @@ namespace dcn::evm
         co_return co_await deploy(file, std::move(sender), std::move(constructor_args),  gas_limit, value);
     }
 
+    asio::awaitable<std::vector<std::expected<chain::Address, chain::DeployError>>> EVM::deployBatch(
+                    std::vector<DeployRequest> requests) noexcept
+    {
+        std::vector<std::expected<chain::Address, chain::DeployError>> results;
+        results.reserve(requests.size());
+
+        // Reading and decoding the bytecode stays off the strand.
+        std::vector<std::expected<std::vector<std::uint8_t>, chain::DeployError>> deployment_inputs;
+        deployment_inputs.reserve(requests.size());
+        for(const DeployRequest & request : requests)
+        {
+            if(!request.code_hex.empty())
+            {
+                deployment_inputs.push_back(_makeDeploymentInput(request.code_hex, request.constructor_args));
+                continue;
+            }
+
+            std::ifstream file(request.code_path, std::ios::binary);
+            const std::string code_hex(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>{});
+            deployment_inputs.push_back(_makeDeploymentInput(code_hex, request.constructor_args));
+        }
+
+        co_await async::ensureOnStrand(_strand);
+
+        for(std::size_t i = 0; i < requests.size(); ++i)
+        {
+            if(!deployment_inputs[i])
+            {
+                results.push_back(std::unexpected(deployment_inputs[i].error()));
+                continue;
+            }
+
+            const DeployRequest & request = requests[i];
+            if(!_storage.account_exists(request.sender))
+            {
+                _storage.add_account(request.sender);
+            }
+            _storage.set_balance(request.sender, request.gas_limit);
+
+            results.push_back(_createOnStrand(*deployment_inputs[i], request.sender, request.gas_limit, request.value));
+        }
+
+        co_return results;
+    }
+
     asio::awaitable<std::expected<std::vector<std::uint8_t>, chain::ExecuteError>> EVM::execute(
                     chain::Address sender,
                     chain::Address recipient,
                     std::vector<std::uint8_t> input_bytes,
                     std::uint64_t gas_limit,
-                    std::uint64_t value) noexcept
+                    std::uint64_t value,
+                    bool pooled) noexcept
     {
         if(std::ranges::all_of(recipient.bytes, [](uint8_t b) { return b == 0; }))
         {
@@ -476,7 +888,20 @@ namespace dcn::evm
         msg.value = value256;
 
         co_await async::ensureOnStrand(_strand);
-        evmc::Result result = _storage.call(msg);
+        std::optional<evmc::Result> pooled_result;
+        if(pooled && _execution_pool.enabled())
+        {
+            // Each run takes its own block and transaction before leaving the strand, so concurrent runs never share them.
+            const EVMStorage::ReservedBlock block = _storage.reserve_block();
+            pooled_result = co_await _execution_pool.execute(_storage.shared_state(), block, msg);
+            co_await async::ensureOnStrand(_strand);
+            if(!pooled_result)
+            {
+                // The run below takes a fresh block; hand this one back unless a later call already followed it.
+                _storage.release_block(block);
+            }
+        }
+        evmc::Result result = pooled_result ? std::move(*pooled_result) : _storage.call(msg);
         
         if (result.status_code != EVMC_SUCCESS)
         {
@@ -635,4 +1060,185 @@ namespace dcn::evm
         co_return true;
     }
 
+    asio::awaitable<bool> EVM::_start()
+    {
+        if(_snapshot_config.path.empty() || !co_await _loadSnapshot())
+        {
+            if(!co_await loadPT())
+            {
+                co_return false;
+            }
+        }
+
+        co_await async::ensureOnStrand(_strand);
+        _ready.store(true, std::memory_order_release);
+        _ready_timer.cancel();
+
+        if(!_snapshot_config.path.empty() && _snapshot_config.interval.count() > 0 && !_closed)
+        {
+            co_spawn(_strand, _runSnapshots(), asio::detached);
+        }
+        co_return true;
+    }
+
+    bool EVM::isReady() const noexcept
+    {
+        return _ready.load(std::memory_order_acquire);
+    }
+
+    asio::awaitable<void> EVM::waitReady()
+    {
+        co_await async::ensureOnStrand(_strand);
+        while(!_ready && !_closed)
+        {
+            std::error_code ec;
+            co_await _ready_timer.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+        }
+    }
+
+    asio::awaitable<std::string> EVM::_snapshotTag()
+    {
+        if(!_snapshot_config.tag)
+        {
+            co_return std::string{};
+        }
+        co_return co_await _snapshot_config.tag();
+    }
+
+    asio::awaitable<bool> EVM::_loadSnapshot()
+    {
+        std::optional<StateSnapshot> snapshot = readStateSnapshot(_snapshot_config.path);
+        if(!snapshot)
+        {
+            co_return false;
+        }
+
+        const std::string tag = co_await _snapshotTag();
+        if(snapshot->header.tag != tag)
+        {
+            spdlog::info("Discarding EVM snapshot {} taken for '{}', expected '{}'",
+                _snapshot_config.path.string(), snapshot->header.tag, tag);
+            co_return false;
+        }
+
+        co_await async::ensureOnStrand(_strand);
+
+        if(!_storage.deserialize_state(snapshot->payload))
+        {
+            spdlog::warn("Cannot restore EVM snapshot {}, deploying PT", _snapshot_config.path.string());
+            co_return false;
+        }
+
+        _registry_address = snapshot->header.registry_address;
+        _runner_address = snapshot->header.runner_address;
+
+        {
+            std::lock_guard lock(_snapshot_write_mutex);
+            _snapshot_written_version = _storage.state_version();
+        }
+
+        spdlog::info("Restored EVM state from snapshot {} ({} bytes), registry {}, runner {}",
+            _snapshot_config.path.string(), snapshot->payload.size(), evmc::hex(_registry_address), evmc::hex(_runner_address));
+        co_return true;
+    }
+
+    asio::awaitable<bool> EVM::saveSnapshot() noexcept
+    {
+        if(_snapshot_config.path.empty())
+        {
+            co_return false;
+        }
+
+        try
+        {
+            StateSnapshotHeader header{.tag = co_await _snapshotTag()};
+
+            co_await async::ensureOnStrand(_strand);
+            if(!_ready)
+            {
+                co_return false;
+            }
+
+            const std::uint64_t version = _storage.state_version();
+            header.registry_address = _registry_address;
+            header.runner_address = _runner_address;
+
+            std::string payload;
+            _storage.serialize_state(payload);
+
+            // Writing and syncing a large file must not hold up execution on the strand.
+            co_return co_await asio::co_spawn(_snapshot_pool, [&]() -> asio::awaitable<bool>
+            {
+                std::lock_guard lock(_snapshot_write_mutex);
+                if(_snapshot_written_version && *_snapshot_written_version >= version)
+                {
+                    co_return true;
+                }
+
+                if(!writeStateSnapshot(_snapshot_config.path, header, payload))
+                {
+                    co_return false;
+                }
+                _snapshot_written_version = version;
+
+                spdlog::debug("Wrote EVM snapshot {} ({} bytes, state version {})",
+                    _snapshot_config.path.string(), payload.size(), version);
+                co_return true;
+            }, asio::use_awaitable);
+        }
+        catch(const std::exception & e)
+        {
+            spdlog::error("Failed to save EVM snapshot: {}", e.what());
+            co_return false;
+        }
+    }
+
+    asio::awaitable<void> EVM::_runSnapshots()
+    {
+        while(true)
+        {
+            _snapshot_timer.expires_after(_snapshot_config.interval);
+            std::error_code ec;
+            co_await _snapshot_timer.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+
+            co_await async::ensureOnStrand(_strand);
+            if(_closed)
+            {
+                co_return;
+            }
+
+            bool dirty = false;
+            {
+                std::lock_guard lock(_snapshot_write_mutex);
+                dirty = !_snapshot_written_version || *_snapshot_written_version != _storage.state_version();
+            }
+
+            if(dirty)
+            {
+                co_await saveSnapshot();
+            }
+        }
+    }
+
+    asio::awaitable<bool> EVM::close() noexcept
+    {
+        co_await async::ensureOnStrand(_strand);
+
+        _closed = true;
+        _snapshot_timer.cancel();
+        _ready_timer.cancel();
+
+        if(_snapshot_config.path.empty() || !_ready)
+        {
+            co_return true;
+        }
+
+        const bool saved = co_await saveSnapshot();
+        if(saved)
+        {
+            spdlog::info("Saved EVM snapshot {}", _snapshot_config.path.string());
+        }
+        co_return saved;
+    }
+
 }
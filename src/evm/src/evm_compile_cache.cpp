@@ -0,0 +1,392 @@
+#include "evm_compile_cache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <system_error>
+#include <utility>
+
+#include <evmc/evmc.hpp>
+#include <evmc/hex.hpp>
+#include <spdlog/spdlog.h>
+
+#include "crypto.hpp"
+
+namespace dcn::evm
+{
+    namespace
+    {
+        // Staging directories older than this were left behind by a crashed compile.
+        constexpr auto STALE_STAGING_AGE = std::chrono::hours(1);
+
+        void appendField(std::vector<std::uint8_t> & preimage, std::string_view field)
+        {
+            const std::uint64_t size = field.size();
+            for(int shift = 56; shift >= 0; shift -= 8)
+            {
+                preimage.push_back(static_cast<std::uint8_t>((size >> shift) & 0xFF));
+            }
+            preimage.insert(preimage.end(), field.begin(), field.end());
+        }
+
+        std::string keccakHex(const std::vector<std::uint8_t> & preimage)
+        {
+            evmc::bytes32 hash{};
+            crypto::Keccak256::getHash(preimage.data(), preimage.size(), hash.bytes);
+            return evmc::hex(evmc::bytes_view{hash.bytes, sizeof(hash.bytes)});
+        }
+
+        std::uint64_t directoryBytes(const std::filesystem::path & dir)
+        {
+            std::uint64_t bytes = 0;
+            std::error_code ec;
+            for(const auto & file : std::filesystem::directory_iterator(dir, ec))
+            {
+                if(file.is_regular_file(ec))
+                {
+                    bytes += file.file_size(ec);
+                }
+            }
+            return bytes;
+        }
+
+        bool copyArtifacts(const std::filesystem::path & from, const std::filesystem::path & to)
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(to, ec);
+            if(ec)
+            {
+                spdlog::error("Failed to create directory '{}': {}", to.string(), ec.message());
+                return false;
+            }
+
+            std::filesystem::directory_iterator it(from, ec);
+            if(ec)
+            {
+                return false;
+            }
+
+            for(const auto & file : it)
+            {
+                if(!file.is_regular_file(ec))
+                {
+                    continue;
+                }
+
+                std::filesystem::copy_file(file.path(), to / file.path().filename(),
+                    std::filesystem::copy_options::overwrite_existing, ec);
+                if(ec)
+                {
+                    spdlog::warn("Failed to copy compile artifact '{}': {}", file.path().string(), ec.message());
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    CompileCache::CompileCache(CompileCacheConfig config)
+    :   _config(std::move(config))
+    {
+        if(!enabled())
+        {
+            return;
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(_config.root / "objects", ec);
+        std::filesystem::create_directories(_config.root / "tmp", ec);
+        if(ec)
+        {
+            spdlog::error("Disabling compile cache, cannot create '{}': {}", _config.root.string(), ec.message());
+            _config.root.clear();
+            return;
+        }
+
+        _scan();
+
+        spdlog::info(
+            "Compile cache '{}': entries={} bytes={} max_bytes={}",
+            _config.root.string(),
+            _stats.entries,
+            _stats.bytes,
+            _config.max_bytes);
+    }
+
+    bool CompileCache::enabled() const
+    {
+        return !_config.root.empty();
+    }
+
+    std::string CompileCache::makeKey(
+        std::string_view source,
+        std::string_view compiler_version,
+        const std::vector<std::string> & flags,
+        std::string_view include_tree_hash)
+    {
+        std::vector<std::uint8_t> preimage;
+        preimage.reserve(source.size() + compiler_version.size() + include_tree_hash.size() + 256);
+
+        // Version tag of the key layout itself.
+        appendField(preimage, "dcn-solc-cache-v2");
+        appendField(preimage, source);
+        appendField(preimage, compiler_version);
+        for(const auto & flag : flags)
+        {
+            appendField(preimage, flag);
+        }
+        appendField(preimage, include_tree_hash);
+
+        return keccakHex(preimage);
+    }
+
+    std::string CompileCache::includeTreeHash(const std::vector<std::filesystem::path> & roots)
+    {
+        std::string memo_key;
+        for(const auto & root : roots)
+        {
+            memo_key += root.string();
+            memo_key.push_back('\n');
+        }
+
+        {
+            std::lock_guard lock(_mutex);
+            if(const auto it = _include_tree_hashes.find(memo_key); it != _include_tree_hashes.end())
+            {
+                return it->second;
+            }
+        }
+
+        std::vector<std::uint8_t> preimage;
+        for(const auto & root : roots)
+        {
+            std::vector<std::filesystem::path> files;
+            std::error_code ec;
+            for(std::filesystem::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec))
+            {
+                if(it->is_regular_file(ec) && it->path().extension() == ".sol")
+                {
+                    files.push_back(it->path());
+                }
+            }
+            std::ranges::sort(files);
+
+            for(const auto & file : files)
+            {
+                std::ifstream in(file, std::ios::binary);
+                const std::string content{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+
+                evmc::bytes32 file_hash{};
+                crypto::Keccak256::getHash(reinterpret_cast<const std::uint8_t *>(content.data()), content.size(), file_hash.bytes);
+
+                appendField(preimage, file.lexically_relative(root).generic_string());
+                preimage.insert(preimage.end(), std::begin(file_hash.bytes), std::end(file_hash.bytes));
+            }
+        }
+
+        std::string hash = keccakHex(preimage);
+
+        std::lock_guard lock(_mutex);
+        _include_tree_hashes.try_emplace(memo_key, hash);
+        return hash;
+    }
+
+    bool CompileCache::fetch(const std::string & key, const std::filesystem::path & out_dir)
+    {
+        if(!enabled())
+        {
+            return false;
+        }
+
+        const std::filesystem::path entry_path = _entryPath(key);
+
+        std::error_code ec;
+        // A peer may evict the entry while we copy from it, which surfaces here as a failed copy.
+        if(!std::filesystem::is_directory(entry_path, ec) || !copyArtifacts(entry_path, out_dir))
+        {
+            std::lock_guard lock(_mutex);
+            if(const auto it = _entries.find(key); it != _entries.end())
+            {
+                _stats.bytes -= std::min(_stats.bytes, it->second.bytes);
+                _entries.erase(it);
+                _stats.entries = _entries.size();
+            }
+            ++_stats.misses;
+            return false;
+        }
+
+        const auto now = std::filesystem::file_time_type::clock::now();
+        std::filesystem::last_write_time(entry_path, now, ec);
+
+        std::lock_guard lock(_mutex);
+        auto [it, inserted] = _entries.try_emplace(key);
+        if(inserted)
+        {
+            // Published by another node since our last scan.
+            it->second.bytes = directoryBytes(entry_path);
+            _stats.bytes += it->second.bytes;
+            _stats.entries = _entries.size();
+        }
+        it->second.last_used = now;
+        ++_stats.hits;
+        return true;
+    }
+
+    std::filesystem::path CompileCache::makeStagingDir(const std::string & key) const
+    {
+        static thread_local std::mt19937_64 rng{std::random_device{}()};
+
+        const std::filesystem::path staging_dir = _config.root / "tmp" / std::format("{}-{:016x}", key, rng());
+
+        std::error_code ec;
+        std::filesystem::create_directories(staging_dir, ec);
+        if(ec)
+        {
+            spdlog::warn("Failed to create staging directory '{}': {}", staging_dir.string(), ec.message());
+        }
+        return staging_dir;
+    }
+
+    bool CompileCache::store(const std::string & key, const std::filesystem::path & staging_dir, const std::filesystem::path & out_dir)
+    {
+        std::error_code ec;
+        if(!copyArtifacts(staging_dir, out_dir))
+        {
+            std::filesystem::remove_all(staging_dir, ec);
+            return false;
+        }
+
+        const std::filesystem::path entry_path = _entryPath(key);
+        const std::uint64_t bytes = directoryBytes(staging_dir);
+
+        std::filesystem::create_directories(entry_path.parent_path(), ec);
+        std::filesystem::rename(staging_dir, entry_path, ec);
+        if(ec)
+        {
+            // Usually a peer published the same key first; either way its outputs are already in out_dir.
+            if(!std::filesystem::is_directory(entry_path))
+            {
+                spdlog::warn("Failed to publish compile cache entry '{}': {}", entry_path.string(), ec.message());
+            }
+            std::filesystem::remove_all(staging_dir, ec);
+            return true;
+        }
+
+        std::vector<std::filesystem::path> evicted;
+        {
+            std::lock_guard lock(_mutex);
+            auto [it, inserted] = _entries.try_emplace(key);
+            if(inserted)
+            {
+                it->second.bytes = bytes;
+                _stats.bytes += bytes;
+                _stats.entries = _entries.size();
+            }
+            it->second.last_used = std::filesystem::file_time_type::clock::now();
+            ++_stats.stores;
+
+            evicted = _evictLocked();
+        }
+        _removeEvicted(evicted);
+        return true;
+    }
+
+    CompileCacheStats CompileCache::stats() const
+    {
+        std::lock_guard lock(_mutex);
+        return _stats;
+    }
+
+    std::filesystem::path CompileCache::_entryPath(const std::string & key) const
+    {
+        return _config.root / "objects" / key.substr(0, 2) / key;
+    }
+
+    void CompileCache::_scan()
+    {
+        std::error_code ec;
+        const auto now = std::filesystem::file_time_type::clock::now();
+
+        for(const auto & staging : std::filesystem::directory_iterator(_config.root / "tmp", ec))
+        {
+            const auto modified = staging.last_write_time(ec);
+            if(!ec && now - modified > STALE_STAGING_AGE)
+            {
+                std::filesystem::remove_all(staging.path(), ec);
+            }
+        }
+
+        std::unique_lock lock(_mutex);
+        for(const auto & shard : std::filesystem::directory_iterator(_config.root / "objects", ec))
+        {
+            if(!shard.is_directory(ec))
+            {
+                continue;
+            }
+
+            for(const auto & entry : std::filesystem::directory_iterator(shard.path(), ec))
+            {
+                if(!entry.is_directory(ec))
+                {
+                    continue;
+                }
+
+                Entry & cached = _entries[entry.path().filename().string()];
+                cached.bytes = directoryBytes(entry.path());
+                cached.last_used = entry.last_write_time(ec);
+                _stats.bytes += cached.bytes;
+            }
+        }
+        _stats.entries = _entries.size();
+
+        const std::vector<std::filesystem::path> evicted = _evictLocked();
+        lock.unlock();
+        _removeEvicted(evicted);
+    }
+
+    std::vector<std::filesystem::path> CompileCache::_evictLocked()
+    {
+        std::vector<std::filesystem::path> evicted;
+        if(_stats.bytes <= _config.max_bytes)
+        {
+            return evicted;
+        }
+
+        // One ordering pass per eviction round instead of a scan per evicted entry.
+        std::vector<std::pair<std::filesystem::file_time_type, std::string>> by_age;
+        by_age.reserve(_entries.size());
+        for(const auto & [key, entry] : _entries)
+        {
+            by_age.emplace_back(entry.last_used, key);
+        }
+        std::ranges::sort(by_age);
+
+        for(const auto & [last_used, key] : by_age)
+        {
+            if(_stats.bytes <= _config.max_bytes)
+            {
+                break;
+            }
+
+            const auto it = _entries.find(key);
+            _stats.bytes -= std::min(_stats.bytes, it->second.bytes);
+            _entries.erase(it);
+            evicted.push_back(_entryPath(key));
+            ++_stats.evictions;
+        }
+        _stats.entries = _entries.size();
+        return evicted;
+    }
+
+    void CompileCache::_removeEvicted(const std::vector<std::filesystem::path> & evicted)
+    {
+        for(const auto & entry_path : evicted)
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(entry_path, ec);
+        }
+    }
+}
@@ -0,0 +1,388 @@
+#include "evm_compile_service.hpp"
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+namespace dcn::evm
+{
+    namespace
+    {
+        std::size_t resolveMaxConcurrentJobs(std::size_t configured)
+        {
+            if(configured > 0)
+            {
+                return configured;
+            }
+            return std::max<std::size_t>(1, std::thread::hardware_concurrency() / 2);
+        }
+
+        asio::awaitable<bool> cancellationRequested()
+        {
+            const asio::cancellation_state state = co_await asio::this_coro::cancellation_state;
+            co_return state.cancelled() != asio::cancellation_type::none;
+        }
+    }
+
+    CompileService::CompileService(asio::io_context & io_context, std::filesystem::path solc_path, CompileServiceConfig config)
+    :   _strand(asio::make_strand(io_context)),
+        _solc_path(std::move(solc_path)),
+        _config(std::move(config))
+#if defined(WIN32)
+        , _blocking_pool(resolveMaxConcurrentJobs(_config.max_concurrent_jobs))
+#endif
+    {
+        _config.max_concurrent_jobs = resolveMaxConcurrentJobs(_config.max_concurrent_jobs);
+        spdlog::info(
+            "Solc compile service: workers={} max_queued={} timeout={}ms",
+            _config.max_concurrent_jobs,
+            _config.max_queued_jobs,
+            _config.job_timeout.count());
+    }
+
+    CompileService::~CompileService()
+    {
+#if !defined(WIN32)
+        // The io_context no longer runs at this point, so nobody else is left to reap the children.
+        for(const int pid : _running_pids)
+        {
+            native::killProcess(pid);
+            int status = 0;
+            waitpid(pid, &status, 0);
+        }
+#else
+        _blocking_pool.join();
+#endif
+    }
+
+    const std::filesystem::path & CompileService::getSolcPath() const
+    {
+        return _solc_path;
+    }
+
+    CompileServiceStats CompileService::stats() const
+    {
+        std::lock_guard lock(_stats_mutex);
+        return _stats;
+    }
+
+    void CompileService::shutdown()
+    {
+        asio::dispatch(_strand, [this]()
+        {
+            _shutdown = true;
+
+            for(const auto & waiter : _slot_waiters)
+            {
+                waiter->wakeup.cancel();
+            }
+
+#if !defined(WIN32)
+            for(const int pid : _running_pids)
+            {
+                native::killProcess(pid);
+            }
+#endif
+        });
+    }
+
+    asio::awaitable<CompileOutcome> CompileService::run(std::vector<std::string> args, std::size_t sources)
+    {
+        // Cleanup after a cancellation still has to await (draining the pipe, reaping the child).
+        const bool throw_if_cancelled = co_await asio::this_coro::throw_if_cancelled();
+        co_await asio::this_coro::throw_if_cancelled(false);
+
+        co_await async::ensureOnStrand(_strand);
+
+        CompileOutcome outcome;
+        const auto enqueued_at = std::chrono::steady_clock::now();
+
+        if(_shutdown || _slot_waiters.size() >= _config.max_queued_jobs)
+        {
+            spdlog::warn("Solc compile job rejected: shutdown={} queued={}", _shutdown, _slot_waiters.size());
+            outcome.status = CompileStatus::REJECTED;
+        }
+        else if(!co_await _acquireSlot())
+        {
+            outcome.status = _shutdown ? CompileStatus::REJECTED : CompileStatus::CANCELLED;
+        }
+        else
+        {
+            const auto acquired_at = std::chrono::steady_clock::now();
+
+            outcome = co_await _runProcess(std::move(args), _config.job_timeout * static_cast<long>(std::max<std::size_t>(1, sources)));
+            co_await async::ensureOnStrand(_strand);
+            outcome.queue_wait = std::chrono::duration_cast<std::chrono::microseconds>(acquired_at - enqueued_at);
+
+            _releaseSlot();
+        }
+
+        _recordOutcome(outcome);
+
+        co_await asio::this_coro::throw_if_cancelled(throw_if_cancelled);
+        co_return outcome;
+    }
+
+    asio::awaitable<bool> CompileService::_acquireSlot()
+    {
+        if(_running < _config.max_concurrent_jobs && _slot_waiters.empty())
+        {
+            ++_running;
+            {
+                std::lock_guard lock(_stats_mutex);
+                _stats.running = _running;
+                _stats.peak_running = std::max(_stats.peak_running, _running);
+            }
+            co_return true;
+        }
+
+        auto waiter = std::make_shared<SlotWaiter>(_strand);
+        _slot_waiters.push_back(waiter);
+        {
+            std::lock_guard lock(_stats_mutex);
+            _stats.queued = _slot_waiters.size();
+        }
+
+        while(!waiter->granted)
+        {
+            waiter->wakeup.expires_at(asio::steady_timer::time_point::max());
+            std::error_code ec;
+            co_await waiter->wakeup.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+            co_await async::ensureOnStrand(_strand);
+
+            if(!waiter->granted && (_shutdown || co_await cancellationRequested()))
+            {
+                std::erase(_slot_waiters, waiter);
+                std::lock_guard lock(_stats_mutex);
+                _stats.queued = _slot_waiters.size();
+                co_return false;
+            }
+        }
+        co_return true;
+    }
+
+    void CompileService::_releaseSlot()
+    {
+        --_running;
+
+        if(!_slot_waiters.empty() && !_shutdown)
+        {
+            const auto waiter = std::move(_slot_waiters.front());
+            _slot_waiters.pop_front();
+
+            ++_running;
+            waiter->granted = true;
+            waiter->wakeup.cancel();
+        }
+
+        std::lock_guard lock(_stats_mutex);
+        _stats.queued = _slot_waiters.size();
+        _stats.running = _running;
+        _stats.peak_running = std::max(_stats.peak_running, _running);
+    }
+
+#if !defined(WIN32)
+    asio::awaitable<CompileOutcome> CompileService::_runProcess(std::vector<std::string> args, std::chrono::milliseconds timeout)
+    {
+        CompileOutcome outcome;
+        const auto started_at = std::chrono::steady_clock::now();
+
+        native::ChildProcess child;
+        try
+        {
+            child = native::spawnProcess(_solc_path.string(), std::move(args));
+        }
+        catch(const std::exception & e)
+        {
+            spdlog::error("Failed to start solc '{}': {}", _solc_path.string(), e.what());
+            outcome.status = CompileStatus::SPAWN_FAILED;
+            co_return outcome;
+        }
+
+        _running_pids.insert(child.pid);
+
+        // Shared with the deadline handler, which may run after this frame has moved on.
+        struct JobState
+        {
+            pid_t pid = -1;
+            bool exited = false;
+            bool timed_out = false;
+        };
+        const auto state = std::make_shared<JobState>(JobState{.pid = child.pid});
+
+        asio::steady_timer deadline(_strand);
+        if(timeout.count() > 0)
+        {
+            deadline.expires_after(timeout);
+            deadline.async_wait([state](const std::error_code & ec)
+            {
+                if(!ec && !state->exited)
+                {
+                    state->timed_out = true;
+                    native::killProcess(state->pid);
+                }
+            });
+        }
+
+        bool cancelled = false;
+        {
+            asio::posix::stream_descriptor pipe(_strand, child.output_fd);
+            std::array<char, 4096> buffer;
+            for(;;)
+            {
+                std::error_code ec;
+                const std::size_t read = co_await pipe.async_read_some(
+                    asio::buffer(buffer), asio::redirect_error(asio::use_awaitable, ec));
+                co_await async::ensureOnStrand(_strand);
+
+                const std::size_t max_output = _config.max_output_bytes;
+                const std::size_t keep = std::min(read, max_output - std::min(max_output, outcome.output.size()));
+                outcome.output.append(buffer.data(), keep);
+
+                if(!ec)
+                {
+                    continue;
+                }
+
+                if(ec == asio::error::operation_aborted && co_await cancellationRequested())
+                {
+                    cancelled = true;
+                    native::killProcess(child.pid);
+                }
+                else if(ec != asio::error::eof)
+                {
+                    spdlog::error("Failed to read solc output: {}", ec.message());
+                    native::killProcess(child.pid);
+                }
+                break;
+            }
+        }
+
+        // The pipe usually closes as the child exits, so the first poll mostly succeeds.
+        std::optional<int> exit_code = native::tryReapProcess(child.pid);
+        const int exit_fd = exit_code ? -1 : native::openProcessExitHandle(child.pid);
+        if(exit_fd >= 0)
+        {
+            asio::posix::stream_descriptor exit_watch(_strand, exit_fd);
+            while(!exit_code)
+            {
+                std::error_code ec;
+                co_await exit_watch.async_wait(
+                    asio::posix::stream_descriptor::wait_read, asio::redirect_error(asio::use_awaitable, ec));
+                co_await async::ensureOnStrand(_strand);
+                if(ec == asio::error::operation_aborted)
+                {
+                    cancelled = true;
+                    native::killProcess(child.pid);
+                }
+                else if(ec)
+                {
+                    spdlog::warn("Failed to wait for solc exit, polling instead: {}", ec.message());
+                    break;
+                }
+                exit_code = native::tryReapProcess(child.pid);
+            }
+        }
+
+        // Without an exit descriptor the child is polled with a short backoff.
+        asio::steady_timer reap_timer(_strand);
+        auto backoff = std::chrono::milliseconds(1);
+        while(!exit_code)
+        {
+            reap_timer.expires_after(backoff);
+            std::error_code ec;
+            co_await reap_timer.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+            co_await async::ensureOnStrand(_strand);
+            if(ec == asio::error::operation_aborted)
+            {
+                cancelled = true;
+                native::killProcess(child.pid);
+            }
+            backoff = std::min(backoff * 2, std::chrono::milliseconds(50));
+            exit_code = native::tryReapProcess(child.pid);
+        }
+
+        state->exited = true;
+        deadline.cancel();
+        _running_pids.erase(child.pid);
+
+        outcome.exit_code = *exit_code;
+        outcome.run_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started_at);
+
+        if(state->timed_out)
+        {
+            outcome.status = CompileStatus::TIMED_OUT;
+        }
+        else if(cancelled || _shutdown)
+        {
+            outcome.status = CompileStatus::CANCELLED;
+        }
+        else
+        {
+            outcome.status = (outcome.exit_code == 0) ? CompileStatus::OK : CompileStatus::FAILED;
+        }
+        co_return outcome;
+    }
+#else
+    asio::awaitable<CompileOutcome> CompileService::_runProcess(std::vector<std::string> args, std::chrono::milliseconds)
+    {
+        CompileOutcome outcome;
+        const auto started_at = std::chrono::steady_clock::now();
+
+        // The blocking spawn and wait run on the pool; this coroutine resumes on its own executor afterwards.
+        co_await asio::co_spawn(_blocking_pool, [&]() -> asio::awaitable<void>
+        {
+            try
+            {
+                auto [exit_code, output] = native::runProcess(_solc_path.string(), std::move(args));
+                outcome.exit_code = exit_code;
+                outcome.output = std::move(output);
+                outcome.status = (exit_code == 0) ? CompileStatus::OK : CompileStatus::FAILED;
+            }
+            catch(const std::exception & e)
+            {
+                spdlog::error("Failed to start solc '{}': {}", _solc_path.string(), e.what());
+                outcome.status = CompileStatus::SPAWN_FAILED;
+            }
+            co_return;
+        }, asio::use_awaitable);
+
+        outcome.run_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started_at);
+        co_return outcome;
+    }
+#endif
+
+    void CompileService::_recordOutcome(const CompileOutcome & outcome)
+    {
+        const std::uint64_t queue_wait_us = static_cast<std::uint64_t>(outcome.queue_wait.count());
+
+        std::lock_guard lock(_stats_mutex);
+        switch(outcome.status)
+        {
+            case CompileStatus::OK:             ++_stats.completed; break;
+            case CompileStatus::FAILED:
+            case CompileStatus::SPAWN_FAILED:   ++_stats.failed; break;
+            case CompileStatus::TIMED_OUT:      ++_stats.timed_out; break;
+            case CompileStatus::CANCELLED:      ++_stats.cancelled; break;
+            case CompileStatus::REJECTED:       ++_stats.rejected; return;
+        }
+
+        _stats.total_queue_wait_us += queue_wait_us;
+        _stats.max_queue_wait_us = std::max(_stats.max_queue_wait_us, queue_wait_us);
+        _stats.total_run_us += static_cast<std::uint64_t>(outcome.run_time.count());
+
+        spdlog::debug(
+            "Solc job finished: status={} exit={} queue_wait={}us run={}us queued={} running={}",
+            static_cast<int>(outcome.status),
+            outcome.exit_code,
+            queue_wait_us,
+            outcome.run_time.count(),
+            _stats.queued,
+            _stats.running);
+    }
+}
@@ -0,0 +1,126 @@
+#include "evm_execution_pool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include <evmone/evmone.h>
+
+namespace dcn::evm
+{
+    ExecutionPool::Context::Context(evmc_revision rev)
+    :   vm(evmc_create_evmone()),
+        storage(vm, rev)
+    {
+        if(!vm)
+        {
+            throw std::runtime_error("Failed to create EVM instance");
+        }
+        vm.set_option("O", "0"); // disable optimizations, as on the main VM
+    }
+
+    ExecutionPool::ExecutionPool(evmc_revision rev, ExecutionPoolConfig config)
+    :   _rev(rev),
+        _config(std::move(config))
+    {
+        if(_config.executors == 0)
+        {
+            return;
+        }
+
+        _pool = std::make_unique<asio::thread_pool>(_config.executors);
+        _idle.reserve(_config.executors);
+        for(std::size_t i = 0; i < _config.executors; ++i)
+        {
+            _idle.push_back(std::make_unique<Context>(_rev));
+        }
+        _stats.executors = _config.executors;
+        spdlog::info("EVM execution pool: executors={}", _config.executors);
+    }
+
+    ExecutionPool::~ExecutionPool()
+    {
+        if(_pool)
+        {
+            _pool->join();
+        }
+    }
+
+    bool ExecutionPool::enabled() const noexcept
+    {
+        return _pool != nullptr;
+    }
+
+    asio::awaitable<std::optional<evmc::Result>> ExecutionPool::execute(
+            std::shared_ptr<const EVMStorage::SharedState> base,
+            EVMStorage::ReservedBlock block,
+            const evmc_message & msg)
+    {
+        co_return co_await asio::co_spawn(*_pool, _run(std::move(base), block, msg), asio::use_awaitable);
+    }
+
+    asio::awaitable<std::optional<evmc::Result>> ExecutionPool::_run(
+            std::shared_ptr<const EVMStorage::SharedState> base,
+            EVMStorage::ReservedBlock block,
+            const evmc_message & msg)
+    {
+        {
+            std::lock_guard lock(_mutex);
+            ++_running;
+            _stats.peak_running = std::max(_stats.peak_running, _running);
+        }
+
+        std::unique_ptr<Context> context = _acquire();
+        context->storage.begin_overlay(std::move(base), block);
+        evmc::Result result = context->storage.call(msg);
+        const bool wrote = context->storage.state_version() != 0;
+        context->storage.end_overlay();
+        _release(std::move(context));
+
+        {
+            std::lock_guard lock(_mutex);
+            --_running;
+            if(wrote)
+            {
+                ++_stats.rejected;
+            }
+            else
+            {
+                ++_stats.completed;
+            }
+        }
+
+        if(wrote)
+        {
+            co_return std::nullopt;
+        }
+        co_return std::move(result);
+    }
+
+    ExecutionPoolStats ExecutionPool::stats() const
+    {
+        std::lock_guard lock(_mutex);
+        return _stats;
+    }
+
+    std::unique_ptr<ExecutionPool::Context> ExecutionPool::_acquire()
+    {
+        {
+            std::lock_guard lock(_mutex);
+            if(!_idle.empty())
+            {
+                std::unique_ptr<Context> context = std::move(_idle.back());
+                _idle.pop_back();
+                return context;
+            }
+        }
+        // Each pool thread holds one context at a time, so this is only a fallback.
+        return std::make_unique<Context>(_rev);
+    }
+
+    void ExecutionPool::_release(std::unique_ptr<Context> context)
+    {
+        std::lock_guard lock(_mutex);
+        _idle.push_back(std::move(context));
+    }
+}
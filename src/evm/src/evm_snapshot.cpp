@@ -0,0 +1,175 @@
+#include "evm_snapshot.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+#include <evmc/evmc.hpp>
+#include <spdlog/spdlog.h>
+
+#include "crypto.hpp"
+
+namespace dcn::evm
+{
+    namespace
+    {
+        constexpr std::string_view SNAPSHOT_MAGIC{"DCNEVMS\0", 8};
+        // Bump when the layout of the header or of EVMStorage::serialize_state changes.
+        constexpr std::uint32_t SNAPSHOT_FORMAT_VERSION = 1;
+
+        constexpr std::size_t ADDRESS_SIZE = sizeof(chain::Address::bytes);
+        constexpr std::size_t HASH_SIZE = sizeof(evmc::bytes32::bytes);
+
+        void appendU32(std::string & out, std::uint32_t value)
+        {
+            for(int shift = 0; shift < 32; shift += 8)
+            {
+                out.push_back(static_cast<char>((value >> shift) & 0xFF));
+            }
+        }
+
+        void appendU64(std::string & out, std::uint64_t value)
+        {
+            for(int shift = 0; shift < 64; shift += 8)
+            {
+                out.push_back(static_cast<char>((value >> shift) & 0xFF));
+            }
+        }
+
+        std::uint64_t readLE(const std::uint8_t * data, std::size_t size)
+        {
+            std::uint64_t value = 0;
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        evmc::bytes32 payloadHash(const std::uint8_t * data, std::size_t size)
+        {
+            evmc::bytes32 hash{};
+            crypto::Keccak256::getHash(data, size, hash.bytes);
+            return hash;
+        }
+    }
+
+    bool writeStateSnapshot(const std::filesystem::path & path, const StateSnapshotHeader & header, std::string_view payload)
+    {
+        std::string head;
+        head.reserve(SNAPSHOT_MAGIC.size() + 64 + header.tag.size());
+        head.append(SNAPSHOT_MAGIC);
+        appendU32(head, SNAPSHOT_FORMAT_VERSION);
+        appendU32(head, static_cast<std::uint32_t>(header.tag.size()));
+        head.append(header.tag);
+        head.append(reinterpret_cast<const char *>(header.registry_address.bytes), ADDRESS_SIZE);
+        head.append(reinterpret_cast<const char *>(header.runner_address.bytes), ADDRESS_SIZE);
+        appendU64(head, payload.size());
+
+        const evmc::bytes32 hash = payloadHash(reinterpret_cast<const std::uint8_t *>(payload.data()), payload.size());
+        head.append(reinterpret_cast<const char *>(hash.bytes), HASH_SIZE);
+
+        std::error_code ec;
+        if(!path.parent_path().empty())
+        {
+            std::filesystem::create_directories(path.parent_path(), ec);
+        }
+
+        std::filesystem::path tmp_path = path;
+        tmp_path += ".tmp";
+        {
+            std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+            out.write(head.data(), static_cast<std::streamsize>(head.size()));
+            out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+            out.close();
+            if(!out)
+            {
+                spdlog::error("Failed to write EVM state snapshot '{}'", tmp_path.string());
+                std::filesystem::remove(tmp_path, ec);
+                return false;
+            }
+        }
+
+        if(!native::syncFile(tmp_path))
+        {
+            spdlog::warn("Failed to sync EVM state snapshot '{}'", tmp_path.string());
+        }
+
+        std::filesystem::rename(tmp_path, path, ec);
+        if(ec)
+        {
+            spdlog::error("Failed to publish EVM state snapshot '{}': {}", path.string(), ec.message());
+            std::filesystem::remove(tmp_path, ec);
+            return false;
+        }
+        return true;
+    }
+
+    std::optional<StateSnapshot> readStateSnapshot(const std::filesystem::path & path)
+    {
+        auto mapped = native::mapFile(path);
+        if(!mapped)
+        {
+            return std::nullopt;
+        }
+
+        const std::uint8_t * data = mapped->data();
+        const std::size_t size = mapped->size();
+
+        const std::size_t fixed_size = SNAPSHOT_MAGIC.size() + 2 * sizeof(std::uint32_t);
+        if(size < fixed_size || std::memcmp(data, SNAPSHOT_MAGIC.data(), SNAPSHOT_MAGIC.size()) != 0)
+        {
+            spdlog::warn("Ignoring EVM state snapshot '{}': not a snapshot file", path.string());
+            return std::nullopt;
+        }
+
+        std::size_t offset = SNAPSHOT_MAGIC.size();
+        const auto format_version = static_cast<std::uint32_t>(readLE(data + offset, sizeof(std::uint32_t)));
+        offset += sizeof(std::uint32_t);
+        if(format_version != SNAPSHOT_FORMAT_VERSION)
+        {
+            spdlog::warn("Ignoring EVM state snapshot '{}': format {} instead of {}", path.string(), format_version, SNAPSHOT_FORMAT_VERSION);
+            return std::nullopt;
+        }
+
+        const std::size_t tag_size = static_cast<std::size_t>(readLE(data + offset, sizeof(std::uint32_t)));
+        offset += sizeof(std::uint32_t);
+        if(size - offset < tag_size + 2 * ADDRESS_SIZE + sizeof(std::uint64_t) + HASH_SIZE)
+        {
+            spdlog::warn("Ignoring EVM state snapshot '{}': truncated header", path.string());
+            return std::nullopt;
+        }
+
+        StateSnapshot snapshot;
+        snapshot.header.tag.assign(reinterpret_cast<const char *>(data + offset), tag_size);
+        offset += tag_size;
+        std::memcpy(snapshot.header.registry_address.bytes, data + offset, ADDRESS_SIZE);
+        offset += ADDRESS_SIZE;
+        std::memcpy(snapshot.header.runner_address.bytes, data + offset, ADDRESS_SIZE);
+        offset += ADDRESS_SIZE;
+
+        const std::uint64_t payload_size = readLE(data + offset, sizeof(std::uint64_t));
+        offset += sizeof(std::uint64_t);
+
+        evmc::bytes32 expected_hash{};
+        std::memcpy(expected_hash.bytes, data + offset, HASH_SIZE);
+        offset += HASH_SIZE;
+
+        if(payload_size != size - offset)
+        {
+            spdlog::warn("Ignoring EVM state snapshot '{}': payload is {} bytes instead of {}", path.string(), size - offset, payload_size);
+            return std::nullopt;
+        }
+
+        if(payloadHash(data + offset, size - offset) != expected_hash)
+        {
+            spdlog::warn("Ignoring EVM state snapshot '{}': checksum mismatch", path.string());
+            return std::nullopt;
+        }
+
+        snapshot.payload = std::span<const std::uint8_t>(data + offset, size - offset);
+        snapshot.file = std::move(*mapped);
+        return snapshot;
+    }
+}
@@ -31,52 +31,210 @@ namespace dcn::evm
         return hash;
     }
 
+    const EVMStorage::Account * EVMStorage::find_account(const evmc::address& addr) const
+    {
+        CachedAccount & cached = _account_cache[addr.bytes[sizeof(addr.bytes) - 1] % ACCOUNT_CACHE_SIZE];
+        if(cached.account != nullptr && cached.address == addr)
+        {
+            return cached.account;
+        }
+
+        const auto it = _accounts.find(addr);
+        const Account * account = it != _accounts.end() ? &it->second : find_base_account(addr);
+        if(account != nullptr)
+        {
+            cached = CachedAccount{.address = addr, .account = account};
+        }
+        return account;
+    }
+
+    EVMStorage::Account * EVMStorage::find_mutable_account(const evmc::address& addr)
+    {
+        const auto it = _accounts.find(addr);
+        if(it != _accounts.end())
+        {
+            return &it->second;
+        }
+
+        const Account * shared = find_base_account(addr);
+        if(shared == nullptr)
+        {
+            return nullptr;
+        }
+
+        // Storage is left behind in the base and read from there until a slot is written.
+        Account copy{
+            .balance = shared->balance,
+            .code = shared->code,
+            .creator = shared->creator,
+            .nonce = shared->nonce,
+            .timestamp = shared->timestamp
+        };
+        _inherited_storage.insert(addr);
+        invalidate_account_cache();
+        return &_accounts.emplace(addr, std::move(copy)).first->second;
+    }
+
+    const EVMStorage::Account * EVMStorage::find_base_account(const evmc::address& addr) const
+    {
+        if(_base == nullptr || _destroyed_accounts.contains(addr))
+        {
+            return nullptr;
+        }
+        const auto it = _base->accounts.find(addr);
+        return it == _base->accounts.end() ? nullptr : it->second.get();
+    }
+
+    evmc::bytes32 EVMStorage::load_slot(const evmc::address& addr, const Account & account, const evmc::bytes32 & slot) const
+    {
+        const auto it = account.storage.find(slot);
+        if(it != account.storage.end())
+        {
+            return it->second;
+        }
+        if(_inherited_storage.empty() || !_inherited_storage.contains(addr))
+        {
+            return {};
+        }
+
+        const Account * shared = find_base_account(addr);
+        if(shared == nullptr)
+        {
+            return {};
+        }
+        const auto shared_it = shared->storage.find(slot);
+        return shared_it == shared->storage.end() ? evmc::bytes32{} : shared_it->second;
+    }
+
+    void EVMStorage::invalidate_account_cache() const noexcept
+    {
+        _account_cache.fill(CachedAccount{});
+    }
+
+    std::uint64_t & EVMStorage::create_nonce_of(const evmc::address & sender)
+    {
+        auto it = _create_nonce.find(sender);
+        if(it == _create_nonce.end())
+        {
+            std::uint64_t nonce = 100;
+            if(_base != nullptr)
+            {
+                const auto shared = _base->create_nonce.find(sender);
+                if(shared != _base->create_nonce.end())
+                {
+                    nonce = shared->second;
+                }
+            }
+            it = _create_nonce.emplace(sender, nonce).first;
+        }
+        return it->second;
+    }
+
+    void EVMStorage::mark_dirty(const evmc::address& addr)
+    {
+        // Nothing was published yet, so the next shared state is built from scratch anyway.
+        if(_shared_state != nullptr)
+        {
+            _dirty_accounts.insert(addr);
+        }
+    }
+
+    bool EVMStorage::add_account(const evmc::address& addr)
+    {
+        if(account_exists(addr) == true)
+        {
+            spdlog::error(std::format("add_account: Account {} already exists", addr));
+            return false;
+        }
+        mark_dirty(addr);
+        invalidate_account_cache();
+        _accounts.emplace(addr, Account{});
+        ++_state_version;
+        return true;
+    }
+
+    void EVMStorage::set_balance(const evmc::address& addr, std::uint64_t x) noexcept
+    {
+        const Account * current = find_account(addr);
+        if(current == nullptr)
+        {
+            spdlog::error(std::format("set_balance : Account {} does not exist", addr));
+            return;
+        }
+
+        evmc::uint256be balance{};
+        for (std::size_t i = 0; i < sizeof(x); ++i)
+            balance.bytes[sizeof(balance) - 1 - i] = static_cast<uint8_t>(x >> (8 * i));
+
+        if(evmc::uint256be{current->balance} != balance)
+        {
+            find_mutable_account(addr)->balance = balance;
+            mark_dirty(addr);
+            ++_state_version;
+        }
+    }
+
     bool EVMStorage::account_exists(const evmc::address& addr) const noexcept
     {
-        return _accounts.find(to_key(addr)) != _accounts.end();
+        return find_account(addr) != nullptr;
     }
 
     evmc::bytes32 EVMStorage::get_storage(const evmc::address& addr, const evmc::bytes32& key) const noexcept
     {
-        if(account_exists(addr) == false) 
+        const Account * account = find_account(addr);
+        if(account == nullptr)
         {
             spdlog::error(std::format("get_storage : Account {} does not exist", addr));
             return {};
         }
-        if(_accounts.at(to_key(addr)).storage.find(key) == _accounts.at(to_key(addr)).storage.end()) return {};
-        return _accounts.at(to_key(addr)).storage.at(key);
+        return load_slot(addr, *account, key);
     }
 
     evmc_storage_status EVMStorage::set_storage(const evmc::address& address, const evmc::bytes32& key, const evmc::bytes32& value) noexcept
     {
-        _accounts[to_key(address)].storage[key] = value;
+        Account * account = find_mutable_account(address);
+        if(account == nullptr)
+        {
+            invalidate_account_cache();
+            account = &_accounts[address];
+        }
+
+        if(load_slot(address, *account, key) != value)
+        {
+            account->storage.insert_or_assign(key, value);
+            mark_dirty(address);
+            ++_state_version;
+        }
         return EVMC_STORAGE_MODIFIED;
     }
 
     evmc::uint256be EVMStorage::get_balance(const evmc::address& addr) const noexcept
     {
-        if(account_exists(addr) == false) 
+        const Account * account = find_account(addr);
+        if(account == nullptr)
         {
             spdlog::error(std::format("get_balance : Account {} does not exist", addr));
             return {};
         }
-        return evmc::uint256be{_accounts.at(to_key(addr)).balance};
+        return evmc::uint256be{account->balance};
     }
 
     std::size_t EVMStorage::get_code_size(const evmc::address& addr) const noexcept
     {
-        return _accounts.at(to_key(addr)).code.size();
+        const Account * account = find_account(addr);
+        return account == nullptr ? 0 : account->code.size();
     }
 
     evmc::bytes32 EVMStorage::get_code_hash(const evmc::address& addr) const noexcept
     {
-        if(account_exists(addr) == false) 
+        const Account * account = find_account(addr);
+        if(account == nullptr)
         {
             spdlog::error(std::format("get_code_hash : Account {} does not exist", addr));
             return {};
         }
 
-        const auto& code = _accounts.at(to_key(addr)).code;
+        const auto& code = account->code;
         evmc::bytes32 hash;
         dcn::crypto::Keccak256::getHash((const std::uint8_t*)code.data(), code.size(), hash.bytes);
         return hash;
@@ -87,8 +245,17 @@ namespace dcn::evm
                              std::uint8_t* buffer_data,
                              std::size_t buffer_size) const noexcept
     {
-        spdlog::debug(std::format("copy_code : Account {}, offset {}, buffer_size {}", addr, code_offset, buffer_size));
-        const auto& code = _accounts.at(to_key(addr)).code;
+        if(spdlog::should_log(spdlog::level::debug))
+        {
+            spdlog::debug(std::format("copy_code : Account {}, offset {}, buffer_size {}", addr, code_offset, buffer_size));
+        }
+        const Account * account = find_account(addr);
+        if(account == nullptr)
+        {
+            spdlog::error(std::format("copy_code : Account {} does not exist", addr));
+            return 0;
+        }
+        const auto& code = account->code;
         if (code_offset >= code.size())
         {
             spdlog::error(std::format("copy_code : Invalid code offset: {}", code_offset));
@@ -101,14 +268,18 @@ namespace dcn::evm
 
     bool EVMStorage::selfdestruct(const evmc::address& addr, const evmc::address& beneficiary) noexcept
     {
-        auto key = to_key(addr);
-        auto it = _accounts.find(key);
-        if (it == _accounts.end()) return false;
+        const bool local = _accounts.erase(addr) > 0;
+        const bool shared = find_base_account(addr) != nullptr;
+        if (!local && !shared) return false;
 
         // Transfer balance
         // implement evmc_uint256be operations
-        //_accounts[to_key(beneficiary)].balance += it->second.balance;
-        _accounts.erase(it);
+        //_accounts[beneficiary].balance += it->second.balance;
+        if (shared) _destroyed_accounts.insert(addr);
+        _inherited_storage.erase(addr);
+        invalidate_account_cache();
+        mark_dirty(addr);
+        ++_state_version;
         return true;
     }
 
@@ -138,6 +309,8 @@ namespace dcn::evm
 
         if(top_level_call)
         {
+            invalidate_account_cache();
+
             ActiveTxContext tx{};
             tx.block_number = ++_head_block_number;
             tx.block_time = static_cast<std::int64_t>(
@@ -183,15 +356,15 @@ namespace dcn::evm
                 code_address = msg.code_address;
             }
 
-            auto it = _accounts.find(to_key(code_address));
+            const Account * account = find_account(code_address);
 
-            if (it == _accounts.end())
+            if (account == nullptr)
             {
                 spdlog::error(std::format("call: Code account {} does not exist", code_address));
                 return evmc::Result{EVMC_FAILURE};
             }
 
-            auto& code = it->second.code;
+            const auto& code = account->code;
             if (code.empty())
             {
                 spdlog::error(std::format("call: Code account {} has no code (recipient {})", code_address, msg.recipient));
@@ -214,7 +387,10 @@ namespace dcn::evm
                 return result;
             }
 
-            spdlog::debug(std::format("call: EVMC execute call from {} to {} ended", actual_sender, msg.recipient));
+            if(spdlog::should_log(spdlog::level::debug))
+            {
+                spdlog::debug(std::format("call: EVMC execute call from {} to {} ended", actual_sender, msg.recipient));
+            }
 
             return result;
         }
@@ -226,15 +402,10 @@ namespace dcn::evm
             const std::vector<std::uint8_t> init_code(patched_msg.input_data, patched_msg.input_data + patched_msg.input_size);
 
             // Calculate address
-            if(!_create_nonce.contains(actual_sender))
-            {
-                _create_nonce[actual_sender] = 100;
-            }
-
             evmc_address new_address;
             if (patched_msg.kind == EVMC_CREATE)
             {
-                new_address = derive_create_address(actual_sender, _create_nonce[actual_sender]++);
+                new_address = derive_create_address(actual_sender, create_nonce_of(actual_sender)++);
             }
             else // CREATE2
             {
@@ -271,11 +442,14 @@ namespace dcn::evm
             }
 
             deploy_contract(new_address, std::move(deployed_code),
-                patched_msg.value, actual_sender, _create_nonce[actual_sender] - 1);
+                patched_msg.value, actual_sender, create_nonce_of(actual_sender) - 1);
 
             result.create_address = new_address;
             
-            spdlog::debug(std::format("call: EVMC create call from {} to {} ended", actual_sender, new_address));
+            if(spdlog::should_log(spdlog::level::debug))
+            {
+                spdlog::debug(std::format("call: EVMC create call from {} to {} ended", actual_sender, new_address));
+            }
             return result;
         }
 
@@ -403,6 +577,8 @@ namespace dcn::evm
 
             EmittedLogRecord row{};
             row.seq = _next_log_seq++;
+            // Log consumers track the sequence, so it must not move backwards after a restore.
+            ++_state_version;
             row.block_number = tx.block_number;
             row.block_hash = evmc::hex(tx.block_hash);
             row.parent_hash = evmc::hex(tx.parent_hash);
@@ -623,12 +799,289 @@ namespace dcn::evm
         return _head_block_number;
     }
 
+    namespace
+    {
+        void appendU64(std::string & out, std::uint64_t value)
+        {
+            for(int shift = 0; shift < 64; shift += 8)
+            {
+                out.push_back(static_cast<char>((value >> shift) & 0xFF));
+            }
+        }
+
+        void appendBytes(std::string & out, const std::uint8_t * data, std::size_t size)
+        {
+            out.append(reinterpret_cast<const char *>(data), size);
+        }
+
+        // Bounds-checked cursor over a serialized state; every read fails once the input is exhausted.
+        struct StateReader
+        {
+            std::span<const std::uint8_t> bytes;
+            std::size_t offset = 0;
+
+            bool readU64(std::uint64_t & value)
+            {
+                if(bytes.size() - offset < sizeof(value))
+                {
+                    return false;
+                }
+                value = 0;
+                for(std::size_t i = 0; i < sizeof(value); ++i)
+                {
+                    value |= static_cast<std::uint64_t>(bytes[offset + i]) << (8 * i);
+                }
+                offset += sizeof(value);
+                return true;
+            }
+
+            bool readBytes(std::uint8_t * out, std::size_t size)
+            {
+                if(bytes.size() - offset < size)
+                {
+                    return false;
+                }
+                std::memcpy(out, bytes.data() + offset, size);
+                offset += size;
+                return true;
+            }
+
+            // Length prefix of a sequence whose elements take at least `element_size` bytes each.
+            bool readCount(std::uint64_t & count, std::size_t element_size)
+            {
+                return readU64(count) && count <= (bytes.size() - offset) / element_size;
+            }
+        };
+    }
+
+    void EVMStorage::serialize_state(std::string & out) const
+    {
+        appendU64(out, _accounts.size());
+        for(const auto & [address, account] : _accounts)
+        {
+            appendBytes(out, address.bytes, sizeof(address.bytes));
+            appendBytes(out, account.balance.bytes, sizeof(account.balance.bytes));
+            appendBytes(out, account.creator.bytes, sizeof(account.creator.bytes));
+            appendU64(out, account.nonce);
+            appendU64(out, account.timestamp);
+
+            appendU64(out, account.code.size());
+            appendBytes(out, account.code.data(), account.code.size());
+
+            appendU64(out, account.storage.size());
+            for(const auto & [slot, value] : account.storage)
+            {
+                appendBytes(out, slot.bytes, sizeof(slot.bytes));
+                appendBytes(out, value.bytes, sizeof(value.bytes));
+            }
+        }
+
+        appendU64(out, _create_nonce.size());
+        for(const auto & [address, nonce] : _create_nonce)
+        {
+            appendBytes(out, address.bytes, sizeof(address.bytes));
+            appendU64(out, nonce);
+        }
+
+        appendU64(out, static_cast<std::uint64_t>(_head_block_number));
+        appendBytes(out, _head_block_hash.bytes, sizeof(_head_block_hash.bytes));
+        appendU64(out, _next_tx_id);
+        appendU64(out, _next_log_seq);
+    }
+
+    bool EVMStorage::deserialize_state(std::span<const std::uint8_t> bytes)
+    {
+        constexpr std::size_t ADDRESS_SIZE = sizeof(evmc::address::bytes);
+        constexpr std::size_t WORD_SIZE = sizeof(evmc::bytes32::bytes);
+        constexpr std::size_t MIN_ACCOUNT_SIZE = ADDRESS_SIZE + WORD_SIZE + ADDRESS_SIZE + 4 * sizeof(std::uint64_t);
+
+        StateReader reader{.bytes = bytes};
+
+        absl::flat_hash_map<evmc::address, Account> accounts;
+        std::uint64_t account_count = 0;
+        if(!reader.readCount(account_count, MIN_ACCOUNT_SIZE))
+        {
+            return false;
+        }
+        accounts.reserve(account_count);
+
+        for(std::uint64_t i = 0; i < account_count; ++i)
+        {
+            evmc::address address{};
+            Account account{};
+            std::uint64_t code_size = 0;
+            std::uint64_t slot_count = 0;
+
+            if(!reader.readBytes(address.bytes, ADDRESS_SIZE) ||
+                !reader.readBytes(account.balance.bytes, WORD_SIZE) ||
+                !reader.readBytes(account.creator.bytes, ADDRESS_SIZE) ||
+                !reader.readU64(account.nonce) ||
+                !reader.readU64(account.timestamp) ||
+                !reader.readCount(code_size, 1))
+            {
+                return false;
+            }
+
+            account.code.resize(code_size);
+            if(!reader.readBytes(account.code.data(), code_size) || !reader.readCount(slot_count, 2 * WORD_SIZE))
+            {
+                return false;
+            }
+
+            account.storage.reserve(slot_count);
+            for(std::uint64_t slot_index = 0; slot_index < slot_count; ++slot_index)
+            {
+                evmc::bytes32 slot{};
+                evmc::bytes32 value{};
+                reader.readBytes(slot.bytes, WORD_SIZE);
+                reader.readBytes(value.bytes, WORD_SIZE);
+                account.storage.insert_or_assign(slot, value);
+            }
+
+            accounts.insert_or_assign(address, std::move(account));
+        }
+
+        absl::flat_hash_map<evmc::address, std::uint64_t> create_nonce;
+        std::uint64_t nonce_count = 0;
+        if(!reader.readCount(nonce_count, ADDRESS_SIZE + sizeof(std::uint64_t)))
+        {
+            return false;
+        }
+        create_nonce.reserve(nonce_count);
+        for(std::uint64_t i = 0; i < nonce_count; ++i)
+        {
+            evmc::address address{};
+            std::uint64_t nonce = 0;
+            reader.readBytes(address.bytes, ADDRESS_SIZE);
+            reader.readU64(nonce);
+            create_nonce.insert_or_assign(address, nonce);
+        }
+
+        std::uint64_t head_block_number = 0;
+        evmc::bytes32 head_block_hash{};
+        std::uint64_t next_tx_id = 0;
+        std::uint64_t next_log_seq = 0;
+        if(!reader.readU64(head_block_number) ||
+            !reader.readBytes(head_block_hash.bytes, WORD_SIZE) ||
+            !reader.readU64(next_tx_id) ||
+            !reader.readU64(next_log_seq) ||
+            reader.offset != bytes.size())
+        {
+            return false;
+        }
+
+        _accounts = std::move(accounts);
+        invalidate_account_cache();
+        _create_nonce = std::move(create_nonce);
+        _head_block_number = static_cast<std::int64_t>(head_block_number);
+        _head_block_hash = head_block_hash;
+        _next_tx_id = next_tx_id;
+        _next_log_seq = next_log_seq;
+        _emitted_logs.clear();
+        _shared_state.reset();
+        _dirty_accounts.clear();
+        ++_state_version;
+        return true;
+    }
+
+    std::uint64_t EVMStorage::state_version() const noexcept
+    {
+        return _state_version;
+    }
+
+    std::shared_ptr<const EVMStorage::SharedState> EVMStorage::shared_state()
+    {
+        if(_shared_state != nullptr && _shared_state->version == _state_version)
+        {
+            return _shared_state;
+        }
+
+        auto state = std::make_shared<SharedState>();
+        if(_shared_state != nullptr)
+        {
+            state->accounts = _shared_state->accounts;
+            for(const evmc::address & address : _dirty_accounts)
+            {
+                const auto it = _accounts.find(address);
+                if(it == _accounts.end())
+                {
+                    state->accounts.erase(address);
+                }
+                else
+                {
+                    state->accounts.insert_or_assign(address, std::make_shared<const Account>(it->second));
+                }
+            }
+        }
+        else
+        {
+            state->accounts.reserve(_accounts.size());
+            for(const auto & [address, account] : _accounts)
+            {
+                state->accounts.emplace(address, std::make_shared<const Account>(account));
+            }
+        }
+        state->create_nonce = _create_nonce;
+        state->version = _state_version;
+
+        _dirty_accounts.clear();
+        _shared_state = std::move(state);
+        return _shared_state;
+    }
+
+    EVMStorage::ReservedBlock EVMStorage::next_block() const noexcept
+    {
+        return ReservedBlock{
+            .number = _head_block_number + 1,
+            .parent_hash = _head_block_hash,
+            .tx_id = _next_tx_id
+        };
+    }
 
-    std::string EVMStorage::to_key(const evmc::address& addr) const
+    EVMStorage::ReservedBlock EVMStorage::reserve_block() noexcept
     {
-        return std::string(reinterpret_cast<const char*>(addr.bytes), sizeof(addr.bytes));
+        const ReservedBlock block = next_block();
+        _head_block_number = block.number;
+        _next_tx_id = block.tx_id + 1;
+        _head_block_hash = make_pseudo_hash(static_cast<std::uint64_t>(block.number), 0, 0);
+        return block;
     }
 
+    bool EVMStorage::release_block(const ReservedBlock & block) noexcept
+    {
+        if(_head_block_number != block.number || _next_tx_id != block.tx_id + 1)
+        {
+            return false;
+        }
+        _head_block_number = block.number - 1;
+        _head_block_hash = block.parent_hash;
+        _next_tx_id = block.tx_id;
+        return true;
+    }
+
+    void EVMStorage::begin_overlay(std::shared_ptr<const SharedState> base, const ReservedBlock & block)
+    {
+        end_overlay();
+        _base = std::move(base);
+        // The top-level call advances these to exactly the reserved block and transaction.
+        _head_block_number = block.number - 1;
+        _head_block_hash = block.parent_hash;
+        _next_tx_id = block.tx_id;
+    }
+
+    void EVMStorage::end_overlay()
+    {
+        _accounts.clear();
+        invalidate_account_cache();
+        _create_nonce.clear();
+        _emitted_logs.clear();
+        _inherited_storage.clear();
+        _destroyed_accounts.clear();
+        _base.reset();
+        _state_version = 0;
+    }
+
+
     evmc_address EVMStorage::derive_create_address(const evmc::address& sender, std::uint64_t nonce)
     {
         std::array<std::uint8_t, 64> data{};
@@ -677,11 +1130,13 @@ namespace dcn::evm
         }
 
         spdlog::debug(std::format("Deploying contract to {} by {}", addr,creator));
-        auto& account = _accounts[to_key(addr)];
+        auto& account = *find_mutable_account(addr);
         account.code = std::move(code);
         account.balance = value;
         account.creator = creator;
         account.nonce = nonce;
         account.timestamp = static_cast<std::uint64_t>(std::chrono::seconds(std::time(nullptr)).count());
+        mark_dirty(addr);
+        ++_state_version;
     }
 }
@@ -40,7 +40,9 @@ namespace dcn::http
         Date,
         Expect,
 
-        Origin
+        Origin,
+
+        RetryAfter
     };
 
     /**
@@ -92,6 +94,9 @@ struct std::formatter<dcn::http::Header> : std::formatter<std::string> {
         // O
         case dcn::http::Header::Origin: return formatter<string>::format("Origin", ctx);
 
+        // R
+        case dcn::http::Header::RetryAfter: return formatter<string>::format("Retry-After", ctx);
+
         // Unknown
         case dcn::http::Header::Unknown:    return formatter<string>::format("Unknown", ctx);
     }
@@ -18,6 +18,7 @@ namespace dcn::parse
         if (utils::equalsIgnoreCase(header_str, std::format("{}", http::Header::Date)))return http::Header::Date;
         if (utils::equalsIgnoreCase(header_str, std::format("{}", http::Header::Expect)))return http::Header::Expect;
         if (utils::equalsIgnoreCase(header_str, std::format("{}", http::Header::Origin)))return http::Header::Origin;
+        if (utils::equalsIgnoreCase(header_str, std::format("{}", http::Header::RetryAfter)))return http::Header::RetryAfter;
 
         return http::Header::Unknown;
     }
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+
+#include "loader.hpp"
+
+namespace dcn::loader
+{
+    struct LazyDeployerConfig
+    {
+        std::filesystem::path storage_path;
+        // Per-connector use counts carried across restarts; they order the warm-up. Empty keeps them in memory only.
+        std::filesystem::path access_stats_path;
+        // Delay between warm-up passes over connectors that could not be deployed yet.
+        std::chrono::milliseconds retry_interval{std::chrono::milliseconds(250)};
+    };
+
+    enum class ConnectorReadiness
+    {
+        DEPLOYED,
+        // The EVM is not ready yet, deployments are held, or the deployer stopped while the caller waited for another deployment.
+        DEPLOYING,
+        FAILED
+    };
+
+    // Deploys stored connectors on first use, and in the background through `warm`, without two callers ever
+    // compiling the same entity. A caller claims only the part of its closure that is not deployed yet, and one
+    // that overlaps a running deployment waits for it to finish before trying again.
+    class LazyDeployer
+    {
+        public:
+            LazyDeployer(asio::io_context & io_context, evm::EVM & evm, registry::Registry & registry, LazyDeployerConfig config);
+
+            LazyDeployer(const LazyDeployer&) = delete;
+            LazyDeployer& operator=(const LazyDeployer&) = delete;
+
+            asio::awaitable<ConnectorReadiness> ensureConnector(const std::string & name);
+
+            // Counts a use of `name` towards its warm-up priority.
+            void recordAccess(const std::string & name);
+
+            // Deploys every stored connector, most used in earlier runs first. Returns once all were tried or on stop.
+            asio::awaitable<void> warm();
+
+            // While held, connectors that are not deployed yet are reported as DEPLOYING instead of being deployed,
+            // so that a bulk import owning the whole registry never races an on-demand deployment.
+            asio::awaitable<void> hold();
+            asio::awaitable<void> resume();
+
+            void stop();
+
+            // Writes the access counts, decaying those of earlier runs so that stale favourites fade out.
+            bool saveAccessStats() const;
+
+        private:
+            ConnectorDependencies _undeployed(const ConnectorDependencies & dependencies) const;
+            bool _tryClaim(const ConnectorDependencies & claim);
+            void _release(const ConnectorDependencies & claim);
+            void _markDeployed(const ConnectorDependencies & dependencies);
+            asio::awaitable<void> _waitForRelease();
+
+            void _loadAccessStats();
+            std::vector<std::string> _warmOrder(std::vector<std::string> names) const;
+
+            asio::strand<asio::io_context::executor_type> _strand;
+            evm::EVM & _evm;
+            registry::Registry & _registry;
+            LazyDeployerConfig _config;
+
+            // Strand state
+            absl::flat_hash_set<std::string> _deployed_connectors;
+            absl::flat_hash_set<std::string> _deployed_transformations;
+            absl::flat_hash_set<std::string> _deployed_conditions;
+            absl::flat_hash_set<std::string> _claimed_connectors;
+            absl::flat_hash_set<std::string> _claimed_transformations;
+            absl::flat_hash_set<std::string> _claimed_conditions;
+            bool _stopped = false;
+            bool _held = false;
+            // Never expires; cancelling it wakes every caller waiting for a claim to be released.
+            asio::steady_timer _release_signal;
+
+            mutable std::mutex _access_mutex;
+            absl::flat_hash_map<std::string, std::uint64_t> _previous_access;
+            absl::flat_hash_map<std::string, std::uint64_t> _access;
+    };
+}
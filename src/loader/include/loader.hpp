@@ -20,10 +20,17 @@ namespace dcn::loader
         std::size_t connectors = 1000;
         std::size_t transformations = 5000;
         std::size_t conditions = 5000;
+        // Generated sources per `solc --standard-json` run when compiling stored entities in bulk.
+        std::size_t compile = 128;
+        // Threads parsing the stored JSON records; 0 uses every hardware thread.
+        std::size_t scan_threads = 0;
     };
 
     bool ensurePTBuildVersion(const std::filesystem::path & storage_path);
 
+    // Tag of an EVM state snapshot: the PT build version and the registry sizes the deployed state corresponds to.
+    asio::awaitable<std::string> makeStateSnapshotTag(registry::Registry & registry);
+
     asio::awaitable<std::expected<chain::Address, pt::PTDeployError>> deployConnector(
         evm::EVM & evm,
         registry::Registry & registry,
@@ -68,20 +75,35 @@ namespace dcn::loader
         const std::string & name,
         const std::filesystem::path & storage_path);
 
+    // Whether the registry contract knows connector `name`; nullopt when the call fails.
+    asio::awaitable<std::optional<bool>> isConnectorDeployed(evm::EVM & evm, const std::string & name);
+
+    // Names in the stored dependency closure of a connector, the connector itself included.
+    struct ConnectorDependencies
+    {
+        std::vector<std::string> connectors;
+        std::vector<std::string> transformations;
+        std::vector<std::string> conditions;
+    };
+
+    asio::awaitable<ConnectorDependencies> collectConnectorDependencies(
+        registry::Registry & registry,
+        const std::string & name);
+
 
     asio::awaitable<bool> loadStoredConnectors(
         evm::EVM & evm,
         registry::Registry & registry,
         const std::filesystem::path & storage_path,
-        std::size_t registry_batch_size = 1000);
+        LoaderBatchConfig batch_config = {});
     asio::awaitable<bool> loadStoredConditions(
         evm::EVM & evm,
         registry::Registry & registry,
         const std::filesystem::path & storage_path,
-        std::size_t registry_batch_size = 5000);
+        LoaderBatchConfig batch_config = {});
     asio::awaitable<bool> loadStoredTransformations(
         evm::EVM & evm,
         registry::Registry & registry,
         const std::filesystem::path & storage_path,
-        std::size_t registry_batch_size = 5000);
+        LoaderBatchConfig batch_config = {});
 }
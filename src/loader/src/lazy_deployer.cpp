@@ -0,0 +1,344 @@
+#include "lazy_deployer.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+#include <nlohmann/json.hpp>
+
+namespace dcn::loader
+{
+    namespace
+    {
+        template<class Names>
+        bool anyClaimed(const Names & names, const absl::flat_hash_set<std::string> & claimed)
+        {
+            return std::ranges::any_of(names, [&claimed](const std::string & name) { return claimed.contains(name); });
+        }
+    }
+
+    LazyDeployer::LazyDeployer(asio::io_context & io_context, evm::EVM & evm, registry::Registry & registry, LazyDeployerConfig config)
+    :   _strand(asio::make_strand(io_context)),
+        _evm(evm),
+        _registry(registry),
+        _config(std::move(config)),
+        _release_signal(_strand, asio::steady_timer::time_point::max())
+    {
+        _loadAccessStats();
+    }
+
+    asio::awaitable<ConnectorReadiness> LazyDeployer::ensureConnector(const std::string & name)
+    {
+        if(!_evm.isReady())
+        {
+            co_return ConnectorReadiness::DEPLOYING;
+        }
+
+        co_await async::ensureOnStrand(_strand);
+        while(!_deployed_connectors.contains(name) && _claimed_connectors.contains(name))
+        {
+            if(_stopped)
+            {
+                co_return ConnectorReadiness::DEPLOYING;
+            }
+            co_await _waitForRelease();
+        }
+        if(_deployed_connectors.contains(name))
+        {
+            co_return ConnectorReadiness::DEPLOYED;
+        }
+
+        // Also covers a state restored from a snapshot, which this set knows nothing about.
+        const std::optional<bool> deployed = co_await isConnectorDeployed(_evm, name);
+        if(!deployed.has_value())
+        {
+            co_return ConnectorReadiness::FAILED;
+        }
+        if(*deployed)
+        {
+            co_await async::ensureOnStrand(_strand);
+            _deployed_connectors.insert(name);
+            co_return ConnectorReadiness::DEPLOYED;
+        }
+
+        co_await async::ensureOnStrand(_strand);
+        if(_held)
+        {
+            co_return ConnectorReadiness::DEPLOYING;
+        }
+
+        const ConnectorDependencies dependencies = co_await collectConnectorDependencies(_registry, name);
+
+        co_await async::ensureOnStrand(_strand);
+        ConnectorDependencies claim = _undeployed(dependencies);
+        while(!_deployed_connectors.contains(name) && !_tryClaim(claim))
+        {
+            if(_stopped)
+            {
+                co_return ConnectorReadiness::DEPLOYING;
+            }
+            co_await _waitForRelease();
+            claim = _undeployed(dependencies);
+        }
+        if(_deployed_connectors.contains(name))
+        {
+            co_return ConnectorReadiness::DEPLOYED;
+        }
+
+        bool deployed_ok = false;
+        try
+        {
+            deployed_ok = co_await ensureConnectorDeployed(_evm, _registry, name, _config.storage_path);
+        }
+        catch(const std::exception & e)
+        {
+            spdlog::error("Failed to deploy connector '{}' on demand: {}", name, e.what());
+        }
+
+        co_await async::ensureOnStrand(_strand);
+        if(deployed_ok)
+        {
+            _markDeployed(dependencies);
+        }
+        _release(claim);
+        co_return deployed_ok ? ConnectorReadiness::DEPLOYED : ConnectorReadiness::FAILED;
+    }
+
+    void LazyDeployer::recordAccess(const std::string & name)
+    {
+        std::lock_guard lock(_access_mutex);
+        ++_access[name];
+    }
+
+    asio::awaitable<void> LazyDeployer::warm()
+    {
+        co_await _evm.waitReady();
+
+        const auto started_at = std::chrono::steady_clock::now();
+        std::vector<std::string> pending = _warmOrder(co_await _registry.getConnectorNames());
+        const std::size_t total = pending.size();
+
+        spdlog::info("Connector warm-up started: {} stored connectors", total);
+
+        std::size_t deployed = 0;
+        std::size_t failed = 0;
+        asio::steady_timer retry_timer(_strand);
+
+        while(!pending.empty())
+        {
+            std::vector<std::string> busy;
+            for(const std::string & name : pending)
+            {
+                co_await async::ensureOnStrand(_strand);
+                if(_stopped)
+                {
+                    co_return;
+                }
+
+                switch(co_await ensureConnector(name))
+                {
+                    case ConnectorReadiness::DEPLOYED:  ++deployed; break;
+                    case ConnectorReadiness::FAILED:    ++failed; break;
+                    case ConnectorReadiness::DEPLOYING: busy.push_back(name); break;
+                }
+            }
+
+            pending = std::move(busy);
+            if(!pending.empty())
+            {
+                retry_timer.expires_after(_config.retry_interval);
+                std::error_code ec;
+                co_await retry_timer.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+            }
+        }
+
+        spdlog::info(
+            "Connector warm-up finished in {}ms: deployed={} failed={}",
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started_at).count(),
+            deployed,
+            failed);
+    }
+
+    asio::awaitable<void> LazyDeployer::hold()
+    {
+        co_await async::ensureOnStrand(_strand);
+        _held = true;
+    }
+
+    asio::awaitable<void> LazyDeployer::resume()
+    {
+        co_await async::ensureOnStrand(_strand);
+        _held = false;
+    }
+
+    void LazyDeployer::stop()
+    {
+        asio::dispatch(_strand, [this]()
+        {
+            _stopped = true;
+            _release_signal.cancel();
+        });
+    }
+
+    ConnectorDependencies LazyDeployer::_undeployed(const ConnectorDependencies & dependencies) const
+    {
+        const auto missing = [](const std::vector<std::string> & names, const absl::flat_hash_set<std::string> & deployed)
+        {
+            std::vector<std::string> result;
+            std::ranges::copy_if(names, std::back_inserter(result), [&deployed](const std::string & name) { return !deployed.contains(name); });
+            return result;
+        };
+
+        return ConnectorDependencies{
+            .connectors = missing(dependencies.connectors, _deployed_connectors),
+            .transformations = missing(dependencies.transformations, _deployed_transformations),
+            .conditions = missing(dependencies.conditions, _deployed_conditions)
+        };
+    }
+
+    bool LazyDeployer::_tryClaim(const ConnectorDependencies & claim)
+    {
+        if(anyClaimed(claim.connectors, _claimed_connectors) ||
+            anyClaimed(claim.transformations, _claimed_transformations) ||
+            anyClaimed(claim.conditions, _claimed_conditions))
+        {
+            return false;
+        }
+
+        _claimed_connectors.insert(claim.connectors.begin(), claim.connectors.end());
+        _claimed_transformations.insert(claim.transformations.begin(), claim.transformations.end());
+        _claimed_conditions.insert(claim.conditions.begin(), claim.conditions.end());
+        return true;
+    }
+
+    void LazyDeployer::_release(const ConnectorDependencies & claim)
+    {
+        for(const auto & name : claim.connectors)
+        {
+            _claimed_connectors.erase(name);
+        }
+        for(const auto & name : claim.transformations)
+        {
+            _claimed_transformations.erase(name);
+        }
+        for(const auto & name : claim.conditions)
+        {
+            _claimed_conditions.erase(name);
+        }
+        _release_signal.cancel();
+    }
+
+    void LazyDeployer::_markDeployed(const ConnectorDependencies & dependencies)
+    {
+        _deployed_connectors.insert(dependencies.connectors.begin(), dependencies.connectors.end());
+        _deployed_transformations.insert(dependencies.transformations.begin(), dependencies.transformations.end());
+        _deployed_conditions.insert(dependencies.conditions.begin(), dependencies.conditions.end());
+    }
+
+    asio::awaitable<void> LazyDeployer::_waitForRelease()
+    {
+        std::error_code ec;
+        co_await _release_signal.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+        co_await async::ensureOnStrand(_strand);
+    }
+
+    std::vector<std::string> LazyDeployer::_warmOrder(std::vector<std::string> names) const
+    {
+        absl::flat_hash_map<std::string, std::uint64_t> priority;
+        {
+            std::lock_guard lock(_access_mutex);
+            priority = _previous_access;
+            for(const auto & [name, count] : _access)
+            {
+                priority[name] += count;
+            }
+        }
+
+        const auto count_of = [&priority](const std::string & name) -> std::uint64_t
+        {
+            const auto it = priority.find(name);
+            return it == priority.end() ? 0 : it->second;
+        };
+
+        std::ranges::sort(names, [&count_of](const std::string & lhs, const std::string & rhs)
+        {
+            const std::uint64_t lhs_count = count_of(lhs);
+            const std::uint64_t rhs_count = count_of(rhs);
+            return lhs_count != rhs_count ? lhs_count > rhs_count : lhs < rhs;
+        });
+        return names;
+    }
+
+    void LazyDeployer::_loadAccessStats()
+    {
+        if(_config.access_stats_path.empty() || !std::filesystem::exists(_config.access_stats_path))
+        {
+            return;
+        }
+
+        std::ifstream in(_config.access_stats_path, std::ios::binary);
+        const nlohmann::json stats = nlohmann::json::parse(in, nullptr, false);
+        if(stats.is_discarded() || !stats.is_object() || !stats.contains("connectors") || !stats["connectors"].is_object())
+        {
+            spdlog::warn("Ignoring malformed connector access stats '{}'", _config.access_stats_path.string());
+            return;
+        }
+
+        std::lock_guard lock(_access_mutex);
+        for(const auto & [name, count] : stats["connectors"].items())
+        {
+            if(count.is_number_unsigned())
+            {
+                _previous_access[name] = count.get<std::uint64_t>();
+            }
+        }
+        spdlog::info("Loaded access stats of {} connectors from '{}'", _previous_access.size(), _config.access_stats_path.string());
+    }
+
+    bool LazyDeployer::saveAccessStats() const
+    {
+        if(_config.access_stats_path.empty())
+        {
+            return true;
+        }
+
+        nlohmann::json connectors = nlohmann::json::object();
+        {
+            std::lock_guard lock(_access_mutex);
+            for(const auto & [name, count] : _previous_access)
+            {
+                if(count / 2 > 0)
+                {
+                    connectors[name] = count / 2;
+                }
+            }
+            for(const auto & [name, count] : _access)
+            {
+                connectors[name] = connectors.value(name, std::uint64_t{0}) + count;
+            }
+        }
+
+        std::filesystem::path tmp_path = _config.access_stats_path;
+        tmp_path += ".tmp";
+        {
+            std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+            out << nlohmann::json{{"connectors", std::move(connectors)}}.dump();
+            if(!out.good())
+            {
+                spdlog::error("Failed to write connector access stats '{}'", tmp_path.string());
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmp_path, _config.access_stats_path, ec);
+        if(ec)
+        {
+            spdlog::error("Failed to publish connector access stats '{}': {}", _config.access_stats_path.string(), ec.message());
+            return false;
+        }
+        return true;
+    }
+}
@@ -1,12 +1,17 @@
 #include "loader.hpp"
 
 #include "utils.hpp"
+#include "storage.hpp"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <sstream>
 #include <string_view>
+#include <thread>
+#include <tuple>
 #include <type_traits>
 
 namespace dcn::loader
@@ -28,21 +33,10 @@ namespace dcn::loader
             absl::flat_hash_map<std::string, ConditionRecord> conditions;
             absl::flat_hash_map<std::string, ConnectorRecord> connectors;
 
-            absl::flat_hash_set<std::string> imported_transformations;
-            absl::flat_hash_set<std::string> importing_transformations;
-
-            absl::flat_hash_set<std::string> imported_conditions;
-            absl::flat_hash_set<std::string> importing_conditions;
-
-            absl::flat_hash_set<std::string> imported_connectors;
-            absl::flat_hash_set<std::string> importing_connectors;
-
             LoaderBatchConfig batch_config{};
             std::vector<std::pair<chain::Address, TransformationRecord>> pending_transformations;
             std::vector<std::pair<chain::Address, ConditionRecord>> pending_conditions;
             std::vector<std::pair<chain::Address, ConnectorRecord>> pending_connectors;
-
-            std::vector<std::string> connector_import_stack;
         };
 
         struct ConnectorEnsureContext
@@ -51,8 +45,66 @@ namespace dcn::loader
             absl::flat_hash_set<std::string> visiting;
 
             std::vector<std::string> connector_deploy_stack;
+
+            // Records resolved ahead of the walk with one registry batch per graph level.
+            absl::flat_hash_map<std::string, registry::ConnectorRecordHandle> connector_records;
+            absl::flat_hash_map<std::string, registry::TransformationRecordHandle> transformation_records;
+            absl::flat_hash_map<std::string, registry::ConditionRecordHandle> condition_records;
+        };
+
+        // Records to deploy, keyed by name. The pointed-to records must outlive the deploy.
+        struct DeployGraph
+        {
+            absl::flat_hash_map<std::string, const TransformationRecord *> transformations;
+            absl::flat_hash_map<std::string, const ConditionRecord *> conditions;
+            absl::flat_hash_map<std::string, const ConnectorRecord *> connectors;
+        };
+
+        enum class DeployNodeKind
+        {
+            TRANSFORMATION,
+            CONDITION,
+            CONNECTOR
+        };
+
+        struct DeployNode
+        {
+            DeployNodeKind kind;
+            std::string name;
+
+            const TransformationRecord * transformation = nullptr;
+            const ConditionRecord * condition = nullptr;
+            const ConnectorRecord * connector = nullptr;
+
+            std::size_t pending_dependencies = 0;
+            std::vector<std::size_t> dependents;
+
+            bool failed = false;
+            std::optional<chain::Address> address;
         };
 
+        static std::string_view deployNodeDir(DeployNodeKind kind)
+        {
+            switch(kind)
+            {
+                case DeployNodeKind::TRANSFORMATION:    return "transformations";
+                case DeployNodeKind::CONDITION:         return "conditions";
+                case DeployNodeKind::CONNECTOR:         return "connectors";
+            }
+            return {};
+        }
+
+        static const std::string & deployNodeOwner(const DeployNode & node)
+        {
+            switch(node.kind)
+            {
+                case DeployNodeKind::TRANSFORMATION:    return node.transformation->owner();
+                case DeployNodeKind::CONDITION:         return node.condition->owner();
+                case DeployNodeKind::CONNECTOR:         break;
+            }
+            return node.connector->owner();
+        }
+
         struct StackPushGuard
         {
             explicit StackPushGuard(std::vector<std::string> & stack, const std::string & value)
@@ -77,6 +129,10 @@ namespace dcn::loader
 
         constexpr std::size_t MAX_CONNECTOR_IMPORT_DEPTH = 4096;
 
+        // Records a scan thread claims at once; small stores are not worth a second thread.
+        constexpr std::size_t JSON_SCAN_CHUNK = 64;
+        constexpr std::size_t JSON_SCAN_PROGRESS_STEP = 10000;
+
         static std::string formatDependencyStack(const std::vector<std::string> & stack)
         {
             if(stack.empty())
@@ -261,32 +317,140 @@ namespace dcn::loader
 
             co_return parsed;
         }
+
+        template<typename HandleT>
+        static std::optional<HandleT> findPrefetchedRecord(
+            const absl::flat_hash_map<std::string, HandleT> & records,
+            const std::string & name)
+        {
+            const auto it = records.find(name);
+            if(it == records.end())
+            {
+                return std::nullopt;
+            }
+            return it->second;
+        }
+
+        // Breadth-first load of the connector graph under `root_name`. Each level costs one batched
+        // connector lookup plus at most one each for its transformations and conditions, so a wide
+        // connector resolves in O(depth) registry round trips instead of O(nodes).
+        static asio::awaitable<void> prefetchConnectorGraph(
+            registry::Registry & registry,
+            const std::string & root_name,
+            ConnectorEnsureContext & context)
+        {
+            std::vector<std::string> frontier{root_name};
+            absl::flat_hash_set<std::string> queued_connectors{root_name};
+            absl::flat_hash_set<std::string> queued_transformations;
+            absl::flat_hash_set<std::string> queued_conditions;
+
+            for(std::size_t depth = 0; !frontier.empty() && depth <= MAX_CONNECTOR_IMPORT_DEPTH; ++depth)
+            {
+                const auto connector_handles = co_await registry.getConnectorRecordHandles(frontier);
+
+                std::vector<std::string> next_frontier;
+                std::vector<std::string> transformation_names;
+                std::vector<std::string> condition_names;
+                const auto queue_connector = [&](const std::string & child_name)
+                {
+                    if(!child_name.empty() && !context.connector_records.contains(child_name) &&
+                        queued_connectors.insert(child_name).second)
+                    {
+                        next_frontier.push_back(child_name);
+                    }
+                };
+
+                for(std::size_t i = 0; i < frontier.size() && i < connector_handles.size(); ++i)
+                {
+                    if(!connector_handles[i].has_value() || !(*connector_handles[i]))
+                    {
+                        continue;
+                    }
+                    context.connector_records.try_emplace(frontier[i], *connector_handles[i]);
+
+                    const Connector & connector = (*connector_handles[i])->connector();
+                    for(const auto & dimension : connector.dimensions())
+                    {
+                        for(const auto & transformation : dimension.transformations())
+                        {
+                            if(!transformation.name().empty() &&
+                                !context.transformation_records.contains(transformation.name()) &&
+                                queued_transformations.insert(transformation.name()).second)
+                            {
+                                transformation_names.push_back(transformation.name());
+                            }
+                        }
+
+                        queue_connector(dimension.composite());
+                        for(const auto & [_, binding_target] : dimension.bindings())
+                        {
+                            queue_connector(binding_target);
+                        }
+                    }
+
+                    if(!connector.condition_name().empty() &&
+                        !context.condition_records.contains(connector.condition_name()) &&
+                        queued_conditions.insert(connector.condition_name()).second)
+                    {
+                        condition_names.push_back(connector.condition_name());
+                    }
+                }
+
+                if(!transformation_names.empty())
+                {
+                    const auto handles = co_await registry.getTransformationRecordHandles(transformation_names);
+                    for(std::size_t i = 0; i < transformation_names.size() && i < handles.size(); ++i)
+                    {
+                        if(handles[i].has_value() && *handles[i])
+                        {
+                            context.transformation_records.try_emplace(transformation_names[i], *handles[i]);
+                        }
+                    }
+                }
+
+                if(!condition_names.empty())
+                {
+                    const auto handles = co_await registry.getConditionRecordHandles(condition_names);
+                    for(std::size_t i = 0; i < condition_names.size() && i < handles.size(); ++i)
+                    {
+                        if(handles[i].has_value() && *handles[i])
+                        {
+                            context.condition_records.try_emplace(condition_names[i], *handles[i]);
+                        }
+                    }
+                }
+
+                spdlog::debug(
+                    "JSON import prefetch connector graph '{}': depth={} connectors={} transformations={} conditions={}",
+                    root_name,
+                    depth,
+                    frontier.size(),
+                    transformation_names.size(),
+                    condition_names.size());
+
+                frontier = std::move(next_frontier);
+            }
+        }
     }
 
-    asio::awaitable<bool> ensureTransformationImported(
-        evm::EVM & evm,
-        registry::Registry & registry,
-        const std::string & name,
-        const std::filesystem::path & storage_path,
-        JsonImportContext & context);
-    asio::awaitable<bool> ensureConditionImported(
+    asio::awaitable<bool> ensureConnectorDeployedImpl(
         evm::EVM & evm,
         registry::Registry & registry,
         const std::string & name,
         const std::filesystem::path & storage_path,
-        JsonImportContext & context);
-    asio::awaitable<bool> ensureConnectorImported(
+        ConnectorEnsureContext & context);
+    static asio::awaitable<bool> ensureTransformationDeployedImpl(
         evm::EVM & evm,
         registry::Registry & registry,
         const std::string & name,
         const std::filesystem::path & storage_path,
-        JsonImportContext & context);
-    asio::awaitable<bool> ensureConnectorDeployedImpl(
+        const ConnectorEnsureContext * context);
+    static asio::awaitable<bool> ensureConditionDeployedImpl(
         evm::EVM & evm,
         registry::Registry & registry,
         const std::string & name,
         const std::filesystem::path & storage_path,
-        ConnectorEnsureContext & context);
+        const ConnectorEnsureContext * context);
     static asio::awaitable<std::expected<chain::Address, pt::PTDeployError>> deployConnectorWithContext(
         evm::EVM & evm,
         registry::Registry & registry,
@@ -296,78 +460,122 @@ namespace dcn::loader
         bool persist_json,
         ConnectorEnsureContext & ensure_context);
 
+    // Records of an entity directory share one pack; `<name>.json` files of older layouts move into it on first open.
+    static storage::pack::PackStore & _recordStore(const std::filesystem::path & dir)
+    {
+        return storage::pack::PackStore::forDirectory(dir, {.migrate_extensions = {".json"}});
+    }
+
+    // Deployed bytecode and ABIs; solc still writes loose `.bin/.abi` files, which are packed on first use.
+    static storage::pack::PackStore & _buildArtifactStore(const std::filesystem::path & bin_dir)
+    {
+        return storage::pack::PackStore::forDirectory(bin_dir, {.migrate_extensions = {".bin", ".abi"}});
+    }
+
     template<class T>
-    static absl::flat_hash_map<std::string, T> _loadJSONRecords(std::filesystem::path dir)
+    static absl::flat_hash_map<std::string, T> _loadJSONRecords(std::filesystem::path dir, std::size_t scan_threads = 0)
     {
-        absl::flat_hash_map<std::string, T> loaded_data;
-        parse::Result<T> loaded_result;
+        std::error_code ec;
+        if(!std::filesystem::is_directory(dir, ec))
+        {
+            spdlog::error("Storage directory '{}' does not exist", dir.string());
+            return {};
+        }
 
-        std::size_t json_files_seen = 0;
-        std::size_t loaded_records = 0;
-        std::size_t open_failures = 0;
-        std::size_t parse_failures = 0;
-        
-        bool success = true;
+        const auto started_at = std::chrono::steady_clock::now();
 
-        try {
-            for (const auto& entry : std::filesystem::directory_iterator(dir)) 
-            {
-                if(!entry.is_regular_file() || entry.path().extension() != ".json")
-                {
-                    continue;
-                }
+        // Views into the mapped segments, sorted by key.
+        const storage::pack::PackScan scan = _recordStore(dir).scan(".json");
+        const auto & records = scan.entries();
 
-                ++json_files_seen;
-                
-                spdlog::debug("JSON import scanning file '{}'", entry.path().string());
+        const std::size_t threads = std::clamp<std::size_t>(
+            scan_threads > 0 ? scan_threads : std::thread::hardware_concurrency(),
+            1,
+            std::max<std::size_t>(1, records.size() / JSON_SCAN_CHUNK));
 
-                std::ifstream file(entry.path());
+        // Each record parses into its own slot, so the merge below does not depend on the scheduling.
+        std::vector<std::optional<T>> parsed(records.size());
+        std::atomic<std::size_t> next_record = 0;
+        std::atomic<std::size_t> scanned_records = 0;
+        std::atomic<std::size_t> parse_failures = 0;
+        const std::size_t progress_step = std::max<std::size_t>(JSON_SCAN_PROGRESS_STEP, records.size() / 10);
 
-                if(!file.is_open())
+        const auto parse_records = [&]()
+        {
+            for(;;)
+            {
+                const std::size_t begin = next_record.fetch_add(JSON_SCAN_CHUNK, std::memory_order_relaxed);
+                if(begin >= records.size())
                 {
-                    spdlog::error(std::format("Failed to open file: {}", entry.path().string()));
-                    ++open_failures;
-                    continue;
+                    return;
                 }
+                const std::size_t end = std::min(records.size(), begin + JSON_SCAN_CHUNK);
 
-                std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-                file.close();
-
-                loaded_result = parse::parseFromJson<T>(json, parse::use_protobuf);
-                if(!loaded_result)
+                for(std::size_t i = begin; i < end; ++i)
                 {
-                    spdlog::error(std::format("Failed to parse JSON: {}", json));
-                    ++parse_failures;
-                    continue;
+                    try
+                    {
+                        std::string json(records[i].value);
+                        auto loaded_result = parse::parseFromJson<T>(json, parse::use_protobuf);
+                        if(!loaded_result)
+                        {
+                            spdlog::error(std::format("Failed to parse JSON: {}", json));
+                            parse_failures.fetch_add(1, std::memory_order_relaxed);
+                            continue;
+                        }
+                        parsed[i] = std::move(*loaded_result);
+                    }
+                    catch(const std::exception & e)
+                    {
+                        spdlog::error(std::format("Exception while loading {}: {}", records[i].key, e.what()));
+                        parse_failures.fetch_add(1, std::memory_order_relaxed);
+                    }
                 }
 
-                loaded_data.try_emplace(entry.path().stem().string(), std::move(*loaded_result));
-                ++loaded_records;
+                const std::size_t done = scanned_records.fetch_add(end - begin, std::memory_order_relaxed) + (end - begin);
+                if(done / progress_step != (done - (end - begin)) / progress_step)
+                {
+                    spdlog::info("JSON import scan '{}': {}/{} records", dir.string(), done, records.size());
+                }
             }
-        } 
-        catch (const std::filesystem::filesystem_error& e) 
+        };
+
+        if(threads > 1)
         {
-            spdlog::error(std::format("Filesystem error: {}", e.what()));
-            success = false;
-        } 
-        catch (const std::exception& e) 
+            asio::thread_pool pool(threads - 1);
+            for(std::size_t i = 1; i < threads; ++i)
+            {
+                asio::post(pool, parse_records);
+            }
+            parse_records();
+            pool.join();
+        }
+        else
         {
-            spdlog::error(std::format("Exception: {}", e.what()));
-            success = false;
+            parse_records();
         }
 
-        if(!success)
+        absl::flat_hash_map<std::string, T> loaded_data;
+        loaded_data.reserve(records.size());
+        std::size_t loaded_records = 0;
+        for(std::size_t i = 0; i < records.size(); ++i)
         {
-            return {};
+            if(parsed[i].has_value())
+            {
+                const std::string_view key = records[i].key;
+                loaded_data.try_emplace(std::string(key.substr(0, key.size() - std::string_view(".json").size())), std::move(*parsed[i]));
+                ++loaded_records;
+            }
         }
 
         spdlog::debug(
-            "JSON import scan finished for '{}': files={}, loaded={}, open_failures={}, parse_failures={}",
+            "JSON import scan finished for '{}' in {}ms on {} threads: records={}, loaded={}, parse_failures={}",
             dir.string(),
-            json_files_seen,
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started_at).count(),
+            threads,
+            records.size(),
             loaded_records,
-            open_failures,
-            parse_failures);
+            parse_failures.load());
 
         return loaded_data;
     }
@@ -387,6 +595,32 @@ namespace dcn::loader
         // remove binary file
         _removeFileNoThrow(out_dir / (name + ".bin"));
         _removeFileNoThrow(out_dir / (name + ".abi"));
+
+        storage::pack::PackStore & artifacts = _buildArtifactStore(out_dir);
+        artifacts.erase(name + ".bin");
+        artifacts.erase(name + ".abi");
+    }
+
+    static bool _hasBuildArtifact(const std::filesystem::path & bin_dir, const std::string & name)
+    {
+        return std::filesystem::exists(bin_dir / (name + ".bin")) || _buildArtifactStore(bin_dir).contains(name + ".bin");
+    }
+
+    // Hex bytecode of `name`, packing a fresh solc output first. The loose file is only removed once its
+    // copy is in the pack, so a concurrent reader of the same name finds it in one place or the other.
+    static std::optional<std::string> _loadBuildArtifact(const std::filesystem::path & bin_dir, const std::string & name)
+    {
+        storage::pack::PackStore & artifacts = _buildArtifactStore(bin_dir);
+        for(const std::string extension : {".abi", ".bin"})
+        {
+            const std::filesystem::path loose_path = bin_dir / (name + extension);
+            const std::optional<native::MappedFile> loose = native::mapFile(loose_path);
+            if(loose && artifacts.put(name + extension, std::string_view(reinterpret_cast<const char *>(loose->data()), loose->size())))
+            {
+                _removeFileNoThrow(loose_path);
+            }
+        }
+        return artifacts.get(name + ".bin");
     }
 
     bool ensurePTBuildVersion(const std::filesystem::path & storage_path)
@@ -441,6 +675,25 @@ namespace dcn::loader
                     }
                 }
 
+                if(std::filesystem::exists(build_dir))
+                {
+                    storage::pack::PackStore & artifacts = _buildArtifactStore(build_dir);
+                    std::vector<std::string> packed;
+                    for(const std::string_view extension : {".bin", ".abi"})
+                    {
+                        const storage::pack::PackScan scan = artifacts.scan(extension);
+                        for(const auto & entry : scan.entries())
+                        {
+                            packed.emplace_back(entry.key);
+                        }
+                    }
+                    for(const std::string & key : packed)
+                    {
+                        artifacts.erase(key);
+                    }
+                    removed_count += packed.size();
+                }
+
                 spdlog::info("PT build cleanup '{}': removed {} cached artifacts", entity_dir, removed_count);
             }
         }
@@ -464,6 +717,11 @@ namespace dcn::loader
         return true;
     }
 
+    asio::awaitable<std::string> makeStateSnapshotTag(registry::Registry & registry)
+    {
+        co_return std::format("{};registry={}", PT_BUILD_VERSION, co_await registry.getWriteMarker());
+    }
+
     template<class RecordType>
     static asio::awaitable<bool> _saveJsonRecord(const std::string & name, RecordType record, const std::filesystem::path out_dir)
     {
@@ -480,10 +738,11 @@ namespace dcn::loader
             co_return false;
         }
 
-        std::ofstream output_file(out_dir / (name + ".json"), std::ios::out | std::ios::trunc);
-
-        output_file << *parsing_result;
-        output_file.close();
+        if(!_recordStore(out_dir).put(name + ".json", *parsing_result))
+        {
+            spdlog::error("Failed to store record `{}`", name);
+            co_return false;
+        }
 
         co_return true;
     }
@@ -592,7 +851,7 @@ namespace dcn::loader
         }
 
         // if binary file does not exist
-        const bool binary_already_exists = std::filesystem::exists(bin_dir / (name + ".bin"));
+        const bool binary_already_exists = _hasBuildArtifact(bin_dir, name);
         const auto cleanup_new_build_artifacts = [&]()
         {
             if(!binary_already_exists)
@@ -682,12 +941,21 @@ namespace dcn::loader
             _removeFileNoThrow(code_path);
         }
 
+        const std::optional<std::string> code_hex = _loadBuildArtifact(bin_dir, name);
+        if(!code_hex)
+        {
+            spdlog::error("Missing build artifact for '{}'", name);
+            cleanup_new_build_artifacts();
+            co_return std::unexpected(pt::PTDeployError{});
+        }
+
         co_await evm.addAccount(address, evm::DEFAULT_GAS_LIMIT);
         co_await evm.setGas(address, evm::DEFAULT_GAS_LIMIT);
         
         std::vector<std::uint8_t> ctor_args = evm::encodeAsArg(evm.getRegistryAddress());
+        std::istringstream code_stream(*code_hex);
         auto deploy_res = co_await evm.deploy(
-            bin_dir / (name + ".bin"),
+            code_stream,
             address, 
             std::move(ctor_args),
             evm::DEFAULT_GAS_LIMIT, 
@@ -816,6 +1084,98 @@ namespace dcn::loader
     }
 
 
+    // Compiles the records whose artifacts are missing in `chunk_size`-sized `solc --standard-json` runs,
+    // fanned out over the compile service, so the per-record deploys that follow find `<name>.bin` ready.
+    // Records that fail here are left to the single-source compile in `_deployObjectLocally`, which reports the error.
+    template<class T, class InternalGetter, class SolidityCodeCtor>
+    static asio::awaitable<void> _precompileRecords(evm::EVM & evm,
+        const std::vector<const T *> & records, InternalGetter getter,
+        const std::filesystem::path & out_dir, SolidityCodeCtor solidity_code_ctor, std::size_t chunk_size)
+    {
+        using Internal_t = std::decay_t<std::invoke_result_t<InternalGetter, const T &>>;
+        using SolidityCodeResult_t = std::decay_t<std::invoke_result_t<SolidityCodeCtor, Internal_t>>;
+
+        const std::filesystem::path bin_dir = out_dir / "build";
+        chunk_size = normalizeBatchSize(chunk_size);
+
+        std::vector<evm::SoliditySource> sources;
+        for(const T * record : records)
+        {
+            const Internal_t & internal = std::invoke(getter, *record);
+            if(internal.name().empty() || _hasBuildArtifact(bin_dir, internal.name()))
+            {
+                continue;
+            }
+
+            const auto solidity_code_result = std::invoke(solidity_code_ctor, internal);
+            if constexpr(std::is_same_v<SolidityCodeResult_t, parse::Result<std::string>>)
+            {
+                if(solidity_code_result && !solidity_code_result->empty())
+                {
+                    sources.push_back(evm::SoliditySource{.name = internal.name(), .code = *solidity_code_result});
+                }
+            }
+            else if constexpr(std::is_same_v<SolidityCodeResult_t, std::string>)
+            {
+                if(!solidity_code_result.empty())
+                {
+                    sources.push_back(evm::SoliditySource{.name = internal.name(), .code = solidity_code_result});
+                }
+            }
+            else
+            {
+                static_assert(utils::always_false<SolidityCodeResult_t>, "Unsupported Solidity code constructor return type");
+            }
+        }
+
+        if(sources.empty())
+        {
+            co_return;
+        }
+
+        // Chunks complete on this strand, which also serializes the bookkeeping below.
+        auto strand = asio::make_strand(co_await asio::this_coro::executor);
+        co_await asio::dispatch(strand, asio::use_awaitable);
+
+        asio::steady_timer all_done(strand);
+        std::size_t remaining = 0;
+        std::size_t compiled = 0;
+
+        for(std::size_t begin = 0; begin < sources.size(); begin += chunk_size)
+        {
+            const std::size_t end = std::min(sources.size(), begin + chunk_size);
+            std::vector<evm::SoliditySource> chunk(
+                std::make_move_iterator(sources.begin() + begin),
+                std::make_move_iterator(sources.begin() + end));
+
+            ++remaining;
+            asio::co_spawn(
+                strand,
+                evm.compileBatch(std::move(chunk), bin_dir, evm.getPTPath() / "contracts", evm.getPTPath() / "node_modules"),
+                [&](std::exception_ptr exception_ptr, std::vector<bool> chunk_compiled)
+                {
+                    if(exception_ptr)
+                    {
+                        utils::logException(exception_ptr, "Batch compile coroutine failed");
+                    }
+                    compiled += static_cast<std::size_t>(std::ranges::count(chunk_compiled, true));
+                    if(--remaining == 0)
+                    {
+                        all_done.cancel();
+                    }
+                });
+        }
+
+        while(remaining > 0)
+        {
+            all_done.expires_at(asio::steady_timer::time_point::max());
+            std::error_code ec;
+            co_await all_done.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+        }
+
+        spdlog::info("Batch compiled {}/{} sources under {}", compiled, sources.size(), bin_dir.string());
+    }
+
     static asio::awaitable<std::expected<chain::Address, pt::PTDeployError>> deployConnectorWithContext(
         evm::EVM & evm,
         registry::Registry & registry,
@@ -841,7 +1201,12 @@ namespace dcn::loader
                     continue;
                 }
 
-                if(!co_await ensureTransformationDeployed(evm, registry, transformation_name, storage_path))
+                if(!co_await ensureTransformationDeployedImpl(
+                    evm,
+                    registry,
+                    transformation_name,
+                    storage_path,
+                    &ensure_context))
                 {
                     spdlog::error(
                         "Cannot deploy connector '{}': dependency transformation '{}' is not deployable",
@@ -893,7 +1258,12 @@ namespace dcn::loader
 
         if(!connector.condition_name().empty())
         {
-            if(!co_await ensureConditionDeployed(evm, registry, connector.condition_name(), storage_path))
+            if(!co_await ensureConditionDeployedImpl(
+                evm,
+                registry,
+                connector.condition_name(),
+                storage_path,
+                &ensure_context))
             {
                 spdlog::error(
                     "Cannot deploy connector '{}': dependency condition '{}' is not deployable",
@@ -975,924 +1345,705 @@ namespace dcn::loader
     }
 
 
-    asio::awaitable<bool> loadStoredConnectors(
+    // Deploys `graph` in dependency waves. Every node whose dependencies are deployed joins the
+    // current wave, which goes to the EVM as one `deployBatch`; nodes are compiled up front in parallel
+    // `solc --standard-json` runs. Startup cost thus follows the graph depth instead of the node count.
+    // Dependencies outside the graph are deployed first through the on-use `ensure*DeployedImpl` path.
+    static asio::awaitable<bool> _deployGraphInWaves(
         evm::EVM & evm,
         registry::Registry & registry,
         const std::filesystem::path & storage_path,
-        std::size_t registry_batch_size)
+        const DeployGraph & graph,
+        JsonImportContext & context)
     {
-        spdlog::info("Loading stored connectors...");
+        std::vector<DeployNode> nodes;
+        nodes.reserve(graph.transformations.size() + graph.conditions.size() + graph.connectors.size());
+
+        absl::flat_hash_map<std::string, std::size_t> transformation_nodes;
+        absl::flat_hash_map<std::string, std::size_t> condition_nodes;
+        absl::flat_hash_map<std::string, std::size_t> connector_nodes;
 
-        if(registry_batch_size == 0)
+        for(const auto & [name, record] : graph.transformations)
+        {
+            transformation_nodes.try_emplace(name, nodes.size());
+            nodes.push_back(DeployNode{.kind = DeployNodeKind::TRANSFORMATION, .name = name, .transformation = record});
+        }
+        for(const auto & [name, record] : graph.conditions)
+        {
+            condition_nodes.try_emplace(name, nodes.size());
+            nodes.push_back(DeployNode{.kind = DeployNodeKind::CONDITION, .name = name, .condition = record});
+        }
+        for(const auto & [name, record] : graph.connectors)
         {
-            registry_batch_size = 1;
+            connector_nodes.try_emplace(name, nodes.size());
+            nodes.push_back(DeployNode{.kind = DeployNodeKind::CONNECTOR, .name = name, .connector = record});
         }
 
-        auto loaded_connectors = _loadJSONRecords<ConnectorRecord>(storage_path / "connectors");
-        if(loaded_connectors.empty())
+        if(nodes.empty())
         {
-            co_return false;
+            co_return true;
         }
 
-        const auto sorted_connectors = utils::topologicalSort<ConnectorRecord, std::string, std::vector>(
-                loaded_connectors,
-                [](const ConnectorRecord & record)
+        // Dependencies outside the graph, with the nodes waiting on them.
+        absl::flat_hash_map<std::string, std::vector<std::size_t>> external_transformations;
+        absl::flat_hash_map<std::string, std::vector<std::size_t>> external_conditions;
+        absl::flat_hash_map<std::string, std::vector<std::size_t>> external_connectors;
+
+        for(std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            if(nodes[i].kind != DeployNodeKind::CONNECTOR)
+            {
+                continue;
+            }
+
+            absl::flat_hash_set<std::size_t> dependencies;
+            const auto add_dependency = [&](
+                const std::string & dependency_name,
+                const absl::flat_hash_map<std::string, std::size_t> & in_graph,
+                absl::flat_hash_map<std::string, std::vector<std::size_t>> & external)
+            {
+                if(dependency_name.empty())
+                {
+                    return;
+                }
+
+                if(const auto it = in_graph.find(dependency_name); it != in_graph.end())
                 {
-                    std::vector<std::string> dependencies;
-                    dependencies.reserve(static_cast<std::size_t>(record.connector().dimensions_size()));
-                    for(const auto & dimension : record.connector().dimensions())
+                    if(it->second != i && dependencies.insert(it->second).second)
                     {
-                        if(dimension.composite().empty())
-                        {
-                            if(dimension.bindings_size() != 0)
-                            {
-                                for(const auto & [_, binding_target] : dimension.bindings())
-                                {
-                                    if(!binding_target.empty())
-                                    {
-                                        dependencies.push_back(binding_target);
-                                    }
-                                }
-                            }
-                            continue;
-                        }
+                        nodes[it->second].dependents.push_back(i);
+                        ++nodes[i].pending_dependencies;
+                    }
+                    else if(it->second == i)
+                    {
+                        spdlog::error("Connector '{}' depends on itself", nodes[i].name);
+                        nodes[i].failed = true;
+                    }
+                    return;
+                }
+                external[dependency_name].push_back(i);
+            };
 
-                        dependencies.push_back(dimension.composite());
+            const Connector & connector = nodes[i].connector->connector();
+            for(const auto & dimension : connector.dimensions())
+            {
+                for(const auto & transformation : dimension.transformations())
+                {
+                    add_dependency(transformation.name(), transformation_nodes, external_transformations);
+                }
 
-                        for(const auto & [_, binding_target] : dimension.bindings())
-                        {
-                            if(binding_target.empty())
-                            {
-                                continue;
-                            }
-                            dependencies.push_back(binding_target);
-                        }
-                    }
-                    return dependencies;
-                },
-                [](const std::string & composite) {return composite;}
-            );
-
-        bool success = true;
-        std::size_t i = 0;
-        const std::size_t progress_batch_size = (sorted_connectors.size() / 100) + 1;
-        assert(progress_batch_size > 0);
-        std::vector<std::pair<chain::Address, ConnectorRecord>> registry_batch;
-        registry_batch.reserve(std::min<std::size_t>(registry_batch_size, sorted_connectors.size()));
-        
-        for(const auto & name : sorted_connectors)
-        {
-            const auto deploy_result = co_await deployConnector(
-                evm,
-                registry,
-                loaded_connectors.at(name),
-                storage_path,
-                false,
-                false);
-            if(!deploy_result)
-            {
-                spdlog::error("Failed to deploy connector `{}`", name);
-                success = false;
-            }
-            else
-            {
-                registry_batch.emplace_back(deploy_result.value(), std::move(loaded_connectors.at(name)));
-                if(registry_batch.size() >= registry_batch_size)
+                add_dependency(dimension.composite(), connector_nodes, external_connectors);
+                for(const auto & [_, binding_target] : dimension.bindings())
                 {
-                    std::vector<std::pair<chain::Address, ConnectorRecord>> batch_to_insert;
-                    batch_to_insert.swap(registry_batch);
-                    if(!co_await registry.addConnectorsBatch(std::move(batch_to_insert), false))
-                    {
-                        spdlog::error("Failed to batch-register loaded connectors");
-                        success = false;
-                    }
+                    add_dependency(binding_target, connector_nodes, external_connectors);
                 }
             }
-
-            if(++i % progress_batch_size == 0) {spdlog::debug("{}/{} connectors loaded", i, loaded_connectors.size());}
+            add_dependency(connector.condition_name(), condition_nodes, external_conditions);
         }
 
-        if(!registry_batch.empty())
+        ConnectorEnsureContext ensure_context;
+        ensure_context.connector_deploy_stack.reserve(64);
+
+        const auto fail_external_dependents = [&](const std::vector<std::size_t> & dependents, std::string_view kind, const std::string & name)
         {
-            if(!co_await registry.addConnectorsBatch(std::move(registry_batch), false))
+            for(const std::size_t dependent : dependents)
             {
-                spdlog::error("Failed to batch-register loaded connectors");
-                success = false;
+                spdlog::error("Cannot deploy connector '{}': dependency {} '{}' is not deployable", nodes[dependent].name, kind, name);
+                nodes[dependent].failed = true;
             }
-        }
-
-        co_return success;
-    }
-
-
-    asio::awaitable<bool> loadStoredTransformations(
-        evm::EVM & evm,
-        registry::Registry & registry,
-        const std::filesystem::path & storage_path,
-        std::size_t registry_batch_size)
-    {
-        spdlog::info("Loading stored transformations...");
+        };
 
-        if(registry_batch_size == 0)
+        for(const auto & [name, dependents] : external_transformations)
         {
-            registry_batch_size = 1;
+            if(!co_await ensureTransformationDeployedImpl(evm, registry, name, storage_path, &ensure_context))
+            {
+                fail_external_dependents(dependents, "transformation", name);
+            }
         }
-
-        auto loaded_transformations = _loadJSONRecords<TransformationRecord>(storage_path / "transformations");
-        if(loaded_transformations.empty())
+        for(const auto & [name, dependents] : external_conditions)
         {
-            co_return false;
+            if(!co_await ensureConditionDeployedImpl(evm, registry, name, storage_path, &ensure_context))
+            {
+                fail_external_dependents(dependents, "condition", name);
+            }
         }
-
-        bool success = true;
-        std::size_t i = 0;
-        const std::size_t progress_batch_size = (loaded_transformations.size() / 100) + 1;
-        assert(progress_batch_size > 0);
-        std::vector<std::pair<chain::Address, TransformationRecord>> registry_batch;
-        registry_batch.reserve(std::min<std::size_t>(registry_batch_size, loaded_transformations.size()));
-
-        for(auto & [name, transformation] : loaded_transformations)
+        for(const auto & [name, dependents] : external_connectors)
         {
-            const auto deploy_result = co_await deployTransformation(
-                evm,
-                registry,
-                transformation,
-                storage_path,
-                false,
-                false);
-            if(!deploy_result)
+            if(!co_await ensureConnectorDeployedImpl(evm, registry, name, storage_path, ensure_context))
             {
-                spdlog::error("Failed to deploy transformation `{}`", name);
-                success = false;
+                fail_external_dependents(dependents, "connector", name);
             }
-            else
+        }
+
+        // Compiling does not depend on deploy order, so every wave finds its artifacts ready.
+        {
+            std::vector<const TransformationRecord *> transformations_to_compile;
+            std::vector<const ConditionRecord *> conditions_to_compile;
+            std::vector<const ConnectorRecord *> connectors_to_compile;
+            for(const DeployNode & node : nodes)
             {
-                registry_batch.emplace_back(deploy_result.value(), std::move(transformation));
-                if(registry_batch.size() >= registry_batch_size)
+                switch(node.kind)
                 {
-                    std::vector<std::pair<chain::Address, TransformationRecord>> batch_to_insert;
-                    batch_to_insert.swap(registry_batch);
-                    if(!co_await registry.addTransformationsBatch(std::move(batch_to_insert), false))
-                    {
-                        spdlog::error("Failed to batch-register loaded transformations");
-                        success = false;
-                    }
+                    case DeployNodeKind::TRANSFORMATION:    transformations_to_compile.push_back(node.transformation); break;
+                    case DeployNodeKind::CONDITION:         conditions_to_compile.push_back(node.condition); break;
+                    case DeployNodeKind::CONNECTOR:         connectors_to_compile.push_back(node.connector); break;
                 }
             }
 
-            if(++i % progress_batch_size == 0) {spdlog::debug("{}/{} transformations loaded", i, loaded_transformations.size());}
+            co_await _precompileRecords(evm, transformations_to_compile, &TransformationRecord::transformation,
+                storage_path / "transformations", &constructTransformationSolidityCode, context.batch_config.compile);
+            co_await _precompileRecords(evm, conditions_to_compile, &ConditionRecord::condition,
+                storage_path / "conditions", &constructConditionSolidityCode, context.batch_config.compile);
+            co_await _precompileRecords(evm, connectors_to_compile, &ConnectorRecord::connector,
+                storage_path / "connectors", &constructConnectorSolidityCode, context.batch_config.compile);
         }
 
-        if(!registry_batch.empty())
+        bool success = true;
+
+        std::vector<std::size_t> wave;
+        for(std::size_t i = 0; i < nodes.size(); ++i)
         {
-            if(!co_await registry.addTransformationsBatch(std::move(registry_batch), false))
+            if(nodes[i].pending_dependencies == 0)
             {
-                spdlog::error("Failed to batch-register loaded transformations");
-                success = false;
+                wave.push_back(i);
             }
         }
-
-        co_return success;
-    }
-
-    asio::awaitable<bool> loadStoredConditions(
-        evm::EVM & evm,
-        registry::Registry & registry,
-        const std::filesystem::path & storage_path,
-        std::size_t registry_batch_size)
-    {
-        spdlog::info("Loading stored conditions...");
-
-        if(registry_batch_size == 0)
+        // Deterministic deploy order, and with it deterministic addresses, across runs.
+        const auto by_kind_and_name = [&](std::size_t lhs, std::size_t rhs)
         {
-            registry_batch_size = 1;
-        }
+            return std::tie(nodes[lhs].kind, nodes[lhs].name) < std::tie(nodes[rhs].kind, nodes[rhs].name);
+        };
 
-        auto loaded_conditions = _loadJSONRecords<ConditionRecord>(storage_path / "conditions");
-        if(loaded_conditions.empty())
+        std::size_t finished = 0;
+        for(std::size_t wave_index = 0; !wave.empty(); ++wave_index)
         {
-            co_return false;
-        }
+            std::ranges::sort(wave, by_kind_and_name);
 
-        bool success = true;
-        std::size_t i = 0;
-        const std::size_t progress_batch_size = (loaded_conditions.size() / 100) + 1;
-        assert(progress_batch_size > 0);
-        std::vector<std::pair<chain::Address, ConditionRecord>> registry_batch;
-        registry_batch.reserve(std::min<std::size_t>(registry_batch_size, loaded_conditions.size()));
+            std::vector<evm::DeployRequest> requests;
+            std::vector<std::size_t> requested_nodes;
+            std::vector<chain::Address> request_owners;
+            requests.reserve(wave.size());
+            requested_nodes.reserve(wave.size());
 
-        for(auto & [name, condition] : loaded_conditions)
-        {
-            const auto deploy_result = co_await deployCondition(
-                evm,
-                registry,
-                condition,
-                storage_path,
-                false,
-                false);
-            if(!deploy_result)
+            const auto node_failed = [&](std::size_t index)
             {
-                spdlog::error("Failed to deploy condition `{}`", name);
+                nodes[index].failed = true;
                 success = false;
-            }
-            else
+            };
+
+            for(const std::size_t index : wave)
             {
-                registry_batch.emplace_back(deploy_result.value(), std::move(condition));
-                if(registry_batch.size() >= registry_batch_size)
+                DeployNode & node = nodes[index];
+                if(node.failed)
+                {
+                    spdlog::error("Skipping deploy of {} '{}': a dependency failed", deployNodeDir(node.kind), node.name);
+                    success = false;
+                    continue;
+                }
+
+                std::optional<std::string> code_hex = _loadBuildArtifact(storage_path / deployNodeDir(node.kind) / "build", node.name);
+                if(!code_hex)
                 {
-                    std::vector<std::pair<chain::Address, ConditionRecord>> batch_to_insert;
-                    batch_to_insert.swap(registry_batch);
-                    if(!co_await registry.addConditionsBatch(std::move(batch_to_insert), false))
+                    // The batch compile left no artifact; the single-record deploy reports why.
+                    std::expected<chain::Address, pt::PTDeployError> deploy_result = std::unexpected(pt::PTDeployError{});
+                    switch(node.kind)
+                    {
+                        case DeployNodeKind::TRANSFORMATION:
+                            deploy_result = co_await deployTransformation(evm, registry, *node.transformation, storage_path, false, false);
+                            break;
+                        case DeployNodeKind::CONDITION:
+                            deploy_result = co_await deployCondition(evm, registry, *node.condition, storage_path, false, false);
+                            break;
+                        case DeployNodeKind::CONNECTOR:
+                            deploy_result = co_await deployConnectorWithContext(evm, registry, *node.connector, storage_path, false, false, ensure_context);
+                            break;
+                    }
+
+                    if(!deploy_result)
                     {
-                        spdlog::error("Failed to batch-register loaded conditions");
-                        success = false;
+                        spdlog::error("Failed to deploy {} '{}': {}", deployNodeDir(node.kind), node.name, static_cast<int>(deploy_result.error().kind));
+                        node_failed(index);
                     }
+                    else
+                    {
+                        node.address = deploy_result.value();
+                    }
+                    continue;
+                }
+
+                const auto owner_result = evmc::from_hex<chain::Address>(deployNodeOwner(node));
+                if(!owner_result)
+                {
+                    spdlog::error("Failed to parse owner address of {} '{}'", deployNodeDir(node.kind), node.name);
+                    node_failed(index);
+                    continue;
                 }
+
+                requests.push_back(evm::DeployRequest{
+                    .code_hex = std::move(*code_hex),
+                    .sender = *owner_result,
+                    .constructor_args = evm::encodeAsArg(evm.getRegistryAddress()),
+                    .gas_limit = evm::DEFAULT_GAS_LIMIT,
+                    .value = 0
+                });
+                requested_nodes.push_back(index);
+                request_owners.push_back(*owner_result);
             }
 
-            if(++i % progress_batch_size == 0) {spdlog::debug("{}/{} conditions loaded", i, loaded_conditions.size());}
-        }
+            spdlog::debug("Deploy wave {}: {} node(s), {} batched", wave_index, wave.size(), requests.size());
 
-        if(!registry_batch.empty())
-        {
-            if(!co_await registry.addConditionsBatch(std::move(registry_batch), false))
+            const auto deploy_results = co_await evm.deployBatch(std::move(requests));
+            for(std::size_t i = 0; i < requested_nodes.size() && i < deploy_results.size(); ++i)
             {
-                spdlog::error("Failed to batch-register loaded conditions");
-                success = false;
+                DeployNode & node = nodes[requested_nodes[i]];
+                const auto & deploy_result = deploy_results[i];
+                if(!deploy_result)
+                {
+                    const auto pt_error = parse::decodeBytes<pt::PTDeployError>(deploy_result.error().result_bytes);
+                    spdlog::error(
+                        "Failed to deploy {} '{}': {}",
+                        deployNodeDir(node.kind),
+                        node.name,
+                        pt_error ? static_cast<int>(pt_error->kind) : static_cast<int>(deploy_result.error().kind));
+                    node_failed(requested_nodes[i]);
+                    continue;
+                }
+
+                const auto owner_result = co_await fetchOwner(evm, *deploy_result);
+                const auto owner_address = owner_result ? chain::readAddressWord(owner_result.value()) : std::nullopt;
+                if(!owner_address || *owner_address != request_owners[i])
+                {
+                    spdlog::error("Owner check failed for {} '{}'", deployNodeDir(node.kind), node.name);
+                    node_failed(requested_nodes[i]);
+                    continue;
+                }
+
+                node.address = *deploy_result;
             }
-        }
 
-        co_return success;
-    }
+            std::vector<std::size_t> next_wave;
+            for(const std::size_t index : wave)
+            {
+                ++finished;
+                const DeployNode & node = nodes[index];
+                if(!node.failed)
+                {
+                    switch(node.kind)
+                    {
+                        case DeployNodeKind::TRANSFORMATION:
+                            context.pending_transformations.emplace_back(*node.address, *node.transformation);
+                            break;
+                        case DeployNodeKind::CONDITION:
+                            context.pending_conditions.emplace_back(*node.address, *node.condition);
+                            break;
+                        case DeployNodeKind::CONNECTOR:
+                            context.pending_connectors.emplace_back(*node.address, *node.connector);
+                            break;
+                    }
+                }
 
-    asio::awaitable<bool> ensureTransformationDeployed(
-        evm::EVM & evm,
-        registry::Registry & registry,
-        const std::string & name,
-        const std::filesystem::path & storage_path)
-    {
-        if(name.empty())
-        {
-            spdlog::error("Cannot deploy transformation with empty name");
-            co_return false;
-        }
+                for(const std::size_t dependent : node.dependents)
+                {
+                    if(node.failed)
+                    {
+                        nodes[dependent].failed = true;
+                    }
+                    if(--nodes[dependent].pending_dependencies == 0)
+                    {
+                        next_wave.push_back(dependent);
+                    }
+                }
+            }
 
-        const auto contains_res = co_await containsRegistryEntry(evm, "containsTransformation(string)", name);
-        if(!contains_res.has_value())
-        {
-            co_return false;
-        }
-        if(*contains_res)
-        {
-            co_return true;
+            // Connector validation reads its dependencies from the registry DB, so those go in first.
+            const bool flush_connectors =
+                context.pending_connectors.size() >= normalizeBatchSize(context.batch_config.connectors);
+            if(!co_await flushPendingTransformations(registry, context, flush_connectors) ||
+                !co_await flushPendingConditions(registry, context, flush_connectors) ||
+                !co_await flushPendingConnectors(registry, context, false))
+            {
+                success = false;
+            }
+
+            wave = std::move(next_wave);
         }
 
-        const auto record_handle_opt = co_await registry.getTransformationRecordHandle(name);
-        if(!record_handle_opt.has_value() || !(*record_handle_opt))
+        if(finished != nodes.size())
         {
-            spdlog::error("Transformation '{}' is missing in registry DB", name);
-            co_return false;
+            for(const DeployNode & node : nodes)
+            {
+                if(node.pending_dependencies != 0)
+                {
+                    spdlog::error("Connector '{}' is part of a dependency cycle", node.name);
+                }
+            }
+            success = false;
         }
 
-        const auto deploy_result = co_await deployTransformation(
-            evm,
-            registry,
-            *(*record_handle_opt),
-            storage_path,
-            false,
-            false);
-        if(!deploy_result &&
-            deploy_result.error().kind != pt::PTDeployError::Kind::TRANSFORMATION_ALREADY_REGISTERED)
+        if(!co_await flushPendingTransformations(registry, context, true) ||
+            !co_await flushPendingConditions(registry, context, true) ||
+            !co_await flushPendingConnectors(registry, context, true))
         {
-            spdlog::error(
-                "Failed to deploy transformation '{}' from DB for runtime use: {}",
-                name,
-                static_cast<int>(deploy_result.error().kind));
-            co_return false;
+            success = false;
         }
 
-        co_return true;
+        spdlog::info("Deployed {}/{} entities", std::ranges::count_if(nodes, [](const DeployNode & node){ return node.address.has_value(); }), nodes.size());
+        co_return success;
     }
 
-    asio::awaitable<bool> ensureConditionDeployed(
+    asio::awaitable<bool> loadStoredConnectors(
         evm::EVM & evm,
         registry::Registry & registry,
-        const std::string & name,
-        const std::filesystem::path & storage_path)
+        const std::filesystem::path & storage_path,
+        LoaderBatchConfig batch_config)
     {
-        if(name.empty())
-        {
-            co_return true;
-        }
-
-        const auto contains_res = co_await containsRegistryEntry(evm, "containsCondition(string)", name);
-        if(!contains_res.has_value())
-        {
-            co_return false;
-        }
-        if(*contains_res)
-        {
-            co_return true;
-        }
+        spdlog::info("Loading stored connectors...");
 
-        const auto record_handle_opt = co_await registry.getConditionRecordHandle(name);
-        if(!record_handle_opt.has_value() || !(*record_handle_opt))
+        const auto loaded_connectors = _loadJSONRecords<ConnectorRecord>(storage_path / "connectors", batch_config.scan_threads);
+        if(loaded_connectors.empty())
         {
-            spdlog::error("Condition '{}' is missing in registry DB", name);
             co_return false;
         }
 
-        const auto deploy_result = co_await deployCondition(
-            evm,
-            registry,
-            *(*record_handle_opt),
-            storage_path,
-            false,
-            false);
-        if(!deploy_result &&
-            deploy_result.error().kind != pt::PTDeployError::Kind::CONDITION_ALREADY_REGISTERED)
+        DeployGraph graph;
+        for(const auto & [name, record] : loaded_connectors)
         {
-            spdlog::error(
-                "Failed to deploy condition '{}' from DB for runtime use: {}",
-                name,
-                static_cast<int>(deploy_result.error().kind));
-            co_return false;
+            graph.connectors.try_emplace(name, &record);
         }
 
-        co_return true;
+        JsonImportContext context;
+        context.batch_config = batch_config;
+        co_return co_await _deployGraphInWaves(evm, registry, storage_path, graph, context);
     }
 
-    asio::awaitable<bool> ensureConnectorDeployed(
-        evm::EVM & evm,
-        registry::Registry & registry,
-        const std::string & name,
-        const std::filesystem::path & storage_path)
-    {
-        ConnectorEnsureContext context;
-        context.connector_deploy_stack.reserve(64);
-        co_return co_await ensureConnectorDeployedImpl(evm, registry, name, storage_path, context);
-    }
 
-    asio::awaitable<bool> importJsonStorageToDatabase(
+    asio::awaitable<bool> loadStoredTransformations(
         evm::EVM & evm,
         registry::Registry & registry,
         const std::filesystem::path & storage_path,
         LoaderBatchConfig batch_config)
     {
-        JsonImportContext context;
-        context.connector_import_stack.reserve(64);
-        context.batch_config.connectors = normalizeBatchSize(batch_config.connectors);
-        context.batch_config.transformations = normalizeBatchSize(batch_config.transformations);
-        context.batch_config.conditions = normalizeBatchSize(batch_config.conditions);
-
-        spdlog::debug(
-            "JSON storage import start: storage_path='{}', batch(connectors={}, transformations={}, conditions={})",
-            storage_path.string(),
-            context.batch_config.connectors,
-            context.batch_config.transformations,
-            context.batch_config.conditions);
-
-        context.transformations = _loadJSONRecords<TransformationRecord>(storage_path / "transformations");
-        context.conditions = _loadJSONRecords<ConditionRecord>(storage_path / "conditions");
-        context.connectors = _loadJSONRecords<ConnectorRecord>(storage_path / "connectors");
-
-        context.pending_transformations.reserve(std::min<std::size_t>(context.batch_config.transformations, context.transformations.size()));
-        context.pending_conditions.reserve(std::min<std::size_t>(context.batch_config.conditions, context.conditions.size()));
-        context.pending_connectors.reserve(std::min<std::size_t>(context.batch_config.connectors, context.connectors.size()));
-
-        std::vector<std::string> transformation_names;
-        transformation_names.reserve(context.transformations.size());
-        for(const auto & [name, _] : context.transformations)
-        {
-            transformation_names.push_back(name);
-        }
-        std::ranges::sort(transformation_names);
+        spdlog::info("Loading stored transformations...");
 
-        std::vector<std::string> condition_names;
-        condition_names.reserve(context.conditions.size());
-        for(const auto & [name, _] : context.conditions)
+        const auto loaded_transformations = _loadJSONRecords<TransformationRecord>(storage_path / "transformations", batch_config.scan_threads);
+        if(loaded_transformations.empty())
         {
-            condition_names.push_back(name);
+            co_return false;
         }
-        std::ranges::sort(condition_names);
 
-        std::vector<std::string> connector_names;
-        connector_names.reserve(context.connectors.size());
-        for(const auto & [name, _] : context.connectors)
+        DeployGraph graph;
+        for(const auto & [name, record] : loaded_transformations)
         {
-            connector_names.push_back(name);
+            graph.transformations.try_emplace(name, &record);
         }
-        std::ranges::sort(connector_names);
-
-        spdlog::debug(
-            "JSON storage import inventory: transformations={}, conditions={}, connectors={}",
-            transformation_names.size(),
-            condition_names.size(),
-            connector_names.size());
-        
-        spdlog::debug("JSON storage import trace logging active (debug level)");
-
-        bool success = true;
-
-        for(std::size_t i = 0; i < transformation_names.size(); ++i)
-        {
-            const auto & name = transformation_names[i];
-            
-            spdlog::debug(
-                "JSON storage import transformation {}/{}: '{}'",
-                i + 1,
-                transformation_names.size(),
-                name);
 
-            try
-            {
-                if(!co_await ensureTransformationImported(evm, registry, name, storage_path, context))
-                {
-                    success = false;
-                }
-            }
-            catch(const std::exception & e)
-            {
-                spdlog::error("Unhandled exception while importing transformation '{}': {}", name, e.what());
-                success = false;
-            }
-            catch(...)
-            {
-                spdlog::error("Unhandled unknown exception while importing transformation '{}'", name);
-                success = false;
-            }
-        }
-        if(!co_await flushPendingTransformations(registry, context, true))
-        {
-            success = false;
-        }
-
-        for(std::size_t i = 0; i < condition_names.size(); ++i)
-        {
-            const auto & name = condition_names[i];
-            
-            spdlog::debug(
-                "JSON storage import condition {}/{}: '{}'",
-                i + 1,
-                condition_names.size(),
-                name);
+        JsonImportContext context;
+        context.batch_config = batch_config;
+        co_return co_await _deployGraphInWaves(evm, registry, storage_path, graph, context);
+    }
 
-            try
-            {
-                if(!co_await ensureConditionImported(evm, registry, name, storage_path, context))
-                {
-                    success = false;
-                }
-            }
-            catch(const std::exception & e)
-            {
-                spdlog::error("Unhandled exception while importing condition '{}': {}", name, e.what());
-                success = false;
-            }
-            catch(...)
-            {
-                spdlog::error("Unhandled unknown exception while importing condition '{}'", name);
-                success = false;
-            }
-        }
-        if(!co_await flushPendingConditions(registry, context, true))
-        {
-            success = false;
-        }
+    asio::awaitable<bool> loadStoredConditions(
+        evm::EVM & evm,
+        registry::Registry & registry,
+        const std::filesystem::path & storage_path,
+        LoaderBatchConfig batch_config)
+    {
+        spdlog::info("Loading stored conditions...");
 
-        for(std::size_t i = 0; i < connector_names.size(); ++i)
+        const auto loaded_conditions = _loadJSONRecords<ConditionRecord>(storage_path / "conditions", batch_config.scan_threads);
+        if(loaded_conditions.empty())
         {
-            const auto & name = connector_names[i];
-
-            spdlog::debug(
-                "JSON storage import connector {}/{}: '{}'",
-                i + 1,
-                connector_names.size(),
-                name);
-            
-            try
-            {
-                if(!co_await ensureConnectorImported(evm, registry, name, storage_path, context))
-                {
-                    success = false;
-                }
-            }
-            catch(const std::exception & e)
-            {
-                spdlog::error("Unhandled exception while importing connector '{}': {}", name, e.what());
-                success = false;
-            }
-            catch(...)
-            {
-                spdlog::error("Unhandled unknown exception while importing connector '{}'", name);
-                success = false;
-            }
+            co_return false;
         }
 
-        if(!co_await flushPendingTransformations(registry, context, true))
-        {
-            success = false;
-        }
-        if(!co_await flushPendingConditions(registry, context, true))
-        {
-            success = false;
-        }
-        if(!co_await flushPendingConnectors(registry, context, true))
+        DeployGraph graph;
+        for(const auto & [name, record] : loaded_conditions)
         {
-            success = false;
+            graph.conditions.try_emplace(name, &record);
         }
 
-        spdlog::debug("JSON storage import finished with status={}", success ? "success" : "failure");
-        co_return success;
+        JsonImportContext context;
+        context.batch_config = batch_config;
+        co_return co_await _deployGraphInWaves(evm, registry, storage_path, graph, context);
     }
 
-    asio::awaitable<bool> ensureTransformationImported(
+    static asio::awaitable<bool> ensureTransformationDeployedImpl(
         evm::EVM & evm,
         registry::Registry & registry,
         const std::string & name,
         const std::filesystem::path & storage_path,
-        JsonImportContext & context)
+        const ConnectorEnsureContext * context)
     {
-        spdlog::debug("JSON import ensure transformation '{}': begin", name);
-
-        if(context.imported_transformations.contains(name))
+        if(name.empty())
         {
-            spdlog::debug("JSON import ensure transformation '{}': already imported in current session", name);
-            co_return true;
+            spdlog::error("Cannot deploy transformation with empty name");
+            co_return false;
         }
 
-        if(context.importing_transformations.contains(name))
+        const auto contains_res = co_await containsRegistryEntry(evm, "containsTransformation(string)", name);
+        if(!contains_res.has_value())
         {
-            spdlog::error("Transformation import cycle detected for '{}'", name);
             co_return false;
         }
-
-        const bool exists_in_db = co_await registry.hasTransformation(name);
-        if(exists_in_db)
+        if(*contains_res)
         {
-            context.imported_transformations.insert(name);
-            spdlog::debug("JSON import ensure transformation '{}': found in DB, skipping JSON deploy", name);
             co_return true;
         }
 
-        const auto json_it = context.transformations.find(name);
-        if(json_it == context.transformations.end())
+        auto record_handle_opt = context != nullptr
+            ? findPrefetchedRecord(context->transformation_records, name)
+            : std::nullopt;
+        if(!record_handle_opt.has_value())
         {
-            spdlog::error("Transformation '{}' not found in DB or JSON storage", name);
+            record_handle_opt = co_await registry.getTransformationRecordHandle(name);
+        }
+        if(!record_handle_opt.has_value() || !(*record_handle_opt))
+        {
+            spdlog::error("Transformation '{}' is missing in registry DB", name);
             co_return false;
         }
 
-        context.importing_transformations.insert(name);
-
         const auto deploy_result = co_await deployTransformation(
             evm,
             registry,
-            json_it->second,
+            *(*record_handle_opt),
             storage_path,
             false,
             false);
-
-        context.importing_transformations.erase(name);
-
-        if(!deploy_result)
+        if(!deploy_result &&
+            deploy_result.error().kind != pt::PTDeployError::Kind::TRANSFORMATION_ALREADY_REGISTERED)
         {
             spdlog::error(
-                "Failed to import transformation '{}' from JSON into DB: {}",
+                "Failed to deploy transformation '{}' from DB for runtime use: {}",
                 name,
                 static_cast<int>(deploy_result.error().kind));
             co_return false;
         }
 
-        spdlog::debug("JSON import ensure transformation '{}': deployed at {}", name, evmc::hex(deploy_result.value()));
-
-        context.pending_transformations.emplace_back(deploy_result.value(), json_it->second);
-        if(!co_await flushPendingTransformations(registry, context, false))
-        {
-            co_return false;
-        }
-
-        context.imported_transformations.insert(name);
-        spdlog::debug("JSON import ensure transformation '{}': complete", name);
         co_return true;
     }
 
-    asio::awaitable<bool> ensureConditionImported(
+    asio::awaitable<bool> ensureTransformationDeployed(
+        evm::EVM & evm,
+        registry::Registry & registry,
+        const std::string & name,
+        const std::filesystem::path & storage_path)
+    {
+        co_return co_await ensureTransformationDeployedImpl(evm, registry, name, storage_path, nullptr);
+    }
+
+    static asio::awaitable<bool> ensureConditionDeployedImpl(
         evm::EVM & evm,
         registry::Registry & registry,
         const std::string & name,
         const std::filesystem::path & storage_path,
-        JsonImportContext & context)
+        const ConnectorEnsureContext * context)
     {
         if(name.empty())
         {
             co_return true;
         }
 
-        spdlog::debug("JSON import ensure condition '{}': begin", name);
-
-        if(context.imported_conditions.contains(name))
-        {
-            spdlog::debug("JSON import ensure condition '{}': already imported in current session", name);
-            co_return true;
-        }
-
-        if(context.importing_conditions.contains(name))
+        const auto contains_res = co_await containsRegistryEntry(evm, "containsCondition(string)", name);
+        if(!contains_res.has_value())
         {
-            spdlog::error("Condition import cycle detected for '{}'", name);
             co_return false;
         }
-
-        const bool exists_in_db = co_await registry.hasCondition(name);
-        if(exists_in_db)
+        if(*contains_res)
         {
-            context.imported_conditions.insert(name);
-            spdlog::debug("JSON import ensure condition '{}': found in DB, skipping JSON deploy", name);
             co_return true;
         }
 
-        const auto json_it = context.conditions.find(name);
-        if(json_it == context.conditions.end())
+        auto record_handle_opt = context != nullptr
+            ? findPrefetchedRecord(context->condition_records, name)
+            : std::nullopt;
+        if(!record_handle_opt.has_value())
+        {
+            record_handle_opt = co_await registry.getConditionRecordHandle(name);
+        }
+        if(!record_handle_opt.has_value() || !(*record_handle_opt))
         {
-            spdlog::error("Condition '{}' not found in DB or JSON storage", name);
+            spdlog::error("Condition '{}' is missing in registry DB", name);
             co_return false;
         }
 
-        context.importing_conditions.insert(name);
-
         const auto deploy_result = co_await deployCondition(
             evm,
             registry,
-            json_it->second,
+            *(*record_handle_opt),
             storage_path,
             false,
             false);
-
-        context.importing_conditions.erase(name);
-
-        if(!deploy_result)
+        if(!deploy_result &&
+            deploy_result.error().kind != pt::PTDeployError::Kind::CONDITION_ALREADY_REGISTERED)
         {
             spdlog::error(
-                "Failed to import condition '{}' from JSON into DB: {}",
+                "Failed to deploy condition '{}' from DB for runtime use: {}",
                 name,
                 static_cast<int>(deploy_result.error().kind));
             co_return false;
         }
 
-        spdlog::debug("JSON import ensure condition '{}': deployed at {}", name, evmc::hex(deploy_result.value()));
-
-        context.pending_conditions.emplace_back(deploy_result.value(), json_it->second);
-        if(!co_await flushPendingConditions(registry, context, false))
-        {
-            co_return false;
-        }
-
-        context.imported_conditions.insert(name);
-        spdlog::debug("JSON import ensure condition '{}': complete", name);
         co_return true;
     }
 
-    asio::awaitable<bool> ensureConnectorImported(
+    asio::awaitable<bool> ensureConditionDeployed(
         evm::EVM & evm,
         registry::Registry & registry,
         const std::string & name,
-        const std::filesystem::path & storage_path,
-        JsonImportContext & context)
+        const std::filesystem::path & storage_path)
     {
-        StackPushGuard stack_guard(context.connector_import_stack, name);
-        const std::size_t depth = context.connector_import_stack.size();
-
-        if(depth > MAX_CONNECTOR_IMPORT_DEPTH)
-        {
-            spdlog::error(
-                "Connector import recursion depth overflow (depth={}, max={}): {}",
-                depth,
-                MAX_CONNECTOR_IMPORT_DEPTH,
-                formatDependencyStack(context.connector_import_stack));
-            co_return false;
-        }
+        co_return co_await ensureConditionDeployedImpl(evm, registry, name, storage_path, nullptr);
+    }
 
-        spdlog::debug(
-            "JSON import ensure connector '{}': begin (depth={}, path={})",
-            name,
-            depth,
-            formatDependencyStack(context.connector_import_stack));
+    asio::awaitable<std::optional<bool>> isConnectorDeployed(evm::EVM & evm, const std::string & name)
+    {
+        co_return co_await containsRegistryEntry(evm, "containsConnector(string)", name);
+    }
 
-        if(context.imported_connectors.contains(name))
-        {
-            spdlog::debug("JSON import ensure connector '{}': already imported in current session", name);
-            co_return true;
-        }
+    asio::awaitable<ConnectorDependencies> collectConnectorDependencies(
+        registry::Registry & registry,
+        const std::string & name)
+    {
+        ConnectorEnsureContext context;
+        co_await prefetchConnectorGraph(registry, name, context);
 
-        if(context.importing_connectors.contains(name))
+        ConnectorDependencies dependencies;
+        dependencies.connectors.reserve(context.connector_records.size());
+        for(const auto & [connector_name, _] : context.connector_records)
         {
-            spdlog::error(
-                "Connector import cycle detected for '{}': {}",
-                name,
-                formatDependencyStack(context.connector_import_stack));
-            co_return false;
+            dependencies.connectors.push_back(connector_name);
         }
-
-        const bool exists_in_db = co_await registry.hasConnector(name);
-        if(exists_in_db)
+        dependencies.transformations.reserve(context.transformation_records.size());
+        for(const auto & [transformation_name, _] : context.transformation_records)
         {
-            context.imported_connectors.insert(name);
-            spdlog::debug("JSON import ensure connector '{}': found in DB, skipping JSON deploy", name);
-            co_return true;
+            dependencies.transformations.push_back(transformation_name);
         }
-
-        const auto json_it = context.connectors.find(name);
-        if(json_it == context.connectors.end())
+        dependencies.conditions.reserve(context.condition_records.size());
+        for(const auto & [condition_name, _] : context.condition_records)
         {
-            spdlog::error("Connector '{}' not found in DB or JSON storage", name);
-            co_return false;
+            dependencies.conditions.push_back(condition_name);
         }
+        co_return dependencies;
+    }
 
-        context.importing_connectors.insert(name);
-        const ConnectorRecord & connector_record = json_it->second;
-        const Connector & connector = connector_record.connector();
-
-        bool ok = true;
-
-        for(const auto & dimension : connector.dimensions())
-        {
-            for(const auto & transformation : dimension.transformations())
-            {
-                const std::string & transformation_name = transformation.name();
-                if(transformation_name.empty())
-                {
-                    continue;
-                }
-
-                spdlog::debug(
-                    "JSON import connector '{}' requires transformation '{}'",
-                    name,
-                    transformation_name);
-
-                if(!co_await ensureTransformationImported(
-                    evm,
-                    registry,
-                    transformation_name,
-                    storage_path,
-                    context))
-                {
-                    ok = false;
-                    break;
-                }
-
-                if(!co_await ensureTransformationDeployed(
-                    evm,
-                    registry,
-                    transformation_name,
-                    storage_path))
-                {
-                    ok = false;
-                    break;
-                }
-            }
+    asio::awaitable<bool> ensureConnectorDeployed(
+        evm::EVM & evm,
+        registry::Registry & registry,
+        const std::string & name,
+        const std::filesystem::path & storage_path)
+    {
+        ConnectorEnsureContext context;
+        context.connector_deploy_stack.reserve(64);
+        co_return co_await ensureConnectorDeployedImpl(evm, registry, name, storage_path, context);
+    }
 
-            if(!ok)
-            {
-                break;
-            }
+    asio::awaitable<bool> importJsonStorageToDatabase(
+        evm::EVM & evm,
+        registry::Registry & registry,
+        const std::filesystem::path & storage_path,
+        LoaderBatchConfig batch_config)
+    {
+        JsonImportContext context;
+        context.batch_config.connectors = normalizeBatchSize(batch_config.connectors);
+        context.batch_config.transformations = normalizeBatchSize(batch_config.transformations);
+        context.batch_config.conditions = normalizeBatchSize(batch_config.conditions);
+        context.batch_config.compile = normalizeBatchSize(batch_config.compile);
 
-            if(!dimension.composite().empty())
-            {
-                spdlog::debug(
-                    "JSON import connector '{}' requires composite connector '{}'",
-                    name,
-                    dimension.composite());
+        spdlog::debug(
+            "JSON storage import start: storage_path='{}', batch(connectors={}, transformations={}, conditions={}, compile={})",
+            storage_path.string(),
+            context.batch_config.connectors,
+            context.batch_config.transformations,
+            context.batch_config.conditions,
+            context.batch_config.compile);
 
-                if(!co_await ensureConnectorImported(
-                    evm,
-                    registry,
-                    dimension.composite(),
-                    storage_path,
-                    context))
-                {
-                    ok = false;
-                    break;
-                }
+        context.transformations = _loadJSONRecords<TransformationRecord>(storage_path / "transformations", batch_config.scan_threads);
+        context.conditions = _loadJSONRecords<ConditionRecord>(storage_path / "conditions", batch_config.scan_threads);
+        context.connectors = _loadJSONRecords<ConnectorRecord>(storage_path / "connectors", batch_config.scan_threads);
 
-                if(!co_await ensureConnectorDeployed(
-                    evm,
-                    registry,
-                    dimension.composite(),
-                    storage_path))
-                {
-                    ok = false;
-                    break;
-                }
-            }
+        context.pending_transformations.reserve(std::min<std::size_t>(context.batch_config.transformations, context.transformations.size()));
+        context.pending_conditions.reserve(std::min<std::size_t>(context.batch_config.conditions, context.conditions.size()));
+        context.pending_connectors.reserve(std::min<std::size_t>(context.batch_config.connectors, context.connectors.size()));
 
-            for(const auto & [_, binding_target] : dimension.bindings())
-            {
-                if(binding_target.empty())
-                {
-                    continue;
-                }
+        std::vector<std::string> transformation_names;
+        transformation_names.reserve(context.transformations.size());
+        for(const auto & [name, _] : context.transformations)
+        {
+            transformation_names.push_back(name);
+        }
+        std::ranges::sort(transformation_names);
 
-                spdlog::debug(
-                    "JSON import connector '{}' requires binding target connector '{}'",
-                    name,
-                    binding_target);
+        std::vector<std::string> condition_names;
+        condition_names.reserve(context.conditions.size());
+        for(const auto & [name, _] : context.conditions)
+        {
+            condition_names.push_back(name);
+        }
+        std::ranges::sort(condition_names);
 
-                if(!co_await ensureConnectorImported(
-                    evm,
-                    registry,
-                    binding_target,
-                    storage_path,
-                    context))
-                {
-                    ok = false;
-                    break;
-                }
+        std::vector<std::string> connector_names;
+        connector_names.reserve(context.connectors.size());
+        for(const auto & [name, _] : context.connectors)
+        {
+            connector_names.push_back(name);
+        }
+        std::ranges::sort(connector_names);
 
-                if(!co_await ensureConnectorDeployed(
-                    evm,
-                    registry,
-                    binding_target,
-                    storage_path))
-                {
-                    ok = false;
-                    break;
-                }
-            }
+        spdlog::debug(
+            "JSON storage import inventory: transformations={}, conditions={}, connectors={}",
+            transformation_names.size(),
+            condition_names.size(),
+            connector_names.size());
+        
+        spdlog::debug("JSON storage import trace logging active (debug level)");
 
-            if(!ok)
+        // Entities already in the DB are not redeployed here; connectors depending on them deploy them on demand.
+        DeployGraph graph;
+        for(const auto & name : transformation_names)
+        {
+            if(!co_await registry.hasTransformation(name))
             {
-                break;
+                graph.transformations.try_emplace(name, &context.transformations.at(name));
             }
         }
-
-        if(ok && !connector.condition_name().empty())
+        for(const auto & name : condition_names)
         {
-            spdlog::debug(
-                "JSON import connector '{}' requires condition '{}'",
-                name,
-                connector.condition_name());
-
-            if(!co_await ensureConditionImported(
-                evm,
-                registry,
-                connector.condition_name(),
-                storage_path,
-                context))
-            {
-                ok = false;
-            }
-            else if(!co_await ensureConditionDeployed(
-                evm,
-                registry,
-                connector.condition_name(),
-                storage_path))
+            if(!co_await registry.hasCondition(name))
             {
-                ok = false;
+                graph.conditions.try_emplace(name, &context.conditions.at(name));
             }
         }
-
-        if(ok)
+        for(const auto & name : connector_names)
         {
-            spdlog::debug("JSON import connector '{}': deploying from JSON", name);
-
-            const auto deploy_result = co_await deployConnector(
-                evm,
-                registry,
-                connector_record,
-                storage_path,
-                false,
-                false);
-            if(!deploy_result)
-            {
-                spdlog::error(
-                    "Failed to import connector '{}' from JSON into DB: {}",
-                    name,
-                    static_cast<int>(deploy_result.error().kind));
-                ok = false;
-            }
-            else
+            if(!co_await registry.hasConnector(name))
             {
-                spdlog::debug("JSON import connector '{}': deployed at {}", name, evmc::hex(deploy_result.value()));
-                
-                context.pending_connectors.emplace_back(deploy_result.value(), connector_record);
-                if(!co_await flushPendingConnectors(registry, context, false))
-                {
-                    ok = false;
-                }
+                graph.connectors.try_emplace(name, &context.connectors.at(name));
             }
         }
 
-        context.importing_connectors.erase(name);
+        spdlog::debug(
+            "JSON storage import missing from DB: transformations={}, conditions={}, connectors={}",
+            graph.transformations.size(),
+            graph.conditions.size(),
+            graph.connectors.size());
 
-        if(!ok)
+        bool success = false;
+        try
         {
-            spdlog::debug("JSON import ensure connector '{}': failed", name);
-            co_return false;
+            success = co_await _deployGraphInWaves(evm, registry, storage_path, graph, context);
+        }
+        catch(const std::exception & e)
+        {
+            spdlog::error("Unhandled exception while importing JSON storage: {}", e.what());
+        }
+        catch(...)
+        {
+            spdlog::error("Unhandled unknown exception while importing JSON storage");
         }
 
-        context.imported_connectors.insert(name);
-        spdlog::debug("JSON import ensure connector '{}': complete", name);
-
-        co_return true;
+        spdlog::debug("JSON storage import finished with status={}", success ? "success" : "failure");
+        co_return success;
     }
 
     asio::awaitable<bool> ensureConnectorDeployedImpl(
@@ -1954,7 +2105,12 @@ namespace dcn::loader
             co_return true;
         }
 
-        const auto record_handle_opt = co_await registry.getConnectorRecordHandle(name);
+        if(!context.connector_records.contains(name))
+        {
+            co_await prefetchConnectorGraph(registry, name, context);
+        }
+
+        const auto record_handle_opt = findPrefetchedRecord(context.connector_records, name);
         if(!record_handle_opt.has_value() || !(*record_handle_opt))
         {
             spdlog::error("Connector '{}' is missing in registry DB", name);
@@ -1981,11 +2137,12 @@ namespace dcn::loader
                     name,
                     transformation_name);
 
-                if(!co_await ensureTransformationDeployed(
+                if(!co_await ensureTransformationDeployedImpl(
                     evm,
                     registry,
                     transformation_name,
-                    storage_path))
+                    storage_path,
+                    &context))
                 {
                     ok = false;
                     break;
@@ -2053,11 +2210,12 @@ namespace dcn::loader
                 name,
                 connector.condition_name());
 
-            if(!co_await ensureConditionDeployed(
+            if(!co_await ensureConditionDeployedImpl(
                 evm,
                 registry,
                 connector.condition_name(),
-                storage_path))
+                storage_path,
+                &context))
             {
                 ok = false;
             }
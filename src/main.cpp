@@ -194,18 +194,30 @@ static std::vector<int> _configureShutdownSignals()
     return shutdown_signal_ids;
 }
 
-static asio::awaitable<void> _runStartupAndListen(
+static asio::awaitable<void> _runStartupImport(
     dcn::registry::Registry & registry,
     dcn::evm::EVM & evm,
-    dcn::server::Server & server,
     const dcn::config::Config & cfg)
 {
     const dcn::loader::LoaderBatchConfig loader_batch_config{
         .connectors = cfg.loader_batch_connectors,
         .transformations = cfg.loader_batch_transformations,
-        .conditions = cfg.loader_batch_conditions
+        .conditions = cfg.loader_batch_conditions,
+        .compile = cfg.loader_batch_compile,
+        .scan_threads = cfg.loader_scan_threads
     };
 
+    co_await evm.waitReady();
+
+    if(!cfg.registry_snapshot_import.empty())
+    {
+        spdlog::info("Importing registry snapshot {}...", cfg.registry_snapshot_import.string());
+        if(!co_await registry.importSnapshot(cfg.registry_snapshot_import))
+        {
+            spdlog::warn("Registry snapshot import failed; continuing with JSON storage import");
+        }
+    }
+
     spdlog::info("Starting JSON storage import...");
 
     const bool import_success = co_await dcn::loader::importJsonStorageToDatabase(
@@ -223,6 +235,54 @@ static asio::awaitable<void> _runStartupAndListen(
         spdlog::info("JSON storage import finished");
     }
 
+    if(!cfg.registry_snapshot_export.empty() && !co_await registry.exportSnapshot(cfg.registry_snapshot_export))
+    {
+        spdlog::warn("Registry snapshot export to {} failed", cfg.registry_snapshot_export.string());
+    }
+}
+
+static asio::awaitable<void> _runStartupAndListen(
+    dcn::registry::Registry & registry,
+    dcn::evm::EVM & evm,
+    dcn::loader::LazyDeployer & deployer,
+    dcn::server::Server & server,
+    const dcn::config::Config & cfg)
+{
+    if(cfg.lazy_start)
+    {
+        // The import deploys the stored graph itself, so on-demand deployments wait for it; the warmer then
+        // deploys the rest, most used first.
+        co_await deployer.hold();
+        asio::co_spawn(
+            co_await asio::this_coro::executor,
+            [&registry, &evm, &deployer, &cfg]() -> asio::awaitable<void>
+            {
+                std::exception_ptr import_exception;
+                try
+                {
+                    co_await _runStartupImport(registry, evm, cfg);
+                }
+                catch(...)
+                {
+                    import_exception = std::current_exception();
+                }
+                co_await deployer.resume();
+                if(import_exception)
+                {
+                    std::rethrow_exception(import_exception);
+                }
+                co_await deployer.warm();
+            },
+            [](std::exception_ptr exception_ptr)
+            {
+                dcn::utils::logException(exception_ptr, "Background startup import failed");
+            });
+    }
+    else
+    {
+        co_await _runStartupImport(registry, evm, cfg);
+    }
+
     if(cfg.chain_ingestion.enabled)
     {
         //asio::co_spawn(io_context, dcn::chain::runEventIngestion(chain_ingestion_cfg, registry), asio::detached);
@@ -238,7 +298,9 @@ static asio::awaitable<void> _runGracefulShutdown(
     std::atomic<bool> & wal_sync_worker_stopped,
     dcn::registry::Registry & registry,
     bool wal_enabled,
-    dcn::events::EventRuntime & events_runtime)
+    dcn::events::EventRuntime & events_runtime,
+    dcn::evm::EVM & evm,
+    dcn::loader::LazyDeployer & deployer)
 {
     spdlog::info("Decentralised Art server stopping...");
     co_await events_runtime.stop();
@@ -246,6 +308,22 @@ static asio::awaitable<void> _runGracefulShutdown(
     co_await server.close();
     spdlog::info("Decentralised Art server close requested");
 
+    deployer.stop();
+    if(!deployer.saveAccessStats())
+    {
+        spdlog::warn("Failed to save connector access stats on shutdown");
+    }
+
+    if(!co_await evm.close())
+    {
+        spdlog::warn("Failed to write the EVM snapshot on shutdown");
+    }
+
+    if(!dcn::storage::pack::PackStore::syncAll())
+    {
+        spdlog::warn("Failed to sync record packs on shutdown");
+    }
+
     if(wal_sync_worker != std::nullopt)
     {
         spdlog::info("Requesting registry WAL sync worker stop...");
@@ -272,6 +350,40 @@ static asio::awaitable<void> _runGracefulShutdown(
         spdlog::info("Registry WAL sync worker stopped");
     }
 
+    for(const dcn::registry::HotCacheStats & cache_stats : registry.cacheStats())
+    {
+        spdlog::info(
+            "Registry cache [{}]: hits={} misses={} evictions={} rejected={} entries={} bytes={}/{}",
+            cache_stats.name,
+            cache_stats.hits,
+            cache_stats.misses,
+            cache_stats.evictions,
+            cache_stats.rejected_admissions,
+            cache_stats.entries,
+            cache_stats.bytes,
+            cache_stats.capacity_bytes);
+    }
+
+    for(const dcn::registry::NameFilterStats & filter_stats : registry.filterStats())
+    {
+        spdlog::info(
+            "Registry name filter [{}]: names={} capacity={} memory_bytes={} estimated_fp_rate={:.5f} probes={} definite_negatives={}",
+            filter_stats.name,
+            filter_stats.inserted,
+            filter_stats.capacity,
+            filter_stats.memory_bytes,
+            filter_stats.estimated_false_positive_rate,
+            filter_stats.probes,
+            filter_stats.definite_negatives);
+    }
+
+    const dcn::registry::ScalarLabelIndexStats label_index_stats = registry.labelIndexStats();
+    spdlog::info(
+        "Registry scalar label index: formats={} labels={} posting_bytes={}",
+        label_index_stats.formats,
+        label_index_stats.labels,
+        label_index_stats.memory_bytes);
+
     if(wal_enabled)
     {
         spdlog::info("Running final registry WAL truncate checkpoint...");
@@ -296,6 +408,11 @@ static void _runImmediateShutdown(
     events_runtime.requestStop();
     spdlog::info("Events runtime stop requested");
 
+    if(!dcn::storage::pack::PackStore::syncAll())
+    {
+        spdlog::warn("Failed to sync record packs on shutdown");
+    }
+
     if(wal_sync_worker)
     {
         spdlog::info("Registry WAL sync worker stopping...");
@@ -353,18 +470,35 @@ int main(int argc, char* argv[])
     arg_parser.addArg<unsigned int>("--chain-batch-size", "Max number of blocks fetched per eth_getLogs request");
     arg_parser.addArg<bool>("--chain-local-source", "Use in-process EVM as chain event source (no RPC)");
     arg_parser.addArg<std::filesystem::path>("--registry-db", "SQLite path for registry storage");
+    arg_parser.addArg<std::filesystem::path>("--registry-snapshot-import", "Bootstrap an empty registry from a binary snapshot before the JSON import");
+    arg_parser.addArg<std::filesystem::path>("--registry-snapshot-export", "Write a binary registry snapshot once the startup import finishes");
     arg_parser.addArg<unsigned int>("--registry-wal-sync-ms", "Interval in milliseconds for periodic SQLite WAL passive checkpoints");
+    arg_parser.addArg<unsigned int>("--registry-cache-mb", "Memory budget in MiB shared by the registry record caches");
+    arg_parser.addArg<unsigned int>("--registry-group-commit-window-us", "Microseconds a single registry add waits to share a store transaction");
+    arg_parser.addArg<unsigned int>("--registry-group-commit-max-batch", "Max single registry adds per group commit (1 disables group commit)");
     arg_parser.addArg<std::filesystem::path>("--events-db", "SQLite path for events hot storage");
     arg_parser.addArg<std::filesystem::path>("--events-archive-root", "Directory for archived monthly events shards");
     arg_parser.addArg<unsigned int>("--events-chain-id", "Chain id used for events ingestion and feed projection");
     arg_parser.addArg<unsigned int>("--events-hot-window-days", "Retention window in days for hot events storage");
-    arg_parser.addArg<unsigned int>("--events-projector-ms", "Interval in milliseconds for projector loop when idle");
+    arg_parser.addArg<unsigned int>("--events-projection-grace-ms", "Age in milliseconds before unprojected jobs are swept by maintenance");
+    arg_parser.addArg<unsigned int>("--events-projector-ms", "Deprecated and ignored; the projector runs as soon as ingested events commit");
     arg_parser.addArg<unsigned int>("--events-archive-ms", "Interval in milliseconds for archive maintenance loop");
+    arg_parser.addArg<unsigned int>("--events-archive-threads", "Number of background threads exporting archive shards");
     arg_parser.addArg<unsigned int>("--events-reorg-window-blocks", "Rolling block window size for reorg reconciliation");
     arg_parser.addArg<unsigned int>("--events-outbox-retention-days", "Retention window in days for replay outbox rows");
+    arg_parser.addArg<unsigned int>("--solc-max-jobs", "Max solc processes compiling at once (0 uses half of the hardware threads)");
+    arg_parser.addArg<unsigned int>("--solc-timeout-ms", "Milliseconds after which a solc run is killed (0 disables the limit)");
+    arg_parser.addArg<std::filesystem::path>("--solc-cache-dir", "Content-addressed solc artifact cache, shareable between nodes (empty disables it)");
+    arg_parser.addArg<unsigned int>("--solc-cache-mb", "Size limit in MiB of the solc artifact cache");
+    arg_parser.addArg<bool>("--lazy-start", "Listen right away and deploy stored connectors on first use or in the background");
+    arg_parser.addArg<std::filesystem::path>("--evm-snapshot", "EVM state snapshot restored at startup instead of redeploying PT (empty disables it)");
+    arg_parser.addArg<unsigned int>("--evm-snapshot-interval-ms", "Interval in milliseconds for writing the EVM snapshot while the state changes (0 writes only on shutdown)");
+    arg_parser.addArg<unsigned int>("--evm-executors", "Threads running /execute calls in parallel over a shared EVM state (default 0 runs them all on the EVM strand)");
     arg_parser.addArg<unsigned int>("--loader-batch-connectors", "Batch size used while adding loaded connectors to registry");
     arg_parser.addArg<unsigned int>("--loader-batch-transformations", "Batch size used while adding loaded transformations to registry");
     arg_parser.addArg<unsigned int>("--loader-batch-conditions", "Batch size used while adding loaded conditions to registry");
+    arg_parser.addArg<unsigned int>("--loader-batch-compile", "Generated sources compiled per solc --standard-json run while loading stored entities");
+    arg_parser.addArg<unsigned int>("--loader-scan-threads", "Threads reading the JSON storage at startup (0 uses every hardware thread)");
 
     arg_parser.parse(argc, argv);
 
@@ -437,15 +571,39 @@ int main(int argc, char* argv[])
     cfg.loader_batch_connectors = arg_parser.getArg<unsigned int>("--loader-batch-connectors").value_or(1000);
     cfg.loader_batch_transformations = arg_parser.getArg<unsigned int>("--loader-batch-transformations").value_or(5000);
     cfg.loader_batch_conditions = arg_parser.getArg<unsigned int>("--loader-batch-conditions").value_or(5000);
+    cfg.loader_batch_compile = arg_parser.getArg<unsigned int>("--loader-batch-compile").value_or(128);
+    cfg.loader_scan_threads = arg_parser.getArg<unsigned int>("--loader-scan-threads").value_or(0);
+
+    cfg.solc_max_jobs = arg_parser.getArg<unsigned int>("--solc-max-jobs").value_or(0);
+    cfg.solc_timeout_ms = arg_parser.getArg<unsigned int>("--solc-timeout-ms").value_or(120000);
+    cfg.solc_cache_mb = arg_parser.getArg<unsigned int>("--solc-cache-mb").value_or(512);
+    cfg.solc_cache_dir = arg_parser.getArg<std::filesystem::path>("--solc-cache-dir").value_or(
+        cfg.storage_path / "solc_cache"
+    );
+
+    cfg.evm_snapshot_path = arg_parser.getArg<std::filesystem::path>("--evm-snapshot").value_or(
+        cfg.storage_path / "evm_state.snapshot"
+    );
+    cfg.evm_snapshot_interval_ms = arg_parser.getArg<unsigned int>("--evm-snapshot-interval-ms").value_or(300000);
+    cfg.evm_executors = arg_parser.getArg<unsigned int>("--evm-executors").value_or(0);
+
+    cfg.lazy_start = arg_parser.getArg<bool>("--lazy-start").value_or(false);
 
     cfg.registry_wal_sync_ms = arg_parser.getArg<unsigned int>("--registry-wal-sync-ms").value_or(30000);
 
+    cfg.registry_cache_mb = arg_parser.getArg<unsigned int>("--registry-cache-mb").value_or(96);
+    cfg.registry_group_commit_window_us = arg_parser.getArg<unsigned int>("--registry-group-commit-window-us").value_or(2000);
+    cfg.registry_group_commit_max_batch = arg_parser.getArg<unsigned int>("--registry-group-commit-max-batch").value_or(64);
+
     const std::chrono::milliseconds registry_wal_sync_interval(cfg.registry_wal_sync_ms);
 
     cfg.registry_db = arg_parser.getArg<std::filesystem::path>("--registry-db").value_or(
         cfg.storage_path / "registry.sqlite"
     );
 
+    cfg.registry_snapshot_import = arg_parser.getArg<std::filesystem::path>("--registry-snapshot-import").value_or("");
+    cfg.registry_snapshot_export = arg_parser.getArg<std::filesystem::path>("--registry-snapshot-export").value_or("");
+
     cfg.events_db = arg_parser.getArg<std::filesystem::path>("--events-db").value_or(
         cfg.storage_path / "events" / "events_hot.sqlite"
     );
@@ -454,8 +612,13 @@ int main(int argc, char* argv[])
     );
     cfg.events_chain_id = arg_parser.getArg<unsigned int>("--events-chain-id").value_or(1);
     cfg.events_hot_window_days = arg_parser.getArg<unsigned int>("--events-hot-window-days").value_or(90);
-    cfg.events_projector_interval_ms = arg_parser.getArg<unsigned int>("--events-projector-ms").value_or(200);
+    cfg.events_projection_grace_ms = arg_parser.getArg<unsigned int>("--events-projection-grace-ms").value_or(5000);
+    if(arg_parser.getArg<unsigned int>("--events-projector-ms").has_value())
+    {
+        spdlog::warn("--events-projector-ms is deprecated and ignored: the events projector no longer polls");
+    }
     cfg.events_archive_interval_ms = arg_parser.getArg<unsigned int>("--events-archive-ms").value_or(30000);
+    cfg.events_archive_export_threads = arg_parser.getArg<unsigned int>("--events-archive-threads").value_or(2);
     cfg.events_reorg_window_blocks = arg_parser.getArg<unsigned int>("--events-reorg-window-blocks").value_or(2048);
     cfg.events_outbox_retention_days = arg_parser.getArg<unsigned int>("--events-outbox-retention-days").value_or(7);
 
@@ -482,11 +645,50 @@ int main(int argc, char* argv[])
 
     asio::io_context io_context;
 
-    dcn::registry::Registry registry(io_context, cfg.registry_db.string());
+    dcn::registry::Registry registry(
+        io_context,
+        cfg.registry_db.string(),
+        dcn::registry::makeRegistryCacheConfig(static_cast<std::size_t>(cfg.registry_cache_mb) * 1024 * 1024),
+        dcn::registry::RegistryWriteConfig{
+            .group_commit_window = std::chrono::microseconds(cfg.registry_group_commit_window_us),
+            .group_commit_max_batch = cfg.registry_group_commit_max_batch
+        });
 
     dcn::auth::AuthManager auth_manager(io_context);
 
-    dcn::evm::EVM evm(io_context, EVMC_SHANGHAI, solc_path, pt_path);
+    dcn::evm::EVM evm(
+        io_context,
+        EVMC_SHANGHAI,
+        solc_path,
+        pt_path,
+        dcn::evm::CompileServiceConfig{
+            .max_concurrent_jobs = cfg.solc_max_jobs,
+            .job_timeout = std::chrono::milliseconds(cfg.solc_timeout_ms)
+        },
+        dcn::evm::CompileCacheConfig{
+            .root = cfg.solc_cache_dir,
+            .max_bytes = static_cast<std::uint64_t>(cfg.solc_cache_mb) * 1024 * 1024
+        },
+        dcn::evm::StateSnapshotConfig{
+            .path = cfg.evm_snapshot_path,
+            .interval = std::chrono::milliseconds(cfg.evm_snapshot_interval_ms),
+            .tag = [&registry]() -> asio::awaitable<std::string>
+            {
+                co_return co_await dcn::loader::makeStateSnapshotTag(registry);
+            }
+        },
+        dcn::evm::ExecutionPoolConfig{
+            .executors = cfg.evm_executors
+        });
+
+    dcn::loader::LazyDeployer deployer(
+        io_context,
+        evm,
+        registry,
+        dcn::loader::LazyDeployerConfig{
+            .storage_path = cfg.storage_path,
+            .access_stats_path = cfg.storage_path / "connector_access.json"
+        });
 
     dcn::server::Server server(io_context, {asio::ip::tcp::v4(), asio::ip::port_type(cfg.port)});
 
@@ -512,8 +714,9 @@ int main(int argc, char* argv[])
             .hot_window_days = static_cast<std::size_t>(cfg.events_hot_window_days),
             .reorg_window_blocks = static_cast<std::size_t>(cfg.events_reorg_window_blocks),
             .outbox_retention_ms = static_cast<std::int64_t>(cfg.events_outbox_retention_days) * 24LL * 60LL * 60LL * 1000LL,
-            .projector_interval_ms = cfg.events_projector_interval_ms,
-            .archive_interval_ms = cfg.events_archive_interval_ms
+            .projection_job_grace_ms = cfg.events_projection_grace_ms,
+            .archive_interval_ms = cfg.events_archive_interval_ms,
+            .archive_export_threads = cfg.events_archive_export_threads
         });
     
     const auto favicon = dcn::file::loadBinaryFile(cfg.resources_path / "media" / "img" / "favicon.svg");
@@ -593,6 +796,8 @@ int main(int argc, char* argv[])
     server.addRoute({dcn::http::Method::OPTIONS, "/formats?limit=<uint>&after=<~string>"}, dcn::OPTIONS_formats);
     server.addRoute({dcn::http::Method::HEAD, "/formats?limit=<uint>&after=<~string>"}, dcn::HEAD_formats, std::ref(registry));
     server.addRoute({dcn::http::Method::GET, "/formats?limit=<uint>&after=<~string>"}, dcn::GET_formats, std::ref(registry));
+    server.addRoute({dcn::http::Method::OPTIONS, "/formats/search?labels=<string>&limit=<uint>&min_shared=<~uint>"}, dcn::OPTIONS_formatsSearch);
+    server.addRoute({dcn::http::Method::GET, "/formats/search?labels=<string>&limit=<uint>&min_shared=<~uint>"}, dcn::GET_formatsSearch, std::ref(registry));
     server.addRoute({dcn::http::Method::OPTIONS, "/format/<string>?limit=<uint>&after=<~string>"}, dcn::OPTIONS_format);
     server.addRoute({dcn::http::Method::GET, "/format/<string>?limit=<uint>&after=<~string>"}, dcn::GET_format, std::ref(registry));
 
@@ -620,7 +825,7 @@ int main(int argc, char* argv[])
     server.addRoute({dcn::http::Method::POST,    "/condition"},                    dcn::POST_condition, std::ref(auth_manager), std::ref(registry), std::ref(evm), std::cref(cfg));
 
     server.addRoute({dcn::http::Method::OPTIONS, "/execute"},   dcn::OPTIONS_execute);
-    server.addRoute({dcn::http::Method::POST, "/execute"},      dcn::POST_execute, std::cref(auth_manager), std::ref(registry), std::ref(evm), std::cref(cfg));
+    server.addRoute({dcn::http::Method::POST, "/execute"},      dcn::POST_execute, std::cref(auth_manager), std::ref(registry), std::ref(evm), std::ref(deployer), std::cref(cfg));
 
     if(!dcn::loader::ensurePTBuildVersion(cfg.storage_path))
     {
@@ -672,6 +877,8 @@ int main(int argc, char* argv[])
          &wal_sync_worker_stopped,
          &registry,
          &events_runtime,
+         &evm,
+         &deployer,
          wal_enabled]() -> asio::awaitable<void>
         {
             return _runGracefulShutdown(
@@ -680,7 +887,9 @@ int main(int argc, char* argv[])
                 wal_sync_worker_stopped,
                 registry,
                 wal_enabled,
-                events_runtime);
+                events_runtime,
+                evm,
+                deployer);
         },
 
         // immediate shutdown
@@ -697,6 +906,7 @@ int main(int argc, char* argv[])
         _runStartupAndListen(
             registry,
             evm,
+            deployer,
             server,
             cfg),
         [&io_context](std::exception_ptr exception_ptr)
@@ -10,7 +10,12 @@
 #   error "Error, unsupported platform"
 #endif
 
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace dcn::native
@@ -32,4 +37,90 @@ namespace dcn::native
      * @param args The arguments to pass to the command
      */
     std::pair<int, std::string> runProcess(const std::string & command, std::vector<std::string> args = {});
+
+    /**
+     * Read-only view of a whole file mapped into memory, unmapped on destruction.
+     * An empty file maps to an empty view.
+     */
+    class MappedFile
+    {
+        public:
+            MappedFile() = default;
+            ~MappedFile();
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            MappedFile(MappedFile && other) noexcept
+                : _view(std::exchange(other._view, nullptr)), _size(std::exchange(other._size, 0))
+            {
+            }
+
+            MappedFile& operator=(MappedFile && other) noexcept
+            {
+                std::swap(_view, other._view);
+                std::swap(_size, other._size);
+                return *this;
+            }
+
+            const std::uint8_t * data() const { return static_cast<const std::uint8_t *>(_view); }
+            std::size_t size() const { return _size; }
+
+        private:
+            friend std::optional<MappedFile> mapFile(const std::filesystem::path & path);
+
+            void * _view = nullptr;
+            std::size_t _size = 0;
+    };
+
+    /**
+     * Maps `path` read-only.
+     *
+     * @return The mapping, or std::nullopt when the file cannot be opened or mapped.
+     */
+    std::optional<MappedFile> mapFile(const std::filesystem::path & path);
+
+    /**
+     * Flushes the contents of `path` to stable storage.
+     *
+     * @return false when the file cannot be opened or the flush fails.
+     */
+    bool syncFile(const std::filesystem::path & path);
+
+#if !defined(WIN32)
+    struct ChildProcess
+    {
+        pid_t pid = -1;
+        // Read end of the pipe carrying the child's stdout and stderr; owned by the caller.
+        int output_fd = -1;
+    };
+
+    /**
+     * Spawns a new process without waiting for it.
+     * Unlike runProcess the caller drives the output pipe and must reap the child with tryReapProcess.
+     *
+     * @param command The command to execute in the new process
+     * @param args The arguments to pass to the command
+     */
+    ChildProcess spawnProcess(const std::string & command, std::vector<std::string> args = {});
+
+    /**
+     * Reaps the child if it has exited, without blocking.
+     *
+     * @return The exit code (-1 when killed by a signal), or std::nullopt while the child is still running.
+     */
+    std::optional<int> tryReapProcess(pid_t pid);
+
+    /**
+     * Opens a descriptor that becomes readable once the child exits, so its exit can be awaited instead of polled.
+     *
+     * @return The descriptor, owned by the caller, or -1 where the platform has none.
+     */
+    int openProcessExitHandle(pid_t pid);
+
+    /**
+     * Sends SIGKILL to a child that has not been reaped yet.
+     */
+    void killProcess(pid_t pid);
+#endif
 }
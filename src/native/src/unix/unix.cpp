@@ -1,6 +1,10 @@
-#include "unix/unix.h"
+#include "native.h"
 
 #include <clocale>
+#include <csignal>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
 #include <spdlog/spdlog.h>
 
 namespace dcn::native {
@@ -87,4 +91,151 @@ namespace dcn::native {
 
         return {exit_code, output};
     }
+
+    ChildProcess spawnProcess(const std::string& command, std::vector<std::string> args)
+    {
+        const bool has_path_separator = command.find('/') != std::string::npos;
+        if (has_path_separator && access(command.c_str(), X_OK) != 0)
+        {
+            throw std::runtime_error("Command not executable: " + command);
+        }
+
+        std::vector<char*> argv;
+        argv.reserve(args.size() + 2);
+        argv.push_back(const_cast<char*>(command.c_str()));
+
+        for (const auto& arg : args)
+        {
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        // Children forked concurrently by other workers must not inherit either end, otherwise
+        // the read end would not see EOF until those unrelated children exit as well. The flag is
+        // set atomically with the pipe so no fork can slip in between.
+        int pipefd[2];
+        if (pipe2(pipefd, O_CLOEXEC) == -1)
+        {
+            spdlog::error("Failed to create pipe");
+            throw std::runtime_error("Failed to create pipe");
+        }
+
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            close(pipefd[0]);
+            close(pipefd[1]);
+            spdlog::error("Failed to fork");
+            throw std::runtime_error("Failed to fork");
+        }
+
+        if (pid == 0)
+        {
+            // Child process; dup2 clears FD_CLOEXEC on the redirected descriptors
+            dup2(pipefd[1], STDOUT_FILENO);
+            dup2(pipefd[1], STDERR_FILENO);
+
+            execvp(command.c_str(), argv.data());
+            _exit(127);
+        }
+
+        close(pipefd[1]);
+        return ChildProcess{.pid = pid, .output_fd = pipefd[0]};
+    }
+
+    std::optional<int> tryReapProcess(pid_t pid)
+    {
+        int status = 0;
+        const pid_t result = waitpid(pid, &status, WNOHANG);
+        if (result == 0)
+        {
+            return std::nullopt;
+        }
+
+        if (result == -1)
+        {
+            if (errno == EINTR)
+            {
+                return std::nullopt;
+            }
+            spdlog::error("waitpid failed for pid {}: {}", pid, strerror(errno));
+            return -1;
+        }
+
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+
+    int openProcessExitHandle(pid_t pid)
+    {
+#if defined(SYS_pidfd_open)
+        // Fails with ENOSYS on kernels older than 5.3.
+        return static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+#else
+        (void)pid;
+        return -1;
+#endif
+    }
+
+    void killProcess(pid_t pid)
+    {
+        if (pid > 0)
+        {
+            kill(pid, SIGKILL);
+        }
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (_view != nullptr)
+        {
+            munmap(_view, _size);
+        }
+    }
+
+    std::optional<MappedFile> mapFile(const std::filesystem::path & path)
+    {
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1)
+        {
+            return std::nullopt;
+        }
+
+        struct stat file_stat{};
+        if (fstat(fd, &file_stat) == -1)
+        {
+            spdlog::error("fstat failed for '{}': {}", path.string(), strerror(errno));
+            close(fd);
+            return std::nullopt;
+        }
+
+        MappedFile mapped;
+        if (file_stat.st_size > 0)
+        {
+            void * view = mmap(nullptr, static_cast<std::size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view == MAP_FAILED)
+            {
+                spdlog::error("mmap failed for '{}': {}", path.string(), strerror(errno));
+                close(fd);
+                return std::nullopt;
+            }
+            mapped._view = view;
+            mapped._size = static_cast<std::size_t>(file_stat.st_size);
+        }
+
+        // The mapping stays valid after the descriptor is closed.
+        close(fd);
+        return mapped;
+    }
+
+    bool syncFile(const std::filesystem::path & path)
+    {
+        const int fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+        if (fd == -1)
+        {
+            return false;
+        }
+        const bool synced = fsync(fd) == 0;
+        close(fd);
+        return synced;
+    }
 } // namespace dcn::native
@@ -1,4 +1,4 @@
-#include "windows/windows.h"
+#include "native.h"
 
 #include <vector>
 
@@ -151,4 +151,70 @@ namespace dcn::native{
 
         return {static_cast<int>(exit_code), output};
     }
+
+    MappedFile::~MappedFile()
+    {
+        if (_view != nullptr)
+        {
+            UnmapViewOfFile(_view);
+        }
+    }
+
+    std::optional<MappedFile> mapFile(const std::filesystem::path & path)
+    {
+        const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return std::nullopt;
+        }
+
+        LARGE_INTEGER file_size{};
+        if (!GetFileSizeEx(file, &file_size))
+        {
+            spdlog::error("GetFileSizeEx failed for '{}': {}", path.string(), GetLastError());
+            CloseHandle(file);
+            return std::nullopt;
+        }
+
+        MappedFile mapped;
+        if (file_size.QuadPart > 0)
+        {
+            const HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mapping == NULL)
+            {
+                spdlog::error("CreateFileMapping failed for '{}': {}", path.string(), GetLastError());
+                CloseHandle(file);
+                return std::nullopt;
+            }
+
+            void * view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+            if (view == NULL)
+            {
+                spdlog::error("MapViewOfFile failed for '{}': {}", path.string(), GetLastError());
+                CloseHandle(file);
+                return std::nullopt;
+            }
+            mapped._view = view;
+            mapped._size = static_cast<std::size_t>(file_size.QuadPart);
+        }
+
+        // The view keeps the mapping alive once the handles are closed.
+        CloseHandle(file);
+        return mapped;
+    }
+
+    bool syncFile(const std::filesystem::path & path)
+    {
+        const HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+            NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        const bool synced = FlushFileBuffers(file) != 0;
+        CloseHandle(file);
+        return synced;
+    }
 }
@@ -1,9 +1,10 @@
 #pragma once
 
 #include <cstdint>
-#include <list>
+#include <filesystem>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -15,6 +16,10 @@
 #include "pt.hpp"
 #include "address.hpp"
 #include "format_hash.hpp"
+#include "registry_cache.hpp"
+#include "registry_filter.hpp"
+#include "registry_group_commit.hpp"
+#include "registry_label_index.hpp"
 #include "registry_store.hpp"
 #include "sqlite_registry_store.hpp"
 #include "sqlite/wal_store.hpp"
@@ -23,26 +28,15 @@ namespace dcn::registry
 {
     using ScalarLabel = dcn::chain::ScalarLabel;
 
-    template<typename KeyT, typename ValueT>
-    struct LruCache
-    {
-        struct Entry
-        {
-            ValueT value;
-            typename std::list<KeyT>::iterator order_it;
-        };
-
-        const char * name = "unnamed-cache";
-        std::size_t capacity = 0;
-        std::list<KeyT> order;
-        absl::flat_hash_map<KeyT, Entry> entries;
-    };
-
     class Registry : public storage::sqlite::IWalStore
     {
         public:
             Registry() = delete;
-            Registry(asio::io_context & io_context, std::string sqlite_path = ":memory:");
+            Registry(
+                asio::io_context & io_context,
+                std::string sqlite_path = ":memory:",
+                RegistryCacheConfig cache_config = {},
+                RegistryWriteConfig write_config = {});
 
             Registry(const Registry&) = delete;
             Registry& operator=(const Registry&) = delete;
@@ -61,6 +55,11 @@ namespace dcn::registry
             asio::awaitable<std::optional<ConnectorRecordHandle>> getConnectorRecordHandle(
                 const std::string & name) const;
 
+            // Batched lookup: cache hits are served directly and all misses are fetched in one store
+            // round trip. Results follow input order; nullopt marks a missing name.
+            asio::awaitable<std::vector<std::optional<ConnectorRecordHandle>>> getConnectorRecordHandles(
+                std::span<const std::string> names) const;
+
             asio::awaitable<bool> hasConnector(const std::string & name) const;
 
             asio::awaitable<std::optional<evmc::bytes32>> getFormatHash(const std::string& name) const;
@@ -80,6 +79,12 @@ namespace dcn::registry
 
             asio::awaitable<std::optional<std::vector<ScalarLabel>>> getScalarLabelsByFormatHash(const evmc::bytes32 & format_hash) const;
 
+            // Formats sharing at least `min_shared` of the given `scalar:tail_id` labels, served from memory.
+            asio::awaitable<FormatSearchResult> searchFormatsByScalarLabels(
+                std::vector<std::string> labels,
+                std::size_t min_shared,
+                std::size_t limit) const;
+
             asio::awaitable<bool> addTransformation(chain::Address address, TransformationRecord transformation);
             asio::awaitable<bool> addTransformationsBatch(
                 std::vector<std::pair<chain::Address, TransformationRecord>> transformations,
@@ -88,6 +93,9 @@ namespace dcn::registry
             asio::awaitable<std::optional<TransformationRecordHandle>> getTransformationRecordHandle(
                 const std::string & name) const;
 
+            asio::awaitable<std::vector<std::optional<TransformationRecordHandle>>> getTransformationRecordHandles(
+                std::span<const std::string> names) const;
+
             asio::awaitable<bool> hasTransformation(const std::string & name) const;
 
             asio::awaitable<bool> addCondition(chain::Address address, ConditionRecord condition);
@@ -99,6 +107,9 @@ namespace dcn::registry
             asio::awaitable<std::optional<ConditionRecordHandle>> getConditionRecordHandle(
                 const std::string & name) const;
 
+            asio::awaitable<std::vector<std::optional<ConditionRecordHandle>>> getConditionRecordHandles(
+                std::span<const std::string> names) const;
+
             asio::awaitable<bool> hasCondition(const std::string & name) const;
 
             asio::awaitable<NameCursorPage> getOwnedConnectorsCursor(
@@ -118,21 +129,83 @@ namespace dcn::registry
 
             asio::awaitable<std::size_t> getAccountsCount() const;
 
+            asio::awaitable<std::size_t> getConnectorsCount() const;
+            asio::awaitable<std::size_t> getTransformationsCount() const;
+            asio::awaitable<std::size_t> getConditionsCount() const;
+
+            // See IRegistryStore::getWriteMarker.
+            asio::awaitable<std::string> getWriteMarker() const;
+
+            // Every stored connector name, unordered.
+            asio::awaitable<std::vector<std::string>> getConnectorNames() const;
+
             asio::awaitable<NameCursorPage> getAccountsCursor(
                 const std::optional<chain::Address> & after,
                 std::size_t limit) const;
 
             asio::awaitable<storage::sqlite::WalCheckpointStats> checkpointWal(storage::sqlite::WalCheckpointMode mode) const override;
 
-        private:
-            static constexpr std::size_t kHotCacheCapacity = 1024;
+            std::vector<HotCacheStats> cacheStats() const;
+
+            std::vector<NameFilterStats> filterStats() const;
 
+            ScalarLabelIndexStats labelIndexStats() const;
+
+            // Writes a consistent binary snapshot of the whole registry; see IRegistryStore::exportSnapshot.
+            asio::awaitable<bool> exportSnapshot(std::filesystem::path path) const;
+
+            // Loads a snapshot into an empty registry and refreshes filters, label index and caches.
+            // Meant for bootstrap: lookups racing the import may miss names until the filters are rebuilt.
+            asio::awaitable<bool> importSnapshot(std::filesystem::path path);
+
+        private:
+            void _rebuildFilter(
+                NameFilter & filter,
+                std::size_t (IRegistryStore::*count_names)() const,
+                bool (IRegistryStore::*for_each_name)(const NameVisitor &) const);
+
+            // Rebuilds every filter, or with `only_if_full` just those that outgrew their capacity.
+            // Must run on the strand once the registry is live.
+            void _rebuildFilters(bool only_if_full);
+
+            // Store one batch, keep filters and caches in step, and report per-item insertion.
+            bool _commitConnectors(
+                std::vector<ConnectorBatchItem> & items,
+                bool all_or_nothing,
+                std::vector<bool> & inserted_items);
+            bool _commitTransformations(
+                std::vector<TransformationBatchItem> & items,
+                bool all_or_nothing,
+                std::vector<bool> & inserted_items);
+            bool _commitConditions(
+                std::vector<ConditionBatchItem> & items,
+                bool all_or_nothing,
+                std::vector<bool> & inserted_items);
+
+            // Commits queued adds that `connector` validates against, so validation sees them in the store.
+            void _flushPendingDependencies(const Connector & connector);
+
+            // Serializes writes only; reads run on the caller's executor against the sharded caches
+            // and the store's read connections.
             asio::strand<asio::io_context::executor_type> _strand;
             std::unique_ptr<IRegistryStore> _store;
-            mutable LruCache<std::string, std::optional<ConnectorRecordHandle>> _connector_record_cache;
-            mutable LruCache<std::string, std::optional<evmc::bytes32>> _format_hash_cache;
-            mutable LruCache<std::string, std::optional<TransformationRecordHandle>> _transformation_record_cache;
-            mutable LruCache<std::string, std::optional<ConditionRecordHandle>> _condition_record_cache;
+            mutable ShardedHotCache<std::string, std::optional<ConnectorRecordHandle>> _connector_record_cache;
+            mutable ShardedHotCache<std::string, std::optional<evmc::bytes32>> _format_hash_cache;
+            mutable ShardedHotCache<std::string, std::optional<TransformationRecordHandle>> _transformation_record_cache;
+            mutable ShardedHotCache<std::string, std::optional<ConditionRecordHandle>> _condition_record_cache;
+
+            // Definite-absence checks answered before the caches and the store.
+            NameFilter _connector_filter{"connector"};
+            NameFilter _transformation_filter{"transformation"};
+            NameFilter _condition_filter{"condition"};
+
+            // Scalar label -> formats postings behind format similarity search.
+            ScalarLabelIndex _label_index;
+
+            // Coalesce concurrent single adds into store batches; declared last as they call back into the members above.
+            GroupCommitQueue<ConnectorBatchItem> _connector_commits;
+            GroupCommitQueue<TransformationBatchItem> _transformation_commits;
+            GroupCommitQueue<ConditionBatchItem> _condition_commits;
     };
 }
 
@@ -0,0 +1,350 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/hash/hash.h>
+
+namespace dcn::registry
+{
+    struct RegistryCacheConfig
+    {
+        std::size_t connector_record_bytes = 48ull * 1024 * 1024;
+        std::size_t format_hash_bytes = 8ull * 1024 * 1024;
+        std::size_t transformation_record_bytes = 24ull * 1024 * 1024;
+        std::size_t condition_record_bytes = 16ull * 1024 * 1024;
+    };
+
+    // Splits one byte budget across the per-kind caches, weighted towards connectors which are
+    // both the largest records and the most frequently resolved.
+    RegistryCacheConfig makeRegistryCacheConfig(std::size_t total_bytes);
+
+    struct HotCacheStats
+    {
+        std::string name;
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+        std::uint64_t rejected_admissions = 0;
+        std::size_t entries = 0;
+        std::size_t bytes = 0;
+        std::size_t capacity_bytes = 0;
+    };
+
+    // Count-min sketch with 4-bit saturating counters, halved periodically so the estimate tracks
+    // recent popularity (TinyLFU).
+    class FrequencySketch
+    {
+        public:
+            void resize(std::size_t expected_entries);
+
+            void increment(std::uint64_t hash);
+
+            std::uint8_t estimate(std::uint64_t hash) const;
+
+        private:
+            static constexpr std::size_t kDepth = 4;
+            static constexpr std::uint8_t kMaxCount = 15;
+
+            std::size_t _index(std::uint64_t hash, std::size_t row) const;
+            void _age();
+
+            std::vector<std::uint8_t> _counters;
+            std::size_t _width_mask = 0;
+            std::size_t _additions = 0;
+            std::size_t _sample_size = 0;
+    };
+
+    // Byte-bounded cache with CLOCK eviction and TinyLFU admission. A hit only flips a reference
+    // bit and bumps the sketch, so it neither allocates nor reorders anything. When space is needed,
+    // a new key is admitted only if it has been requested more often than the entry it would
+    // displace, which keeps one-off enumerations from flushing the hot set.
+    template<typename KeyT, typename ValueT>
+    class HotCache
+    {
+        public:
+            void setCapacityBytes(std::size_t capacity_bytes)
+            {
+                _capacity_bytes = capacity_bytes;
+                _sketch.resize(capacity_bytes / kExpectedEntryBytes);
+            }
+
+            const ValueT * get(const KeyT & key)
+            {
+                _sketch.increment(absl::Hash<KeyT>{}(key));
+
+                const auto it = _index.find(key);
+                if(it == _index.end())
+                {
+                    ++_stats.misses;
+                    return nullptr;
+                }
+
+                ++_stats.hits;
+                Slot & slot = _slots[it->second];
+                slot.referenced = true;
+                return &slot.value;
+            }
+
+            // Returns false when the entry was not cached (too large, or not admitted).
+            bool put(const KeyT & key, ValueT value, std::size_t bytes)
+            {
+                const auto it = _index.find(key);
+                if(it != _index.end())
+                {
+                    Slot & slot = _slots[it->second];
+                    _used_bytes = _used_bytes - slot.bytes + bytes;
+                    slot.value = std::move(value);
+                    slot.bytes = bytes;
+                    slot.referenced = true;
+                    _evictOverflow(it->second);
+                    return true;
+                }
+
+                if(bytes > _capacity_bytes)
+                {
+                    ++_stats.rejected_admissions;
+                    return false;
+                }
+
+                if(_used_bytes + bytes > _capacity_bytes)
+                {
+                    const std::size_t victim = _advanceClock();
+                    const std::uint8_t candidate_frequency = _sketch.estimate(absl::Hash<KeyT>{}(key));
+                    const std::uint8_t victim_frequency = _sketch.estimate(absl::Hash<KeyT>{}(_slots[victim].key));
+                    if(candidate_frequency <= victim_frequency)
+                    {
+                        ++_stats.rejected_admissions;
+                        return false;
+                    }
+                }
+
+                std::size_t slot_index = 0;
+                if(!_free_slots.empty())
+                {
+                    slot_index = _free_slots.back();
+                    _free_slots.pop_back();
+                }
+                else
+                {
+                    slot_index = _slots.size();
+                    _slots.emplace_back();
+                }
+
+                Slot & slot = _slots[slot_index];
+                slot.key = key;
+                slot.value = std::move(value);
+                slot.bytes = bytes;
+                slot.referenced = false;
+                slot.occupied = true;
+                _index.insert_or_assign(key, slot_index);
+                _used_bytes += bytes;
+
+                _evictOverflow(slot_index);
+                return true;
+            }
+
+            // Drops every entry; statistics and the frequency sketch are kept.
+            void clear()
+            {
+                _slots.clear();
+                _free_slots.clear();
+                _index.clear();
+                _hand = 0;
+                _used_bytes = 0;
+            }
+
+            HotCacheStats stats() const
+            {
+                HotCacheStats out = _stats;
+                out.entries = _index.size();
+                out.bytes = _used_bytes;
+                out.capacity_bytes = _capacity_bytes;
+                return out;
+            }
+
+        private:
+            static constexpr std::size_t kExpectedEntryBytes = 512;
+
+            struct Slot
+            {
+                KeyT key{};
+                ValueT value{};
+                std::size_t bytes = 0;
+                bool referenced = false;
+                bool occupied = false;
+            };
+
+            // Returns the next occupied slot whose reference bit is clear, clearing bits on the way.
+            std::size_t _advanceClock()
+            {
+                while(true)
+                {
+                    if(_hand >= _slots.size())
+                    {
+                        _hand = 0;
+                    }
+
+                    Slot & slot = _slots[_hand];
+                    if(slot.occupied)
+                    {
+                        if(!slot.referenced)
+                        {
+                            return _hand;
+                        }
+                        slot.referenced = false;
+                    }
+                    ++_hand;
+                }
+            }
+
+            void _evict(std::size_t slot_index)
+            {
+                Slot & slot = _slots[slot_index];
+                _index.erase(slot.key);
+                _used_bytes -= slot.bytes;
+                slot = Slot{};
+                _free_slots.push_back(slot_index);
+                ++_stats.evictions;
+            }
+
+            void _evictOverflow(std::size_t keep_slot)
+            {
+                while(_used_bytes > _capacity_bytes && _index.size() > 1)
+                {
+                    const std::size_t victim = _advanceClock();
+                    if(victim == keep_slot)
+                    {
+                        _slots[victim].referenced = true;
+                        ++_hand;
+                        continue;
+                    }
+                    _evict(victim);
+                }
+            }
+
+            std::vector<Slot> _slots;
+            std::vector<std::size_t> _free_slots;
+            absl::flat_hash_map<KeyT, std::size_t> _index;
+            std::size_t _hand = 0;
+            std::size_t _capacity_bytes = 0;
+            std::size_t _used_bytes = 0;
+            FrequencySketch _sketch;
+            HotCacheStats _stats;
+    };
+
+    // HotCache split into independently locked shards so concurrent readers only contend on the
+    // same key range. Each shard tracks a write generation: a reader records it before going to the
+    // store and only fills the cache if no writer touched the shard in between, so a slow miss can
+    // never overwrite a fresher entry published by a write.
+    template<typename KeyT, typename ValueT>
+    class ShardedHotCache
+    {
+        public:
+            static constexpr std::size_t kShardCount = 16;
+
+            void init(const char * name, std::size_t capacity_bytes)
+            {
+                _name = name;
+                for(Shard & shard : _shards)
+                {
+                    shard.cache.setCapacityBytes(capacity_bytes / kShardCount);
+                }
+            }
+
+            const char * name() const { return _name; }
+
+            std::optional<ValueT> get(const KeyT & key)
+            {
+                Shard & shard = _shard(key);
+                const std::lock_guard<std::mutex> lock(shard.mutex);
+                const ValueT * cached = shard.cache.get(key);
+                if(cached == nullptr)
+                {
+                    return std::nullopt;
+                }
+                return *cached;
+            }
+
+            std::uint64_t generation(const KeyT & key)
+            {
+                Shard & shard = _shard(key);
+                const std::lock_guard<std::mutex> lock(shard.mutex);
+                return shard.generation;
+            }
+
+            // Write path: publish the value and invalidate any reader fill still in flight for this shard.
+            void put(const KeyT & key, ValueT value, std::size_t bytes)
+            {
+                Shard & shard = _shard(key);
+                const std::lock_guard<std::mutex> lock(shard.mutex);
+                ++shard.generation;
+                shard.cache.put(key, std::move(value), bytes);
+            }
+
+            // Bulk invalidation after the store changed underneath the cache; also fences in-flight fills.
+            void clear()
+            {
+                for(Shard & shard : _shards)
+                {
+                    const std::lock_guard<std::mutex> lock(shard.mutex);
+                    ++shard.generation;
+                    shard.cache.clear();
+                }
+            }
+
+            // Read path: cache a store result unless a write landed in the shard since `generation` was taken.
+            bool fill(const KeyT & key, ValueT value, std::size_t bytes, std::uint64_t generation)
+            {
+                Shard & shard = _shard(key);
+                const std::lock_guard<std::mutex> lock(shard.mutex);
+                if(shard.generation != generation)
+                {
+                    return false;
+                }
+                return shard.cache.put(key, std::move(value), bytes);
+            }
+
+            HotCacheStats stats() const
+            {
+                HotCacheStats out;
+                out.name = _name;
+                for(const Shard & shard : _shards)
+                {
+                    const std::lock_guard<std::mutex> lock(shard.mutex);
+                    const HotCacheStats shard_stats = shard.cache.stats();
+                    out.hits += shard_stats.hits;
+                    out.misses += shard_stats.misses;
+                    out.evictions += shard_stats.evictions;
+                    out.rejected_admissions += shard_stats.rejected_admissions;
+                    out.entries += shard_stats.entries;
+                    out.bytes += shard_stats.bytes;
+                    out.capacity_bytes += shard_stats.capacity_bytes;
+                }
+                return out;
+            }
+
+        private:
+            struct Shard
+            {
+                mutable std::mutex mutex;
+                std::uint64_t generation = 0;
+                HotCache<KeyT, ValueT> cache;
+            };
+
+            Shard & _shard(const KeyT & key)
+            {
+                return _shards[absl::Hash<KeyT>{}(key) % kShardCount];
+            }
+
+            const char * _name = "unnamed-cache";
+            std::array<Shard, kShardCount> _shards;
+    };
+}
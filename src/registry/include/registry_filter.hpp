@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dcn::registry
+{
+    struct NameFilterStats
+    {
+        std::string name;
+        std::size_t capacity = 0;
+        std::size_t inserted = 0;
+        std::size_t memory_bytes = 0;
+        double estimated_false_positive_rate = 0.0;
+        std::uint64_t probes = 0;
+        std::uint64_t definite_negatives = 0;
+    };
+
+    // Split-block Bloom filter over registry names. Each name touches a single 64-byte block and
+    // sets one bit in each of its eight words, so a probe costs one cache line. Bits are atomics:
+    // probes run concurrently with inserts, and a name is inserted before its row is written, so a
+    // negative answer is always authoritative for committed rows.
+    class NameFilter
+    {
+        public:
+            static constexpr std::size_t kBitsPerKey = 12;
+            static constexpr std::size_t kMinCapacity = 4096;
+
+            explicit NameFilter(const char * name);
+
+            // Replaces the filter contents with the names produced by `source`, sized for at least
+            // twice the current population. Must not race with `add`.
+            void rebuild(
+                std::size_t expected_names,
+                const std::function<bool(const std::function<void(const std::string &)> &)> & source);
+
+            void add(std::string_view name);
+
+            // False means the name is definitely absent. Always true until the first rebuild.
+            bool mayContain(std::string_view name) const;
+
+            bool needsGrowth() const;
+
+            NameFilterStats stats() const;
+
+        private:
+            struct Blocks
+            {
+                explicit Blocks(std::size_t block_count);
+
+                std::size_t block_count = 0;
+                std::size_t capacity = 0;
+                std::vector<std::atomic<std::uint64_t>> words;
+            };
+
+            static void _insert(Blocks & blocks, std::string_view name);
+            static bool _test(const Blocks & blocks, std::string_view name);
+
+            const char * _name;
+            mutable std::shared_mutex _mutex;
+            std::unique_ptr<Blocks> _blocks;
+            std::atomic<std::size_t> _inserted{0};
+            mutable std::atomic<std::uint64_t> _probes{0};
+            mutable std::atomic<std::uint64_t> _definite_negatives{0};
+    };
+}
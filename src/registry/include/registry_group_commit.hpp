@@ -0,0 +1,148 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <absl/container/flat_hash_set.h>
+#include <spdlog/spdlog.h>
+
+#include "async.hpp"
+
+namespace dcn::registry
+{
+    struct RegistryWriteConfig
+    {
+        // How long the first queued single add waits for company before its batch is committed.
+        std::chrono::microseconds group_commit_window{2000};
+        // A batch is committed as soon as it reaches this size; 1 disables group commit.
+        std::size_t group_commit_max_batch = 64;
+    };
+
+    // Write-behind queue that turns concurrent single-entity adds into one store batch. Every member
+    // must be used from the registry write strand; waiters park on a per-entry timer that the flush
+    // cancels once their batch has committed, so each caller still gets its own result.
+    template<typename ItemT>
+    class GroupCommitQueue
+    {
+        public:
+            // Commits `items` and reports per item whether it was inserted.
+            using CommitFn = std::function<std::vector<bool>(std::vector<ItemT> & items)>;
+
+            GroupCommitQueue(
+                const asio::strand<asio::io_context::executor_type> & strand,
+                const char * name,
+                CommitFn commit)
+                : _strand(strand)
+                , _name(name)
+                , _commit(std::move(commit))
+            {
+            }
+
+            void configure(const RegistryWriteConfig & config)
+            {
+                _window = config.group_commit_window;
+                _max_batch = config.group_commit_max_batch;
+            }
+
+            bool enabled() const { return _max_batch > 1; }
+
+            bool empty() const { return _items.empty(); }
+
+            bool isPending(const std::string & name) const { return _pending_names.contains(name); }
+
+            asio::awaitable<bool> submit(std::string name, ItemT item)
+            {
+                auto waiter = std::make_shared<Waiter>(_strand);
+                _items.push_back(std::move(item));
+                _waiters.push_back(waiter);
+                _pending_names.insert(std::move(name));
+
+                if(_items.size() >= _max_batch)
+                {
+                    flush();
+                }
+                else if(!_flush_scheduled)
+                {
+                    _flush_scheduled = true;
+                    asio::co_spawn(_strand, _flushAfterWindow(), asio::detached);
+                }
+
+                while(!waiter->done)
+                {
+                    waiter->wakeup.expires_at(asio::steady_timer::time_point::max());
+                    std::error_code ec;
+                    co_await waiter->wakeup.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+                }
+                co_return waiter->inserted;
+            }
+
+            // Commits everything queued so far; also used to order a write behind pending ones.
+            void flush()
+            {
+                if(_items.empty())
+                {
+                    return;
+                }
+
+                std::vector<ItemT> items = std::move(_items);
+                std::vector<std::shared_ptr<Waiter>> waiters = std::move(_waiters);
+                _items.clear();
+                _waiters.clear();
+                _pending_names.clear();
+
+                std::vector<bool> inserted = _commit(items);
+                inserted.resize(waiters.size(), false);
+
+                spdlog::debug("Registry group commit [{}]: batch={}", _name, waiters.size());
+
+                for(std::size_t i = 0; i < waiters.size(); ++i)
+                {
+                    waiters[i]->inserted = inserted[i];
+                    waiters[i]->done = true;
+                    waiters[i]->wakeup.cancel();
+                }
+            }
+
+        private:
+            struct Waiter
+            {
+                explicit Waiter(const asio::strand<asio::io_context::executor_type> & strand)
+                    : wakeup(strand)
+                {
+                }
+
+                asio::steady_timer wakeup;
+                bool done = false;
+                bool inserted = false;
+            };
+
+            asio::awaitable<void> _flushAfterWindow()
+            {
+                asio::steady_timer timer(_strand);
+                timer.expires_after(_window);
+                std::error_code ec;
+                co_await timer.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+
+                _flush_scheduled = false;
+                flush();
+            }
+
+            asio::strand<asio::io_context::executor_type> _strand;
+            const char * _name;
+            CommitFn _commit;
+
+            std::chrono::microseconds _window{0};
+            std::size_t _max_batch = 1;
+
+            std::vector<ItemT> _items;
+            std::vector<std::shared_ptr<Waiter>> _waiters;
+            absl::flat_hash_set<std::string> _pending_names;
+            bool _flush_scheduled = false;
+    };
+}
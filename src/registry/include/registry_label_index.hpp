@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "format_hash.hpp"
+
+namespace dcn::registry
+{
+    using FormatLabelsVisitor = std::function<void(const evmc::bytes32 &, const std::vector<chain::ScalarLabel> &)>;
+
+    // Compressed set of 32-bit ids split roaring-style into 2^16-id chunks. A chunk stores the sorted low
+    // halves of its ids while sparse and switches to a 1024-word bitmap once it holds more than 4096.
+    class PostingBitmap
+    {
+        public:
+            static constexpr std::size_t kArrayMaxCardinality = 4096;
+            static constexpr std::size_t kBitmapWords = 1024;
+
+            // Cheapest when ids arrive in increasing order; adding a present id is a no-op.
+            void add(std::uint32_t id);
+
+            bool contains(std::uint32_t id) const;
+
+            std::size_t cardinality() const;
+
+            std::size_t memoryBytes() const;
+
+            PostingBitmap intersect(const PostingBitmap & other) const;
+
+            void forEach(const std::function<void(std::uint32_t)> & visitor) const;
+
+        private:
+            struct Container
+            {
+                std::uint16_t key = 0;
+                std::uint32_t cardinality = 0;
+                std::vector<std::uint16_t> array;
+                std::vector<std::uint64_t> bits;
+
+                bool isBitmap() const { return !bits.empty(); }
+            };
+
+            static Container _intersectContainers(const Container & lhs, const Container & rhs);
+
+            std::vector<Container> _containers;
+    };
+
+    struct FormatMatch
+    {
+        evmc::bytes32 format_hash{};
+        std::size_t shared_labels = 0;
+        std::size_t format_labels = 0;
+    };
+
+    struct FormatSearchResult
+    {
+        std::size_t total_matches = 0;
+        std::vector<FormatMatch> matches;
+    };
+
+    struct ScalarLabelIndexStats
+    {
+        std::size_t formats = 0;
+        std::size_t labels = 0;
+        std::size_t memory_bytes = 0;
+    };
+
+    // Inverted index from scalar label (`scalar:tail_id`, as served by /format) to the formats using it.
+    // Formats are immutable once stored, so the index only ever grows.
+    class ScalarLabelIndex
+    {
+        public:
+            static std::string labelKey(const chain::ScalarLabel & label);
+
+            // Replaces the index contents with the formats produced by `source`.
+            bool rebuild(const std::function<bool(const FormatLabelsVisitor &)> & source);
+
+            // Registers a format; a format hash that is already indexed is ignored.
+            void add(const evmc::bytes32 & format_hash, const std::vector<chain::ScalarLabel> & labels);
+
+            // Formats sharing at least `min_shared` of `labels`, best first: most shared labels, then fewest
+            // labels outside the query, then format hash. `min_shared == labels.size()` asks for supersets.
+            FormatSearchResult search(const std::vector<std::string> & labels, std::size_t min_shared, std::size_t limit) const;
+
+            ScalarLabelIndexStats stats() const;
+
+        private:
+            void _addLocked(const evmc::bytes32 & format_hash, const std::vector<chain::ScalarLabel> & labels);
+
+            mutable std::shared_mutex _mutex;
+            std::vector<evmc::bytes32> _formats;
+            std::vector<std::uint32_t> _format_label_counts;
+            absl::flat_hash_map<evmc::bytes32, std::uint32_t> _format_ids;
+            absl::flat_hash_map<std::string, PostingBitmap> _postings;
+    };
+}
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <cstddef>
+#include <filesystem>
+#include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -10,6 +13,7 @@
 #include "pt.hpp"
 #include "format_hash.hpp"
 #include "parser.hpp"
+#include "registry_label_index.hpp"
 #include "sqlite/wal.hpp"
 
 namespace dcn::registry
@@ -40,6 +44,7 @@ namespace dcn::registry
     };
 
     using NameCursor = std::string;
+    using NameVisitor = std::function<void(const std::string &)>;
 
     inline std::string serializeNameCursor(const NameCursor & cursor)
     {
@@ -62,6 +67,10 @@ namespace dcn::registry
 
             virtual std::optional<ConnectorRecordHandle> getConnectorRecordHandle(const std::string & name) const = 0;
 
+            // Resolves every name with one query per chunk; results follow input order, nullopt when missing.
+            virtual std::vector<std::optional<ConnectorRecordHandle>> getConnectorRecordHandles(
+                std::span<const std::string> names) const = 0;
+
             virtual std::optional<evmc::bytes32> getConnectorFormatHash(const std::string & name) const = 0;
 
             virtual bool addConnector(
@@ -70,9 +79,11 @@ namespace dcn::registry
                 const evmc::bytes32 & format_hash,
                 const std::vector<ScalarLabel> & canonical_scalar_labels) = 0;
 
+            // With `all_or_nothing == false`, `inserted_items` (when given) receives one flag per item.
             virtual bool addConnectorsBatch(
                 const std::vector<ConnectorBatchItem> & items,
-                bool all_or_nothing = true) = 0;
+                bool all_or_nothing = true,
+                std::vector<bool> * inserted_items = nullptr) = 0;
 
             virtual std::size_t getFormatConnectorNamesCount(const evmc::bytes32 & format_hash) const = 0;
 
@@ -95,25 +106,33 @@ namespace dcn::registry
             virtual std::optional<TransformationRecordHandle> getTransformationRecordHandle(
                 const std::string & name) const = 0;
 
+            virtual std::vector<std::optional<TransformationRecordHandle>> getTransformationRecordHandles(
+                std::span<const std::string> names) const = 0;
+
             virtual bool addTransformation(
                 const chain::Address & address,
                 const TransformationRecord & record) = 0;
 
             virtual bool addTransformationsBatch(
                 const std::vector<TransformationBatchItem> & items,
-                bool all_or_nothing = true) = 0;
+                bool all_or_nothing = true,
+                std::vector<bool> * inserted_items = nullptr) = 0;
 
             virtual bool hasCondition(const std::string & name) const = 0;
             virtual std::optional<ConditionRecordHandle> getConditionRecordHandle(
                 const std::string & name) const = 0;
 
+            virtual std::vector<std::optional<ConditionRecordHandle>> getConditionRecordHandles(
+                std::span<const std::string> names) const = 0;
+
             virtual bool addCondition(
                 const chain::Address & address,
                 const ConditionRecord & record) = 0;
 
             virtual bool addConditionsBatch(
                 const std::vector<ConditionBatchItem> & items,
-                bool all_or_nothing = true) = 0;
+                bool all_or_nothing = true,
+                std::vector<bool> * inserted_items = nullptr) = 0;
 
             virtual NameCursorPage getOwnedConnectorsCursor(
                 const chain::Address & owner,
@@ -136,6 +155,30 @@ namespace dcn::registry
                 const std::optional<chain::Address> & after,
                 std::size_t limit) const = 0;
 
+            // Full-table name scans, used to seed the in-memory negative-lookup filters.
+            virtual std::size_t getConnectorsCount() const = 0;
+            virtual bool forEachConnectorName(const NameVisitor & visitor) const = 0;
+
+            virtual std::size_t getTransformationsCount() const = 0;
+            virtual bool forEachTransformationName(const NameVisitor & visitor) const = 0;
+
+            virtual std::size_t getConditionsCount() const = 0;
+            virtual bool forEachConditionName(const NameVisitor & visitor) const = 0;
+
+            // Identity of this store and the number of entity writes it has taken. The store only grows, so
+            // an equal marker means equal contents, while another store or a copy restored elsewhere differs.
+            virtual std::string getWriteMarker() const = 0;
+
+            // Visits every format with its stored scalar labels, used to seed the scalar label index.
+            virtual bool forEachFormatScalarLabels(const FormatLabelsVisitor & visitor) const = 0;
+
+            // Writes every record, format membership, scalar label and ownership row to one sorted,
+            // checksummed file, read from a single consistent snapshot of the store.
+            virtual bool exportSnapshot(const std::filesystem::path & path) const = 0;
+
+            // Bulk-loads a file written by `exportSnapshot` into an empty store; all or nothing.
+            virtual bool importSnapshot(const std::filesystem::path & path) = 0;
+
             virtual bool checkpointWal(storage::sqlite::WalCheckpointMode mode) const = 0;
     };
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -26,6 +27,9 @@ namespace dcn::registry
 
             std::optional<ConnectorRecordHandle> getConnectorRecordHandle(const std::string & name) const override;
 
+            std::vector<std::optional<ConnectorRecordHandle>> getConnectorRecordHandles(
+                std::span<const std::string> names) const override;
+
             std::optional<evmc::bytes32> getConnectorFormatHash(const std::string & name) const override;
 
             bool addConnector(
@@ -34,7 +38,10 @@ namespace dcn::registry
                 const evmc::bytes32 & format_hash,
                 const std::vector<ScalarLabel> & canonical_scalar_labels) override;
 
-            bool addConnectorsBatch(const std::vector<ConnectorBatchItem> & items, bool all_or_nothing = true) override;
+            bool addConnectorsBatch(
+                const std::vector<ConnectorBatchItem> & items,
+                bool all_or_nothing = true,
+                std::vector<bool> * inserted_items = nullptr) override;
 
             std::size_t getFormatConnectorNamesCount(const evmc::bytes32 & format_hash) const override;
 
@@ -56,26 +63,34 @@ namespace dcn::registry
             std::optional<TransformationRecordHandle> getTransformationRecordHandle(
                 const std::string & name) const override;
 
+            std::vector<std::optional<TransformationRecordHandle>> getTransformationRecordHandles(
+                std::span<const std::string> names) const override;
+
             bool addTransformation(
                 const chain::Address & address,
                 const TransformationRecord & record) override;
 
             bool addTransformationsBatch(
                 const std::vector<TransformationBatchItem> & items,
-                bool all_or_nothing = true) override;
+                bool all_or_nothing = true,
+                std::vector<bool> * inserted_items = nullptr) override;
 
             bool hasCondition(const std::string & name) const override;
 
             std::optional<ConditionRecordHandle> getConditionRecordHandle(
                 const std::string & name) const override;
 
+            std::vector<std::optional<ConditionRecordHandle>> getConditionRecordHandles(
+                std::span<const std::string> names) const override;
+
             bool addCondition(
                 const chain::Address & address,
                 const ConditionRecord & record) override;
 
             bool addConditionsBatch(
                 const std::vector<ConditionBatchItem> & items,
-                bool all_or_nothing = true) override;
+                bool all_or_nothing = true,
+                std::vector<bool> * inserted_items = nullptr) override;
 
             NameCursorPage getOwnedConnectorsCursor(
                 const chain::Address & owner,
@@ -98,17 +113,73 @@ namespace dcn::registry
                 const std::optional<chain::Address> & after,
                 std::size_t limit) const override;
 
+            std::size_t getConnectorsCount() const override;
+            bool forEachConnectorName(const NameVisitor & visitor) const override;
+
+            std::size_t getTransformationsCount() const override;
+            bool forEachTransformationName(const NameVisitor & visitor) const override;
+
+            std::string getWriteMarker() const override;
+
+            std::size_t getConditionsCount() const override;
+            bool forEachConditionName(const NameVisitor & visitor) const override;
+
+            bool forEachFormatScalarLabels(const FormatLabelsVisitor & visitor) const override;
+
+            bool exportSnapshot(const std::filesystem::path & path) const override;
+            bool importSnapshot(const std::filesystem::path & path) override;
+
             bool checkpointWal(storage::sqlite::WalCheckpointMode mode) const override;
 
         private:
+            // Exclusive use of a read connection for the duration of one query. File-backed stores hand
+            // out pooled read-only connections so lookups never queue behind the writer; in-memory stores
+            // have a single connection and serialize readers with writers instead.
+            class ReadLease final
+            {
+                public:
+                    explicit ReadLease(const SQLiteRegistryStore & store);
+                    ~ReadLease();
+
+                    ReadLease(const ReadLease &) = delete;
+                    ReadLease & operator=(const ReadLease &) = delete;
+
+                    sqlite3 * db() const { return _db; }
+
+                private:
+                    const SQLiteRegistryStore & _store;
+                    sqlite3 * _db = nullptr;
+                    std::unique_lock<std::mutex> _memory_lock;
+            };
+
             sqlite3 * _db = nullptr;
+            std::string _db_path;
+            bool _pooled_reads = false;
+
+            mutable std::mutex _write_mutex;
+            mutable std::mutex _readers_mutex;
+            mutable std::vector<sqlite3 *> _idle_readers;
+
+            sqlite3 * _openReader() const;
 
             bool _initializeSchema() const;
+            int _schemaVersion() const;
+            bool _tableExists(const char * table_name) const;
+            // Rebuilds version 1 rowid key tables as WITHOUT ROWID tables and bumps `user_version`.
+            bool _migrateToClusteredTables() const;
+            // Populates `accounts`, `formats` and their counters from the base tables on first open.
+            bool _backfillAggregates() const;
+            // Set-based fill of `accounts`, `formats` and their counters; runs inside the caller's transaction.
+            bool _rebuildAggregates() const;
             bool _exec(const char * sql) const;
             bool _beginTransaction() const;
             bool _commitTransaction() const;
             void _rollbackTransaction() const;
 
+            std::size_t _countTableRows(const char * table_name) const;
+            std::size_t _readCounter(const char * counter_name) const;
+            bool _forEachNameInTable(const char * table_name, const NameVisitor & visitor) const;
+
             NameCursorPage _getOwnedCursorFromTable(
                 const char * table_name,
                 const chain::Address & owner,
@@ -2,12 +2,14 @@
 #include <cstdlib>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string_view>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <evmc/hex.hpp>
+#include <google/protobuf/arena.h>
 
 #include "registry.hpp"
 #include "sqlite_registry_store.hpp"
@@ -34,6 +36,10 @@ namespace dcn::registry
         // Resolve connector by name from pending connector + persisted connector records.
         static const Connector * resolveConnector(const std::string & connector_name, ConnectorGraphContext & graph_context);
 
+        // Load every not-yet-resolved composite and binding target of `connector` with one store query.
+        // May rehash the connector cache, so pointers from `resolveConnector` must be re-resolved.
+        static void prefetchChildConnectors(const Connector & connector, ConnectorGraphContext & graph_context);
+
         // Validate all referenced transformations are present.
         static bool validateConnectorTransformations(const Connector & connector, const IRegistryStore & store);
 
@@ -88,6 +94,45 @@ namespace dcn::registry
             return &it->second;
         }
 
+        static void prefetchChildConnectors(const Connector & connector, ConnectorGraphContext & graph_context)
+        {
+            std::vector<std::string> child_names;
+            const auto collect = [&child_names, &graph_context](const std::string & child_name)
+            {
+                if(child_name.empty() || child_name == graph_context.pending_connector.name() ||
+                    graph_context.connector_cache.contains(child_name) ||
+                    (graph_context.staged_connectors != nullptr && graph_context.staged_connectors->contains(child_name)))
+                {
+                    return;
+                }
+                child_names.push_back(child_name);
+            };
+
+            for(const Dimension & dimension : connector.dimensions())
+            {
+                collect(dimension.composite());
+                for(const auto & [_, binding_target] : dimension.bindings())
+                {
+                    collect(binding_target);
+                }
+            }
+
+            // A single child is no cheaper batched; leave it to `resolveConnector`.
+            if(child_names.size() < 2)
+            {
+                return;
+            }
+
+            const auto record_handles = graph_context.store.getConnectorRecordHandles(child_names);
+            for(std::size_t i = 0; i < child_names.size() && i < record_handles.size(); ++i)
+            {
+                if(record_handles[i].has_value() && *record_handles[i])
+                {
+                    graph_context.connector_cache.try_emplace(child_names[i], (*record_handles[i])->connector());
+                }
+            }
+        }
+
         static bool validateConnectorTransformations(const Connector & connector, const IRegistryStore & store)
         {
             for(const Dimension & dimension : connector.dimensions())
@@ -306,6 +351,9 @@ namespace dcn::registry
                     return std::nullopt;
                 }
 
+                prefetchChildConnectors(*connector, context);
+                connector = resolveConnector(frame.connector_name, context);
+
                 visit_state[frame.connector_name] = VisitState::VISITING;
                 stack.push_back(StackFrame{.connector_name = frame.connector_name, .post_visit = true});
 
@@ -676,92 +724,321 @@ namespace dcn::registry
             }
         }
 
+        constexpr std::size_t HOT_CACHE_ENTRY_OVERHEAD_BYTES = 64;
+
+        template<typename ValueT>
+        static std::size_t hotCacheValueBytes(const std::optional<ValueT> & value)
+        {
+            if(!value.has_value())
+            {
+                return 0;
+            }
+
+            if constexpr(std::is_same_v<ValueT, evmc::bytes32>)
+            {
+                return sizeof(evmc::bytes32);
+            }
+            else
+            {
+                if(!*value)
+                {
+                    return 0;
+                }
+                // Records decoded by the store own an arena; charge what it actually holds.
+                const google::protobuf::Arena * arena = (*value)->GetArena();
+                return arena != nullptr
+                    ? static_cast<std::size_t>(arena->SpaceAllocated())
+                    : (*value)->ByteSizeLong();
+            }
+        }
+
+        // Approximate resident size used to charge an entry against its cache's byte budget.
+        template<typename ValueT>
+        static std::size_t hotCacheEntryBytes(const std::string & key, const ValueT & value)
+        {
+            return HOT_CACHE_ENTRY_OVERHEAD_BYTES + key.size() + hotCacheValueBytes(value);
+        }
+
         template<typename KeyT, typename ValueT, typename ValueArgT>
         static void putHotCacheEntry(
-            LruCache<KeyT, ValueT> & cache,
+            ShardedHotCache<KeyT, ValueT> & cache,
             const KeyT & key,
             ValueArgT && value)
         {
-            if(cache.capacity == 0)
+            ValueT cached_value(std::forward<ValueArgT>(value));
+            const std::size_t bytes = hotCacheEntryBytes(key, cached_value);
+            cache.put(key, std::move(cached_value), bytes);
+            spdlog::debug("Cache put [{}] key={} bytes={}", cache.name(), cacheKeyToString(key), bytes);
+        }
+
+        template<typename KeyT, typename ValueT>
+        static std::optional<ValueT> getHotCacheEntry(ShardedHotCache<KeyT, ValueT> & cache, const KeyT & key)
+        {
+            return cache.get(key);
+        }
+
+        template<typename KeyT, typename ValueT>
+        static std::uint64_t hotCacheGeneration(ShardedHotCache<KeyT, ValueT> & cache, const KeyT & key)
+        {
+            return cache.generation(key);
+        }
+
+        template<typename KeyT, typename ValueT, typename ValueArgT>
+        static void fillHotCacheEntry(
+            ShardedHotCache<KeyT, ValueT> & cache,
+            const KeyT & key,
+            ValueArgT && value,
+            std::uint64_t generation)
+        {
+            ValueT cached_value(std::forward<ValueArgT>(value));
+            const std::size_t bytes = hotCacheEntryBytes(key, cached_value);
+            if(!cache.fill(key, std::move(cached_value), bytes, generation))
             {
-                return;
+                spdlog::debug("Cache fill skipped [{}] key={} (raced with write or not admitted)", cache.name(), cacheKeyToString(key));
+            }
+        }
+
+        // Answers filter negatives and cache hits in place, then resolves the remaining names with a
+        // single `fetch_missing` call and fills the cache with its results.
+        template<typename HandleT, typename FetchT>
+        static std::vector<std::optional<HandleT>> resolveRecordHandles(
+            ShardedHotCache<std::string, std::optional<HandleT>> & cache,
+            const NameFilter & filter,
+            std::span<const std::string> names,
+            FetchT && fetch_missing)
+        {
+            std::vector<std::optional<HandleT>> out(names.size());
+
+            std::vector<std::string> missing_names;
+            std::vector<std::size_t> missing_positions;
+            std::vector<std::uint64_t> missing_generations;
+            for(std::size_t i = 0; i < names.size(); ++i)
+            {
+                const std::string & name = names[i];
+                if(!filter.mayContain(name))
+                {
+                    continue;
+                }
+
+                if(auto cached = getHotCacheEntry(cache, name))
+                {
+                    out[i] = std::move(*cached);
+                    continue;
+                }
+
+                missing_generations.push_back(hotCacheGeneration(cache, name));
+                missing_positions.push_back(i);
+                missing_names.push_back(name);
             }
 
-            const auto it = cache.entries.find(key);
-            if(it != cache.entries.end())
+            if(missing_names.empty())
             {
-                it->second.value = std::forward<ValueArgT>(value);
-                cache.order.splice(cache.order.begin(), cache.order, it->second.order_it);
-                it->second.order_it = cache.order.begin();
-                spdlog::debug("Cache update [{}] key={}", cache.name, cacheKeyToString(key));
-                return;
+                return out;
             }
 
-            if(cache.entries.size() >= cache.capacity)
+            std::vector<std::optional<HandleT>> fetched = fetch_missing(std::span<const std::string>(missing_names));
+            fetched.resize(missing_names.size());
+            for(std::size_t i = 0; i < missing_names.size(); ++i)
             {
-                const KeyT & lru_key = cache.order.back();
-                spdlog::debug("Cache remove [{}] key={} (evicted LRU)", cache.name, cacheKeyToString(lru_key));
-                cache.entries.erase(lru_key);
-                cache.order.pop_back();
+                fillHotCacheEntry(cache, missing_names[i], fetched[i], missing_generations[i]);
+                out[missing_positions[i]] = std::move(fetched[i]);
             }
 
-            cache.order.push_front(key);
-            const auto order_it = cache.order.begin();
-            cache.entries.insert_or_assign(
-                *order_it,
-                typename LruCache<KeyT, ValueT>::Entry{
-                    .value = std::forward<ValueArgT>(value),
-                    .order_it = order_it});
-            spdlog::debug("Cache add [{}] key={}", cache.name, cacheKeyToString(key));
+            spdlog::debug(
+                "Cache batch [{}]: requested={} fetched={}",
+                cache.name(),
+                names.size(),
+                missing_names.size());
+            return out;
         }
+    }
 
-        template<typename KeyT, typename ValueT>
-        static const ValueT * getHotCacheEntry(LruCache<KeyT, ValueT> & cache, const KeyT & key)
+
+    Registry::Registry(
+        asio::io_context & io_context,
+        std::string sqlite_path,
+        RegistryCacheConfig cache_config,
+        RegistryWriteConfig write_config)
+        : _strand(asio::make_strand(io_context))
+        , _store(std::make_unique<SQLiteRegistryStore>(std::move(sqlite_path)))
+        , _connector_commits(_strand, "connector", [this](std::vector<ConnectorBatchItem> & items)
+            {
+                std::vector<bool> inserted_items;
+                _commitConnectors(items, false, inserted_items);
+                return inserted_items;
+            })
+        , _transformation_commits(_strand, "transformation", [this](std::vector<TransformationBatchItem> & items)
+            {
+                std::vector<bool> inserted_items;
+                _commitTransformations(items, false, inserted_items);
+                return inserted_items;
+            })
+        , _condition_commits(_strand, "condition", [this](std::vector<ConditionBatchItem> & items)
+            {
+                std::vector<bool> inserted_items;
+                _commitConditions(items, false, inserted_items);
+                return inserted_items;
+            })
+    {
+        _connector_record_cache.init("connector-record", cache_config.connector_record_bytes);
+        _format_hash_cache.init("format-hash", cache_config.format_hash_bytes);
+        _transformation_record_cache.init("transformation-record", cache_config.transformation_record_bytes);
+        _condition_record_cache.init("condition-record", cache_config.condition_record_bytes);
+
+        _rebuildFilters(false);
+        _label_index.rebuild([this](const FormatLabelsVisitor & visitor) { return _store->forEachFormatScalarLabels(visitor); });
+
+        _connector_commits.configure(write_config);
+        _transformation_commits.configure(write_config);
+        _condition_commits.configure(write_config);
+    }
+
+    void Registry::_rebuildFilter(
+        NameFilter & filter,
+        std::size_t (IRegistryStore::*count_names)() const,
+        bool (IRegistryStore::*for_each_name)(const NameVisitor &) const)
+    {
+        filter.rebuild(
+            ((*_store).*count_names)(),
+            [this, for_each_name](const NameVisitor & visitor) { return ((*_store).*for_each_name)(visitor); });
+    }
+
+    void Registry::_rebuildFilters(bool only_if_full)
+    {
+        if(!only_if_full || _connector_filter.needsGrowth())
+        {
+            _rebuildFilter(_connector_filter, &IRegistryStore::getConnectorsCount, &IRegistryStore::forEachConnectorName);
+        }
+        if(!only_if_full || _transformation_filter.needsGrowth())
+        {
+            _rebuildFilter(_transformation_filter, &IRegistryStore::getTransformationsCount, &IRegistryStore::forEachTransformationName);
+        }
+        if(!only_if_full || _condition_filter.needsGrowth())
+        {
+            _rebuildFilter(_condition_filter, &IRegistryStore::getConditionsCount, &IRegistryStore::forEachConditionName);
+        }
+    }
+
+    bool Registry::_commitConnectors(
+        std::vector<ConnectorBatchItem> & items,
+        bool all_or_nothing,
+        std::vector<bool> & inserted_items)
+    {
+        // Names go into the filter before the rows exist so a concurrent reader never sees a false negative.
+        for(const ConnectorBatchItem & item : items)
+        {
+            _connector_filter.add(item.record.connector().name());
+        }
+
+        const bool inserted = _store->addConnectorsBatch(items, all_or_nothing, &inserted_items);
+        _rebuildFilters(true);
+
+        for(std::size_t i = 0; i < items.size() && i < inserted_items.size(); ++i)
         {
-            const auto it = cache.entries.find(key);
-            if(it == cache.entries.end())
+            if(!inserted_items[i])
             {
-                return nullptr;
+                continue;
             }
 
-            cache.order.splice(cache.order.begin(), cache.order, it->second.order_it);
-            it->second.order_it = cache.order.begin();
-            return &it->second.value;
+            _label_index.add(items[i].format_hash, items[i].canonical_scalar_labels);
+
+            const std::string & connector_name = items[i].record.connector().name();
+            putHotCacheEntry(
+                _connector_record_cache,
+                connector_name,
+                std::optional<ConnectorRecordHandle>(std::make_shared<ConnectorRecord>(items[i].record)));
+            putHotCacheEntry(
+                _format_hash_cache,
+                connector_name,
+                std::optional<evmc::bytes32>(items[i].format_hash));
         }
+        return inserted;
+    }
 
-        template<typename KeyT, typename ValueT>
-        static void clearHotCache(LruCache<KeyT, ValueT> & cache, const char * reason)
+    bool Registry::_commitTransformations(
+        std::vector<TransformationBatchItem> & items,
+        bool all_or_nothing,
+        std::vector<bool> & inserted_items)
+    {
+        for(const TransformationBatchItem & item : items)
+        {
+            _transformation_filter.add(item.record.transformation().name());
+        }
+
+        const bool inserted = _store->addTransformationsBatch(items, all_or_nothing, &inserted_items);
+        _rebuildFilters(true);
+
+        for(std::size_t i = 0; i < items.size() && i < inserted_items.size(); ++i)
         {
-            if(cache.entries.empty())
+            if(inserted_items[i])
             {
-                return;
+                putHotCacheEntry(
+                    _transformation_record_cache,
+                    items[i].record.transformation().name(),
+                    std::optional<TransformationRecordHandle>(
+                        std::make_shared<TransformationRecord>(items[i].record)));
             }
+        }
+        return inserted;
+    }
 
-            for(const auto & [key, entry] : cache.entries)
+    bool Registry::_commitConditions(
+        std::vector<ConditionBatchItem> & items,
+        bool all_or_nothing,
+        std::vector<bool> & inserted_items)
+    {
+        for(const ConditionBatchItem & item : items)
+        {
+            _condition_filter.add(item.record.condition().name());
+        }
+
+        const bool inserted = _store->addConditionsBatch(items, all_or_nothing, &inserted_items);
+        _rebuildFilters(true);
+
+        for(std::size_t i = 0; i < items.size() && i < inserted_items.size(); ++i)
+        {
+            if(inserted_items[i])
             {
-                (void)entry;
-                spdlog::debug("Cache remove [{}] key={} ({})", cache.name, cacheKeyToString(key), reason);
+                putHotCacheEntry(
+                    _condition_record_cache,
+                    items[i].record.condition().name(),
+                    std::optional<ConditionRecordHandle>(
+                        std::make_shared<ConditionRecord>(items[i].record)));
             }
-
-            cache.entries.clear();
-            cache.order.clear();
         }
+        return inserted;
     }
 
-
-    Registry::Registry(asio::io_context & io_context, std::string sqlite_path)
-        : _strand(asio::make_strand(io_context))
-        , _store(std::make_unique<SQLiteRegistryStore>(std::move(sqlite_path)))
+    void Registry::_flushPendingDependencies(const Connector & connector)
     {
-        _connector_record_cache.name = "connector-record";
-        _format_hash_cache.name = "format-hash";
-        _transformation_record_cache.name = "transformation-record";
-        _condition_record_cache.name = "condition-record";
-
-        _connector_record_cache.capacity = kHotCacheCapacity;
-        _format_hash_cache.capacity = kHotCacheCapacity;
-        _transformation_record_cache.capacity = kHotCacheCapacity;
-        _condition_record_cache.capacity = kHotCacheCapacity;
+        bool flush_transformations = false;
+        bool flush_connectors = _connector_commits.isPending(connector.name());
+        for(const Dimension & dimension : connector.dimensions())
+        {
+            for(const auto & transformation : dimension.transformations())
+            {
+                flush_transformations = flush_transformations || _transformation_commits.isPending(transformation.name());
+            }
+
+            flush_connectors = flush_connectors || _connector_commits.isPending(dimension.composite());
+            for(const auto & [_, binding_target] : dimension.bindings())
+            {
+                flush_connectors = flush_connectors || _connector_commits.isPending(binding_target);
+            }
+        }
+
+        if(flush_transformations)
+        {
+            _transformation_commits.flush();
+        }
+        if(_condition_commits.isPending(connector.condition_name()))
+        {
+            _condition_commits.flush();
+        }
+        if(flush_connectors)
+        {
+            _connector_commits.flush();
+        }
     }
 
     asio::awaitable<bool> Registry::addConnector(chain::Address address, ConnectorRecord record)
@@ -775,6 +1052,7 @@ namespace dcn::registry
         }
 
         co_await async::ensureOnStrand(_strand);
+        _flushPendingDependencies(connector);
 
         if(connector.dimensions_size() <= 0)
         {
@@ -873,10 +1151,25 @@ namespace dcn::registry
             co_return true;
         }
 
+        if(_connector_commits.enabled())
+        {
+            co_return co_await _connector_commits.submit(
+                connector_name,
+                ConnectorBatchItem{
+                    .address = address,
+                    .record = std::move(record),
+                    .format_hash = format_hash,
+                    .canonical_scalar_labels = canonical_scalar_labels
+                });
+        }
+
+        _connector_filter.add(connector_name);
         if(!_store->addConnector(address, record, format_hash, canonical_scalar_labels))
         {
             co_return false;
         }
+        _rebuildFilters(true);
+        _label_index.add(format_hash, canonical_scalar_labels);
 
         putHotCacheEntry(
             _connector_record_cache,
@@ -895,6 +1188,10 @@ namespace dcn::registry
         bool all_or_nothing)
     {
         co_await async::ensureOnStrand(_strand);
+        // Batch validation reads dependencies from the store, so queued single adds land first.
+        _transformation_commits.flush();
+        _condition_commits.flush();
+        _connector_commits.flush();
 
         std::vector<ConnectorBatchItem> batch_items;
         batch_items.reserve(connectors.size());
@@ -1083,30 +1380,8 @@ namespace dcn::registry
             co_return all_valid;
         }
 
-        const bool inserted = _store->addConnectorsBatch(batch_items, all_or_nothing);
-        if(!inserted && all_or_nothing)
-        {
-            co_return false;
-        }
-
-        for(const ConnectorBatchItem & item : batch_items)
-        {
-            const std::string & connector_name = item.record.connector().name();
-            if(!_store->hasConnector(connector_name))
-            {
-                continue;
-            }
-
-            putHotCacheEntry(
-                _connector_record_cache,
-                connector_name,
-                std::optional<ConnectorRecordHandle>(std::make_shared<ConnectorRecord>(item.record)));
-            putHotCacheEntry(
-                _format_hash_cache,
-                connector_name,
-                std::optional<evmc::bytes32>(item.format_hash));
-        }
-
+        std::vector<bool> inserted_items;
+        const bool inserted = _commitConnectors(batch_items, all_or_nothing, inserted_items);
         co_return inserted && all_valid;
     }
 
@@ -1115,15 +1390,19 @@ namespace dcn::registry
     {
         spdlog::debug("Registry::getConnectorRecordHandle('{}'): enter", name);
 
-        co_await async::ensureOnStrand(_strand);
-        spdlog::debug("Registry::getConnectorRecordHandle('{}'): on strand", name);
+        if(!_connector_filter.mayContain(name))
+        {
+            spdlog::debug("Registry::getConnectorRecordHandle('{}'): filter negative", name);
+            co_return std::nullopt;
+        }
 
-        if(const auto * cached = getHotCacheEntry(_connector_record_cache, name))
+        if(const auto cached = getHotCacheEntry(_connector_record_cache, name))
         {
             spdlog::debug("Registry::getConnectorRecordHandle('{}'): cache hit has_value={}", name, cached->has_value());
             co_return *cached;
         }
 
+        const std::uint64_t generation = hotCacheGeneration(_connector_record_cache, name);
         const auto record_handle_opt = _store->getConnectorRecordHandle(name);
 
         spdlog::debug(
@@ -1132,22 +1411,37 @@ namespace dcn::registry
             record_handle_opt.has_value(),
             record_handle_opt.has_value() ? static_cast<bool>(*record_handle_opt) : false);
 
-        putHotCacheEntry(_connector_record_cache, name, record_handle_opt);
+        fillHotCacheEntry(_connector_record_cache, name, record_handle_opt, generation);
         
         spdlog::debug("Registry::getConnectorRecordHandle('{}'): done", name);
 
         co_return record_handle_opt;
     }
 
+    asio::awaitable<std::vector<std::optional<ConnectorRecordHandle>>> Registry::getConnectorRecordHandles(
+        std::span<const std::string> names) const
+    {
+        co_return resolveRecordHandles(
+            _connector_record_cache,
+            _connector_filter,
+            names,
+            [this](std::span<const std::string> missing_names)
+            {
+                return _store->getConnectorRecordHandles(missing_names);
+            });
+    }
+
     asio::awaitable<bool> Registry::hasConnector(const std::string & name) const
     {
         spdlog::debug("Registry::hasConnector('{}'): enter", name);
 
-        co_await async::ensureOnStrand(_strand);
-        
-        spdlog::debug("Registry::hasConnector('{}'): on strand", name);
+        if(!_connector_filter.mayContain(name))
+        {
+            spdlog::debug("Registry::hasConnector('{}'): filter negative", name);
+            co_return false;
+        }
 
-        if(const auto * cached = getHotCacheEntry(_connector_record_cache, name))
+        if(const auto cached = getHotCacheEntry(_connector_record_cache, name))
         {
             const bool cache_has_record = cached->has_value() && static_cast<bool>(cached->value());
             spdlog::debug("Registry::hasConnector('{}'): cache hit has_record={}", name, cache_has_record);
@@ -1157,34 +1451,38 @@ namespace dcn::registry
             }
         }
 
+        const std::uint64_t generation = hotCacheGeneration(_connector_record_cache, name);
         const bool exists = _store->hasConnector(name);
         
         spdlog::debug("Registry::hasConnector('{}'): store result={}", name, exists);
         
         if(!exists)
         {
-            putHotCacheEntry(_connector_record_cache, name, std::nullopt);
+            fillHotCacheEntry(_connector_record_cache, name, std::nullopt, generation);
         }
         co_return exists;
     }
 
     asio::awaitable<std::optional<evmc::bytes32>> Registry::getFormatHash(const std::string & name) const
     {
-        co_await async::ensureOnStrand(_strand);
+        if(!_connector_filter.mayContain(name))
+        {
+            co_return std::nullopt;
+        }
 
-        if(const auto * cached = getHotCacheEntry(_format_hash_cache, name))
+        if(const auto cached = getHotCacheEntry(_format_hash_cache, name))
         {
             co_return *cached;
         }
 
+        const std::uint64_t generation = hotCacheGeneration(_format_hash_cache, name);
         const auto format_hash_opt = _store->getConnectorFormatHash(name);
-        putHotCacheEntry(_format_hash_cache, name, format_hash_opt);
+        fillHotCacheEntry(_format_hash_cache, name, format_hash_opt, generation);
         co_return format_hash_opt;
     }
 
     asio::awaitable<std::size_t> Registry::getFormatConnectorNamesCount(const evmc::bytes32 & format_hash) const
     {
-        co_await async::ensureOnStrand(_strand);
         co_return _store->getFormatConnectorNamesCount(format_hash);
     }
 
@@ -1193,13 +1491,11 @@ namespace dcn::registry
         const std::optional<NameCursor> & after,
         std::size_t limit) const
     {
-        co_await async::ensureOnStrand(_strand);
         co_return _store->getFormatConnectorNamesCursor(format_hash, after, limit);
     }
 
     asio::awaitable<std::size_t> Registry::getFormatsCount() const
     {
-        co_await async::ensureOnStrand(_strand);
         co_return _store->getFormatsCount();
     }
 
@@ -1207,17 +1503,56 @@ namespace dcn::registry
         const std::optional<evmc::bytes32> & after,
         std::size_t limit) const
     {
-        co_await async::ensureOnStrand(_strand);
         co_return _store->getFormatsCursor(after, limit);
     }
 
     asio::awaitable<std::optional<std::vector<ScalarLabel>>> Registry::getScalarLabelsByFormatHash(
         const evmc::bytes32 & format_hash) const
     {
-        co_await async::ensureOnStrand(_strand);
         co_return _store->getScalarLabelsByFormatHash(format_hash);
     }
 
+    asio::awaitable<FormatSearchResult> Registry::searchFormatsByScalarLabels(
+        std::vector<std::string> labels,
+        std::size_t min_shared,
+        std::size_t limit) const
+    {
+        co_return _label_index.search(labels, min_shared, limit);
+    }
+
+    ScalarLabelIndexStats Registry::labelIndexStats() const
+    {
+        return _label_index.stats();
+    }
+
+    asio::awaitable<bool> Registry::exportSnapshot(std::filesystem::path path) const
+    {
+        co_return _store->exportSnapshot(path);
+    }
+
+    asio::awaitable<bool> Registry::importSnapshot(std::filesystem::path path)
+    {
+        co_await async::ensureOnStrand(_strand);
+        _transformation_commits.flush();
+        _condition_commits.flush();
+        _connector_commits.flush();
+
+        if(!_store->importSnapshot(path))
+        {
+            co_return false;
+        }
+
+        // Lookups made before the import may have cached negative answers.
+        _connector_record_cache.clear();
+        _format_hash_cache.clear();
+        _transformation_record_cache.clear();
+        _condition_record_cache.clear();
+
+        _rebuildFilters(false);
+        _label_index.rebuild([this](const FormatLabelsVisitor & visitor) { return _store->forEachFormatScalarLabels(visitor); });
+        co_return true;
+    }
+
     asio::awaitable<bool> Registry::addTransformation(chain::Address address, TransformationRecord record)
     {
         const std::string transformation_name = record.transformation().name();
@@ -1228,6 +1563,10 @@ namespace dcn::registry
         }
 
         co_await async::ensureOnStrand(_strand);
+        if(_transformation_commits.isPending(transformation_name))
+        {
+            _transformation_commits.flush();
+        }
 
         const auto existing_record_handle_opt = _store->getTransformationRecordHandle(transformation_name);
         if(existing_record_handle_opt.has_value() && *existing_record_handle_opt)
@@ -1247,7 +1586,19 @@ namespace dcn::registry
             co_return true;
         }
 
+        if(_transformation_commits.enabled())
+        {
+            co_return co_await _transformation_commits.submit(
+                transformation_name,
+                TransformationBatchItem{
+                    .address = address,
+                    .record = std::move(record)
+                });
+        }
+
+        _transformation_filter.add(transformation_name);
         const bool inserted = _store->addTransformation(address, record);
+        _rebuildFilters(true);
         if(inserted)
         {
             putHotCacheEntry(
@@ -1265,6 +1616,7 @@ namespace dcn::registry
         bool all_or_nothing)
     {
         co_await async::ensureOnStrand(_strand);
+        _transformation_commits.flush();
 
         std::vector<TransformationBatchItem> batch_items;
         batch_items.reserve(transformations.size());
@@ -1330,23 +1682,8 @@ namespace dcn::registry
             co_return all_valid;
         }
 
-        const bool inserted = _store->addTransformationsBatch(batch_items, all_or_nothing);
-        if(inserted || !all_or_nothing)
-        {
-            for(const auto & item : batch_items)
-            {
-                if(!_store->hasTransformation(item.record.transformation().name()))
-                {
-                    continue;
-                }
-                putHotCacheEntry(
-                    _transformation_record_cache,
-                    item.record.transformation().name(),
-                    std::optional<TransformationRecordHandle>(
-                        std::make_shared<TransformationRecord>(item.record)));
-            }
-        }
-
+        std::vector<bool> inserted_items;
+        const bool inserted = _commitTransformations(batch_items, all_or_nothing, inserted_items);
         co_return inserted && all_valid;
     }
 
@@ -1355,11 +1692,13 @@ namespace dcn::registry
     {
         spdlog::debug("Registry::getTransformationRecordHandle('{}'): enter", name);
 
-        co_await async::ensureOnStrand(_strand);
-        
-        spdlog::debug("Registry::getTransformationRecordHandle('{}'): on strand", name);
+        if(!_transformation_filter.mayContain(name))
+        {
+            spdlog::debug("Registry::getTransformationRecordHandle('{}'): filter negative", name);
+            co_return std::nullopt;
+        }
 
-        if(const auto * cached = getHotCacheEntry(_transformation_record_cache, name))
+        if(const auto cached = getHotCacheEntry(_transformation_record_cache, name))
         {
             spdlog::debug(
                 "Registry::getTransformationRecordHandle('{}'): cache hit has_value={}",
@@ -1369,6 +1708,7 @@ namespace dcn::registry
             co_return *cached;
         }
 
+        const std::uint64_t generation = hotCacheGeneration(_transformation_record_cache, name);
         const auto record_handle_opt = _store->getTransformationRecordHandle(name);
             
         spdlog::debug(
@@ -1377,21 +1717,36 @@ namespace dcn::registry
             record_handle_opt.has_value(),
             record_handle_opt.has_value() ? static_cast<bool>(*record_handle_opt) : false);
 
-        putHotCacheEntry(_transformation_record_cache, name, record_handle_opt);
+        fillHotCacheEntry(_transformation_record_cache, name, record_handle_opt, generation);
         
         spdlog::debug("Registry::getTransformationRecordHandle('{}'): done", name);
         co_return record_handle_opt;
     }
 
+    asio::awaitable<std::vector<std::optional<TransformationRecordHandle>>> Registry::getTransformationRecordHandles(
+        std::span<const std::string> names) const
+    {
+        co_return resolveRecordHandles(
+            _transformation_record_cache,
+            _transformation_filter,
+            names,
+            [this](std::span<const std::string> missing_names)
+            {
+                return _store->getTransformationRecordHandles(missing_names);
+            });
+    }
+
     asio::awaitable<bool> Registry::hasTransformation(const std::string & name) const
     {
         spdlog::debug("Registry::hasTransformation('{}'): enter", name);
 
-        co_await async::ensureOnStrand(_strand);
-        
-        spdlog::debug("Registry::hasTransformation('{}'): on strand", name);
+        if(!_transformation_filter.mayContain(name))
+        {
+            spdlog::debug("Registry::hasTransformation('{}'): filter negative", name);
+            co_return false;
+        }
 
-        if(const auto * cached = getHotCacheEntry(_transformation_record_cache, name))
+        if(const auto cached = getHotCacheEntry(_transformation_record_cache, name))
         {
             const bool cache_has_record = cached->has_value() && static_cast<bool>(cached->value());
             
@@ -1403,13 +1758,14 @@ namespace dcn::registry
             }
         }
 
+        const std::uint64_t generation = hotCacheGeneration(_transformation_record_cache, name);
         const bool exists = _store->hasTransformation(name);
         
         spdlog::debug("Registry::hasTransformation('{}'): store result={}", name, exists);
         
         if(!exists)
         {
-            putHotCacheEntry(_transformation_record_cache, name, std::nullopt);
+            fillHotCacheEntry(_transformation_record_cache, name, std::nullopt, generation);
         }
         co_return exists;
     }
@@ -1424,6 +1780,10 @@ namespace dcn::registry
         }
 
         co_await async::ensureOnStrand(_strand);
+        if(_condition_commits.isPending(condition_name))
+        {
+            _condition_commits.flush();
+        }
 
         const auto existing_record_handle_opt = _store->getConditionRecordHandle(condition_name);
         if(existing_record_handle_opt.has_value() && *existing_record_handle_opt)
@@ -1443,7 +1803,19 @@ namespace dcn::registry
             co_return true;
         }
 
+        if(_condition_commits.enabled())
+        {
+            co_return co_await _condition_commits.submit(
+                condition_name,
+                ConditionBatchItem{
+                    .address = address,
+                    .record = std::move(record)
+                });
+        }
+
+        _condition_filter.add(condition_name);
         const bool inserted = _store->addCondition(address, record);
+        _rebuildFilters(true);
         if(inserted)
         {
             putHotCacheEntry(
@@ -1461,6 +1833,7 @@ namespace dcn::registry
         bool all_or_nothing)
     {
         co_await async::ensureOnStrand(_strand);
+        _condition_commits.flush();
 
         std::vector<ConditionBatchItem> batch_items;
         batch_items.reserve(conditions.size());
@@ -1526,23 +1899,8 @@ namespace dcn::registry
             co_return all_valid;
         }
 
-        const bool inserted = _store->addConditionsBatch(batch_items, all_or_nothing);
-        if(inserted || !all_or_nothing)
-        {
-            for(const auto & item : batch_items)
-            {
-                if(!_store->hasCondition(item.record.condition().name()))
-                {
-                    continue;
-                }
-                putHotCacheEntry(
-                    _condition_record_cache,
-                    item.record.condition().name(),
-                    std::optional<ConditionRecordHandle>(
-                        std::make_shared<ConditionRecord>(item.record)));
-            }
-        }
-
+        std::vector<bool> inserted_items;
+        const bool inserted = _commitConditions(batch_items, all_or_nothing, inserted_items);
         co_return inserted && all_valid;
     }
 
@@ -1551,16 +1909,19 @@ namespace dcn::registry
     {
         spdlog::debug("Registry::getConditionRecordHandle('{}'): enter", name);
 
-        co_await async::ensureOnStrand(_strand);
-        
-        spdlog::debug("Registry::getConditionRecordHandle('{}'): on strand", name);
+        if(!_condition_filter.mayContain(name))
+        {
+            spdlog::debug("Registry::getConditionRecordHandle('{}'): filter negative", name);
+            co_return std::nullopt;
+        }
 
-        if(const auto * cached = getHotCacheEntry(_condition_record_cache, name))
+        if(const auto cached = getHotCacheEntry(_condition_record_cache, name))
         {
             spdlog::debug("Registry::getConditionRecordHandle('{}'): cache hit has_value={}", name, cached->has_value());
             co_return *cached;
         }
 
+        const std::uint64_t generation = hotCacheGeneration(_condition_record_cache, name);
         const auto record_handle_opt = _store->getConditionRecordHandle(name);
         
         spdlog::debug(
@@ -1569,22 +1930,37 @@ namespace dcn::registry
             record_handle_opt.has_value(),
             record_handle_opt.has_value() ? static_cast<bool>(*record_handle_opt) : false);
         
-        putHotCacheEntry(_condition_record_cache, name, record_handle_opt);
+        fillHotCacheEntry(_condition_record_cache, name, record_handle_opt, generation);
         
         spdlog::debug("Registry::getConditionRecordHandle('{}'): done", name);
         
         co_return record_handle_opt;
     }
 
+    asio::awaitable<std::vector<std::optional<ConditionRecordHandle>>> Registry::getConditionRecordHandles(
+        std::span<const std::string> names) const
+    {
+        co_return resolveRecordHandles(
+            _condition_record_cache,
+            _condition_filter,
+            names,
+            [this](std::span<const std::string> missing_names)
+            {
+                return _store->getConditionRecordHandles(missing_names);
+            });
+    }
+
     asio::awaitable<bool> Registry::hasCondition(const std::string & name) const
     {
         spdlog::debug("Registry::hasCondition('{}'): enter", name);
 
-        co_await async::ensureOnStrand(_strand);
-        
-        spdlog::debug("Registry::hasCondition('{}'): on strand", name);
+        if(!_condition_filter.mayContain(name))
+        {
+            spdlog::debug("Registry::hasCondition('{}'): filter negative", name);
+            co_return false;
+        }
 
-        if(const auto * cached = getHotCacheEntry(_condition_record_cache, name))
+        if(const auto cached = getHotCacheEntry(_condition_record_cache, name))
         {
             const bool cache_has_record = cached->has_value() && static_cast<bool>(cached->value());
             
@@ -1596,13 +1972,14 @@ namespace dcn::registry
             }
         }
 
+        const std::uint64_t generation = hotCacheGeneration(_condition_record_cache, name);
         const bool exists = _store->hasCondition(name);
         
         spdlog::debug("Registry::hasCondition('{}'): store result={}", name, exists);
         
         if(!exists)
         {
-            putHotCacheEntry(_condition_record_cache, name, std::nullopt);
+            fillHotCacheEntry(_condition_record_cache, name, std::nullopt, generation);
         }
         co_return exists;
     }
@@ -1612,7 +1989,6 @@ namespace dcn::registry
         const std::optional<NameCursor> & after,
         std::size_t limit) const
     {
-        co_await async::ensureOnStrand(_strand);
         co_return _store->getOwnedConnectorsCursor(owner, after, limit);
     }
 
@@ -1621,7 +1997,6 @@ namespace dcn::registry
         const std::optional<NameCursor> & after,
         std::size_t limit) const
     {
-        co_await async::ensureOnStrand(_strand);
         co_return _store->getOwnedTransformationsCursor(owner, after, limit);
     }
 
@@ -1630,21 +2005,46 @@ namespace dcn::registry
         const std::optional<NameCursor> & after,
         std::size_t limit) const
     {
-        co_await async::ensureOnStrand(_strand);
         co_return _store->getOwnedConditionsCursor(owner, after, limit);
     }
 
     asio::awaitable<std::size_t> Registry::getAccountsCount() const
     {
-        co_await async::ensureOnStrand(_strand);
         co_return _store->getAccountsCount();
     }
 
+    asio::awaitable<std::size_t> Registry::getConnectorsCount() const
+    {
+        co_return _store->getConnectorsCount();
+    }
+
+    asio::awaitable<std::size_t> Registry::getTransformationsCount() const
+    {
+        co_return _store->getTransformationsCount();
+    }
+
+    asio::awaitable<std::string> Registry::getWriteMarker() const
+    {
+        co_return _store->getWriteMarker();
+    }
+
+    asio::awaitable<std::size_t> Registry::getConditionsCount() const
+    {
+        co_return _store->getConditionsCount();
+    }
+
+    asio::awaitable<std::vector<std::string>> Registry::getConnectorNames() const
+    {
+        std::vector<std::string> names;
+        names.reserve(_store->getConnectorsCount());
+        _store->forEachConnectorName([&names](const std::string & name) { names.push_back(name); });
+        co_return names;
+    }
+
     asio::awaitable<NameCursorPage> Registry::getAccountsCursor(
         const std::optional<chain::Address> & after,
         std::size_t limit) const
     {
-        co_await async::ensureOnStrand(_strand);
         co_return _store->getAccountsCursor(after, limit);
     }
 
@@ -1658,6 +2058,25 @@ namespace dcn::registry
         co_return stats;
     }
 
+    std::vector<NameFilterStats> Registry::filterStats() const
+    {
+        return {
+            _connector_filter.stats(),
+            _transformation_filter.stats(),
+            _condition_filter.stats()
+        };
+    }
+
+    std::vector<HotCacheStats> Registry::cacheStats() const
+    {
+        return {
+            _connector_record_cache.stats(),
+            _format_hash_cache.stats(),
+            _transformation_record_cache.stats(),
+            _condition_record_cache.stats()
+        };
+    }
+
     asio::awaitable<bool> Registry::add(chain::Address address, ConnectorRecord connector)
     {
         return addConnector(address, std::move(connector));
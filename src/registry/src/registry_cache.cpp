@@ -0,0 +1,101 @@
+#include <algorithm>
+
+#include "registry_cache.hpp"
+
+namespace dcn::registry
+{
+    namespace
+    {
+        constexpr std::size_t MIN_SKETCH_WIDTH = 64;
+        constexpr std::size_t MAX_SKETCH_WIDTH = std::size_t{1} << 20;
+        constexpr std::array<std::uint64_t, 4> SKETCH_SEEDS{
+            0x9E3779B97F4A7C15ull,
+            0xC2B2AE3D27D4EB4Full,
+            0x165667B19E3779F9ull,
+            0xD6E8FEB86659FD93ull
+        };
+
+        static std::size_t nextPowerOfTwo(std::size_t value)
+        {
+            std::size_t out = 1;
+            while(out < value)
+            {
+                out <<= 1;
+            }
+            return out;
+        }
+    }
+
+    RegistryCacheConfig makeRegistryCacheConfig(std::size_t total_bytes)
+    {
+        return RegistryCacheConfig{
+            .connector_record_bytes = total_bytes / 2,
+            .format_hash_bytes = total_bytes / 12,
+            .transformation_record_bytes = total_bytes / 4,
+            .condition_record_bytes = total_bytes / 6
+        };
+    }
+
+    void FrequencySketch::resize(std::size_t expected_entries)
+    {
+        const std::size_t width = nextPowerOfTwo(std::clamp(expected_entries, MIN_SKETCH_WIDTH, MAX_SKETCH_WIDTH));
+        _counters.assign(width * kDepth, 0);
+        _width_mask = width - 1;
+        _additions = 0;
+        _sample_size = width * 10;
+    }
+
+    std::size_t FrequencySketch::_index(std::uint64_t hash, std::size_t row) const
+    {
+        const std::uint64_t mixed = (hash + SKETCH_SEEDS[row]) * SKETCH_SEEDS[row];
+        return row * (_width_mask + 1) + static_cast<std::size_t>((mixed >> 32) & _width_mask);
+    }
+
+    void FrequencySketch::increment(std::uint64_t hash)
+    {
+        if(_counters.empty())
+        {
+            return;
+        }
+
+        bool incremented = false;
+        for(std::size_t row = 0; row < kDepth; ++row)
+        {
+            std::uint8_t & counter = _counters[_index(hash, row)];
+            if(counter < kMaxCount)
+            {
+                ++counter;
+                incremented = true;
+            }
+        }
+
+        if(incremented && ++_additions >= _sample_size)
+        {
+            _age();
+        }
+    }
+
+    std::uint8_t FrequencySketch::estimate(std::uint64_t hash) const
+    {
+        if(_counters.empty())
+        {
+            return 0;
+        }
+
+        std::uint8_t out = kMaxCount;
+        for(std::size_t row = 0; row < kDepth; ++row)
+        {
+            out = std::min(out, _counters[_index(hash, row)]);
+        }
+        return out;
+    }
+
+    void FrequencySketch::_age()
+    {
+        for(std::uint8_t & counter : _counters)
+        {
+            counter >>= 1;
+        }
+        _additions /= 2;
+    }
+}
@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+#include <absl/hash/hash.h>
+#include <spdlog/spdlog.h>
+
+#include "registry_filter.hpp"
+
+namespace dcn::registry
+{
+    namespace
+    {
+        constexpr std::size_t WORDS_PER_BLOCK = 8;
+        constexpr std::size_t BITS_PER_BLOCK = WORDS_PER_BLOCK * 64;
+        constexpr std::uint64_t BIT_SALT = 0x9E3779B97F4A7C15ull;
+
+        static std::uint64_t hashName(std::string_view name)
+        {
+            return static_cast<std::uint64_t>(absl::Hash<std::string_view>{}(name));
+        }
+
+        static std::size_t blockIndex(std::uint64_t hash, std::size_t block_count)
+        {
+            // Multiply-shift range reduction on the upper half; the lower half picks bits.
+            return static_cast<std::size_t>(((hash >> 32) * static_cast<std::uint64_t>(block_count)) >> 32);
+        }
+
+        static std::uint64_t wordMask(std::uint64_t hash, std::size_t word)
+        {
+            const std::uint64_t mixed = (static_cast<std::uint32_t>(hash) ^ (BIT_SALT >> (word * 8))) * BIT_SALT;
+            return std::uint64_t{1} << (mixed >> 58);
+        }
+    }
+
+    NameFilter::Blocks::Blocks(std::size_t block_count_)
+        : block_count(block_count_)
+        , capacity(block_count_ * BITS_PER_BLOCK / NameFilter::kBitsPerKey)
+        , words(block_count_ * WORDS_PER_BLOCK)
+    {
+    }
+
+    NameFilter::NameFilter(const char * name)
+        : _name(name)
+    {
+    }
+
+    void NameFilter::_insert(Blocks & blocks, std::string_view name)
+    {
+        const std::uint64_t hash = hashName(name);
+        const std::size_t base = blockIndex(hash, blocks.block_count) * WORDS_PER_BLOCK;
+        for(std::size_t word = 0; word < WORDS_PER_BLOCK; ++word)
+        {
+            blocks.words[base + word].fetch_or(wordMask(hash, word), std::memory_order_relaxed);
+        }
+    }
+
+    bool NameFilter::_test(const Blocks & blocks, std::string_view name)
+    {
+        const std::uint64_t hash = hashName(name);
+        const std::size_t base = blockIndex(hash, blocks.block_count) * WORDS_PER_BLOCK;
+        for(std::size_t word = 0; word < WORDS_PER_BLOCK; ++word)
+        {
+            const std::uint64_t mask = wordMask(hash, word);
+            if((blocks.words[base + word].load(std::memory_order_relaxed) & mask) != mask)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void NameFilter::rebuild(
+        std::size_t expected_names,
+        const std::function<bool(const std::function<void(const std::string &)> &)> & source)
+    {
+        const std::size_t capacity = std::max(kMinCapacity, expected_names * 2);
+        const std::size_t block_count = (capacity * kBitsPerKey + BITS_PER_BLOCK - 1) / BITS_PER_BLOCK;
+
+        auto blocks = std::make_unique<Blocks>(block_count);
+        std::size_t inserted = 0;
+        const bool ok = source([&blocks, &inserted](const std::string & name)
+        {
+            _insert(*blocks, name);
+            ++inserted;
+        });
+
+        if(!ok)
+        {
+            spdlog::error("Failed to rebuild registry name filter [{}]; lookups fall back to the store", _name);
+            const std::unique_lock<std::shared_mutex> lock(_mutex);
+            _blocks.reset();
+            _inserted.store(0, std::memory_order_relaxed);
+            return;
+        }
+
+        {
+            const std::unique_lock<std::shared_mutex> lock(_mutex);
+            _blocks = std::move(blocks);
+            _inserted.store(inserted, std::memory_order_relaxed);
+        }
+
+        const NameFilterStats filter_stats = stats();
+        spdlog::info(
+            "Registry name filter [{}] built: names={} capacity={} memory_bytes={} estimated_fp_rate={:.5f}",
+            _name,
+            filter_stats.inserted,
+            filter_stats.capacity,
+            filter_stats.memory_bytes,
+            filter_stats.estimated_false_positive_rate);
+    }
+
+    void NameFilter::add(std::string_view name)
+    {
+        const std::shared_lock<std::shared_mutex> lock(_mutex);
+        if(!_blocks)
+        {
+            return;
+        }
+        _insert(*_blocks, name);
+        _inserted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool NameFilter::mayContain(std::string_view name) const
+    {
+        const std::shared_lock<std::shared_mutex> lock(_mutex);
+        if(!_blocks)
+        {
+            return true;
+        }
+
+        _probes.fetch_add(1, std::memory_order_relaxed);
+        if(_test(*_blocks, name))
+        {
+            return true;
+        }
+
+        _definite_negatives.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    bool NameFilter::needsGrowth() const
+    {
+        const std::shared_lock<std::shared_mutex> lock(_mutex);
+        return _blocks && _inserted.load(std::memory_order_relaxed) > _blocks->capacity;
+    }
+
+    NameFilterStats NameFilter::stats() const
+    {
+        NameFilterStats out;
+        out.name = _name;
+        out.inserted = _inserted.load(std::memory_order_relaxed);
+        out.probes = _probes.load(std::memory_order_relaxed);
+        out.definite_negatives = _definite_negatives.load(std::memory_order_relaxed);
+
+        const std::shared_lock<std::shared_mutex> lock(_mutex);
+        if(!_blocks)
+        {
+            out.estimated_false_positive_rate = 1.0;
+            return out;
+        }
+
+        out.capacity = _blocks->capacity;
+        out.memory_bytes = _blocks->words.size() * sizeof(std::uint64_t);
+
+        // One bit per word within a block: each word behaves as a 64-bit Bloom filter with k=1
+        // loaded by the names that hashed to its block.
+        const double names_per_block =
+            static_cast<double>(out.inserted) / static_cast<double>(_blocks->block_count);
+        const double word_fill = 1.0 - std::exp(-names_per_block / 64.0);
+        out.estimated_false_positive_rate = std::pow(word_fill, static_cast<double>(WORDS_PER_BLOCK));
+        return out;
+    }
+}
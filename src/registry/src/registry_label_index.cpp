@@ -0,0 +1,451 @@
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <iterator>
+#include <mutex>
+
+#include <spdlog/spdlog.h>
+
+#include "registry_label_index.hpp"
+
+namespace dcn::registry
+{
+    namespace
+    {
+        // Galloping beats a linear merge once one side is this many times larger.
+        constexpr std::size_t GALLOP_RATIO = 32;
+
+        static void setBit(std::vector<std::uint64_t> & bits, std::uint16_t low)
+        {
+            bits[low >> 6] |= std::uint64_t{1} << (low & 63);
+        }
+
+        static bool testBit(const std::vector<std::uint64_t> & bits, std::uint16_t low)
+        {
+            return (bits[low >> 6] >> (low & 63)) & 1u;
+        }
+    }
+
+    void PostingBitmap::add(std::uint32_t id)
+    {
+        const std::uint16_t key = static_cast<std::uint16_t>(id >> 16);
+        const std::uint16_t low = static_cast<std::uint16_t>(id & 0xFFFF);
+
+        auto container_it = _containers.end();
+        if(_containers.empty() || _containers.back().key < key)
+        {
+            _containers.push_back(Container{.key = key});
+            container_it = std::prev(_containers.end());
+        }
+        else
+        {
+            container_it = std::lower_bound(
+                _containers.begin(),
+                _containers.end(),
+                key,
+                [](const Container & container, std::uint16_t value) { return container.key < value; });
+            if(container_it == _containers.end() || container_it->key != key)
+            {
+                container_it = _containers.insert(container_it, Container{.key = key});
+            }
+        }
+
+        Container & container = *container_it;
+        if(container.isBitmap())
+        {
+            if(!testBit(container.bits, low))
+            {
+                setBit(container.bits, low);
+                ++container.cardinality;
+            }
+            return;
+        }
+
+        const auto low_it = (container.array.empty() || container.array.back() < low)
+            ? container.array.end()
+            : std::lower_bound(container.array.begin(), container.array.end(), low);
+        if(low_it != container.array.end() && *low_it == low)
+        {
+            return;
+        }
+        container.array.insert(low_it, low);
+        ++container.cardinality;
+
+        if(container.cardinality > kArrayMaxCardinality)
+        {
+            container.bits.assign(kBitmapWords, 0);
+            for(const std::uint16_t value : container.array)
+            {
+                setBit(container.bits, value);
+            }
+            container.array.clear();
+            container.array.shrink_to_fit();
+        }
+    }
+
+    bool PostingBitmap::contains(std::uint32_t id) const
+    {
+        const std::uint16_t key = static_cast<std::uint16_t>(id >> 16);
+        const std::uint16_t low = static_cast<std::uint16_t>(id & 0xFFFF);
+
+        const auto container_it = std::lower_bound(
+            _containers.begin(),
+            _containers.end(),
+            key,
+            [](const Container & container, std::uint16_t value) { return container.key < value; });
+        if(container_it == _containers.end() || container_it->key != key)
+        {
+            return false;
+        }
+
+        if(container_it->isBitmap())
+        {
+            return testBit(container_it->bits, low);
+        }
+        return std::binary_search(container_it->array.begin(), container_it->array.end(), low);
+    }
+
+    std::size_t PostingBitmap::cardinality() const
+    {
+        std::size_t total = 0;
+        for(const Container & container : _containers)
+        {
+            total += container.cardinality;
+        }
+        return total;
+    }
+
+    std::size_t PostingBitmap::memoryBytes() const
+    {
+        std::size_t total = _containers.capacity() * sizeof(Container);
+        for(const Container & container : _containers)
+        {
+            total += container.array.capacity() * sizeof(std::uint16_t);
+            total += container.bits.capacity() * sizeof(std::uint64_t);
+        }
+        return total;
+    }
+
+    PostingBitmap::Container PostingBitmap::_intersectContainers(const Container & lhs, const Container & rhs)
+    {
+        Container out{.key = lhs.key};
+
+        if(lhs.isBitmap() && rhs.isBitmap())
+        {
+            // Plain word loop: the compiler vectorizes the AND and the popcount reduction.
+            out.bits.resize(kBitmapWords);
+            std::uint32_t cardinality = 0;
+            for(std::size_t word = 0; word < kBitmapWords; ++word)
+            {
+                out.bits[word] = lhs.bits[word] & rhs.bits[word];
+                cardinality += static_cast<std::uint32_t>(std::popcount(out.bits[word]));
+            }
+            out.cardinality = cardinality;
+
+            if(cardinality <= kArrayMaxCardinality)
+            {
+                out.array.reserve(cardinality);
+                for(std::size_t word = 0; word < kBitmapWords; ++word)
+                {
+                    for(std::uint64_t bits = out.bits[word]; bits != 0; bits &= bits - 1)
+                    {
+                        out.array.push_back(static_cast<std::uint16_t>(word * 64 + std::countr_zero(bits)));
+                    }
+                }
+                out.bits.clear();
+            }
+            return out;
+        }
+
+        if(lhs.isBitmap() || rhs.isBitmap())
+        {
+            const Container & array_side = lhs.isBitmap() ? rhs : lhs;
+            const Container & bitmap_side = lhs.isBitmap() ? lhs : rhs;
+            for(const std::uint16_t value : array_side.array)
+            {
+                if(testBit(bitmap_side.bits, value))
+                {
+                    out.array.push_back(value);
+                }
+            }
+            out.cardinality = static_cast<std::uint32_t>(out.array.size());
+            return out;
+        }
+
+        const std::vector<std::uint16_t> & small = lhs.array.size() <= rhs.array.size() ? lhs.array : rhs.array;
+        const std::vector<std::uint16_t> & large = lhs.array.size() <= rhs.array.size() ? rhs.array : lhs.array;
+        out.array.reserve(small.size());
+
+        if(small.size() * GALLOP_RATIO < large.size())
+        {
+            auto search_from = large.begin();
+            for(const std::uint16_t value : small)
+            {
+                search_from = std::lower_bound(search_from, large.end(), value);
+                if(search_from == large.end())
+                {
+                    break;
+                }
+                if(*search_from == value)
+                {
+                    out.array.push_back(value);
+                }
+            }
+        }
+        else
+        {
+            std::set_intersection(
+                small.begin(), small.end(),
+                large.begin(), large.end(),
+                std::back_inserter(out.array));
+        }
+
+        out.cardinality = static_cast<std::uint32_t>(out.array.size());
+        return out;
+    }
+
+    PostingBitmap PostingBitmap::intersect(const PostingBitmap & other) const
+    {
+        PostingBitmap out;
+        auto lhs_it = _containers.begin();
+        auto rhs_it = other._containers.begin();
+        while(lhs_it != _containers.end() && rhs_it != other._containers.end())
+        {
+            if(lhs_it->key < rhs_it->key)
+            {
+                ++lhs_it;
+                continue;
+            }
+            if(rhs_it->key < lhs_it->key)
+            {
+                ++rhs_it;
+                continue;
+            }
+
+            Container container = _intersectContainers(*lhs_it, *rhs_it);
+            if(container.cardinality > 0)
+            {
+                out._containers.push_back(std::move(container));
+            }
+            ++lhs_it;
+            ++rhs_it;
+        }
+        return out;
+    }
+
+    void PostingBitmap::forEach(const std::function<void(std::uint32_t)> & visitor) const
+    {
+        for(const Container & container : _containers)
+        {
+            const std::uint32_t base = static_cast<std::uint32_t>(container.key) << 16;
+            if(!container.isBitmap())
+            {
+                for(const std::uint16_t value : container.array)
+                {
+                    visitor(base | value);
+                }
+                continue;
+            }
+
+            for(std::size_t word = 0; word < kBitmapWords; ++word)
+            {
+                for(std::uint64_t bits = container.bits[word]; bits != 0; bits &= bits - 1)
+                {
+                    visitor(base | static_cast<std::uint32_t>(word * 64 + std::countr_zero(bits)));
+                }
+            }
+        }
+    }
+
+    std::string ScalarLabelIndex::labelKey(const chain::ScalarLabel & label)
+    {
+        return std::format("{}:{}", label.scalar, label.tail_id);
+    }
+
+    void ScalarLabelIndex::_addLocked(const evmc::bytes32 & format_hash, const std::vector<chain::ScalarLabel> & labels)
+    {
+        if(_format_ids.contains(format_hash))
+        {
+            return;
+        }
+
+        const std::uint32_t format_id = static_cast<std::uint32_t>(_formats.size());
+        _format_ids.emplace(format_hash, format_id);
+        _formats.push_back(format_hash);
+
+        std::vector<std::string> keys;
+        keys.reserve(labels.size());
+        for(const chain::ScalarLabel & label : labels)
+        {
+            keys.push_back(labelKey(label));
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        for(const std::string & key : keys)
+        {
+            _postings[key].add(format_id);
+        }
+        _format_label_counts.push_back(static_cast<std::uint32_t>(keys.size()));
+    }
+
+    bool ScalarLabelIndex::rebuild(const std::function<bool(const FormatLabelsVisitor &)> & source)
+    {
+        const std::unique_lock<std::shared_mutex> lock(_mutex);
+        _formats.clear();
+        _format_label_counts.clear();
+        _format_ids.clear();
+        _postings.clear();
+
+        const bool ok = source([this](const evmc::bytes32 & format_hash, const std::vector<chain::ScalarLabel> & labels)
+        {
+            _addLocked(format_hash, labels);
+        });
+
+        if(!ok)
+        {
+            spdlog::error("Failed to build scalar label index; format search returns partial results");
+            return false;
+        }
+
+        std::size_t memory_bytes = 0;
+        for(const auto & [_, posting] : _postings)
+        {
+            memory_bytes += posting.memoryBytes();
+        }
+        spdlog::info(
+            "Scalar label index built: formats={} labels={} posting_bytes={}",
+            _formats.size(),
+            _postings.size(),
+            memory_bytes);
+        return true;
+    }
+
+    void ScalarLabelIndex::add(const evmc::bytes32 & format_hash, const std::vector<chain::ScalarLabel> & labels)
+    {
+        const std::unique_lock<std::shared_mutex> lock(_mutex);
+        _addLocked(format_hash, labels);
+    }
+
+    FormatSearchResult ScalarLabelIndex::search(
+        const std::vector<std::string> & labels,
+        std::size_t min_shared,
+        std::size_t limit) const
+    {
+        std::vector<std::string> query(labels);
+        std::sort(query.begin(), query.end());
+        query.erase(std::unique(query.begin(), query.end()), query.end());
+
+        FormatSearchResult result;
+        if(query.empty() || min_shared == 0 || min_shared > query.size())
+        {
+            return result;
+        }
+
+        const std::shared_lock<std::shared_mutex> lock(_mutex);
+
+        std::vector<const PostingBitmap *> postings;
+        postings.reserve(query.size());
+        for(const std::string & label : query)
+        {
+            const auto it = _postings.find(label);
+            if(it != _postings.end())
+            {
+                postings.push_back(&it->second);
+            }
+        }
+        if(postings.size() < min_shared)
+        {
+            return result;
+        }
+
+        std::vector<std::uint32_t> matched_ids;
+        std::vector<std::uint32_t> shared_counts;
+        if(min_shared == query.size())
+        {
+            // Superset query: intersect smallest postings first so the running set shrinks fastest.
+            std::sort(
+                postings.begin(),
+                postings.end(),
+                [](const PostingBitmap * lhs, const PostingBitmap * rhs) { return lhs->cardinality() < rhs->cardinality(); });
+
+            PostingBitmap intersection = *postings.front();
+            for(std::size_t i = 1; i < postings.size() && intersection.cardinality() > 0; ++i)
+            {
+                intersection = intersection.intersect(*postings[i]);
+            }
+            intersection.forEach([&matched_ids](std::uint32_t id) { matched_ids.push_back(id); });
+            shared_counts.assign(matched_ids.size(), static_cast<std::uint32_t>(query.size()));
+        }
+        else
+        {
+            // Sized to the ids the postings can touch rather than to every registered format.
+            std::size_t touched_bound = 0;
+            for(const PostingBitmap * posting : postings)
+            {
+                touched_bound += posting->cardinality();
+            }
+
+            absl::flat_hash_map<std::uint32_t, std::uint32_t> counts;
+            counts.reserve(std::min(touched_bound, _formats.size()));
+            for(const PostingBitmap * posting : postings)
+            {
+                posting->forEach([&counts](std::uint32_t id) { ++counts[id]; });
+            }
+
+            for(const auto & [id, count] : counts)
+            {
+                if(count >= min_shared)
+                {
+                    matched_ids.push_back(id);
+                    shared_counts.push_back(count);
+                }
+            }
+        }
+
+        result.total_matches = matched_ids.size();
+        result.matches.reserve(matched_ids.size());
+        for(std::size_t i = 0; i < matched_ids.size(); ++i)
+        {
+            result.matches.push_back(FormatMatch{
+                .format_hash = _formats[matched_ids[i]],
+                .shared_labels = shared_counts[i],
+                .format_labels = _format_label_counts[matched_ids[i]]
+            });
+        }
+
+        const auto better = [](const FormatMatch & lhs, const FormatMatch & rhs)
+        {
+            if(lhs.shared_labels != rhs.shared_labels)
+            {
+                return lhs.shared_labels > rhs.shared_labels;
+            }
+            const std::size_t lhs_extra = lhs.format_labels - lhs.shared_labels;
+            const std::size_t rhs_extra = rhs.format_labels - rhs.shared_labels;
+            if(lhs_extra != rhs_extra)
+            {
+                return lhs_extra < rhs_extra;
+            }
+            return lhs.format_hash < rhs.format_hash;
+        };
+
+        const std::size_t keep = std::min(limit, result.matches.size());
+        std::partial_sort(result.matches.begin(), result.matches.begin() + keep, result.matches.end(), better);
+        result.matches.resize(keep);
+        return result;
+    }
+
+    ScalarLabelIndexStats ScalarLabelIndex::stats() const
+    {
+        const std::shared_lock<std::shared_mutex> lock(_mutex);
+
+        ScalarLabelIndexStats out;
+        out.formats = _formats.size();
+        out.labels = _postings.size();
+        for(const auto & [_, posting] : _postings)
+        {
+            out.memory_bytes += posting.memoryBytes();
+        }
+        return out;
+    }
+}
@@ -0,0 +1,571 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <absl/crc/crc32c.h>
+#include <spdlog/spdlog.h>
+#include <sqlite3.h>
+
+#include "sqlite/statement.hpp"
+#include "sqlite/exec.hpp"
+
+#include "sqlite_registry_store.hpp"
+
+namespace dcn::registry
+{
+    namespace
+    {
+        // File layout, all integers little-endian:
+        //   magic[8] | u32 format version | u32 registry schema version
+        //   per table, in SNAPSHOT_TABLES order:
+        //     u8 table index | u32 column count | (u8 1, column values)* | u8 0 | u64 row count
+        //   u8 0xFF | u32 CRC32C of every preceding byte
+        // A column value is a u8 tag followed by an i64, or a u32 length and that many bytes.
+        constexpr std::array<char, 8> SNAPSHOT_MAGIC{'D', 'C', 'N', 'R', 'S', 'N', 'A', 'P'};
+        constexpr std::uint32_t SNAPSHOT_FORMAT_VERSION = 1;
+        constexpr std::uint8_t SNAPSHOT_ROW = 1;
+        constexpr std::uint8_t SNAPSHOT_TABLE_END = 0;
+        constexpr std::uint8_t SNAPSHOT_END = 0xFF;
+        constexpr std::size_t SNAPSHOT_IO_CHUNK_BYTES = 1 << 20;
+        constexpr std::uint32_t MAX_SNAPSHOT_VALUE_BYTES = 16 * 1024 * 1024;
+        // Page cache for the import transaction, in KiB (negative cache_size).
+        constexpr int SNAPSHOT_IMPORT_CACHE_KIB = 256 * 1024;
+
+        enum class ValueTag : std::uint8_t
+        {
+            NULL_VALUE = 0,
+            INTEGER = 1,
+            TEXT = 2,
+            BLOB = 3
+        };
+
+        struct SnapshotTable
+        {
+            const char * name;
+            const char * column_names;
+            std::uint32_t column_count;
+            const char * primary_key;
+        };
+
+        // Authoritative tables only, each dumped in primary-key order so the import appends to its
+        // b-trees. `accounts`, `formats` and `registry_counters` are derived and rebuilt after loading.
+        constexpr std::array<SnapshotTable, 8> SNAPSHOT_TABLES{{
+            {"connectors", "name, owner, format_hash, payload_blob, created_at", 5, "name"},
+            {"transformations", "name, owner, payload_blob, created_at", 4, "name"},
+            {"conditions", "name, owner, payload_blob, created_at", 4, "name"},
+            {"format_members", "format_hash, name", 2, "format_hash, name"},
+            {"scalar_labels_by_format", "format_hash, scalar, path_hash, tail_id", 4, "format_hash, scalar, path_hash, tail_id"},
+            {"owned_connectors", "owner, name", 2, "owner, name"},
+            {"owned_transformations", "owner, name", 2, "owner, name"},
+            {"owned_conditions", "owner, name", 2, "owner, name"},
+        }};
+
+        static int readUserVersion(sqlite3 * db)
+        {
+            storage::sqlite::Statement stmt(db, "PRAGMA user_version;");
+            if(stmt.step() != SQLITE_ROW)
+            {
+                throw std::runtime_error("PRAGMA user_version returned no row");
+            }
+            return sqlite3_column_int(stmt.get(), 0);
+        }
+
+        // Buffered writer that checksums each chunk as it goes to disk.
+        class SnapshotWriter
+        {
+            public:
+                explicit SnapshotWriter(const std::filesystem::path & path)
+                    : _out(path, std::ios::binary | std::ios::trunc)
+                {
+                    if(!_out)
+                    {
+                        throw std::runtime_error("cannot open " + path.string());
+                    }
+                    _buffer.reserve(SNAPSHOT_IO_CHUNK_BYTES);
+                }
+
+                void bytes(const void * data, std::size_t size)
+                {
+                    if(size == 0)
+                    {
+                        return;
+                    }
+                    _buffer.append(static_cast<const char *>(data), size);
+                    if(_buffer.size() >= SNAPSHOT_IO_CHUNK_BYTES)
+                    {
+                        _flush();
+                    }
+                }
+
+                void u8(std::uint8_t value) { bytes(&value, 1); }
+
+                void u32(std::uint32_t value)
+                {
+                    std::array<std::uint8_t, 4> out{};
+                    for(std::size_t i = 0; i < out.size(); ++i)
+                    {
+                        out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+                    }
+                    bytes(out.data(), out.size());
+                }
+
+                void u64(std::uint64_t value)
+                {
+                    std::array<std::uint8_t, 8> out{};
+                    for(std::size_t i = 0; i < out.size(); ++i)
+                    {
+                        out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+                    }
+                    bytes(out.data(), out.size());
+                }
+
+                void finish()
+                {
+                    _flush();
+                    const std::uint32_t crc = static_cast<std::uint32_t>(_crc);
+                    u32(crc);
+                    _out.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+                    _buffer.clear();
+                    _out.flush();
+                    if(!_out)
+                    {
+                        throw std::runtime_error("snapshot write failed");
+                    }
+                }
+
+            private:
+                void _flush()
+                {
+                    _crc = absl::ExtendCrc32c(_crc, std::string_view(_buffer));
+                    _out.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+                    _buffer.clear();
+                    if(!_out)
+                    {
+                        throw std::runtime_error("snapshot write failed");
+                    }
+                }
+
+                std::ofstream _out;
+                std::string _buffer;
+                absl::crc32c_t _crc{0};
+        };
+
+        // Chunked reader over everything but the trailing checksum, which it verifies at the end.
+        class SnapshotReader
+        {
+            public:
+                explicit SnapshotReader(const std::filesystem::path & path)
+                    : _in(path, std::ios::binary)
+                {
+                    std::error_code ec;
+                    const std::uintmax_t file_size = std::filesystem::file_size(path, ec);
+                    if(!_in || ec || file_size < SNAPSHOT_MAGIC.size() + sizeof(std::uint32_t))
+                    {
+                        throw std::runtime_error("cannot open " + path.string());
+                    }
+                    _remaining = static_cast<std::size_t>(file_size) - sizeof(std::uint32_t);
+                }
+
+                void bytes(void * data, std::size_t size)
+                {
+                    auto * out = static_cast<char *>(data);
+                    while(size > 0)
+                    {
+                        if(_pos == _buffer.size())
+                        {
+                            _fill();
+                        }
+                        const std::size_t take = std::min(size, _buffer.size() - _pos);
+                        std::memcpy(out, _buffer.data() + _pos, take);
+                        _pos += take;
+                        out += take;
+                        size -= take;
+                    }
+                }
+
+                void string(std::string & out, std::size_t size)
+                {
+                    out.resize(size);
+                    bytes(out.data(), size);
+                }
+
+                std::uint8_t u8()
+                {
+                    std::uint8_t value = 0;
+                    bytes(&value, 1);
+                    return value;
+                }
+
+                std::uint32_t u32()
+                {
+                    std::array<std::uint8_t, 4> in{};
+                    bytes(in.data(), in.size());
+                    std::uint32_t value = 0;
+                    for(std::size_t i = 0; i < in.size(); ++i)
+                    {
+                        value |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+                    }
+                    return value;
+                }
+
+                std::uint64_t u64()
+                {
+                    std::array<std::uint8_t, 8> in{};
+                    bytes(in.data(), in.size());
+                    std::uint64_t value = 0;
+                    for(std::size_t i = 0; i < in.size(); ++i)
+                    {
+                        value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+                    }
+                    return value;
+                }
+
+                // Call once the end marker is read: the payload must be fully consumed and match its CRC.
+                void verifyChecksum()
+                {
+                    if(_remaining != 0 || _pos != _buffer.size())
+                    {
+                        throw std::runtime_error("trailing bytes after end marker");
+                    }
+
+                    std::array<std::uint8_t, 4> in{};
+                    _in.read(reinterpret_cast<char *>(in.data()), static_cast<std::streamsize>(in.size()));
+                    if(!_in)
+                    {
+                        throw std::runtime_error("missing checksum");
+                    }
+                    std::uint32_t stored = 0;
+                    for(std::size_t i = 0; i < in.size(); ++i)
+                    {
+                        stored |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+                    }
+                    if(stored != static_cast<std::uint32_t>(_crc))
+                    {
+                        throw std::runtime_error("checksum mismatch");
+                    }
+                }
+
+            private:
+                void _fill()
+                {
+                    if(_remaining == 0)
+                    {
+                        throw std::runtime_error("unexpected end of snapshot");
+                    }
+                    _buffer.resize(std::min(_remaining, SNAPSHOT_IO_CHUNK_BYTES));
+                    _in.read(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+                    if(!_in)
+                    {
+                        throw std::runtime_error("snapshot read failed");
+                    }
+                    _crc = absl::ExtendCrc32c(_crc, std::string_view(_buffer));
+                    _remaining -= _buffer.size();
+                    _pos = 0;
+                }
+
+                std::ifstream _in;
+                std::string _buffer;
+                std::size_t _pos = 0;
+                std::size_t _remaining = 0;
+                absl::crc32c_t _crc{0};
+        };
+
+        static void writeColumn(SnapshotWriter & writer, sqlite3_stmt * stmt, int column)
+        {
+            switch(sqlite3_column_type(stmt, column))
+            {
+                case SQLITE_NULL:
+                    writer.u8(static_cast<std::uint8_t>(ValueTag::NULL_VALUE));
+                    return;
+
+                case SQLITE_INTEGER:
+                    writer.u8(static_cast<std::uint8_t>(ValueTag::INTEGER));
+                    writer.u64(static_cast<std::uint64_t>(sqlite3_column_int64(stmt, column)));
+                    return;
+
+                case SQLITE_TEXT:
+                {
+                    const unsigned char * text = sqlite3_column_text(stmt, column);
+                    const int size = sqlite3_column_bytes(stmt, column);
+                    writer.u8(static_cast<std::uint8_t>(ValueTag::TEXT));
+                    writer.u32(static_cast<std::uint32_t>(size));
+                    writer.bytes(text, static_cast<std::size_t>(size));
+                    return;
+                }
+
+                case SQLITE_BLOB:
+                {
+                    const void * blob = sqlite3_column_blob(stmt, column);
+                    const int size = sqlite3_column_bytes(stmt, column);
+                    writer.u8(static_cast<std::uint8_t>(ValueTag::BLOB));
+                    writer.u32(static_cast<std::uint32_t>(size));
+                    writer.bytes(blob, static_cast<std::size_t>(size));
+                    return;
+                }
+
+                default:
+                    throw std::runtime_error("unsupported column type");
+            }
+        }
+
+        // `buffer` must outlive the statement step: text and blob values are bound without copying.
+        static void bindColumn(SnapshotReader & reader, sqlite3_stmt * stmt, int index, std::string & buffer)
+        {
+            const auto tag = static_cast<ValueTag>(reader.u8());
+            int rc = SQLITE_OK;
+            switch(tag)
+            {
+                case ValueTag::NULL_VALUE:
+                    rc = sqlite3_bind_null(stmt, index);
+                    break;
+
+                case ValueTag::INTEGER:
+                    rc = sqlite3_bind_int64(stmt, index, static_cast<sqlite3_int64>(reader.u64()));
+                    break;
+
+                case ValueTag::TEXT:
+                case ValueTag::BLOB:
+                {
+                    const std::uint32_t size = reader.u32();
+                    if(size > MAX_SNAPSHOT_VALUE_BYTES)
+                    {
+                        throw std::runtime_error("value too large");
+                    }
+                    reader.string(buffer, size);
+                    rc = tag == ValueTag::TEXT
+                        ? sqlite3_bind_text(stmt, index, buffer.data(), static_cast<int>(size), SQLITE_STATIC)
+                        : sqlite3_bind_blob(stmt, index, buffer.data(), static_cast<int>(size), SQLITE_STATIC);
+                    break;
+                }
+
+                default:
+                    throw std::runtime_error("unknown value tag");
+            }
+
+            if(rc != SQLITE_OK)
+            {
+                throw std::runtime_error("bind failed");
+            }
+        }
+    }
+
+    bool SQLiteRegistryStore::exportSnapshot(const std::filesystem::path & path) const
+    {
+        std::filesystem::path staging_path = path;
+        staging_path += ".partial";
+
+        try
+        {
+            const ReadLease reader(*this);
+            sqlite3 * db = reader.db();
+
+            // Every table is read inside one transaction, so the file is a single version of the store
+            // even while writers keep committing.
+            if(!storage::sqlite::exec(db, "BEGIN;"))
+            {
+                throw std::runtime_error("cannot open read transaction");
+            }
+            struct ReadTransaction
+            {
+                sqlite3 * db;
+                ~ReadTransaction() { (void)storage::sqlite::exec(db, "COMMIT;"); }
+            } read_transaction{db};
+
+            SnapshotWriter writer(staging_path);
+            writer.bytes(SNAPSHOT_MAGIC.data(), SNAPSHOT_MAGIC.size());
+            writer.u32(SNAPSHOT_FORMAT_VERSION);
+            writer.u32(static_cast<std::uint32_t>(readUserVersion(db)));
+
+            std::uint64_t total_rows = 0;
+            for(std::size_t table_index = 0; table_index < SNAPSHOT_TABLES.size(); ++table_index)
+            {
+                const SnapshotTable & table = SNAPSHOT_TABLES[table_index];
+                writer.u8(static_cast<std::uint8_t>(table_index));
+                writer.u32(table.column_count);
+
+                const std::string sql = std::string("SELECT ") + table.column_names + " FROM " + table.name +
+                    " ORDER BY " + table.primary_key + ";";
+                storage::sqlite::Statement stmt(db, sql.c_str());
+
+                std::uint64_t rows = 0;
+                int rc = stmt.step();
+                for(; rc == SQLITE_ROW; rc = stmt.step())
+                {
+                    writer.u8(SNAPSHOT_ROW);
+                    for(std::uint32_t column = 0; column < table.column_count; ++column)
+                    {
+                        writeColumn(writer, stmt.get(), static_cast<int>(column));
+                    }
+                    ++rows;
+                }
+                if(rc != SQLITE_DONE)
+                {
+                    throw std::runtime_error(std::string("scan of ") + table.name + " failed: " + sqlite3_errmsg(db));
+                }
+
+                writer.u8(SNAPSHOT_TABLE_END);
+                writer.u64(rows);
+                total_rows += rows;
+            }
+
+            writer.u8(SNAPSHOT_END);
+            writer.finish();
+
+            std::filesystem::rename(staging_path, path);
+            spdlog::info("Registry snapshot exported to {}: rows={}", path.string(), total_rows);
+            return true;
+        }
+        catch(const std::exception & e)
+        {
+            spdlog::error("Registry snapshot export to {} failed: {}", path.string(), e.what());
+            std::error_code ec;
+            std::filesystem::remove(staging_path, ec);
+            return false;
+        }
+    }
+
+    bool SQLiteRegistryStore::importSnapshot(const std::filesystem::path & path)
+    {
+        const std::lock_guard<std::mutex> write_lock(_write_mutex);
+
+        try
+        {
+            {
+                storage::sqlite::Statement probe(
+                    _db,
+                    "SELECT EXISTS(SELECT 1 FROM connectors) OR EXISTS(SELECT 1 FROM transformations) "
+                    "OR EXISTS(SELECT 1 FROM conditions);");
+                if(probe.step() != SQLITE_ROW || sqlite3_column_int(probe.get(), 0) != 0)
+                {
+                    spdlog::error("Registry snapshot import needs an empty registry");
+                    return false;
+                }
+            }
+
+            SnapshotReader reader(path);
+            std::array<char, SNAPSHOT_MAGIC.size()> magic{};
+            reader.bytes(magic.data(), magic.size());
+            if(magic != SNAPSHOT_MAGIC)
+            {
+                throw std::runtime_error("not a registry snapshot");
+            }
+            const std::uint32_t format_version = reader.u32();
+            const std::uint32_t schema_version = reader.u32();
+            if(format_version != SNAPSHOT_FORMAT_VERSION || static_cast<int>(schema_version) != _schemaVersion())
+            {
+                throw std::runtime_error(
+                    "unsupported snapshot version format=" + std::to_string(format_version) +
+                    " schema=" + std::to_string(schema_version));
+            }
+
+            // Durability is only needed at the final commit; the page cache holds the growing b-trees.
+            (void)_exec("PRAGMA synchronous=OFF;");
+            (void)_exec(("PRAGMA cache_size=-" + std::to_string(SNAPSHOT_IMPORT_CACHE_KIB) + ";").c_str());
+            struct RestorePragmas
+            {
+                const SQLiteRegistryStore & store;
+                ~RestorePragmas()
+                {
+                    (void)store._exec("PRAGMA synchronous=NORMAL;");
+                    (void)store._exec("PRAGMA cache_size=-2000;");
+                }
+            } restore_pragmas{*this};
+
+            if(!_beginTransaction())
+            {
+                throw std::runtime_error("cannot open write transaction");
+            }
+
+            try
+            {
+                std::uint64_t total_rows = 0;
+                for(std::size_t table_index = 0; table_index < SNAPSHOT_TABLES.size(); ++table_index)
+                {
+                    const SnapshotTable & table = SNAPSHOT_TABLES[table_index];
+                    if(reader.u8() != table_index || reader.u32() != table.column_count)
+                    {
+                        throw std::runtime_error(std::string("unexpected section for ") + table.name);
+                    }
+
+                    std::string placeholders;
+                    for(std::uint32_t column = 0; column < table.column_count; ++column)
+                    {
+                        placeholders += column == 0 ? "?" : ", ?";
+                    }
+                    const std::string sql = std::string("INSERT INTO ") + table.name + "(" + table.column_names +
+                        ") VALUES(" + placeholders + ");";
+                    storage::sqlite::Statement insert(_db, sql.c_str());
+                    std::vector<std::string> buffers(table.column_count);
+
+                    std::uint64_t rows = 0;
+                    for(std::uint8_t marker = reader.u8(); marker != SNAPSHOT_TABLE_END; marker = reader.u8())
+                    {
+                        if(marker != SNAPSHOT_ROW)
+                        {
+                            throw std::runtime_error(std::string("bad row marker in ") + table.name);
+                        }
+                        for(std::uint32_t column = 0; column < table.column_count; ++column)
+                        {
+                            bindColumn(reader, insert.get(), static_cast<int>(column) + 1, buffers[column]);
+                        }
+                        if(insert.step() != SQLITE_DONE)
+                        {
+                            throw std::runtime_error(std::string("insert into ") + table.name + " failed: " + sqlite3_errmsg(_db));
+                        }
+                        insert.reset();
+                        ++rows;
+                    }
+
+                    if(reader.u64() != rows)
+                    {
+                        throw std::runtime_error(std::string("row count mismatch in ") + table.name);
+                    }
+                    total_rows += rows;
+                }
+
+                if(reader.u8() != SNAPSHOT_END)
+                {
+                    throw std::runtime_error("missing end marker");
+                }
+                reader.verifyChecksum();
+
+                // Derived tables are filled once from the loaded rows instead of per inserted entity.
+                if(!_exec("DELETE FROM accounts;") || !_exec("DELETE FROM formats;") || !_rebuildAggregates())
+                {
+                    throw std::runtime_error("aggregate rebuild failed");
+                }
+
+                if(!_commitTransaction())
+                {
+                    throw std::runtime_error("commit failed");
+                }
+                spdlog::info("Registry snapshot imported from {}: rows={}", path.string(), total_rows);
+            }
+            catch(...)
+            {
+                _rollbackTransaction();
+                throw;
+            }
+        }
+        catch(const std::exception & e)
+        {
+            spdlog::error("Registry snapshot import from {} failed: {}", path.string(), e.what());
+            return false;
+        }
+
+        // The whole load sits in the WAL; fold it into the main file now rather than on the next sync tick.
+        if(_pooled_reads && !_exec("PRAGMA wal_checkpoint(TRUNCATE);"))
+        {
+            spdlog::warn("Registry WAL checkpoint after snapshot import failed");
+        }
+        return true;
+    }
+}
@@ -3,14 +3,18 @@
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <format>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string_view>
 #include <stdexcept>
 #include <string>
 
+#include <absl/container/flat_hash_map.h>
 #include <evmc/hex.hpp>
+#include <google/protobuf/arena.h>
 #include <spdlog/spdlog.h>
 #include <sqlite3.h>
 
@@ -28,6 +32,38 @@ namespace dcn::registry
         constexpr int MAX_RECORD_BLOB_BYTES = 16 * 1024 * 1024;
         constexpr int SQLITE_DEFAULT_BUSY_TIMEOUT_MS = 5000;
         constexpr int SQLITE_CHECKPOINT_BUSY_TIMEOUT_MS = 250;
+        constexpr std::size_t MAX_IDLE_READERS = 16;
+        constexpr std::size_t MAX_NAMES_PER_QUERY = 256;
+        constexpr int REGISTRY_SCHEMA_VERSION = 2;
+
+        // Index-only tables keyed by binary hashes/addresses. Stored WITHOUT ROWID so the primary key
+        // is the table itself instead of a rowid b-tree plus a separate key index.
+        struct ClusteredTable
+        {
+            const char * name;
+            const char * columns;
+            const char * column_names;
+            const char * primary_key;
+        };
+
+        constexpr std::array<ClusteredTable, 5> CLUSTERED_TABLES{{
+            {"format_members", "format_hash BLOB NOT NULL, name TEXT NOT NULL", "format_hash, name", "format_hash, name"},
+            {
+                "scalar_labels_by_format",
+                "format_hash BLOB NOT NULL, scalar TEXT NOT NULL, path_hash BLOB NOT NULL, tail_id INTEGER NOT NULL",
+                "format_hash, scalar, path_hash, tail_id",
+                "format_hash, scalar, path_hash, tail_id"
+            },
+            {"owned_connectors", "owner BLOB NOT NULL, name TEXT NOT NULL", "owner, name", "owner, name"},
+            {"owned_transformations", "owner BLOB NOT NULL, name TEXT NOT NULL", "owner, name", "owner, name"},
+            {"owned_conditions", "owner BLOB NOT NULL, name TEXT NOT NULL", "owner, name", "owner, name"},
+        }};
+
+        static std::string clusteredTableSql(const ClusteredTable & table, const std::string & table_name)
+        {
+            return "CREATE TABLE IF NOT EXISTS " + table_name + " (" + table.columns +
+                ", PRIMARY KEY(" + table.primary_key + ")) WITHOUT ROWID;";
+        }
 
         static int toSqliteInt(std::size_t value)
         {
@@ -73,14 +109,23 @@ namespace dcn::registry
             return out;
         }
 
+        // First arena block as a multiple of the wire size: decoded strings, repeated fields and map
+        // nodes typically need a few times the encoded bytes, so most records fit a single block.
+        constexpr std::size_t RECORD_ARENA_BLOCK_FACTOR = 4;
+        constexpr std::size_t RECORD_ARENA_MIN_BLOCK_BYTES = 256;
+        constexpr std::size_t RECORD_ARENA_MAX_BLOCK_BYTES = 64 * 1024;
+
+        // Decodes a record blob into its own protobuf arena. The returned handle shares ownership of
+        // the arena, so the record's sub-messages, strings and map nodes are freed in one step with
+        // the last handle instead of one by one.
         template <typename TRecord>
-        static std::optional<TRecord> parseRecordBlob(sqlite3_stmt * stmt, int index)
+        static std::shared_ptr<const TRecord> decodeRecordHandle(sqlite3_stmt * stmt, int index)
         {
             const void * payload_blob = sqlite3_column_blob(stmt, index);
             const int payload_size = sqlite3_column_bytes(stmt, index);
             if(payload_blob == nullptr || payload_size <= 0)
             {
-                return std::nullopt;
+                return nullptr;
             }
             if(payload_size > MAX_RECORD_BLOB_BYTES)
             {
@@ -88,23 +133,181 @@ namespace dcn::registry
                     "SQLite record payload too large for protobuf decode: bytes={} (limit={})",
                     payload_size,
                     MAX_RECORD_BLOB_BYTES);
-                return std::nullopt;
+                return nullptr;
             }
 
-            TRecord record;
-            if(!record.ParseFromArray(payload_blob, payload_size))
+            google::protobuf::ArenaOptions arena_options;
+            arena_options.start_block_size = std::clamp(
+                static_cast<std::size_t>(payload_size) * RECORD_ARENA_BLOCK_FACTOR,
+                RECORD_ARENA_MIN_BLOCK_BYTES,
+                RECORD_ARENA_MAX_BLOCK_BYTES);
+            arena_options.max_block_size = RECORD_ARENA_MAX_BLOCK_BYTES;
+
+            auto arena = std::make_shared<google::protobuf::Arena>(arena_options);
+            TRecord * record = google::protobuf::Arena::Create<TRecord>(arena.get());
+            if(!record->ParseFromArray(payload_blob, payload_size))
             {
-                return std::nullopt;
+                return nullptr;
             }
 
-            return record;
+            return std::shared_ptr<const TRecord>(std::move(arena), record);
+        }
+
+        // Keeps the `accounts` and `formats` key tables and their `registry_counters` rows in step with
+        // entity inserts. Runs inside the caller's transaction or savepoint, so a rollback undoes both.
+        class AggregateWriter
+        {
+            public:
+                explicit AggregateWriter(sqlite3 * db)
+                    : _db(db)
+                    , _insert_account(db, "INSERT OR IGNORE INTO accounts(owner) VALUES(?1);")
+                    , _insert_format(db, "INSERT OR IGNORE INTO formats(format_hash) VALUES(?1);")
+                    , _bump_counter(db, "UPDATE registry_counters SET value = value + 1 WHERE name = ?1;")
+                {
+                }
+
+                // Called once for every inserted entity, so it also advances the store's write marker.
+                bool noteAccount(const chain::Address & owner)
+                {
+                    _insert_account.reset();
+                    bindAddress(_insert_account.get(), 1, owner);
+                    return _insertKey(_insert_account, "accounts") && _bump("writes");
+                }
+
+                bool noteFormat(const evmc::bytes32 & format_hash)
+                {
+                    _insert_format.reset();
+                    bindBytes32(_insert_format.get(), 1, format_hash);
+                    return _insertKey(_insert_format, "formats");
+                }
+
+            private:
+                bool _insertKey(const storage::sqlite::Statement & insert_key, const char * counter_name)
+                {
+                    if(insert_key.step() != SQLITE_DONE)
+                    {
+                        return false;
+                    }
+                    if(sqlite3_changes(_db) == 0)
+                    {
+                        return true;
+                    }
+                    return _bump(counter_name);
+                }
+
+                bool _bump(const char * counter_name)
+                {
+                    _bump_counter.reset();
+                    sqlite3_bind_text(_bump_counter.get(), 1, counter_name, -1, SQLITE_STATIC);
+                    return _bump_counter.step() == SQLITE_DONE;
+                }
+
+                sqlite3 * _db;
+                storage::sqlite::Statement _insert_account;
+                storage::sqlite::Statement _insert_format;
+                storage::sqlite::Statement _bump_counter;
+        };
+
+        // Resolves `names` against `table_name` with one `IN (...)` query per chunk of distinct names.
+        // Duplicated input names share the handle decoded for their first occurrence.
+        template <typename TRecord>
+        static std::vector<std::optional<std::shared_ptr<const TRecord>>> fetchRecordsByName(
+            sqlite3 * db,
+            const char * table_name,
+            std::span<const std::string> names)
+        {
+            std::vector<std::optional<std::shared_ptr<const TRecord>>> out(names.size());
+
+            absl::flat_hash_map<std::string_view, std::size_t> first_position;
+            first_position.reserve(names.size());
+            std::vector<std::string_view> distinct_names;
+            distinct_names.reserve(names.size());
+            for(std::size_t i = 0; i < names.size(); ++i)
+            {
+                if(first_position.try_emplace(names[i], i).second)
+                {
+                    distinct_names.push_back(names[i]);
+                }
+            }
+
+            std::string sql;
+            for(std::size_t offset = 0; offset < distinct_names.size(); offset += MAX_NAMES_PER_QUERY)
+            {
+                const std::size_t chunk_size = std::min(MAX_NAMES_PER_QUERY, distinct_names.size() - offset);
+
+                sql.assign("SELECT name, payload_blob FROM ");
+                sql.append(table_name);
+                sql.append(" WHERE name IN (");
+                for(std::size_t i = 0; i < chunk_size; ++i)
+                {
+                    sql.append(i == 0 ? "?" : ",?");
+                }
+                sql.append(");");
+
+                storage::sqlite::Statement stmt(db, sql.c_str());
+                for(std::size_t i = 0; i < chunk_size; ++i)
+                {
+                    const std::string_view name = distinct_names[offset + i];
+                    sqlite3_bind_text(
+                        stmt.get(),
+                        static_cast<int>(i + 1),
+                        name.data(),
+                        static_cast<int>(name.size()),
+                        SQLITE_STATIC);
+                }
+
+                int rc = stmt.step();
+                for(; rc == SQLITE_ROW; rc = stmt.step())
+                {
+                    const unsigned char * name_text = sqlite3_column_text(stmt.get(), 0);
+                    if(name_text == nullptr)
+                    {
+                        continue;
+                    }
+
+                    const std::string_view row_name(
+                        reinterpret_cast<const char *>(name_text),
+                        static_cast<std::size_t>(sqlite3_column_bytes(stmt.get(), 0)));
+                    const auto position_it = first_position.find(row_name);
+                    if(position_it == first_position.end())
+                    {
+                        continue;
+                    }
+
+                    auto record_handle = decodeRecordHandle<TRecord>(stmt.get(), 1);
+                    if(!record_handle)
+                    {
+                        spdlog::debug("SQLite batch lookup in {}: protobuf decode failed for '{}'", table_name, row_name);
+                        continue;
+                    }
+                    out[position_it->second] = std::move(record_handle);
+                }
+
+                if(rc != SQLITE_DONE)
+                {
+                    throw std::runtime_error(sqlite3_errmsg(db));
+                }
+            }
+
+            for(std::size_t i = 0; i < names.size(); ++i)
+            {
+                const std::size_t first = first_position.at(names[i]);
+                if(first != i)
+                {
+                    out[i] = out[first];
+                }
+            }
+
+            return out;
         }
     }
 
     SQLiteRegistryStore::SQLiteRegistryStore(const std::string & db_path)
+        : _db_path(db_path.empty() ? ":memory:" : db_path)
+        , _pooled_reads(_db_path != ":memory:")
     {
         const int open_res = sqlite3_open_v2(
-            db_path.empty() ? ":memory:" : db_path.c_str(),
+            _db_path.c_str(),
             &_db,
             SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX,
             nullptr);
@@ -136,6 +339,12 @@ namespace dcn::registry
 
     SQLiteRegistryStore::~SQLiteRegistryStore()
     {
+        for(sqlite3 * reader : _idle_readers)
+        {
+            sqlite3_close(reader);
+        }
+        _idle_readers.clear();
+
         if(_db != nullptr)
         {
             sqlite3_close(_db);
@@ -143,6 +352,75 @@ namespace dcn::registry
         }
     }
 
+    SQLiteRegistryStore::ReadLease::ReadLease(const SQLiteRegistryStore & store)
+        : _store(store)
+    {
+        if(!_store._pooled_reads)
+        {
+            _memory_lock = std::unique_lock<std::mutex>(_store._write_mutex);
+            _db = _store._db;
+            return;
+        }
+
+        {
+            const std::lock_guard<std::mutex> lock(_store._readers_mutex);
+            if(!_store._idle_readers.empty())
+            {
+                _db = _store._idle_readers.back();
+                _store._idle_readers.pop_back();
+                return;
+            }
+        }
+
+        _db = _store._openReader();
+    }
+
+    SQLiteRegistryStore::ReadLease::~ReadLease()
+    {
+        if(!_store._pooled_reads || _db == nullptr)
+        {
+            return;
+        }
+
+        {
+            const std::lock_guard<std::mutex> lock(_store._readers_mutex);
+            if(_store._idle_readers.size() < MAX_IDLE_READERS)
+            {
+                _store._idle_readers.push_back(_db);
+                return;
+            }
+        }
+
+        sqlite3_close(_db);
+    }
+
+    sqlite3 * SQLiteRegistryStore::_openReader() const
+    {
+        sqlite3 * reader = nullptr;
+        const int open_res = sqlite3_open_v2(
+            _db_path.c_str(),
+            &reader,
+            SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX,
+            nullptr);
+        if(open_res != SQLITE_OK)
+        {
+            const std::string msg = (reader == nullptr) ? "sqlite open failed" : sqlite3_errmsg(reader);
+            if(reader != nullptr)
+            {
+                sqlite3_close(reader);
+            }
+            throw std::runtime_error(std::string("Failed to open registry read connection: ") + msg);
+        }
+
+        sqlite3_busy_timeout(reader, SQLITE_DEFAULT_BUSY_TIMEOUT_MS);
+        if(!storage::sqlite::exec(reader, "PRAGMA query_only=1;"))
+        {
+            sqlite3_close(reader);
+            throw std::runtime_error("Failed to configure registry read connection");
+        }
+        return reader;
+    }
+
     bool SQLiteRegistryStore::_exec(const char * sql) const
     {
         return storage::sqlite::exec(_db, sql);
@@ -188,72 +466,230 @@ namespace dcn::registry
                 "payload_blob BLOB NOT NULL,"
                 "created_at INTEGER NOT NULL DEFAULT (CAST(strftime('%s','now') AS INTEGER))"
                 ");") &&
+            _exec("CREATE TABLE IF NOT EXISTS accounts (owner BLOB PRIMARY KEY) WITHOUT ROWID;") &&
+            _exec("CREATE TABLE IF NOT EXISTS formats (format_hash BLOB PRIMARY KEY) WITHOUT ROWID;") &&
             _exec(
-                "CREATE TABLE IF NOT EXISTS format_members ("
-                "format_hash BLOB NOT NULL,"
-                "name TEXT NOT NULL,"
-                "PRIMARY KEY(format_hash, name)"
-                ");") &&
-            _exec(
-                "CREATE TABLE IF NOT EXISTS scalar_labels_by_format ("
-                "format_hash BLOB NOT NULL,"
-                "scalar TEXT NOT NULL,"
-                "path_hash BLOB NOT NULL,"
-                "tail_id INTEGER NOT NULL,"
-                "PRIMARY KEY(format_hash, scalar, path_hash, tail_id)"
-                ");") &&
-            _exec(
-                "CREATE TABLE IF NOT EXISTS owned_connectors ("
-                "owner BLOB NOT NULL,"
-                "name TEXT NOT NULL,"
-                "PRIMARY KEY(owner, name)"
-                ");") &&
-            _exec(
-                "CREATE TABLE IF NOT EXISTS owned_transformations ("
-                "owner BLOB NOT NULL,"
-                "name TEXT NOT NULL,"
-                "PRIMARY KEY(owner, name)"
-                ");") &&
-            _exec(
-                "CREATE TABLE IF NOT EXISTS owned_conditions ("
-                "owner BLOB NOT NULL,"
-                "name TEXT NOT NULL,"
-                "PRIMARY KEY(owner, name)"
-                ");") &&
-            _exec("CREATE INDEX IF NOT EXISTS idx_format_members_format_name ON format_members(format_hash, name);") &&
-            _exec("CREATE INDEX IF NOT EXISTS idx_scalar_labels_format ON scalar_labels_by_format(format_hash);") &&
-            _exec("CREATE INDEX IF NOT EXISTS idx_owned_connectors_owner_name ON owned_connectors(owner, name);") &&
-            _exec("CREATE INDEX IF NOT EXISTS idx_owned_transformations_owner_name ON owned_transformations(owner, name);") &&
-            _exec("CREATE INDEX IF NOT EXISTS idx_owned_conditions_owner_name ON owned_conditions(owner, name);");
+                "CREATE TABLE IF NOT EXISTS registry_counters ("
+                "name TEXT PRIMARY KEY,"
+                "value INTEGER NOT NULL"
+                ") WITHOUT ROWID;");
 
         if(!base_schema_ok)
         {
             return false;
         }
 
+        const int schema_version = _schemaVersion();
+        if(schema_version < 0)
+        {
+            return false;
+        }
+
+        if(schema_version < REGISTRY_SCHEMA_VERSION && !_migrateToClusteredTables())
+        {
+            return false;
+        }
+
+        for(const ClusteredTable & table : CLUSTERED_TABLES)
+        {
+            if(!_exec(clusteredTableSql(table, table.name).c_str()))
+            {
+                return false;
+            }
+        }
+
+        if(schema_version != REGISTRY_SCHEMA_VERSION &&
+            !_exec(("PRAGMA user_version = " + std::to_string(REGISTRY_SCHEMA_VERSION) + ";").c_str()))
+        {
+            return false;
+        }
+
+        // The write marker of a database without one starts from its current contents under a fresh identity.
+        if(!_exec(
+                "INSERT OR IGNORE INTO registry_counters(name, value) VALUES "
+                "('store_id', random()), "
+                "('writes', (SELECT COUNT(*) FROM connectors) + (SELECT COUNT(*) FROM transformations) + (SELECT COUNT(*) FROM conditions));"))
+        {
+            return false;
+        }
+
+        return _backfillAggregates();
+    }
+
+    int SQLiteRegistryStore::_schemaVersion() const
+    {
+        try
+        {
+            storage::sqlite::Statement stmt(_db, "PRAGMA user_version;");
+            if(stmt.step() != SQLITE_ROW)
+            {
+                return -1;
+            }
+            return sqlite3_column_int(stmt.get(), 0);
+        }
+        catch(const std::exception & e)
+        {
+            spdlog::error("SQLite registry schema version query failed: {}", e.what());
+            return -1;
+        }
+    }
+
+    bool SQLiteRegistryStore::_tableExists(const char * table_name) const
+    {
+        try
+        {
+            storage::sqlite::Statement stmt(_db, "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = ?1;");
+            sqlite3_bind_text(stmt.get(), 1, table_name, -1, SQLITE_STATIC);
+            return stmt.step() == SQLITE_ROW;
+        }
+        catch(const std::exception & e)
+        {
+            spdlog::error("SQLite table lookup failed for {}: {}", table_name, e.what());
+            return false;
+        }
+    }
+
+    bool SQLiteRegistryStore::_migrateToClusteredTables() const
+    {
+        if(!_beginTransaction())
+        {
+            return false;
+        }
+
+        std::size_t migrated_tables = 0;
+        for(const ClusteredTable & table : CLUSTERED_TABLES)
+        {
+            if(!_tableExists(table.name))
+            {
+                continue;
+            }
+
+            // Version 1 tables were rowid tables with a separate copy of the key in an index; rebuilding
+            // them also drops those indexes.
+            const std::string staging_name = std::string(table.name) + "_v2";
+            const bool rebuilt =
+                _exec(("DROP TABLE IF EXISTS " + staging_name + ";").c_str()) &&
+                _exec(clusteredTableSql(table, staging_name).c_str()) &&
+                _exec((
+                    "INSERT OR IGNORE INTO " + staging_name + "(" + table.column_names + ") "
+                    "SELECT " + table.column_names + " FROM " + table.name + ";").c_str()) &&
+                _exec(("DROP TABLE " + std::string(table.name) + ";").c_str()) &&
+                _exec(("ALTER TABLE " + staging_name + " RENAME TO " + table.name + ";").c_str());
+            if(!rebuilt)
+            {
+                spdlog::error("Failed to migrate registry table {} to schema v{}", table.name, REGISTRY_SCHEMA_VERSION);
+                _rollbackTransaction();
+                return false;
+            }
+            ++migrated_tables;
+        }
+
+        if(!_exec(("PRAGMA user_version = " + std::to_string(REGISTRY_SCHEMA_VERSION) + ";").c_str()) ||
+            !_commitTransaction())
+        {
+            _rollbackTransaction();
+            return false;
+        }
+
+        if(migrated_tables > 0)
+        {
+            spdlog::info("Migrated {} registry tables to schema v{}; compacting database", migrated_tables, REGISTRY_SCHEMA_VERSION);
+            if(!_exec("VACUUM;"))
+            {
+                spdlog::warn("Registry VACUUM after schema migration failed; freed pages stay on the freelist");
+            }
+        }
         return true;
     }
 
+    bool SQLiteRegistryStore::_backfillAggregates() const
+    {
+        try
+        {
+            storage::sqlite::Statement probe(_db, "SELECT 1 FROM registry_counters WHERE name = 'accounts' LIMIT 1;");
+            if(probe.step() == SQLITE_ROW)
+            {
+                return true;
+            }
+        }
+        catch(const std::exception & e)
+        {
+            spdlog::error("SQLite registry counters probe failed: {}", e.what());
+            return false;
+        }
+
+        spdlog::info("Backfilling registry account and format aggregates");
+        if(!_beginTransaction())
+        {
+            return false;
+        }
+
+        if(!_rebuildAggregates())
+        {
+            _rollbackTransaction();
+            return false;
+        }
+
+        return _commitTransaction();
+    }
+
+    bool SQLiteRegistryStore::_rebuildAggregates() const
+    {
+        return
+            _exec(
+                "INSERT OR IGNORE INTO accounts(owner) "
+                "SELECT owner FROM owned_connectors "
+                "UNION SELECT owner FROM owned_transformations "
+                "UNION SELECT owner FROM owned_conditions;") &&
+            _exec("INSERT OR IGNORE INTO formats(format_hash) SELECT DISTINCT format_hash FROM format_members;") &&
+            _exec(
+                "INSERT OR REPLACE INTO registry_counters(name, value) VALUES "
+                "('accounts', (SELECT COUNT(*) FROM accounts)), "
+                "('formats', (SELECT COUNT(*) FROM formats)), "
+                "('writes', (SELECT COUNT(*) FROM connectors) + (SELECT COUNT(*) FROM transformations) + (SELECT COUNT(*) FROM conditions));");
+    }
+
+    std::size_t SQLiteRegistryStore::_readCounter(const char * counter_name) const
+    {
+        try
+        {
+            const ReadLease reader(*this);
+            storage::sqlite::Statement stmt(reader.db(), "SELECT value FROM registry_counters WHERE name = ?1;");
+            sqlite3_bind_text(stmt.get(), 1, counter_name, -1, SQLITE_STATIC);
+            if(stmt.step() != SQLITE_ROW)
+            {
+                return 0;
+            }
+            return static_cast<std::size_t>(sqlite3_column_int64(stmt.get(), 0));
+        }
+        catch(const std::exception & e)
+        {
+            spdlog::error("SQLite registry counter read failed for {}: {}", counter_name, e.what());
+            return 0;
+        }
+    }
+
     bool SQLiteRegistryStore::hasConnector(const std::string & name) const
     {
         try
         {
-            if(_db == nullptr)
+            const ReadLease reader(*this);
+            if(reader.db() == nullptr)
             {
                 spdlog::error("SQLite hasConnector called with null DB handle for name={}", name);
                 return false;
             }
             
-            spdlog::debug("SQLite::hasConnector('{}'): prepare (db={})", name, static_cast<const void *>(_db));
+            spdlog::debug("SQLite::hasConnector('{}'): prepare (db={})", name, static_cast<const void *>(reader.db()));
             
-            storage::sqlite::Statement stmt(_db, "SELECT 1 FROM connectors WHERE name = ?1 LIMIT 1;");
+            storage::sqlite::Statement stmt(reader.db(), "SELECT 1 FROM connectors WHERE name = ?1 LIMIT 1;");
             const int bind_rc = sqlite3_bind_text(stmt.get(), 1, name.c_str(), static_cast<int>(name.size()), SQLITE_TRANSIENT);
             
             spdlog::debug("SQLite::hasConnector('{}'): bind rc={}", name, bind_rc);
             
             if(bind_rc != SQLITE_OK)
             {
-                spdlog::error("SQLite::hasConnector('{}'): bind failed rc={} err={}", name, bind_rc, sqlite3_errmsg(_db));
+                spdlog::error("SQLite::hasConnector('{}'): bind failed rc={} err={}", name, bind_rc, sqlite3_errmsg(reader.db()));
                 return false;
             }
             const int rc = stmt.step();
@@ -273,9 +709,10 @@ namespace dcn::registry
     {
         try
         {
+            const ReadLease reader(*this);
             spdlog::debug("SQLite::getConnectorRecordHandle('{}'): prepare", name);
             
-            storage::sqlite::Statement stmt(_db, "SELECT payload_blob FROM connectors WHERE name = ?1 LIMIT 1;");
+            storage::sqlite::Statement stmt(reader.db(), "SELECT payload_blob FROM connectors WHERE name = ?1 LIMIT 1;");
             sqlite3_bind_text(stmt.get(), 1, name.c_str(), static_cast<int>(name.size()), SQLITE_TRANSIENT);
             
             spdlog::debug("SQLite::getConnectorRecordHandle('{}'): bound name", name);
@@ -292,8 +729,8 @@ namespace dcn::registry
             const int blob_size = sqlite3_column_bytes(stmt.get(), 0);
             spdlog::debug("SQLite::getConnectorRecordHandle('{}'): row found blob_size={}", name, blob_size);
 
-            auto record_opt = parseRecordBlob<ConnectorRecord>(stmt.get(), 0);
-            if(!record_opt.has_value())
+            auto record_handle = decodeRecordHandle<ConnectorRecord>(stmt.get(), 0);
+            if(!record_handle)
             {
                 
                 spdlog::debug("SQLite::getConnectorRecordHandle('{}'): protobuf decode failed", name);
@@ -302,7 +739,7 @@ namespace dcn::registry
 
             
             spdlog::debug("SQLite::getConnectorRecordHandle('{}'): decoded record", name);
-            return std::make_shared<ConnectorRecord>(std::move(*record_opt));
+            return record_handle;
         }
         catch(const std::exception & e)
         {
@@ -311,11 +748,32 @@ namespace dcn::registry
         }
     }
 
+    std::vector<std::optional<ConnectorRecordHandle>> SQLiteRegistryStore::getConnectorRecordHandles(
+        std::span<const std::string> names) const
+    {
+        if(names.empty())
+        {
+            return {};
+        }
+
+        try
+        {
+            const ReadLease reader(*this);
+            return fetchRecordsByName<ConnectorRecord>(reader.db(), "connectors", names);
+        }
+        catch(const std::exception & e)
+        {
+            spdlog::error("SQLite getConnectorRecordHandles query failed for {} names: {}", names.size(), e.what());
+            return std::vector<std::optional<ConnectorRecordHandle>>(names.size());
+        }
+    }
+
     std::optional<evmc::bytes32> SQLiteRegistryStore::getConnectorFormatHash(const std::string & name) const
     {
         try
         {
-            storage::sqlite::Statement stmt(_db, "SELECT format_hash FROM connectors WHERE name = ?1 LIMIT 1;");
+            const ReadLease reader(*this);
+            storage::sqlite::Statement stmt(reader.db(), "SELECT format_hash FROM connectors WHERE name = ?1 LIMIT 1;");
             sqlite3_bind_text(stmt.get(), 1, name.c_str(), static_cast<int>(name.size()), SQLITE_TRANSIENT);
             if(stmt.step() != SQLITE_ROW)
             {
@@ -336,6 +794,8 @@ namespace dcn::registry
         const evmc::bytes32 & format_hash,
         const std::vector<ScalarLabel> & canonical_scalar_labels)
     {
+        const std::lock_guard<std::mutex> write_lock(_write_mutex);
+
         const std::string & connector_name = record.connector().name();
         const auto owner_opt = evmc::from_hex<chain::Address>(record.owner());
         if(!owner_opt)
@@ -399,6 +859,13 @@ namespace dcn::registry
                 return false;
             }
 
+            AggregateWriter aggregates(_db);
+            if(!aggregates.noteFormat(format_hash))
+            {
+                rollback_with_log("update formats");
+                return false;
+            }
+
             storage::sqlite::Statement insert_scalar_label(
                 _db,
                 "INSERT OR IGNORE INTO scalar_labels_by_format(format_hash, scalar, path_hash, tail_id) "
@@ -427,6 +894,12 @@ namespace dcn::registry
                 rollback_with_log("insert owned_connectors");
                 return false;
             }
+
+            if(!aggregates.noteAccount(*owner_opt))
+            {
+                rollback_with_log("update accounts");
+                return false;
+            }
         }
         catch(const std::exception & e)
         {
@@ -445,8 +918,18 @@ namespace dcn::registry
         return true;
     }
 
-    bool SQLiteRegistryStore::addConnectorsBatch(const std::vector<ConnectorBatchItem> & items, bool all_or_nothing)
+    bool SQLiteRegistryStore::addConnectorsBatch(
+        const std::vector<ConnectorBatchItem> & items,
+        bool all_or_nothing,
+        std::vector<bool> * inserted_items)
     {
+        const std::lock_guard<std::mutex> write_lock(_write_mutex);
+
+        if(inserted_items != nullptr)
+        {
+            inserted_items->assign(items.size(), false);
+        }
+
         if(items.empty())
         {
             return true;
@@ -463,6 +946,10 @@ namespace dcn::registry
         auto rollback_batch_with_log = [&](const char * reason)
         {
             spdlog::debug("DB remove connector batch pending changes count={} reason={}", items.size(), reason);
+            if(inserted_items != nullptr)
+            {
+                inserted_items->assign(items.size(), false);
+            }
             _rollbackTransaction();
         };
 
@@ -472,6 +959,7 @@ namespace dcn::registry
             storage::sqlite::Statement insert_format_member(_db, "INSERT OR IGNORE INTO format_members(format_hash, name) VALUES(?1, ?2);");
             storage::sqlite::Statement insert_scalar_label(_db, "INSERT OR IGNORE INTO scalar_labels_by_format(format_hash, scalar, path_hash, tail_id) VALUES(?1, ?2, ?3, ?4);");
             storage::sqlite::Statement insert_owned(_db, "INSERT OR REPLACE INTO owned_connectors(owner, name) VALUES(?1, ?2);");
+            AggregateWriter aggregates(_db);
 
             for(const ConnectorBatchItem & item : items)
             {
@@ -551,6 +1039,11 @@ namespace dcn::registry
                     }
                 }
 
+                if(item_ok && !aggregates.noteFormat(item.format_hash))
+                {
+                    item_ok = fail_item("update formats");
+                }
+
                 if(item_ok)
                 {
                     for(const ScalarLabel & label : item.canonical_scalar_labels)
@@ -579,6 +1072,11 @@ namespace dcn::registry
                     }
                 }
 
+                if(item_ok && !aggregates.noteAccount(*owner_opt))
+                {
+                    item_ok = fail_item("update accounts");
+                }
+
                 if(item_ok && savepoint_active)
                 {
                     if(!_exec("RELEASE SAVEPOINT connector_batch_item;"))
@@ -604,6 +1102,10 @@ namespace dcn::registry
                 else
                 {
                     ++inserted_count;
+                    if(inserted_items != nullptr)
+                    {
+                        (*inserted_items)[static_cast<std::size_t>(&item - items.data())] = true;
+                    }
                 }
             }
         }
@@ -628,7 +1130,8 @@ namespace dcn::registry
     {
         try
         {
-            storage::sqlite::Statement stmt(_db, "SELECT COUNT(*) FROM format_members WHERE format_hash = ?1;");
+            const ReadLease reader(*this);
+            storage::sqlite::Statement stmt(reader.db(), "SELECT COUNT(*) FROM format_members WHERE format_hash = ?1;");
             bindBytes32(stmt.get(), 1, format_hash);
             if(stmt.step() != SQLITE_ROW)
             {
@@ -659,10 +1162,11 @@ namespace dcn::registry
 
         try
         {
+            const ReadLease reader(*this);
             const std::size_t query_limit = limit + 1;
             if(after.has_value())
             {
-                storage::sqlite::Statement stmt(_db, "SELECT name FROM format_members WHERE format_hash = ?1 AND name > ?2 ORDER BY name ASC LIMIT ?3;");
+                storage::sqlite::Statement stmt(reader.db(), "SELECT name FROM format_members WHERE format_hash = ?1 AND name > ?2 ORDER BY name ASC LIMIT ?3;");
                 bindBytes32(stmt.get(), 1, format_hash);
                 sqlite3_bind_text(stmt.get(), 2, after->c_str(), static_cast<int>(after->size()), SQLITE_TRANSIENT);
                 sqlite3_bind_int(stmt.get(), 3, toSqliteInt(query_limit));
@@ -677,7 +1181,7 @@ namespace dcn::registry
             }
             else
             {
-                storage::sqlite::Statement stmt(_db, "SELECT name FROM format_members WHERE format_hash = ?1 ORDER BY name ASC LIMIT ?2;");
+                storage::sqlite::Statement stmt(reader.db(), "SELECT name FROM format_members WHERE format_hash = ?1 ORDER BY name ASC LIMIT ?2;");
                 bindBytes32(stmt.get(), 1, format_hash);
                 sqlite3_bind_int(stmt.get(), 2, toSqliteInt(query_limit));
                 for(int rc = stmt.step(); rc == SQLITE_ROW; rc = stmt.step())
@@ -716,20 +1220,7 @@ namespace dcn::registry
 
     std::size_t SQLiteRegistryStore::getFormatsCount() const
     {
-        try
-        {
-            storage::sqlite::Statement stmt(_db, "SELECT COUNT(DISTINCT format_hash) FROM format_members;");
-            if(stmt.step() != SQLITE_ROW)
-            {
-                return 0;
-            }
-            return static_cast<std::size_t>(sqlite3_column_int64(stmt.get(), 0));
-        }
-        catch(const std::exception & e)
-        {
-            spdlog::error("SQLite getFormatsCount query failed: {}", e.what());
-            return 0;
-        }
+        return _readCounter("formats");
     }
 
     NameCursorPage SQLiteRegistryStore::getFormatsCursor(
@@ -744,12 +1235,13 @@ namespace dcn::registry
 
         try
         {
+            const ReadLease reader(*this);
             const std::size_t query_limit = limit + 1;
             if(after.has_value())
             {
                 storage::sqlite::Statement stmt(
-                    _db,
-                    "SELECT DISTINCT format_hash FROM format_members "
+                    reader.db(),
+                    "SELECT format_hash FROM formats "
                     "WHERE format_hash > ?1 ORDER BY format_hash ASC LIMIT ?2;");
                 bindBytes32(stmt.get(), 1, *after);
                 sqlite3_bind_int(stmt.get(), 2, toSqliteInt(query_limit));
@@ -765,8 +1257,8 @@ namespace dcn::registry
             else
             {
                 storage::sqlite::Statement stmt(
-                    _db,
-                    "SELECT DISTINCT format_hash FROM format_members "
+                    reader.db(),
+                    "SELECT format_hash FROM formats "
                     "ORDER BY format_hash ASC LIMIT ?1;");
                 sqlite3_bind_int(stmt.get(), 1, toSqliteInt(query_limit));
                 for(int rc = stmt.step(); rc == SQLITE_ROW; rc = stmt.step())
@@ -806,8 +1298,9 @@ namespace dcn::registry
     {
         try
         {
+            const ReadLease reader(*this);
             storage::sqlite::Statement stmt(
-                _db,
+                reader.db(),
                 "SELECT scalar, path_hash, tail_id FROM scalar_labels_by_format WHERE format_hash = ?1 ORDER BY path_hash ASC, scalar ASC, tail_id ASC;");
             bindBytes32(stmt.get(), 1, format_hash);
 
@@ -848,22 +1341,23 @@ namespace dcn::registry
     {
         try
         {
-            if(_db == nullptr)
+            const ReadLease reader(*this);
+            if(reader.db() == nullptr)
             {
                 spdlog::error("SQLite hasTransformation called with null DB handle for name={}", name);
                 return false;
             }
             
-            spdlog::debug("SQLite::hasTransformation('{}'): prepare (db={})", name, static_cast<const void *>(_db));
+            spdlog::debug("SQLite::hasTransformation('{}'): prepare (db={})", name, static_cast<const void *>(reader.db()));
             
-            storage::sqlite::Statement stmt(_db, "SELECT 1 FROM transformations WHERE name = ?1 LIMIT 1;");
+            storage::sqlite::Statement stmt(reader.db(), "SELECT 1 FROM transformations WHERE name = ?1 LIMIT 1;");
             const int bind_rc = sqlite3_bind_text(stmt.get(), 1, name.c_str(), static_cast<int>(name.size()), SQLITE_TRANSIENT);
             
             spdlog::debug("SQLite::hasTransformation('{}'): bind rc={}", name, bind_rc);
 
             if(bind_rc != SQLITE_OK)
             {
-                spdlog::error("SQLite::hasTransformation('{}'): bind failed rc={} err={}", name, bind_rc, sqlite3_errmsg(_db));
+                spdlog::error("SQLite::hasTransformation('{}'): bind failed rc={} err={}", name, bind_rc, sqlite3_errmsg(reader.db()));
                 return false;
             }
             const int rc = stmt.step();
@@ -883,10 +1377,11 @@ namespace dcn::registry
     {
         try
         {
+            const ReadLease reader(*this);
             
             spdlog::debug("SQLite::getTransformationRecordHandle('{}'): prepare", name);
             
-            storage::sqlite::Statement stmt(_db, "SELECT payload_blob FROM transformations WHERE name = ?1 LIMIT 1;");
+            storage::sqlite::Statement stmt(reader.db(), "SELECT payload_blob FROM transformations WHERE name = ?1 LIMIT 1;");
             sqlite3_bind_text(stmt.get(), 1, name.c_str(), static_cast<int>(name.size()), SQLITE_TRANSIENT);
             
             spdlog::debug("SQLite::getTransformationRecordHandle('{}'): bound name", name);
@@ -904,8 +1399,8 @@ namespace dcn::registry
             const int blob_size = sqlite3_column_bytes(stmt.get(), 0);
             spdlog::debug("SQLite::getTransformationRecordHandle('{}'): row found blob_size={}", name, blob_size);
 
-            auto record_opt = parseRecordBlob<TransformationRecord>(stmt.get(), 0);
-            if(!record_opt.has_value())
+            auto record_handle = decodeRecordHandle<TransformationRecord>(stmt.get(), 0);
+            if(!record_handle)
             {
                 
                 spdlog::debug("SQLite::getTransformationRecordHandle('{}'): protobuf decode failed", name);
@@ -913,7 +1408,7 @@ namespace dcn::registry
             }
 
             spdlog::debug("SQLite::getTransformationRecordHandle('{}'): decoded record", name);
-            return std::make_shared<TransformationRecord>(std::move(*record_opt));
+            return record_handle;
         }
         catch(const std::exception & e)
         {
@@ -922,8 +1417,30 @@ namespace dcn::registry
         }
     }
 
+    std::vector<std::optional<TransformationRecordHandle>> SQLiteRegistryStore::getTransformationRecordHandles(
+        std::span<const std::string> names) const
+    {
+        if(names.empty())
+        {
+            return {};
+        }
+
+        try
+        {
+            const ReadLease reader(*this);
+            return fetchRecordsByName<TransformationRecord>(reader.db(), "transformations", names);
+        }
+        catch(const std::exception & e)
+        {
+            spdlog::error("SQLite getTransformationRecordHandles query failed for {} names: {}", names.size(), e.what());
+            return std::vector<std::optional<TransformationRecordHandle>>(names.size());
+        }
+    }
+
     bool SQLiteRegistryStore::addTransformation(const chain::Address & address, const TransformationRecord & record)
     {
+        const std::lock_guard<std::mutex> write_lock(_write_mutex);
+
         const std::string & transformation_name = record.transformation().name();
         const auto owner_opt = evmc::from_hex<chain::Address>(record.owner());
         if(!owner_opt)
@@ -975,6 +1492,13 @@ namespace dcn::registry
                 rollback_with_log("insert owned_transformations");
                 return false;
             }
+
+            AggregateWriter aggregates(_db);
+            if(!aggregates.noteAccount(*owner_opt))
+            {
+                rollback_with_log("update accounts");
+                return false;
+            }
         }
         catch(const std::exception & e)
         {
@@ -993,8 +1517,18 @@ namespace dcn::registry
         return true;
     }
 
-    bool SQLiteRegistryStore::addTransformationsBatch(const std::vector<TransformationBatchItem> & items, bool all_or_nothing)
+    bool SQLiteRegistryStore::addTransformationsBatch(
+        const std::vector<TransformationBatchItem> & items,
+        bool all_or_nothing,
+        std::vector<bool> * inserted_items)
     {
+        const std::lock_guard<std::mutex> write_lock(_write_mutex);
+
+        if(inserted_items != nullptr)
+        {
+            inserted_items->assign(items.size(), false);
+        }
+
         if(items.empty())
         {
             return true;
@@ -1011,6 +1545,10 @@ namespace dcn::registry
         auto rollback_batch_with_log = [&](const char * reason)
         {
             spdlog::debug("DB remove transformation batch pending changes count={} reason={}", items.size(), reason);
+            if(inserted_items != nullptr)
+            {
+                inserted_items->assign(items.size(), false);
+            }
             _rollbackTransaction();
         };
 
@@ -1018,6 +1556,7 @@ namespace dcn::registry
         {
             storage::sqlite::Statement insert_entity(_db, "INSERT INTO transformations(name, owner, payload_blob) VALUES(?1, ?2, ?3);");
             storage::sqlite::Statement insert_owned(_db, "INSERT OR REPLACE INTO owned_transformations(owner, name) VALUES(?1, ?2);");
+            AggregateWriter aggregates(_db);
             for(const TransformationBatchItem & item : items)
             {
                 const bool use_savepoint = !all_or_nothing;
@@ -1099,6 +1638,11 @@ namespace dcn::registry
                     }
                 }
 
+                if(item_ok && !aggregates.noteAccount(*owner_opt))
+                {
+                    item_ok = fail_item("update accounts");
+                }
+
                 if(item_ok && savepoint_active)
                 {
                     if(!_exec("RELEASE SAVEPOINT transformation_batch_item;"))
@@ -1124,6 +1668,10 @@ namespace dcn::registry
                 else
                 {
                     ++inserted_count;
+                    if(inserted_items != nullptr)
+                    {
+                        (*inserted_items)[static_cast<std::size_t>(&item - items.data())] = true;
+                    }
                 }
             }
         }
@@ -1148,22 +1696,23 @@ namespace dcn::registry
     {
         try
         {
-            if(_db == nullptr)
+            const ReadLease reader(*this);
+            if(reader.db() == nullptr)
             {
                 spdlog::error("SQLite hasCondition called with null DB handle for name={}", name);
                 return false;
             }
             
-            spdlog::debug("SQLite::hasCondition('{}'): prepare (db={})", name, static_cast<const void *>(_db));
+            spdlog::debug("SQLite::hasCondition('{}'): prepare (db={})", name, static_cast<const void *>(reader.db()));
             
-            storage::sqlite::Statement stmt(_db, "SELECT 1 FROM conditions WHERE name = ?1 LIMIT 1;");
+            storage::sqlite::Statement stmt(reader.db(), "SELECT 1 FROM conditions WHERE name = ?1 LIMIT 1;");
             const int bind_rc = sqlite3_bind_text(stmt.get(), 1, name.c_str(), static_cast<int>(name.size()), SQLITE_TRANSIENT);
             
             spdlog::debug("SQLite::hasCondition('{}'): bind rc={}", name, bind_rc);
             
             if(bind_rc != SQLITE_OK)
             {
-                spdlog::error("SQLite::hasCondition('{}'): bind failed rc={} err={}", name, bind_rc, sqlite3_errmsg(_db));
+                spdlog::error("SQLite::hasCondition('{}'): bind failed rc={} err={}", name, bind_rc, sqlite3_errmsg(reader.db()));
                 return false;
             }
             const int rc = stmt.step();
@@ -1183,10 +1732,11 @@ namespace dcn::registry
     {
         try
         {
+            const ReadLease reader(*this);
             
             spdlog::debug("SQLite::getConditionRecordHandle('{}'): prepare", name);
             
-            storage::sqlite::Statement stmt(_db, "SELECT payload_blob FROM conditions WHERE name = ?1 LIMIT 1;");
+            storage::sqlite::Statement stmt(reader.db(), "SELECT payload_blob FROM conditions WHERE name = ?1 LIMIT 1;");
             sqlite3_bind_text(stmt.get(), 1, name.c_str(), static_cast<int>(name.size()), SQLITE_TRANSIENT);
             
             spdlog::debug("SQLite::getConditionRecordHandle('{}'): bound name", name);
@@ -1203,8 +1753,8 @@ namespace dcn::registry
             const int blob_size = sqlite3_column_bytes(stmt.get(), 0);
             spdlog::debug("SQLite::getConditionRecordHandle('{}'): row found blob_size={}", name, blob_size);
 
-            auto record_opt = parseRecordBlob<ConditionRecord>(stmt.get(), 0);
-            if(!record_opt.has_value())
+            auto record_handle = decodeRecordHandle<ConditionRecord>(stmt.get(), 0);
+            if(!record_handle)
             {
                 
                 spdlog::debug("SQLite::getConditionRecordHandle('{}'): protobuf decode failed", name);
@@ -1213,7 +1763,7 @@ namespace dcn::registry
 
             
             spdlog::debug("SQLite::getConditionRecordHandle('{}'): decoded record", name);
-            return std::make_shared<ConditionRecord>(std::move(*record_opt));
+            return record_handle;
         }
         catch(const std::exception & e)
         {
@@ -1222,8 +1772,30 @@ namespace dcn::registry
         }
     }
 
+    std::vector<std::optional<ConditionRecordHandle>> SQLiteRegistryStore::getConditionRecordHandles(
+        std::span<const std::string> names) const
+    {
+        if(names.empty())
+        {
+            return {};
+        }
+
+        try
+        {
+            const ReadLease reader(*this);
+            return fetchRecordsByName<ConditionRecord>(reader.db(), "conditions", names);
+        }
+        catch(const std::exception & e)
+        {
+            spdlog::error("SQLite getConditionRecordHandles query failed for {} names: {}", names.size(), e.what());
+            return std::vector<std::optional<ConditionRecordHandle>>(names.size());
+        }
+    }
+
     bool SQLiteRegistryStore::addCondition(const chain::Address & address, const ConditionRecord & record)
     {
+        const std::lock_guard<std::mutex> write_lock(_write_mutex);
+
         const std::string & condition_name = record.condition().name();
         const auto owner_opt = evmc::from_hex<chain::Address>(record.owner());
         if(!owner_opt)
@@ -1275,6 +1847,13 @@ namespace dcn::registry
                 rollback_with_log("insert owned_conditions");
                 return false;
             }
+
+            AggregateWriter aggregates(_db);
+            if(!aggregates.noteAccount(*owner_opt))
+            {
+                rollback_with_log("update accounts");
+                return false;
+            }
         }
         catch(const std::exception & e)
         {
@@ -1293,8 +1872,18 @@ namespace dcn::registry
         return true;
     }
 
-    bool SQLiteRegistryStore::addConditionsBatch(const std::vector<ConditionBatchItem> & items, bool all_or_nothing)
+    bool SQLiteRegistryStore::addConditionsBatch(
+        const std::vector<ConditionBatchItem> & items,
+        bool all_or_nothing,
+        std::vector<bool> * inserted_items)
     {
+        const std::lock_guard<std::mutex> write_lock(_write_mutex);
+
+        if(inserted_items != nullptr)
+        {
+            inserted_items->assign(items.size(), false);
+        }
+
         if(items.empty())
         {
             return true;
@@ -1311,6 +1900,10 @@ namespace dcn::registry
         auto rollback_batch_with_log = [&](const char * reason)
         {
             spdlog::debug("DB remove condition batch pending changes count={} reason={}", items.size(), reason);
+            if(inserted_items != nullptr)
+            {
+                inserted_items->assign(items.size(), false);
+            }
             _rollbackTransaction();
         };
 
@@ -1318,6 +1911,7 @@ namespace dcn::registry
         {
             storage::sqlite::Statement insert_entity(_db, "INSERT INTO conditions(name, owner, payload_blob) VALUES(?1, ?2, ?3);");
             storage::sqlite::Statement insert_owned(_db, "INSERT OR REPLACE INTO owned_conditions(owner, name) VALUES(?1, ?2);");
+            AggregateWriter aggregates(_db);
             for(const ConditionBatchItem & item : items)
             {
                 const bool use_savepoint = !all_or_nothing;
@@ -1399,6 +1993,11 @@ namespace dcn::registry
                     }
                 }
 
+                if(item_ok && !aggregates.noteAccount(*owner_opt))
+                {
+                    item_ok = fail_item("update accounts");
+                }
+
                 if(item_ok && savepoint_active)
                 {
                     if(!_exec("RELEASE SAVEPOINT condition_batch_item;"))
@@ -1424,6 +2023,10 @@ namespace dcn::registry
                 else
                 {
                     ++inserted_count;
+                    if(inserted_items != nullptr)
+                    {
+                        (*inserted_items)[static_cast<std::size_t>(&item - items.data())] = true;
+                    }
                 }
             }
         }
@@ -1458,13 +2061,14 @@ namespace dcn::registry
 
         try
         {
+            const ReadLease reader(*this);
             const std::size_t query_limit = limit + 1;
             if(after.has_value())
             {
                 const std::string sql =
                     std::string("SELECT name FROM ") + table_name +
                     " WHERE owner = ?1 AND name > ?2 ORDER BY name ASC LIMIT ?3;";
-                storage::sqlite::Statement stmt(_db, sql.c_str());
+                storage::sqlite::Statement stmt(reader.db(), sql.c_str());
                 bindAddress(stmt.get(), 1, owner);
                 sqlite3_bind_text(stmt.get(), 2, after->c_str(), static_cast<int>(after->size()), SQLITE_TRANSIENT);
                 sqlite3_bind_int(stmt.get(), 3, toSqliteInt(query_limit));
@@ -1483,7 +2087,7 @@ namespace dcn::registry
                 const std::string sql =
                     std::string("SELECT name FROM ") + table_name +
                     " WHERE owner = ?1 ORDER BY name ASC LIMIT ?2;";
-                storage::sqlite::Statement stmt(_db, sql.c_str());
+                storage::sqlite::Statement stmt(reader.db(), sql.c_str());
                 bindAddress(stmt.get(), 1, owner);
                 sqlite3_bind_int(stmt.get(), 2, toSqliteInt(query_limit));
                 for(int rc = stmt.step(); rc == SQLITE_ROW; rc = stmt.step())
@@ -1539,28 +2143,7 @@ namespace dcn::registry
 
     std::size_t SQLiteRegistryStore::getAccountsCount() const
     {
-        try
-        {
-            storage::sqlite::Statement stmt(
-                _db,
-                "SELECT COUNT(*) FROM ("
-                "SELECT owner FROM owned_connectors "
-                "UNION "
-                "SELECT owner FROM owned_transformations "
-                "UNION "
-                "SELECT owner FROM owned_conditions"
-                ") AS all_owners;");
-            if(stmt.step() != SQLITE_ROW)
-            {
-                return 0;
-            }
-            return static_cast<std::size_t>(sqlite3_column_int64(stmt.get(), 0));
-        }
-        catch(const std::exception & e)
-        {
-            spdlog::error("SQLite getAccountsCount query failed: {}", e.what());
-            return 0;
-        }
+        return _readCounter("accounts");
     }
 
     NameCursorPage SQLiteRegistryStore::getAccountsCursor(
@@ -1575,18 +2158,13 @@ namespace dcn::registry
 
         try
         {
+            const ReadLease reader(*this);
             const std::size_t query_limit = limit + 1;
             if(after.has_value())
             {
                 storage::sqlite::Statement stmt(
-                    _db,
-                    "SELECT owner FROM ("
-                    "SELECT owner FROM owned_connectors "
-                    "UNION "
-                    "SELECT owner FROM owned_transformations "
-                    "UNION "
-                    "SELECT owner FROM owned_conditions"
-                    ") AS all_owners "
+                    reader.db(),
+                    "SELECT owner FROM accounts "
                     "WHERE owner > ?1 ORDER BY owner ASC LIMIT ?2;");
                 bindAddress(stmt.get(), 1, *after);
                 sqlite3_bind_int(stmt.get(), 2, toSqliteInt(query_limit));
@@ -1602,14 +2180,8 @@ namespace dcn::registry
             else
             {
                 storage::sqlite::Statement stmt(
-                    _db,
-                    "SELECT owner FROM ("
-                    "SELECT owner FROM owned_connectors "
-                    "UNION "
-                    "SELECT owner FROM owned_transformations "
-                    "UNION "
-                    "SELECT owner FROM owned_conditions"
-                    ") AS all_owners "
+                    reader.db(),
+                    "SELECT owner FROM accounts "
                     "ORDER BY owner ASC LIMIT ?1;");
                 sqlite3_bind_int(stmt.get(), 1, toSqliteInt(query_limit));
                 for(int rc = stmt.step(); rc == SQLITE_ROW; rc = stmt.step())
@@ -1645,8 +2217,148 @@ namespace dcn::registry
         return page;
     }
 
+    std::size_t SQLiteRegistryStore::_countTableRows(const char * table_name) const
+    {
+        try
+        {
+            const ReadLease reader(*this);
+            const std::string sql = std::string("SELECT COUNT(*) FROM ") + table_name + ";";
+            storage::sqlite::Statement stmt(reader.db(), sql.c_str());
+            if(stmt.step() != SQLITE_ROW)
+            {
+                return 0;
+            }
+            return static_cast<std::size_t>(sqlite3_column_int64(stmt.get(), 0));
+        }
+        catch(const std::exception & e)
+        {
+            spdlog::error("SQLite row count query failed for table={}: {}", table_name, e.what());
+            return 0;
+        }
+    }
+
+    bool SQLiteRegistryStore::_forEachNameInTable(const char * table_name, const NameVisitor & visitor) const
+    {
+        try
+        {
+            const ReadLease reader(*this);
+            const std::string sql = std::string("SELECT name FROM ") + table_name + ";";
+            storage::sqlite::Statement stmt(reader.db(), sql.c_str());
+
+            int rc = stmt.step();
+            std::string name;
+            for(; rc == SQLITE_ROW; rc = stmt.step())
+            {
+                const unsigned char * name_text = sqlite3_column_text(stmt.get(), 0);
+                if(name_text == nullptr)
+                {
+                    continue;
+                }
+                name.assign(
+                    reinterpret_cast<const char *>(name_text),
+                    static_cast<std::size_t>(sqlite3_column_bytes(stmt.get(), 0)));
+                visitor(name);
+            }
+            return rc == SQLITE_DONE;
+        }
+        catch(const std::exception & e)
+        {
+            spdlog::error("SQLite name scan failed for table={}: {}", table_name, e.what());
+            return false;
+        }
+    }
+
+    std::size_t SQLiteRegistryStore::getConnectorsCount() const
+    {
+        return _countTableRows("connectors");
+    }
+
+    bool SQLiteRegistryStore::forEachConnectorName(const NameVisitor & visitor) const
+    {
+        return _forEachNameInTable("connectors", visitor);
+    }
+
+    std::size_t SQLiteRegistryStore::getTransformationsCount() const
+    {
+        return _countTableRows("transformations");
+    }
+
+    bool SQLiteRegistryStore::forEachTransformationName(const NameVisitor & visitor) const
+    {
+        return _forEachNameInTable("transformations", visitor);
+    }
+
+    std::size_t SQLiteRegistryStore::getConditionsCount() const
+    {
+        return _countTableRows("conditions");
+    }
+
+    std::string SQLiteRegistryStore::getWriteMarker() const
+    {
+        return std::format("{:016x}:{}", _readCounter("store_id"), _readCounter("writes"));
+    }
+
+    bool SQLiteRegistryStore::forEachConditionName(const NameVisitor & visitor) const
+    {
+        return _forEachNameInTable("conditions", visitor);
+    }
+
+    bool SQLiteRegistryStore::forEachFormatScalarLabels(const FormatLabelsVisitor & visitor) const
+    {
+        try
+        {
+            const ReadLease reader(*this);
+            storage::sqlite::Statement stmt(
+                reader.db(),
+                "SELECT format_hash, scalar, path_hash, tail_id FROM scalar_labels_by_format ORDER BY format_hash ASC;");
+
+            std::optional<evmc::bytes32> current_format;
+            std::vector<ScalarLabel> labels;
+            int rc = stmt.step();
+            for(; rc == SQLITE_ROW; rc = stmt.step())
+            {
+                const auto format_hash = columnBytes32(stmt.get(), 0);
+                const unsigned char * scalar_text = sqlite3_column_text(stmt.get(), 1);
+                const auto path_hash = columnBytes32(stmt.get(), 2);
+                const sqlite3_int64 tail_id_raw = sqlite3_column_int64(stmt.get(), 3);
+                if(!format_hash.has_value() || scalar_text == nullptr || !path_hash.has_value())
+                {
+                    continue;
+                }
+                if(tail_id_raw < 0 || tail_id_raw > static_cast<sqlite3_int64>(std::numeric_limits<std::uint32_t>::max()))
+                {
+                    continue;
+                }
+
+                if(current_format.has_value() && *current_format != *format_hash)
+                {
+                    visitor(*current_format, labels);
+                    labels.clear();
+                }
+                current_format = *format_hash;
+                labels.push_back(ScalarLabel{
+                    .scalar = std::string(reinterpret_cast<const char *>(scalar_text)),
+                    .path_hash = *path_hash,
+                    .tail_id = static_cast<std::uint32_t>(tail_id_raw)});
+            }
+
+            if(current_format.has_value())
+            {
+                visitor(*current_format, labels);
+            }
+            return rc == SQLITE_DONE;
+        }
+        catch(const std::exception & e)
+        {
+            spdlog::error("SQLite scalar label scan failed: {}", e.what());
+            return false;
+        }
+    }
+
     bool SQLiteRegistryStore::checkpointWal(const storage::sqlite::WalCheckpointMode mode) const
     {
+        const std::lock_guard<std::mutex> write_lock(_write_mutex);
+
         if(_db == nullptr)
         {
             return false;
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "native.h"
+#include "async.hpp"
+
+namespace dcn::storage::pack
+{
+    struct PackStoreConfig
+    {
+        // The active segment is sealed and a new one started once it grows past this.
+        std::uint64_t segment_bytes = 64 * 1024 * 1024;
+        // Appends are fsync'ed in the background in groups of at least this many bytes, and always on sync() and
+        // close; 0 syncs each one before put returns.
+        std::uint64_t sync_bytes = 1024 * 1024;
+        // The index is rewritten this often while it is behind the segments, so a restart after a crash only
+        // replays what came after; 0 writes it only on sync() and close.
+        std::chrono::milliseconds index_interval{std::chrono::seconds(30)};
+        // Segments are rewritten once dead records make up this share of them...
+        double compact_garbage_ratio = 0.5;
+        // ...and take at least this many bytes.
+        std::uint64_t compact_min_garbage_bytes = 16 * 1024 * 1024;
+        // Loose files of the store directory with one of these extensions are moved into the pack when it opens.
+        std::vector<std::string> migrate_extensions;
+    };
+
+    struct PackStoreStats
+    {
+        std::size_t entries = 0;
+        std::size_t segments = 0;
+        std::uint64_t live_bytes = 0;
+        std::uint64_t total_bytes = 0;
+        std::uint64_t compactions = 0;
+        std::uint64_t migrated_files = 0;
+    };
+
+    // Values of a key range read straight out of mapped segments. The views stay valid as long as the scan.
+    class PackScan
+    {
+        public:
+            struct Entry
+            {
+                std::string_view key;
+                std::string_view value;
+            };
+
+            // Sorted by key.
+            const std::vector<Entry> & entries() const { return _entries; }
+
+        private:
+            friend class PackStore;
+
+            std::vector<std::shared_ptr<const native::MappedFile>> _segments;
+            std::vector<Entry> _entries;
+    };
+
+    // Append-only key/value store under `<dir>/pack`: records go to numbered segment files, an index
+    // file maps every live key to its record, and segments holding mostly dead records are rewritten.
+    // Replaces one small file per value, whose inode and fsync cost dominate large stores.
+    // Group syncs and compaction run on a maintenance thread of the store, never inside put or erase.
+    class PackStore
+    {
+        public:
+            // Replays whatever the index does not cover yet and cuts a torn record off the last segment.
+            explicit PackStore(std::filesystem::path dir, PackStoreConfig config = {});
+            ~PackStore();
+
+            PackStore(const PackStore&) = delete;
+            PackStore& operator=(const PackStore&) = delete;
+
+            // Store shared by every caller of `dir` in this process; `config` applies when it is first opened.
+            static PackStore & forDirectory(const std::filesystem::path & dir, const PackStoreConfig & config = {});
+            // Syncs every store opened through forDirectory; those live until static destruction, so shutdown
+            // paths call this instead of relying on it.
+            static bool syncAll();
+
+            bool put(std::string_view key, std::string_view value);
+            bool erase(std::string_view key);
+
+            bool contains(std::string_view key) const;
+            std::optional<std::string> get(std::string_view key) const;
+
+            // Every entry whose key ends with `key_suffix`.
+            PackScan scan(std::string_view key_suffix) const;
+
+            // Flushes pending appends to disk and rewrites the index.
+            bool sync();
+            // Rewrites the live records now; puts and reads go on meanwhile.
+            bool compact();
+
+            PackStoreStats stats() const;
+            const std::filesystem::path & directory() const;
+
+        private:
+            struct Location
+            {
+                std::uint32_t segment = 0;
+                std::uint64_t offset = 0;
+                std::uint32_t value_size = 0;
+
+                bool operator==(const Location &) const = default;
+            };
+
+            bool _loadIndex(std::uint32_t & watermark_segment, std::uint64_t & watermark_offset);
+            std::string _encodeIndex();
+            bool _publishIndex(const std::string & data);
+            bool _writeIndex();
+            void _replay(std::uint32_t segment, std::uint64_t from);
+            void _dropUnreferencedSegments();
+            bool _openActive(std::uint32_t segment);
+            bool _append(std::uint8_t op, std::string_view key, std::string_view value, Location & location);
+            bool _syncActive();
+            bool _syncPending();
+            bool _compact(bool forced);
+            bool _needsCompaction() const;
+            void _maybeCompact();
+            void _migrate();
+            void _requestMaintenance();
+            void _runMaintenance();
+            void _scheduleIndexWrite();
+
+            std::filesystem::path _segmentPath(std::uint32_t segment) const;
+            std::uint64_t _recordSize(std::size_t key_size, std::size_t value_size) const;
+            std::uint64_t _totalBytes() const;
+
+            std::filesystem::path _dir;
+            std::filesystem::path _pack_dir;
+            PackStoreConfig _config;
+
+            mutable std::mutex _mutex;
+            absl::flat_hash_map<std::string, Location> _index;
+            std::vector<std::uint32_t> _segments;
+            absl::flat_hash_map<std::uint32_t, std::uint64_t> _segment_sizes;
+            std::uint64_t _live_bytes = 0;
+
+            std::uint32_t _active_segment = 0;
+            std::ofstream _active;
+            std::uint64_t _unsynced_bytes = 0;
+            // Segments sealed before all of their appends were synced.
+            std::vector<std::uint32_t> _sealed_unsynced;
+            bool _index_dirty = false;
+
+            std::uint64_t _compactions = 0;
+            std::uint64_t _migrated_files = 0;
+
+            // Serializes the slow disk work, which runs without `_mutex` held.
+            std::mutex _maintenance_mutex;
+            bool _maintenance_scheduled = false;
+            bool _sync_requested = false;
+            bool _compact_requested = false;
+            bool _stopping = false;
+            asio::thread_pool _maintenance{1};
+            asio::steady_timer _index_timer{_maintenance};
+    };
+}
@@ -3,6 +3,7 @@
 #include "sqlite/wal.hpp"
 #include "sqlite/wal_store.hpp"
 #include "sqlite/wal_sync_worker.hpp"
+#include "pack/pack_store.hpp"
 
 
 namespace dcn::storage
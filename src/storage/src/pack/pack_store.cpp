@@ -0,0 +1,1184 @@
+#include "pack/pack_store.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <system_error>
+#include <utility>
+
+#include <absl/container/flat_hash_set.h>
+#include <spdlog/spdlog.h>
+
+namespace dcn::storage::pack
+{
+    namespace
+    {
+        constexpr std::uint32_t RECORD_MAGIC = 0x50'4E'43'44; // "DCNP"
+        constexpr std::uint8_t OP_PUT = 1;
+        constexpr std::uint8_t OP_ERASE = 2;
+        // magic, op, key size, value size, checksum
+        constexpr std::size_t RECORD_HEADER_SIZE = 4 + 1 + 4 + 4 + 8;
+
+        constexpr std::string_view INDEX_MAGIC{"DCNPIDX\0", 8};
+        constexpr std::uint32_t INDEX_FORMAT_VERSION = 1;
+
+        constexpr std::string_view SEGMENT_PREFIX = "seg-";
+        constexpr std::string_view SEGMENT_EXTENSION = ".pack";
+
+        constexpr std::uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+        constexpr std::uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+        std::uint64_t fnv1a(std::string_view data, std::uint64_t hash = FNV_OFFSET)
+        {
+            for(const char c : data)
+            {
+                hash ^= static_cast<std::uint8_t>(c);
+                hash *= FNV_PRIME;
+            }
+            return hash;
+        }
+
+        std::uint64_t recordChecksum(std::uint8_t op, std::string_view key, std::string_view value)
+        {
+            const char op_byte = static_cast<char>(op);
+            return fnv1a(value, fnv1a(key, fnv1a(std::string_view(&op_byte, 1))));
+        }
+
+        void appendLE(std::string & out, std::uint64_t value, std::size_t size)
+        {
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+            }
+        }
+
+        // Header of the record; its key and value follow it in the segment.
+        std::string encodeRecordHeader(std::uint8_t op, std::string_view key, std::string_view value)
+        {
+            std::string header;
+            header.reserve(RECORD_HEADER_SIZE);
+            appendLE(header, RECORD_MAGIC, 4);
+            appendLE(header, op, 1);
+            appendLE(header, key.size(), 4);
+            appendLE(header, value.size(), 4);
+            appendLE(header, recordChecksum(op, key, value), 8);
+            return header;
+        }
+
+        std::uint64_t readLE(const char * data, std::size_t size)
+        {
+            std::uint64_t value = 0;
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                value |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(data[i])) << (8 * i);
+            }
+            return value;
+        }
+
+        struct RecordView
+        {
+            std::uint8_t op = 0;
+            std::string_view key;
+            std::string_view value;
+            std::uint64_t size = 0;
+        };
+
+        // Parses the record at `offset`, or returns std::nullopt for a torn or corrupt one.
+        std::optional<RecordView> readRecord(std::string_view segment, std::uint64_t offset)
+        {
+            if(offset > segment.size() || segment.size() - offset < RECORD_HEADER_SIZE)
+            {
+                return std::nullopt;
+            }
+
+            const char * header = segment.data() + offset;
+            if(readLE(header, 4) != RECORD_MAGIC)
+            {
+                return std::nullopt;
+            }
+
+            RecordView record;
+            record.op = static_cast<std::uint8_t>(header[4]);
+            const std::uint64_t key_size = readLE(header + 5, 4);
+            const std::uint64_t value_size = readLE(header + 9, 4);
+            const std::uint64_t checksum = readLE(header + 13, 8);
+
+            if((record.op != OP_PUT && record.op != OP_ERASE) ||
+                segment.size() - offset - RECORD_HEADER_SIZE < key_size + value_size)
+            {
+                return std::nullopt;
+            }
+
+            record.key = segment.substr(offset + RECORD_HEADER_SIZE, key_size);
+            record.value = segment.substr(offset + RECORD_HEADER_SIZE + key_size, value_size);
+            record.size = RECORD_HEADER_SIZE + key_size + value_size;
+
+            if(recordChecksum(record.op, record.key, record.value) != checksum)
+            {
+                return std::nullopt;
+            }
+            return record;
+        }
+
+        std::string_view viewOf(const native::MappedFile & file)
+        {
+            return std::string_view(reinterpret_cast<const char *>(file.data()), file.size());
+        }
+
+        struct OpenStores
+        {
+            std::mutex mutex;
+            absl::flat_hash_map<std::string, std::unique_ptr<PackStore>> stores;
+        };
+
+        OpenStores & openStores()
+        {
+            static OpenStores open_stores;
+            return open_stores;
+        }
+
+        std::optional<std::uint32_t> parseSegmentId(const std::filesystem::path & path)
+        {
+            const std::string filename = path.filename().string();
+            if(!filename.starts_with(SEGMENT_PREFIX) || !filename.ends_with(SEGMENT_EXTENSION))
+            {
+                return std::nullopt;
+            }
+
+            const std::string_view digits = std::string_view(filename).substr(
+                SEGMENT_PREFIX.size(), filename.size() - SEGMENT_PREFIX.size() - SEGMENT_EXTENSION.size());
+            std::uint32_t id = 0;
+            const auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), id);
+            if(ec != std::errc{} || end != digits.data() + digits.size())
+            {
+                return std::nullopt;
+            }
+            return id;
+        }
+    }
+
+    PackStore::PackStore(std::filesystem::path dir, PackStoreConfig config)
+    :   _dir(std::move(dir)),
+        _pack_dir(_dir / "pack"),
+        _config(std::move(config))
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(_pack_dir, ec);
+        if(ec)
+        {
+            spdlog::error("Failed to create pack directory '{}': {}", _pack_dir.string(), ec.message());
+        }
+
+        for(const auto & entry : std::filesystem::directory_iterator(_pack_dir, ec))
+        {
+            const std::optional<std::uint32_t> id = parseSegmentId(entry.path());
+            if(id && entry.is_regular_file())
+            {
+                _segments.push_back(*id);
+                _segment_sizes[*id] = entry.file_size();
+            }
+        }
+        std::ranges::sort(_segments);
+
+        // Without a usable index every segment is replayed from the start.
+        std::uint32_t watermark_segment = _segments.empty() ? 0 : _segments.front();
+        std::uint64_t watermark_offset = 0;
+        _loadIndex(watermark_segment, watermark_offset);
+
+        for(const std::uint32_t segment : _segments)
+        {
+            if(segment >= watermark_segment)
+            {
+                _replay(segment, segment == watermark_segment ? watermark_offset : 0);
+            }
+        }
+        _dropUnreferencedSegments();
+
+        const std::uint32_t last_segment = _segments.empty() ? 0 : _segments.back();
+        if(_segments.empty() || _segment_sizes[last_segment] >= _config.segment_bytes)
+        {
+            _openActive(last_segment + 1);
+        }
+        else
+        {
+            _openActive(last_segment);
+        }
+
+        _migrate();
+
+        spdlog::debug("Opened pack '{}': entries={} segments={} live_bytes={}", _pack_dir.string(), _index.size(), _segments.size(), _live_bytes);
+        _maybeCompact();
+        asio::post(_maintenance, [this]() { _scheduleIndexWrite(); });
+    }
+
+    PackStore::~PackStore()
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _stopping = true;
+        }
+        asio::post(_maintenance, [this]() { _index_timer.cancel(); });
+        _maintenance.join();
+        sync();
+    }
+
+    PackStore & PackStore::forDirectory(const std::filesystem::path & dir, const PackStoreConfig & config)
+    {
+        std::error_code ec;
+        std::filesystem::path key_path = std::filesystem::weakly_canonical(dir, ec);
+        if(ec)
+        {
+            key_path = std::filesystem::absolute(dir);
+        }
+
+        OpenStores & open_stores = openStores();
+        std::lock_guard lock(open_stores.mutex);
+        auto & store = open_stores.stores[key_path.string()];
+        if(!store)
+        {
+            store = std::make_unique<PackStore>(dir, config);
+        }
+        return *store;
+    }
+
+    bool PackStore::syncAll()
+    {
+        OpenStores & open_stores = openStores();
+        std::lock_guard lock(open_stores.mutex);
+
+        bool synced = true;
+        for(const auto & [_, store] : open_stores.stores)
+        {
+            if(!store->sync())
+            {
+                spdlog::warn("Failed to sync pack '{}'", store->_pack_dir.string());
+                synced = false;
+            }
+        }
+        return synced;
+    }
+
+    bool PackStore::put(std::string_view key, std::string_view value)
+    {
+        std::lock_guard lock(_mutex);
+
+        Location location;
+        if(!_append(OP_PUT, key, value, location))
+        {
+            return false;
+        }
+
+        const auto [it, inserted] = _index.try_emplace(std::string(key), location);
+        if(!inserted)
+        {
+            _live_bytes -= _recordSize(key.size(), it->second.value_size);
+            it->second = location;
+        }
+        _live_bytes += _recordSize(key.size(), value.size());
+        _index_dirty = true;
+
+        _maybeCompact();
+        return true;
+    }
+
+    bool PackStore::erase(std::string_view key)
+    {
+        std::lock_guard lock(_mutex);
+
+        const auto it = _index.find(key);
+        if(it == _index.end())
+        {
+            return true;
+        }
+
+        Location location;
+        if(!_append(OP_ERASE, key, {}, location))
+        {
+            return false;
+        }
+
+        _live_bytes -= _recordSize(key.size(), it->second.value_size);
+        _index.erase(it);
+        _index_dirty = true;
+
+        _maybeCompact();
+        return true;
+    }
+
+    bool PackStore::contains(std::string_view key) const
+    {
+        std::lock_guard lock(_mutex);
+        return _index.contains(key);
+    }
+
+    std::optional<std::string> PackStore::get(std::string_view key) const
+    {
+        std::lock_guard lock(_mutex);
+
+        const auto it = _index.find(key);
+        if(it == _index.end())
+        {
+            return std::nullopt;
+        }
+
+        std::ifstream in(_segmentPath(it->second.segment), std::ios::binary);
+        in.seekg(static_cast<std::streamoff>(it->second.offset + RECORD_HEADER_SIZE + key.size()));
+
+        std::string value(it->second.value_size, '\0');
+        in.read(value.data(), static_cast<std::streamsize>(value.size()));
+        if(!in)
+        {
+            spdlog::error("Failed to read '{}' from pack '{}'", key, _pack_dir.string());
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    PackScan PackStore::scan(std::string_view key_suffix) const
+    {
+        std::lock_guard lock(_mutex);
+
+        PackScan scan;
+        absl::flat_hash_map<std::uint32_t, std::shared_ptr<const native::MappedFile>> mapped;
+        for(const auto & [key, location] : _index)
+        {
+            if(!key.ends_with(key_suffix))
+            {
+                continue;
+            }
+
+            auto & segment = mapped[location.segment];
+            if(!segment)
+            {
+                std::optional<native::MappedFile> file = native::mapFile(_segmentPath(location.segment));
+                if(!file)
+                {
+                    spdlog::error("Failed to map pack segment '{}'", _segmentPath(location.segment).string());
+                    continue;
+                }
+                segment = std::make_shared<const native::MappedFile>(std::move(*file));
+                scan._segments.push_back(segment);
+            }
+
+            // Keys and values are viewed in the mapping, so the scan does not depend on the index staying put.
+            const std::optional<RecordView> record = readRecord(viewOf(*segment), location.offset);
+            if(!record || record->op != OP_PUT)
+            {
+                spdlog::error("Pack '{}' has a corrupt record for '{}'", _pack_dir.string(), key);
+                continue;
+            }
+            scan._entries.push_back(PackScan::Entry{.key = record->key, .value = record->value});
+        }
+
+        std::ranges::sort(scan._entries, {}, &PackScan::Entry::key);
+        return scan;
+    }
+
+    bool PackStore::sync()
+    {
+        std::lock_guard maintenance_lock(_maintenance_mutex);
+        if(!_syncPending())
+        {
+            return false;
+        }
+
+        std::string data;
+        {
+            std::lock_guard lock(_mutex);
+            // Only what was appended since the bulk sync above goes to disk with the lock held.
+            if(!_syncActive())
+            {
+                return false;
+            }
+            if(!_index_dirty)
+            {
+                return true;
+            }
+            data = _encodeIndex();
+            _index_dirty = false;
+        }
+
+        if(!_publishIndex(data))
+        {
+            std::lock_guard lock(_mutex);
+            _index_dirty = true;
+            return false;
+        }
+        return true;
+    }
+
+    bool PackStore::compact()
+    {
+        std::lock_guard maintenance_lock(_maintenance_mutex);
+        return _compact(true);
+    }
+
+    PackStoreStats PackStore::stats() const
+    {
+        std::lock_guard lock(_mutex);
+
+        return PackStoreStats{
+            .entries = _index.size(),
+            .segments = _segments.size(),
+            .live_bytes = _live_bytes,
+            .total_bytes = _totalBytes(),
+            .compactions = _compactions,
+            .migrated_files = _migrated_files
+        };
+    }
+
+    const std::filesystem::path & PackStore::directory() const
+    {
+        return _dir;
+    }
+
+    // Index layout: magic, version, watermark segment and offset, entry count, entries, checksum.
+    // Everything in segments before the watermark is reflected in the entries.
+    bool PackStore::_loadIndex(std::uint32_t & watermark_segment, std::uint64_t & watermark_offset)
+    {
+        const std::filesystem::path index_path = _pack_dir / "index";
+        const std::optional<native::MappedFile> file = native::mapFile(index_path);
+        if(!file)
+        {
+            return false;
+        }
+
+        const std::string_view data = viewOf(*file);
+        constexpr std::size_t FIXED_SIZE = 8 + 4 + 4 + 8 + 8;
+        if(data.size() < FIXED_SIZE + 8 || !data.starts_with(INDEX_MAGIC) ||
+            readLE(data.data() + 8, 4) != INDEX_FORMAT_VERSION ||
+            readLE(data.data() + data.size() - 8, 8) != fnv1a(data.substr(0, data.size() - 8)))
+        {
+            spdlog::warn("Ignoring invalid pack index '{}'; replaying all segments", index_path.string());
+            return false;
+        }
+
+        const std::uint64_t count = readLE(data.data() + 24, 8);
+
+        constexpr std::size_t ENTRY_FIXED_SIZE = 4 + 4 + 8 + 4;
+        const std::size_t end = data.size() - 8;
+        std::size_t offset = FIXED_SIZE;
+        for(std::uint64_t i = 0; i < count; ++i)
+        {
+            if(end - offset < ENTRY_FIXED_SIZE)
+            {
+                break;
+            }
+            const std::size_t key_size = readLE(data.data() + offset, 4);
+            if(end - offset - ENTRY_FIXED_SIZE < key_size)
+            {
+                break;
+            }
+
+            const char * fields = data.data() + offset + 4 + key_size;
+            const Location location{
+                .segment = static_cast<std::uint32_t>(readLE(fields, 4)),
+                .offset = readLE(fields + 4, 8),
+                .value_size = static_cast<std::uint32_t>(readLE(fields + 12, 4))
+            };
+            const std::string_view key = data.substr(offset + 4, key_size);
+            offset += ENTRY_FIXED_SIZE + key_size;
+
+            // Entries into segments that were lost or cut short mean the index cannot be trusted.
+            const auto size_it = _segment_sizes.find(location.segment);
+            if(size_it == _segment_sizes.end() || location.offset + _recordSize(key_size, location.value_size) > size_it->second)
+            {
+                break;
+            }
+
+            _index.emplace(key, location);
+            _live_bytes += _recordSize(key_size, location.value_size);
+        }
+
+        if(_index.size() != count || offset != end)
+        {
+            spdlog::warn("Pack index '{}' does not match its segments; replaying all segments", index_path.string());
+            _index.clear();
+            _live_bytes = 0;
+            return false;
+        }
+
+        watermark_segment = static_cast<std::uint32_t>(readLE(data.data() + 12, 4));
+        watermark_offset = readLE(data.data() + 16, 8);
+        return true;
+    }
+
+    std::string PackStore::_encodeIndex()
+    {
+        std::string data;
+        data.append(INDEX_MAGIC);
+        appendLE(data, INDEX_FORMAT_VERSION, 4);
+        appendLE(data, _active_segment, 4);
+        appendLE(data, _segment_sizes[_active_segment], 8);
+        appendLE(data, _index.size(), 8);
+        for(const auto & [key, location] : _index)
+        {
+            appendLE(data, key.size(), 4);
+            data.append(key);
+            appendLE(data, location.segment, 4);
+            appendLE(data, location.offset, 8);
+            appendLE(data, location.value_size, 4);
+        }
+        appendLE(data, fnv1a(data), 8);
+        return data;
+    }
+
+    bool PackStore::_publishIndex(const std::string & data)
+    {
+        const std::filesystem::path index_path = _pack_dir / "index";
+        std::filesystem::path tmp_path = index_path;
+        tmp_path += ".tmp";
+        {
+            std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+            out.write(data.data(), static_cast<std::streamsize>(data.size()));
+            out.close();
+            if(!out)
+            {
+                spdlog::error("Failed to write pack index '{}'", tmp_path.string());
+                return false;
+            }
+        }
+
+        if(!native::syncFile(tmp_path))
+        {
+            spdlog::warn("Failed to sync pack index '{}'", tmp_path.string());
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmp_path, index_path, ec);
+        if(ec)
+        {
+            spdlog::error("Failed to publish pack index '{}': {}", index_path.string(), ec.message());
+            return false;
+        }
+        return true;
+    }
+
+    bool PackStore::_writeIndex()
+    {
+        if(!_syncActive() || !_publishIndex(_encodeIndex()))
+        {
+            return false;
+        }
+        _index_dirty = false;
+        return true;
+    }
+
+    void PackStore::_replay(std::uint32_t segment, std::uint64_t from)
+    {
+        const std::filesystem::path path = _segmentPath(segment);
+        std::optional<std::uint64_t> torn_at;
+        std::size_t replayed = 0;
+        {
+            const std::optional<native::MappedFile> file = native::mapFile(path);
+            if(!file)
+            {
+                spdlog::error("Failed to map pack segment '{}'", path.string());
+                return;
+            }
+
+            const std::string_view data = viewOf(*file);
+            std::uint64_t offset = from;
+            while(offset < data.size())
+            {
+                const std::optional<RecordView> record = readRecord(data, offset);
+                if(!record)
+                {
+                    torn_at = offset;
+                    break;
+                }
+
+                const auto it = _index.find(record->key);
+                if(it != _index.end())
+                {
+                    _live_bytes -= _recordSize(record->key.size(), it->second.value_size);
+                }
+
+                if(record->op == OP_PUT)
+                {
+                    const Location location{
+                        .segment = segment,
+                        .offset = offset,
+                        .value_size = static_cast<std::uint32_t>(record->value.size())
+                    };
+                    if(it != _index.end())
+                    {
+                        it->second = location;
+                    }
+                    else
+                    {
+                        _index.emplace(record->key, location);
+                    }
+                    _live_bytes += record->size;
+                }
+                else if(it != _index.end())
+                {
+                    _index.erase(it);
+                }
+
+                offset += record->size;
+                ++replayed;
+            }
+        }
+
+        if(replayed > 0)
+        {
+            _index_dirty = true;
+        }
+
+        if(!torn_at)
+        {
+            return;
+        }
+
+        if(segment != _segments.back())
+        {
+            spdlog::error("Pack segment '{}' is corrupt at offset {}; skipping its remaining records", path.string(), *torn_at);
+            return;
+        }
+
+        // An append interrupted by a crash; nothing past it was ever acknowledged as synced.
+        std::error_code ec;
+        std::filesystem::resize_file(path, *torn_at, ec);
+        if(ec)
+        {
+            spdlog::error("Failed to truncate torn pack segment '{}': {}", path.string(), ec.message());
+            return;
+        }
+        spdlog::warn("Truncated torn record at offset {} of pack segment '{}'", *torn_at, path.string());
+        _segment_sizes[segment] = *torn_at;
+    }
+
+    // Only leading segments go: an erase record in a later segment may still shadow a put in an earlier one.
+    void PackStore::_dropUnreferencedSegments()
+    {
+        absl::flat_hash_set<std::uint32_t> referenced;
+        for(const auto & [_, location] : _index)
+        {
+            referenced.insert(location.segment);
+        }
+
+        std::size_t dropped = 0;
+        while(_segments.size() - dropped > 1 && !referenced.contains(_segments[dropped]))
+        {
+            const std::uint32_t segment = _segments[dropped];
+            std::error_code ec;
+            std::filesystem::remove(_segmentPath(segment), ec);
+            if(ec)
+            {
+                spdlog::warn("Failed to remove pack segment '{}': {}", _segmentPath(segment).string(), ec.message());
+                break;
+            }
+            _segment_sizes.erase(segment);
+            ++dropped;
+        }
+
+        if(dropped > 0)
+        {
+            _segments.erase(_segments.begin(), _segments.begin() + static_cast<std::ptrdiff_t>(dropped));
+            _index_dirty = true;
+        }
+    }
+
+    bool PackStore::_openActive(std::uint32_t segment)
+    {
+        if(_active.is_open())
+        {
+            _active.close();
+        }
+
+        _active_segment = segment;
+        if(!_segment_sizes.contains(segment))
+        {
+            _segments.push_back(segment);
+            _segment_sizes[segment] = 0;
+        }
+
+        _active.open(_segmentPath(segment), std::ios::binary | std::ios::app);
+        if(!_active.is_open())
+        {
+            spdlog::error("Failed to open pack segment '{}'", _segmentPath(segment).string());
+            return false;
+        }
+        return true;
+    }
+
+    bool PackStore::_append(std::uint8_t op, std::string_view key, std::string_view value, Location & location)
+    {
+        if(key.size() > UINT32_MAX || value.size() > UINT32_MAX)
+        {
+            spdlog::error("Pack record '{}' is too large", key);
+            return false;
+        }
+
+        if(_segment_sizes[_active_segment] >= _config.segment_bytes)
+        {
+            if(_unsynced_bytes > 0)
+            {
+                _sealed_unsynced.push_back(_active_segment);
+            }
+            if(!_openActive(_active_segment + 1))
+            {
+                return false;
+            }
+        }
+
+        const std::string header = encodeRecordHeader(op, key, value);
+
+        // Flushed right away so that reads, which go through separate handles, see the record.
+        _active.write(header.data(), static_cast<std::streamsize>(header.size()));
+        _active.write(key.data(), static_cast<std::streamsize>(key.size()));
+        _active.write(value.data(), static_cast<std::streamsize>(value.size()));
+        _active.flush();
+        if(!_active)
+        {
+            spdlog::error("Failed to append to pack segment '{}'", _segmentPath(_active_segment).string());
+            _active.clear();
+            return false;
+        }
+
+        const std::uint64_t record_size = _recordSize(key.size(), value.size());
+        std::uint64_t & segment_size = _segment_sizes[_active_segment];
+        location = Location{
+            .segment = _active_segment,
+            .offset = segment_size,
+            .value_size = static_cast<std::uint32_t>(value.size())
+        };
+        segment_size += record_size;
+        _unsynced_bytes += record_size;
+
+        if(_config.sync_bytes == 0)
+        {
+            return _syncActive();
+        }
+        if(_unsynced_bytes >= _config.sync_bytes)
+        {
+            _sync_requested = true;
+            _requestMaintenance();
+        }
+        return true;
+    }
+
+    bool PackStore::_syncActive()
+    {
+        if(_unsynced_bytes == 0)
+        {
+            return true;
+        }
+
+        for(const std::uint32_t segment : _sealed_unsynced)
+        {
+            if(!native::syncFile(_segmentPath(segment)))
+            {
+                spdlog::error("Failed to sync pack segment '{}'", _segmentPath(segment).string());
+                return false;
+            }
+        }
+        _sealed_unsynced.clear();
+
+        if(!native::syncFile(_segmentPath(_active_segment)))
+        {
+            spdlog::error("Failed to sync pack segment '{}'", _segmentPath(_active_segment).string());
+            return false;
+        }
+        _unsynced_bytes = 0;
+        return true;
+    }
+
+    // Syncs everything appended so far with the lock released, so puts go on meanwhile; what they append
+    // is left for the next round.
+    bool PackStore::_syncPending()
+    {
+        std::vector<std::uint32_t> segments;
+        std::uint64_t pending_bytes = 0;
+        {
+            std::lock_guard lock(_mutex);
+            if(_unsynced_bytes == 0)
+            {
+                return true;
+            }
+            segments = std::exchange(_sealed_unsynced, {});
+            segments.push_back(_active_segment);
+            pending_bytes = _unsynced_bytes;
+        }
+
+        for(const std::uint32_t segment : segments)
+        {
+            if(!native::syncFile(_segmentPath(segment)))
+            {
+                spdlog::error("Failed to sync pack segment '{}'", _segmentPath(segment).string());
+                std::lock_guard lock(_mutex);
+                _sealed_unsynced.insert(_sealed_unsynced.begin(), segments.begin(), segments.end());
+                return false;
+            }
+        }
+
+        std::lock_guard lock(_mutex);
+        _unsynced_bytes -= std::min(_unsynced_bytes, pending_bytes);
+        return true;
+    }
+
+    // Copies the live records into fresh segments numbered between the current ones and a new active
+    // segment, publishes an index that points there, then deletes the old segments. Puts go on to the new
+    // active segment meanwhile, so a replay still applies them over the copies; a crash before the index is
+    // published leaves the old index in charge, and the copies are replayed over it as plain overwrites.
+    bool PackStore::_compact(bool forced)
+    {
+        const auto started_at = std::chrono::steady_clock::now();
+        if(!_syncPending())
+        {
+            return false;
+        }
+
+        std::vector<std::uint32_t> old_segments;
+        std::uint64_t old_bytes = 0;
+        std::vector<std::pair<std::string, Location>> live;
+        std::uint32_t first_segment = 0;
+        std::uint32_t active_segment = 0;
+        {
+            std::lock_guard lock(_mutex);
+            if(!forced && !_needsCompaction())
+            {
+                return true;
+            }
+
+            old_segments = _segments;
+            old_bytes = _totalBytes();
+            live.assign(_index.begin(), _index.end());
+
+            // The copies never take more segments than their live bytes fill, plus a partial last one.
+            first_segment = old_segments.back() + 1;
+            active_segment = first_segment + static_cast<std::uint32_t>(_live_bytes / std::max<std::uint64_t>(_config.segment_bytes, 1)) + 2;
+            if(!_syncActive() || !_openActive(active_segment))
+            {
+                return false;
+            }
+        }
+        std::ranges::sort(live, {}, &std::pair<std::string, Location>::first);
+
+        absl::flat_hash_map<std::uint32_t, native::MappedFile> mapped;
+        for(const std::uint32_t segment : old_segments)
+        {
+            std::optional<native::MappedFile> file = native::mapFile(_segmentPath(segment));
+            if(!file)
+            {
+                spdlog::error("Failed to map pack segment '{}' for compaction", _segmentPath(segment).string());
+                return false;
+            }
+            mapped.emplace(segment, std::move(*file));
+        }
+
+        std::vector<std::uint32_t> written;
+        absl::flat_hash_map<std::uint32_t, std::uint64_t> written_sizes;
+        std::vector<Location> moved(live.size());
+        std::ofstream out;
+        const auto abort = [&]()
+        {
+            out.close();
+            for(const std::uint32_t segment : written)
+            {
+                std::error_code ec;
+                std::filesystem::remove(_segmentPath(segment), ec);
+            }
+            return false;
+        };
+
+        for(std::size_t i = 0; i < live.size(); ++i)
+        {
+            const auto & [key, location] = live[i];
+            const std::optional<RecordView> record = readRecord(viewOf(mapped.at(location.segment)), location.offset);
+            if(!record)
+            {
+                spdlog::error("Pack '{}' has a corrupt record for '{}'; aborting compaction", _pack_dir.string(), key);
+                return abort();
+            }
+
+            if(written.empty() || written_sizes[written.back()] >= _config.segment_bytes)
+            {
+                const std::uint32_t segment = written.empty() ? first_segment : written.back() + 1;
+                if(segment >= active_segment)
+                {
+                    spdlog::error("Pack '{}' ran out of segments for compaction", _pack_dir.string());
+                    return abort();
+                }
+                out.close();
+                out.open(_segmentPath(segment), std::ios::binary | std::ios::trunc);
+                written.push_back(segment);
+                written_sizes[segment] = 0;
+            }
+
+            const std::string header = encodeRecordHeader(OP_PUT, key, record->value);
+            out.write(header.data(), static_cast<std::streamsize>(header.size()));
+            out.write(key.data(), static_cast<std::streamsize>(key.size()));
+            out.write(record->value.data(), static_cast<std::streamsize>(record->value.size()));
+            if(!out)
+            {
+                spdlog::error("Failed to write pack segment '{}' for compaction", _segmentPath(written.back()).string());
+                return abort();
+            }
+
+            std::uint64_t & segment_size = written_sizes[written.back()];
+            moved[i] = Location{
+                .segment = written.back(),
+                .offset = segment_size,
+                .value_size = location.value_size
+            };
+            segment_size += _recordSize(key.size(), record->value.size());
+        }
+        if(!written.empty())
+        {
+            out.close();
+            if(!out)
+            {
+                return abort();
+            }
+        }
+        for(const std::uint32_t segment : written)
+        {
+            if(!native::syncFile(_segmentPath(segment)))
+            {
+                spdlog::error("Failed to sync pack segment '{}' for compaction", _segmentPath(segment).string());
+                return abort();
+            }
+        }
+
+        std::string index_data;
+        {
+            std::lock_guard lock(_mutex);
+            // Keys written or erased since the copy keep their newer record.
+            for(std::size_t i = 0; i < live.size(); ++i)
+            {
+                const auto it = _index.find(live[i].first);
+                if(it != _index.end() && it->second == live[i].second)
+                {
+                    it->second = moved[i];
+                }
+            }
+
+            std::vector<std::uint32_t> segments = written;
+            for(const std::uint32_t segment : _segments)
+            {
+                if(std::ranges::find(old_segments, segment) == old_segments.end())
+                {
+                    segments.push_back(segment);
+                }
+            }
+            for(const std::uint32_t segment : old_segments)
+            {
+                _segment_sizes.erase(segment);
+            }
+            for(const std::uint32_t segment : written)
+            {
+                _segment_sizes[segment] = written_sizes[segment];
+            }
+            _segments = std::move(segments);
+            _index_dirty = true;
+            ++_compactions;
+
+            if(!_syncActive())
+            {
+                return false;
+            }
+            index_data = _encodeIndex();
+            _index_dirty = false;
+        }
+
+        if(!_publishIndex(index_data))
+        {
+            std::lock_guard lock(_mutex);
+            _index_dirty = true;
+            return false;
+        }
+
+        mapped.clear();
+        for(const std::uint32_t segment : old_segments)
+        {
+            std::error_code ec;
+            std::filesystem::remove(_segmentPath(segment), ec);
+            if(ec)
+            {
+                spdlog::warn("Failed to remove compacted pack segment '{}': {}", _segmentPath(segment).string(), ec.message());
+            }
+        }
+
+        const PackStoreStats compacted = stats();
+        spdlog::info(
+            "Compacted pack '{}' in {}ms: {} -> {} bytes, {} entries",
+            _pack_dir.string(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started_at).count(),
+            old_bytes,
+            compacted.live_bytes,
+            compacted.entries);
+        return true;
+    }
+
+    bool PackStore::_needsCompaction() const
+    {
+        const std::uint64_t total_bytes = _totalBytes();
+        const std::uint64_t garbage_bytes = total_bytes - std::min(total_bytes, _live_bytes);
+        return garbage_bytes >= _config.compact_min_garbage_bytes &&
+            static_cast<double>(garbage_bytes) >= _config.compact_garbage_ratio * static_cast<double>(total_bytes);
+    }
+
+    void PackStore::_maybeCompact()
+    {
+        if(_needsCompaction())
+        {
+            _compact_requested = true;
+            _requestMaintenance();
+        }
+    }
+
+    void PackStore::_requestMaintenance()
+    {
+        if(_maintenance_scheduled)
+        {
+            return;
+        }
+        _maintenance_scheduled = true;
+        asio::post(_maintenance, [this]() { _runMaintenance(); });
+    }
+
+    void PackStore::_runMaintenance()
+    {
+        while(true)
+        {
+            bool compact = false;
+            bool sync = false;
+            {
+                std::lock_guard lock(_mutex);
+                compact = std::exchange(_compact_requested, false);
+                sync = std::exchange(_sync_requested, false);
+                if(!compact && !sync)
+                {
+                    _maintenance_scheduled = false;
+                    return;
+                }
+            }
+
+            std::lock_guard maintenance_lock(_maintenance_mutex);
+            if(compact)
+            {
+                _compact(false);
+            }
+            else
+            {
+                _syncPending();
+            }
+        }
+    }
+
+    void PackStore::_scheduleIndexWrite()
+    {
+        if(_config.index_interval.count() <= 0)
+        {
+            return;
+        }
+
+        _index_timer.expires_after(_config.index_interval);
+        _index_timer.async_wait([this](const std::error_code & ec)
+        {
+            if(ec)
+            {
+                return;
+            }
+            {
+                std::lock_guard lock(_mutex);
+                if(_stopping)
+                {
+                    return;
+                }
+            }
+            sync();
+            _scheduleIndexWrite();
+        });
+    }
+
+    void PackStore::_migrate()
+    {
+        if(_config.migrate_extensions.empty())
+        {
+            return;
+        }
+
+        std::vector<std::filesystem::path> files;
+        std::error_code ec;
+        for(const auto & entry : std::filesystem::directory_iterator(_dir, ec))
+        {
+            if(entry.is_regular_file() &&
+                std::ranges::find(_config.migrate_extensions, entry.path().extension().string()) != _config.migrate_extensions.end())
+            {
+                files.push_back(entry.path());
+            }
+        }
+        if(files.empty())
+        {
+            return;
+        }
+        std::ranges::sort(files);
+
+        std::vector<std::filesystem::path> migrated;
+        migrated.reserve(files.size());
+        for(const std::filesystem::path & path : files)
+        {
+            const std::optional<native::MappedFile> file = native::mapFile(path);
+            if(!file)
+            {
+                spdlog::warn("Failed to read '{}' for migration into its pack", path.string());
+                continue;
+            }
+
+            const std::string key = path.filename().string();
+            Location location;
+            if(!_append(OP_PUT, key, viewOf(*file), location))
+            {
+                break;
+            }
+
+            const auto [it, inserted] = _index.try_emplace(key, location);
+            if(!inserted)
+            {
+                _live_bytes -= _recordSize(key.size(), it->second.value_size);
+                it->second = location;
+            }
+            _live_bytes += _recordSize(key.size(), file->size());
+            migrated.push_back(path);
+        }
+
+        // The loose files only go once their copies are durable, so an interrupted migration simply reruns.
+        _index_dirty = true;
+        if(!_writeIndex())
+        {
+            return;
+        }
+        for(const std::filesystem::path & path : migrated)
+        {
+            std::filesystem::remove(path, ec);
+        }
+
+        _migrated_files += migrated.size();
+        spdlog::info("Migrated {} loose files of '{}' into its pack", migrated.size(), _dir.string());
+    }
+
+    std::filesystem::path PackStore::_segmentPath(std::uint32_t segment) const
+    {
+        return _pack_dir / std::format("{}{:08}{}", SEGMENT_PREFIX, segment, SEGMENT_EXTENSION);
+    }
+
+    std::uint64_t PackStore::_recordSize(std::size_t key_size, std::size_t value_size) const
+    {
+        return RECORD_HEADER_SIZE + key_size + value_size;
+    }
+
+    std::uint64_t PackStore::_totalBytes() const
+    {
+        std::uint64_t total_bytes = 0;
+        for(const auto & [_, size] : _segment_sizes)
+        {
+            total_bytes += size;
+        }
+        return total_bytes;
+    }
+}
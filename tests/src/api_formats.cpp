@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -293,3 +294,98 @@ TEST_F(UnitTest, API_Formats_Head_MirrorsValidationAndReturnsNoBody)
         EXPECT_TRUE(response.getBody().empty());
     }
 }
+
+TEST_F(UnitTest, API_Formats_Search_RanksFormatsBySharedScalarLabels)
+{
+    asio::io_context io_context;
+    registry::Registry registry(io_context);
+
+    const std::string owner_hex = evmc::hex(makeAddressFromByte(0xA5));
+
+    ASSERT_TRUE(addScalarConnector(io_context, registry, "TIME", owner_hex, 0x11));
+    ASSERT_TRUE(addScalarConnector(io_context, registry, "PITCH", owner_hex, 0x12));
+    ASSERT_TRUE(addScalarConnector(io_context, registry, "VOLUME", owner_hex, 0x13));
+
+    ConnectorRecord time_pitch = makeConnectorRecord("SEARCH_TP", owner_hex);
+    addDimension(time_pitch, "TIME");
+    addDimension(time_pitch, "PITCH");
+    ASSERT_TRUE(runAwaitable(io_context, registry.addConnector(makeAddressFromByte(0x31), std::move(time_pitch))));
+
+    ConnectorRecord time_pitch_volume = makeConnectorRecord("SEARCH_TPV", owner_hex);
+    addDimension(time_pitch_volume, "TIME");
+    addDimension(time_pitch_volume, "PITCH");
+    addDimension(time_pitch_volume, "VOLUME");
+    ASSERT_TRUE(runAwaitable(io_context, registry.addConnector(makeAddressFromByte(0x32), std::move(time_pitch_volume))));
+
+    ConnectorRecord time_volume = makeConnectorRecord("SEARCH_TV", owner_hex);
+    addDimension(time_volume, "TIME");
+    addDimension(time_volume, "VOLUME");
+    ASSERT_TRUE(runAwaitable(io_context, registry.addConnector(makeAddressFromByte(0x33), std::move(time_volume))));
+
+    const auto tp_hash = runAwaitable(io_context, registry.getFormatHash("SEARCH_TP"));
+    const auto tpv_hash = runAwaitable(io_context, registry.getFormatHash("SEARCH_TPV"));
+    const auto tv_hash = runAwaitable(io_context, registry.getFormatHash("SEARCH_TV"));
+    ASSERT_TRUE(tp_hash.has_value() && tpv_hash.has_value() && tv_hash.has_value());
+
+    const auto search = [&](const std::string & labels, std::optional<std::size_t> min_shared)
+    {
+        http::Request request;
+        request.setMethod(http::Method::GET)
+               .setPath(http::URL("/formats/search?labels=" + labels + "&limit=10"))
+               .setVersion("HTTP/1.1");
+
+        server::QueryArgsList query_args;
+        query_args.emplace("labels", makeStringRouteArg(labels));
+        query_args.emplace("limit", makeUintRouteArg(10));
+        if(min_shared.has_value())
+        {
+            query_args.emplace("min_shared", makeUintRouteArg(*min_shared));
+        }
+        return runAwaitable(io_context, GET_formatsSearch(request, {}, std::move(query_args), registry));
+    };
+
+    {
+        // Superset query: both formats holding TIME and PITCH, the one without extra labels first.
+        const auto response = search("TIME:0,PITCH:0", std::nullopt);
+        ASSERT_EQ(response.getCode(), http::Code::OK);
+
+        const auto body = nlohmann::json::parse(response.getBody());
+        EXPECT_EQ(body["min_shared"], 2);
+        EXPECT_EQ(body["total_matches"], 2);
+        ASSERT_EQ(body["formats"].size(), 2);
+        EXPECT_EQ(body["formats"][0]["format_hash"], evmc::hex(*tp_hash));
+        EXPECT_EQ(body["formats"][0]["shared_labels"], 2);
+        EXPECT_EQ(body["formats"][0]["format_labels"], 2);
+        EXPECT_EQ(body["formats"][1]["format_hash"], evmc::hex(*tpv_hash));
+        EXPECT_EQ(body["formats"][1]["format_labels"], 3);
+    }
+
+    {
+        // Partial overlap: every format sharing two of the three labels.
+        const auto response = search("PITCH:0,VOLUME:0,TIME:0", 2);
+        ASSERT_EQ(response.getCode(), http::Code::OK);
+
+        const auto body = nlohmann::json::parse(response.getBody());
+        ASSERT_EQ(body["formats"].size(), 3);
+        EXPECT_EQ(body["formats"][0]["format_hash"], evmc::hex(*tpv_hash));
+        EXPECT_EQ(body["formats"][0]["shared_labels"], 3);
+
+        std::vector<std::string> rest{
+            body["formats"][1]["format_hash"].get<std::string>(),
+            body["formats"][2]["format_hash"].get<std::string>()};
+        std::sort(rest.begin(), rest.end());
+        std::vector<std::string> expected{evmc::hex(*tp_hash), evmc::hex(*tv_hash)};
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(rest, expected);
+    }
+
+    {
+        const auto response = search("UNKNOWN:0", std::nullopt);
+        ASSERT_EQ(response.getCode(), http::Code::OK);
+        EXPECT_EQ(nlohmann::json::parse(response.getBody())["total_matches"], 0);
+    }
+
+    EXPECT_EQ(search("TIME", std::nullopt).getCode(), http::Code::BadRequest);
+    EXPECT_EQ(search("TIME:0,,PITCH:0", std::nullopt).getCode(), http::Code::BadRequest);
+    EXPECT_EQ(search("TIME:0", 2).getCode(), http::Code::BadRequest);
+}
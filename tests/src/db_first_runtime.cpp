@@ -2,12 +2,15 @@
 #include "test_connector_helpers.hpp"
 
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 #include <nlohmann/json.hpp>
@@ -149,6 +152,30 @@ namespace
         return exec_rc == SQLITE_OK;
     }
 
+    std::optional<std::string> querySqlText(const std::filesystem::path & db_path, const std::string & sql)
+    {
+        sqlite3 * db = nullptr;
+        if(sqlite3_open_v2(db_path.string().c_str(), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK)
+        {
+            if(db != nullptr)
+            {
+                sqlite3_close(db);
+            }
+            return std::nullopt;
+        }
+
+        std::optional<std::string> result;
+        sqlite3_stmt * stmt = nullptr;
+        if(sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW)
+        {
+            const unsigned char * text = sqlite3_column_text(stmt, 0);
+            result = text == nullptr ? std::string{} : std::string(reinterpret_cast<const char *>(text));
+        }
+        sqlite3_finalize(stmt);
+        sqlite3_close(db);
+        return result;
+    }
+
     server::RouteArg makeStringRouteArg(const std::string & value)
     {
         return server::RouteArg(
@@ -419,6 +446,137 @@ TEST_F(UnitTest, Registry_CheckpointWal_PassiveReturnsTrue)
     EXPECT_TRUE(runAwaitable(io_context, registry.checkpointWal(storage::sqlite::WalCheckpointMode::PASSIVE)).ok);
 }
 
+TEST_F(UnitTest, Registry_SQLite_ConcurrentReadsDoNotSerializeOrGoStaleBehindWrites)
+{
+    const auto storage_path = makeTestPath("registry_concurrent_reads");
+    PathScope storage_scope(storage_path);
+    ASSERT_TRUE(std::filesystem::create_directories(storage_path));
+    const auto db_path = storage_path / "registry.sqlite";
+
+    asio::io_context io_context;
+    registry::Registry registry(io_context, db_path.string());
+
+    const std::string owner_hex = evmc::hex(makeAddressFromByte(0xC3));
+    const auto seeded = makeTransformationRecord("ConcurrentReadTx", owner_hex, "return x;");
+    ASSERT_TRUE(runAwaitable(io_context, registry.addTransformation(makeAddressFromByte(0x56), seeded)));
+
+    constexpr int READERS = 64;
+    std::atomic<int> hits{0};
+    std::atomic<int> misses{0};
+    for(int i = 0; i < READERS; ++i)
+    {
+        asio::co_spawn(io_context, [&]() -> asio::awaitable<void>
+        {
+            const auto handle = co_await registry.getTransformationRecordHandle("ConcurrentReadTx");
+            if(handle.has_value() && *handle)
+            {
+                hits.fetch_add(1);
+            }
+            // Concurrent lookups of a name that is being written must not leave a stale negative entry.
+            if(!(co_await registry.hasTransformation("ConcurrentLateTx")))
+            {
+                misses.fetch_add(1);
+            }
+        }, asio::detached);
+    }
+
+    const auto late = makeTransformationRecord("ConcurrentLateTx", owner_hex, "return x + 1;");
+    std::atomic<bool> late_added{false};
+    asio::co_spawn(io_context, [&]() -> asio::awaitable<void>
+    {
+        late_added = co_await registry.addTransformation(makeAddressFromByte(0x57), late);
+    }, asio::detached);
+
+    io_context.restart();
+    std::vector<std::thread> workers;
+    for(int i = 0; i < 4; ++i)
+    {
+        workers.emplace_back([&io_context]() { io_context.run(); });
+    }
+    for(std::thread & worker : workers)
+    {
+        worker.join();
+    }
+
+    EXPECT_TRUE(late_added.load());
+    EXPECT_EQ(hits.load(), READERS);
+    EXPECT_LE(misses.load(), READERS);
+    EXPECT_TRUE(runAwaitable(io_context, registry.hasTransformation("ConcurrentLateTx")));
+    EXPECT_TRUE(runAwaitable(io_context, registry.getTransformationRecordHandle("ConcurrentLateTx")).value_or(nullptr) != nullptr);
+}
+
+TEST_F(UnitTest, Storage_PackStore_MigratesReplaysTornTailAndCompacts)
+{
+    const auto dir = makeTestPath("pack_store");
+    PathScope dir_scope(dir);
+    ASSERT_TRUE(std::filesystem::create_directories(dir));
+
+    {
+        std::ofstream(dir / "Old.json") << "{\"old\":1}";
+        std::ofstream(dir / "Other.json") << "{\"other\":2}";
+        std::ofstream(dir / "notes.txt") << "kept";
+    }
+
+    {
+        storage::pack::PackStore store(dir, {.migrate_extensions = {".json"}});
+        EXPECT_FALSE(std::filesystem::exists(dir / "Old.json"));
+        EXPECT_TRUE(std::filesystem::exists(dir / "notes.txt"));
+        EXPECT_EQ(store.stats().migrated_files, 2u);
+        EXPECT_EQ(store.get("Old.json"), "{\"old\":1}");
+
+        ASSERT_TRUE(store.put("Old.json", "{\"old\":3}"));
+        ASSERT_TRUE(store.erase("Other.json"));
+        ASSERT_TRUE(store.put("New.json", "{}"));
+        ASSERT_TRUE(store.put("New.bin", "6080"));
+
+        const auto scan = store.scan(".json");
+        ASSERT_EQ(scan.entries().size(), 2u);
+        EXPECT_EQ(scan.entries()[0].key, "New.json");
+        EXPECT_EQ(scan.entries()[1].value, "{\"old\":3}");
+    }
+
+    // A record cut short by a crash is dropped on reopen, everything before it survives.
+    {
+        std::ofstream segment(dir / "pack" / "seg-00000001.pack", std::ios::binary | std::ios::app);
+        segment << "DCNP\x01torn";
+    }
+    {
+        storage::pack::PackStore store(dir);
+        EXPECT_EQ(store.get("Old.json"), "{\"old\":3}");
+        EXPECT_FALSE(store.contains("Other.json"));
+        ASSERT_TRUE(store.put("Late.json", "{}"));
+    }
+
+    // Without the index every segment is replayed; overwrites then trigger compaction.
+    ASSERT_TRUE(std::filesystem::remove(dir / "pack" / "index"));
+    {
+        storage::pack::PackStore store(dir, {.segment_bytes = 256, .compact_min_garbage_bytes = 0});
+        EXPECT_EQ(store.stats().entries, 4u);
+        for(int i = 0; i < 64; ++i)
+        {
+            ASSERT_TRUE(store.put("Hot.json", std::string(32, static_cast<char>('a' + i % 26))));
+        }
+
+        // Compaction runs on the store's maintenance thread, after the puts returned.
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        auto stats = store.stats();
+        while((stats.compactions == 0 || stats.total_bytes >= 2 * stats.live_bytes + 256) && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            stats = store.stats();
+        }
+        EXPECT_GT(stats.compactions, 0u);
+        EXPECT_LT(stats.total_bytes, 2 * stats.live_bytes + 256);
+        EXPECT_EQ(store.get("Hot.json"), std::string(32, static_cast<char>('a' + 63 % 26)));
+    }
+
+    storage::pack::PackStore reopened(dir);
+    EXPECT_EQ(reopened.get("Hot.json"), std::string(32, static_cast<char>('a' + 63 % 26)));
+    EXPECT_EQ(reopened.get("Late.json"), "{}");
+    EXPECT_EQ(reopened.get("New.bin"), "6080");
+    EXPECT_EQ(reopened.scan(".json").entries().size(), 4u);
+}
+
 TEST_F(UnitTest, API_ReadEndpoints_ReturnFromDbWithoutEvmDeployment)
 {
     asio::io_context io_context;
@@ -522,6 +680,7 @@ TEST_F(UnitTest, API_Execute_MissingConnectorReturnsNotFound)
 
     config::Config cfg;
     cfg.storage_path = storage_path;
+    loader::LazyDeployer deployer(io_context, evm_instance, registry, {.storage_path = storage_path});
 
     auto request = makeExecuteRequest(access_token, "MissingConnector");
     const auto response = runAwaitable(
@@ -533,6 +692,7 @@ TEST_F(UnitTest, API_Execute_MissingConnectorReturnsNotFound)
             auth_manager,
             registry,
             evm_instance,
+            deployer,
             cfg));
 
     ASSERT_EQ(response.getCode(), http::Code::NotFound);
@@ -1030,6 +1190,12 @@ TEST_F(UnitTest, API_Execute_LazilyDeploysConnectorClosureFromDb)
 
     config::Config cfg;
     cfg.storage_path = storage_path;
+    loader::LazyDeployer deployer(io_context, evm_instance, registry, {.storage_path = storage_path});
+
+    // A held deployer leaves the connector to the running import.
+    runAwaitable(io_context, deployer.hold());
+    EXPECT_EQ(runAwaitable(io_context, deployer.ensureConnector("LazyConnector")), loader::ConnectorReadiness::DEPLOYING);
+    runAwaitable(io_context, deployer.resume());
 
     auto request = makeExecuteRequest(access_token, "LazyConnector");
     const auto response = runAwaitable(
@@ -1041,6 +1207,7 @@ TEST_F(UnitTest, API_Execute_LazilyDeploysConnectorClosureFromDb)
             auth_manager,
             registry,
             evm_instance,
+            deployer,
             cfg));
 
     ASSERT_EQ(response.getCode(), http::Code::OK);
@@ -1057,6 +1224,197 @@ TEST_F(UnitTest, API_Execute_LazilyDeploysConnectorClosureFromDb)
     EXPECT_TRUE(*contains_connector_after);
 }
 
+TEST_F(UnitTest, API_Execute_ConcurrentFirstUseWaitsForTheRunningDeployment)
+{
+    ASSERT_TRUE(std::filesystem::exists(solcPath())) << std::format("Missing Solidity compiler at '{}'", solcPath().string());
+    ASSERT_TRUE(std::filesystem::exists(ptPath() / "contracts")) << std::format("Missing PT contracts at '{}'", (ptPath() / "contracts").string());
+
+    const auto storage_path = makeTestPath("execute_concurrent_first_use");
+    PathScope storage_scope(storage_path);
+    ASSERT_TRUE(prepareStorageLayout(storage_path));
+    const auto db_path = storage_path / "registry.sqlite";
+
+    asio::io_context io_context;
+    registry::Registry registry(io_context, db_path.string());
+    auth::AuthManager auth_manager(io_context);
+    evm::EVM evm_instance(io_context, EVMC_SHANGHAI, solcPath(), ptPath());
+    io_context.run();
+
+    const chain::Address caller = makeAddressFromByte(0x56);
+    const std::string owner_hex = evmc::hex(caller);
+    (void)runAwaitable(io_context, evm_instance.addAccount(caller, evm::DEFAULT_GAS_LIMIT));
+    (void)runAwaitable(io_context, evm_instance.setGas(caller, evm::DEFAULT_GAS_LIMIT));
+    const std::string access_token = runAwaitable(io_context, auth_manager.generateAccessToken(caller));
+
+    ConnectorRecord connector_record = makeConnectorRecord("WarmConnector", owner_hex);
+    addConnectorDimension(connector_record, "", "WarmTx");
+    ASSERT_TRUE(runAwaitable(io_context, registry.addTransformation(makeAddressFromByte(0x33), makeTransformationRecord("WarmTx", owner_hex))));
+    ASSERT_TRUE(runAwaitable(io_context, registry.addConnector(makeAddressFromByte(0x34), connector_record)));
+
+    config::Config cfg;
+    cfg.storage_path = storage_path;
+    const auto access_stats_path = storage_path / "connector_access.json";
+    loader::LazyDeployer deployer(io_context, evm_instance, registry, {.storage_path = storage_path, .access_stats_path = access_stats_path});
+
+    const auto request = makeExecuteRequest(access_token, "WarmConnector");
+    const auto execute = [&]()
+    {
+        return asio::co_spawn(
+            io_context,
+            POST_execute(request, {}, {}, auth_manager, registry, evm_instance, deployer, cfg),
+            asio::use_future);
+    };
+
+    // The second request overlaps the compile started by the first one.
+    auto first = execute();
+    auto second = execute();
+    io_context.restart();
+    io_context.run();
+
+    // The second request waits for it instead of being turned away.
+    EXPECT_EQ(first.get().getCode(), http::Code::OK);
+    EXPECT_EQ(second.get().getCode(), http::Code::OK);
+
+    const auto retried = runAwaitable(io_context, POST_execute(request, {}, {}, auth_manager, registry, evm_instance, deployer, cfg));
+    EXPECT_EQ(retried.getCode(), http::Code::OK);
+
+    ASSERT_TRUE(deployer.saveAccessStats());
+    std::ifstream stats_file(access_stats_path);
+    const auto stats = json::parse(stats_file, nullptr, false);
+    ASSERT_FALSE(stats.is_discarded());
+    EXPECT_EQ(stats["connectors"]["WarmConnector"], 3);
+}
+
+TEST_F(UnitTest, EVMStorage_Overlay_ReadsThroughSharedStateAndKeepsWritesLocal)
+{
+    evmc::VM vm(evmc_create_evmone());
+    evm::EVMStorage storage(vm, EVMC_SHANGHAI);
+
+    const chain::Address contract = makeAddressFromByte(0x61);
+    const chain::Address untouched = makeAddressFromByte(0x62);
+    evmc::bytes32 slot{};
+    slot.bytes[31] = 1;
+    evmc::bytes32 value{};
+    value.bytes[31] = 7;
+
+    ASSERT_TRUE(storage.add_account(contract));
+    ASSERT_TRUE(storage.add_account(untouched));
+    storage.set_storage(contract, slot, value);
+
+    const auto base = storage.shared_state();
+    EXPECT_EQ(storage.shared_state(), base);
+
+    // A released block goes back to the head only while nothing followed it.
+    const auto released = storage.reserve_block();
+    EXPECT_TRUE(storage.release_block(released));
+    EXPECT_EQ(storage.head_block_number(), released.number - 1);
+
+    const auto block = storage.reserve_block();
+    EXPECT_EQ(block.number, released.number);
+    EXPECT_EQ(block.tx_id, released.tx_id);
+    const auto later = storage.reserve_block();
+    EXPECT_FALSE(storage.release_block(block));
+    EXPECT_EQ(storage.head_block_number(), later.number);
+
+    evm::EVMStorage overlay(vm, EVMC_SHANGHAI);
+    overlay.begin_overlay(base, block);
+    EXPECT_TRUE(overlay.account_exists(contract));
+    EXPECT_EQ(overlay.get_storage(contract, slot), value);
+    EXPECT_EQ(overlay.state_version(), 0u);
+
+    evmc::bytes32 other_slot{};
+    other_slot.bytes[31] = 2;
+    overlay.set_storage(contract, other_slot, value);
+    EXPECT_TRUE(overlay.selfdestruct(untouched, contract));
+    EXPECT_NE(overlay.state_version(), 0u);
+
+    // Slots not written on the overlay still come from the base.
+    EXPECT_EQ(overlay.get_storage(contract, slot), value);
+    EXPECT_EQ(overlay.get_storage(contract, other_slot), value);
+    EXPECT_FALSE(overlay.account_exists(untouched));
+
+    EXPECT_EQ(storage.get_storage(contract, other_slot), evmc::bytes32{});
+    EXPECT_TRUE(storage.account_exists(untouched));
+    EXPECT_EQ(base->accounts.size(), 2u);
+
+    overlay.end_overlay();
+    EXPECT_FALSE(overlay.account_exists(contract));
+
+    // A write publishes a new state sharing the accounts it left alone.
+    storage.set_storage(contract, other_slot, value);
+    const auto next = storage.shared_state();
+    ASSERT_NE(next, base);
+    EXPECT_EQ(next->accounts.at(untouched), base->accounts.at(untouched));
+    EXPECT_NE(next->accounts.at(contract), base->accounts.at(contract));
+    EXPECT_EQ(next->accounts.at(contract)->storage.size(), 2u);
+    EXPECT_EQ(base->accounts.at(contract)->storage.size(), 1u);
+}
+
+TEST_F(UnitTest, API_Execute_PooledExecutionsRunConcurrentlyWithStrandResults)
+{
+    ASSERT_TRUE(std::filesystem::exists(solcPath())) << std::format("Missing Solidity compiler at '{}'", solcPath().string());
+    ASSERT_TRUE(std::filesystem::exists(ptPath() / "contracts")) << std::format("Missing PT contracts at '{}'", (ptPath() / "contracts").string());
+
+    const auto storage_path = makeTestPath("execute_pooled");
+    PathScope storage_scope(storage_path);
+    ASSERT_TRUE(prepareStorageLayout(storage_path));
+    const auto db_path = storage_path / "registry.sqlite";
+
+    asio::io_context io_context;
+    registry::Registry registry(io_context, db_path.string());
+    auth::AuthManager auth_manager(io_context);
+    evm::EVM evm_instance(io_context, EVMC_SHANGHAI, solcPath(), ptPath(), {}, {}, {}, {.executors = 4});
+    io_context.run();
+
+    const chain::Address caller = makeAddressFromByte(0x57);
+    const std::string owner_hex = evmc::hex(caller);
+    (void)runAwaitable(io_context, evm_instance.addAccount(caller, evm::DEFAULT_GAS_LIMIT));
+    (void)runAwaitable(io_context, evm_instance.setGas(caller, evm::DEFAULT_GAS_LIMIT));
+    const std::string access_token = runAwaitable(io_context, auth_manager.generateAccessToken(caller));
+
+    ConnectorRecord connector_record = makeConnectorRecord("PooledConnector", owner_hex);
+    addConnectorDimension(connector_record, "", "PooledTx");
+    ASSERT_TRUE(runAwaitable(io_context, registry.addTransformation(makeAddressFromByte(0x35), makeTransformationRecord("PooledTx", owner_hex))));
+    ASSERT_TRUE(runAwaitable(io_context, registry.addConnector(makeAddressFromByte(0x36), connector_record)));
+
+    config::Config cfg;
+    cfg.storage_path = storage_path;
+    loader::LazyDeployer deployer(io_context, evm_instance, registry, {.storage_path = storage_path});
+
+    const auto request = makeExecuteRequest(access_token, "PooledConnector");
+    const auto first = runAwaitable(io_context, POST_execute(request, {}, {}, auth_manager, registry, evm_instance, deployer, cfg));
+    ASSERT_EQ(first.getCode(), http::Code::OK);
+
+    const std::int64_t head_before = runAwaitable(io_context, evm_instance.getHeadBlockNumber());
+    const auto completed_before = evm_instance.getExecutionStats().completed;
+
+    constexpr std::size_t REQUESTS = 8;
+    std::vector<std::future<http::Response>> responses;
+    for(std::size_t i = 0; i < REQUESTS; ++i)
+    {
+        responses.push_back(asio::co_spawn(
+            io_context,
+            POST_execute(request, {}, {}, auth_manager, registry, evm_instance, deployer, cfg),
+            asio::use_future));
+    }
+    io_context.restart();
+    io_context.run();
+
+    for(auto & response : responses)
+    {
+        const auto served = response.get();
+        ASSERT_EQ(served.getCode(), http::Code::OK);
+        EXPECT_EQ(served.getBody(), first.getBody());
+    }
+
+    // Read-only runs stay off the strand's storage but still take their block from the head.
+    const auto stats = evm_instance.getExecutionStats();
+    EXPECT_EQ(stats.completed, completed_before + REQUESTS);
+    // Calls overlap only when they actually leave the io thread for the pool.
+    EXPECT_GT(stats.peak_running, 1u);
+    EXPECT_EQ(runAwaitable(io_context, evm_instance.getHeadBlockNumber()), head_before + static_cast<std::int64_t>(REQUESTS));
+}
+
 TEST_F(UnitTest, API_Execute_BrokenDbDependencyReturnsInvariantError)
 {
     ASSERT_TRUE(std::filesystem::exists(solcPath())) << std::format("Missing Solidity compiler at '{}'", solcPath().string());
@@ -1091,6 +1449,7 @@ TEST_F(UnitTest, API_Execute_BrokenDbDependencyReturnsInvariantError)
 
     config::Config cfg;
     cfg.storage_path = storage_path;
+    loader::LazyDeployer deployer(io_context, evm_instance, registry, {.storage_path = storage_path});
 
     auto request = makeExecuteRequest(access_token, "BrokenConnector");
     const auto response = runAwaitable(
@@ -1102,6 +1461,7 @@ TEST_F(UnitTest, API_Execute_BrokenDbDependencyReturnsInvariantError)
             auth_manager,
             registry,
             evm_instance,
+            deployer,
             cfg));
 
     ASSERT_EQ(response.getCode(), http::Code::InternalServerError);
@@ -1171,7 +1531,146 @@ TEST_F(UnitTest, SQLiteRegistryStore_QueryHelpers_PrepareFailureReturnsSafeDefau
     EXPECT_FALSE(owned_conditions_page.next_after.has_value());
 }
 
-TEST_F(UnitTest, Loader_StartupImport_DbHitJsonIsNoopAndKeepsFile)
+TEST_F(UnitTest, SQLiteRegistryStore_Aggregates_TrackAccountsAndFormatsAndBackfillOnOpen)
+{
+    const auto storage_path = makeTestPath("sqlite_registry_aggregates");
+    PathScope storage_scope(storage_path);
+    ASSERT_TRUE(prepareStorageLayout(storage_path));
+    const auto db_path = storage_path / "registry.sqlite";
+
+    const chain::Address owner_a = makeAddressFromByte(0x71);
+    const chain::Address owner_b = makeAddressFromByte(0x72);
+    const chain::Address owner_c = makeAddressFromByte(0x73);
+    evmc::bytes32 format_x{};
+    format_x.bytes[31] = 0x01;
+    evmc::bytes32 format_y{};
+    format_y.bytes[31] = 0x02;
+    const std::vector<registry::ScalarLabel> empty_labels;
+
+    const auto expect_aggregates = [&](const registry::SQLiteRegistryStore & store)
+    {
+        EXPECT_EQ(store.getAccountsCount(), 3u);
+        EXPECT_EQ(store.getFormatsCount(), 2u);
+
+        const auto first_accounts = store.getAccountsCursor(std::nullopt, 2);
+        ASSERT_EQ(first_accounts.entries.size(), 2u);
+        EXPECT_EQ(first_accounts.entries[0], evmc::hex(owner_a));
+        EXPECT_EQ(first_accounts.entries[1], evmc::hex(owner_b));
+        EXPECT_TRUE(first_accounts.has_more);
+
+        const auto last_accounts = store.getAccountsCursor(owner_b, 2);
+        ASSERT_EQ(last_accounts.entries.size(), 1u);
+        EXPECT_EQ(last_accounts.entries[0], evmc::hex(owner_c));
+        EXPECT_FALSE(last_accounts.has_more);
+
+        const auto formats = store.getFormatsCursor(std::nullopt, 8);
+        ASSERT_EQ(formats.entries.size(), 2u);
+        EXPECT_EQ(formats.entries[0], evmc::hex(format_x));
+        EXPECT_EQ(formats.entries[1], evmc::hex(format_y));
+    };
+
+    {
+        registry::SQLiteRegistryStore store(db_path.string());
+        EXPECT_EQ(store.getAccountsCount(), 0u);
+        EXPECT_EQ(store.getFormatsCount(), 0u);
+
+        ASSERT_TRUE(store.addTransformation(makeAddressFromByte(0x74), makeTransformationRecord("AggTxA", evmc::hex(owner_a))));
+        ASSERT_TRUE(store.addCondition(makeAddressFromByte(0x75), makeConditionRecord("AggCondA", evmc::hex(owner_a))));
+        ASSERT_TRUE(store.addTransformationsBatch({
+            registry::TransformationBatchItem{
+                .address = makeAddressFromByte(0x76),
+                .record = makeTransformationRecord("AggTxB", evmc::hex(owner_b))}}));
+        ASSERT_TRUE(store.addConnector(makeAddressFromByte(0x77), makeConnectorRecord("AggConnC1", evmc::hex(owner_c)), format_x, empty_labels));
+        ASSERT_TRUE(store.addConnector(makeAddressFromByte(0x78), makeConnectorRecord("AggConnC2", evmc::hex(owner_c)), format_x, empty_labels));
+        ASSERT_TRUE(store.addConnector(makeAddressFromByte(0x79), makeConnectorRecord("AggConnA", evmc::hex(owner_a)), format_y, empty_labels));
+
+        // A rejected duplicate must not move the counters.
+        const std::string marker = store.getWriteMarker();
+        EXPECT_FALSE(store.addTransformation(makeAddressFromByte(0x7A), makeTransformationRecord("AggTxA", evmc::hex(owner_b))));
+        EXPECT_EQ(store.getWriteMarker(), marker);
+        EXPECT_TRUE(marker.ends_with(":6"));
+
+        expect_aggregates(store);
+
+        // Another store with the same number of records does not share the marker.
+        registry::SQLiteRegistryStore other(":memory:");
+        for(const std::string name : {"OtherTx1", "OtherTx2", "OtherTx3", "OtherTx4", "OtherTx5", "OtherTx6"})
+        {
+            ASSERT_TRUE(other.addTransformation(makeAddressFromByte(0x7B), makeTransformationRecord(name, evmc::hex(owner_a))));
+        }
+        EXPECT_TRUE(other.getWriteMarker().ends_with(":6"));
+        EXPECT_NE(other.getWriteMarker(), marker);
+    }
+
+    // Databases written before the aggregate tables existed are backfilled on open.
+    ASSERT_TRUE(executeSqlScript(
+        db_path,
+        "DROP TABLE accounts;"
+        "DROP TABLE formats;"
+        "DROP TABLE registry_counters;"));
+
+    registry::SQLiteRegistryStore reopened(db_path.string());
+    expect_aggregates(reopened);
+}
+
+TEST_F(UnitTest, SQLiteRegistryStore_SchemaV2_MigratesRowidKeyTablesToWithoutRowid)
+{
+    const auto storage_path = makeTestPath("sqlite_registry_schema_v2");
+    PathScope storage_scope(storage_path);
+    ASSERT_TRUE(prepareStorageLayout(storage_path));
+    const auto db_path = storage_path / "registry.sqlite";
+
+    const chain::Address owner = makeAddressFromByte(0x7B);
+    const std::string owner_hex = evmc::hex(owner);
+    evmc::bytes32 format_hash{};
+    format_hash.bytes[31] = 0x7C;
+    const std::vector<registry::ScalarLabel> empty_labels;
+
+    {
+        registry::SQLiteRegistryStore store(db_path.string());
+        ASSERT_TRUE(store.addTransformation(makeAddressFromByte(0x7D), makeTransformationRecord("MigrateTx", owner_hex)));
+        ASSERT_TRUE(store.addConnector(makeAddressFromByte(0x7E), makeConnectorRecord("MigrateConnector", owner_hex), format_hash, empty_labels));
+    }
+    EXPECT_EQ(querySqlText(db_path, "PRAGMA user_version;"), std::optional<std::string>("2"));
+
+    // Rewrite the key tables in their version 1 shape: rowid tables plus a duplicate key index.
+    ASSERT_TRUE(executeSqlScript(
+        db_path,
+        "CREATE TABLE owned_transformations_v1 (owner BLOB NOT NULL, name TEXT NOT NULL, PRIMARY KEY(owner, name));"
+        "INSERT INTO owned_transformations_v1 SELECT owner, name FROM owned_transformations;"
+        "DROP TABLE owned_transformations;"
+        "ALTER TABLE owned_transformations_v1 RENAME TO owned_transformations;"
+        "CREATE INDEX idx_owned_transformations_owner_name ON owned_transformations(owner, name);"
+        "CREATE TABLE format_members_v1 (format_hash BLOB NOT NULL, name TEXT NOT NULL, PRIMARY KEY(format_hash, name));"
+        "INSERT INTO format_members_v1 SELECT format_hash, name FROM format_members;"
+        "DROP TABLE format_members;"
+        "ALTER TABLE format_members_v1 RENAME TO format_members;"
+        "CREATE INDEX idx_format_members_format_name ON format_members(format_hash, name);"
+        "PRAGMA user_version = 1;"));
+
+    registry::SQLiteRegistryStore store(db_path.string());
+
+    EXPECT_EQ(querySqlText(db_path, "PRAGMA user_version;"), std::optional<std::string>("2"));
+    for(const std::string table_name : {"owned_transformations", "format_members", "owned_connectors", "scalar_labels_by_format"})
+    {
+        const auto table_sql = querySqlText(
+            db_path,
+            "SELECT sql FROM sqlite_master WHERE type = 'table' AND name = '" + table_name + "';");
+        ASSERT_TRUE(table_sql.has_value()) << table_name;
+        EXPECT_NE(table_sql->find("WITHOUT ROWID"), std::string::npos) << table_name;
+    }
+    EXPECT_FALSE(querySqlText(
+        db_path,
+        "SELECT name FROM sqlite_master WHERE type = 'index' AND name LIKE 'idx_%';").has_value());
+
+    const auto owned_page = store.getOwnedTransformationsCursor(owner, std::nullopt, 8);
+    ASSERT_EQ(owned_page.entries.size(), 1u);
+    EXPECT_EQ(owned_page.entries[0], "MigrateTx");
+    EXPECT_EQ(store.getFormatConnectorNamesCount(format_hash), 1u);
+    EXPECT_EQ(store.getAccountsCount(), 1u);
+}
+
+TEST_F(UnitTest, Loader_StartupImport_DbHitJsonIsNoopAndKeepsRecord)
 {
     ASSERT_TRUE(std::filesystem::exists(solcPath())) << std::format("Missing Solidity compiler at '{}'", solcPath().string());
     ASSERT_TRUE(std::filesystem::exists(ptPath() / "contracts")) << std::format("Missing PT contracts at '{}'", (ptPath() / "contracts").string());
@@ -1206,7 +1705,9 @@ TEST_F(UnitTest, Loader_StartupImport_DbHitJsonIsNoopAndKeepsFile)
         loader::importJsonStorageToDatabase(evm_instance, registry, storage_path));
     EXPECT_TRUE(import_result);
 
-    const auto file_after = readTextFile(json_file_path);
+    // The loose file moves into the pack as it was.
+    EXPECT_FALSE(std::filesystem::exists(json_file_path));
+    const auto file_after = storage::pack::PackStore::forDirectory(storage_path / "transformations").get("ImportedTx.json");
     ASSERT_TRUE(file_after.has_value());
     EXPECT_EQ(*file_after, *file_before);
 
@@ -1324,6 +1825,66 @@ TEST_F(UnitTest, Loader_StartupImport_UnresolvedDependencySkipsAndDoesNotInsertO
     EXPECT_FALSE(*contains_connector);
 }
 
+TEST_F(UnitTest, Loader_StartupImport_WavesSkipDependentsOfFailedNodeOnly)
+{
+    ASSERT_TRUE(std::filesystem::exists(solcPath())) << std::format("Missing Solidity compiler at '{}'", solcPath().string());
+    ASSERT_TRUE(std::filesystem::exists(ptPath() / "contracts")) << std::format("Missing PT contracts at '{}'", (ptPath() / "contracts").string());
+
+    const auto storage_path = makeTestPath("startup_import_waves");
+    PathScope storage_scope(storage_path);
+    ASSERT_TRUE(prepareStorageLayout(storage_path));
+    const auto db_path = storage_path / "registry.sqlite";
+
+    asio::io_context io_context;
+    registry::Registry registry(io_context, db_path.string());
+    evm::EVM evm_instance(io_context, EVMC_SHANGHAI, solcPath(), ptPath());
+    io_context.run();
+
+    const std::string owner_hex = evmc::hex(makeAddressFromByte(0x95));
+    ASSERT_TRUE(writeJsonRecord(storage_path / "transformations" / "WaveTx.json", makeTransformationRecord("WaveTx", owner_hex)));
+
+    // Two independent branches of depth two; only the second one has an undeployable root.
+    ConnectorRecord good_leaf = makeConnectorRecord("WaveGoodLeaf", owner_hex);
+    addConnectorDimension(good_leaf, "", "WaveTx");
+    ConnectorRecord good_root = makeConnectorRecord("WaveGoodRoot", owner_hex);
+    addConnectorDimension(good_root, "WaveGoodLeaf", "WaveTx");
+
+    ConnectorRecord broken_leaf = makeConnectorRecord("WaveBrokenLeaf", owner_hex);
+    addConnectorDimension(broken_leaf, "", "MissingWaveTx");
+    ConnectorRecord broken_root = makeConnectorRecord("WaveBrokenRoot", owner_hex);
+    addConnectorDimension(broken_root, "WaveBrokenLeaf", "WaveTx");
+
+    for(const auto & record : {good_leaf, good_root, broken_leaf, broken_root})
+    {
+        ASSERT_TRUE(writeJsonRecord(storage_path / "connectors" / (record.connector().name() + ".json"), record));
+    }
+
+    const bool import_result = runAwaitable(
+        io_context,
+        loader::importJsonStorageToDatabase(evm_instance, registry, storage_path));
+    EXPECT_FALSE(import_result);
+
+    for(const std::string name : {"WaveGoodLeaf", "WaveGoodRoot"})
+    {
+        const auto handle = runAwaitable(io_context, registry.getConnectorRecordHandle(name));
+        EXPECT_TRUE(handle.has_value()) << name;
+
+        const auto contains = containsConnector(io_context, evm_instance, name);
+        ASSERT_TRUE(contains.has_value());
+        EXPECT_TRUE(*contains) << name;
+    }
+
+    for(const std::string name : {"WaveBrokenLeaf", "WaveBrokenRoot"})
+    {
+        const auto handle = runAwaitable(io_context, registry.getConnectorRecordHandle(name));
+        EXPECT_FALSE(handle.has_value()) << name;
+
+        const auto contains = containsConnector(io_context, evm_instance, name);
+        ASSERT_TRUE(contains.has_value());
+        EXPECT_FALSE(*contains) << name;
+    }
+}
+
 TEST_F(UnitTest, Loader_StartupImport_DbCycleDependencyReturnsErrorWithoutCrash)
 {
     ASSERT_TRUE(std::filesystem::exists(solcPath())) << std::format("Missing Solidity compiler at '{}'", solcPath().string());
@@ -1371,3 +1932,114 @@ TEST_F(UnitTest, Loader_StartupImport_DbCycleDependencyReturnsErrorWithoutCrash)
     ASSERT_TRUE(contains_imported.has_value());
     EXPECT_FALSE(*contains_imported);
 }
+
+TEST_F(UnitTest, SQLiteRegistryStore_RecordHandles_DecodeIntoArenaOwnedByHandle)
+{
+    const auto storage_path = makeTestPath("sqlite_registry_arena_records");
+    PathScope storage_scope(storage_path);
+    ASSERT_TRUE(prepareStorageLayout(storage_path));
+    const auto db_path = storage_path / "registry.sqlite";
+
+    const std::string owner_hex = evmc::hex(makeAddressFromByte(0x81));
+    ConnectorRecord deep = makeConnectorRecord("ArenaDeep", owner_hex);
+    for(int i = 0; i < 32; ++i)
+    {
+        Dimension * dimension = deep.mutable_connector()->add_dimensions();
+        dimension->set_composite("ArenaChild" + std::to_string(i));
+        (*dimension->mutable_bindings())[std::to_string(i)] = "ArenaBinding" + std::to_string(i);
+        dimension->add_transformations()->set_name("ArenaTx" + std::to_string(i));
+    }
+
+    std::optional<registry::ConnectorRecordHandle> single;
+    std::vector<std::optional<registry::ConnectorRecordHandle>> batch;
+    {
+        registry::SQLiteRegistryStore store(db_path.string());
+        evmc::bytes32 format_hash{};
+        format_hash.bytes[31] = 0x09;
+        ASSERT_TRUE(store.addConnector(makeAddressFromByte(0x82), deep, format_hash, {}));
+
+        single = store.getConnectorRecordHandle("ArenaDeep");
+        const std::vector<std::string> names{"ArenaDeep", "ArenaMissing"};
+        batch = store.getConnectorRecordHandles(names);
+    }
+
+    // Handles keep their arena alive after the store that decoded them is gone.
+    ASSERT_TRUE(single.has_value() && *single);
+    EXPECT_NE((*single)->GetArena(), nullptr);
+    EXPECT_EQ((*single)->SerializeAsString(), deep.SerializeAsString());
+    EXPECT_EQ((*single)->connector().dimensions(31).bindings().at("31"), "ArenaBinding31");
+
+    ASSERT_EQ(batch.size(), 2u);
+    ASSERT_TRUE(batch[0].has_value() && *batch[0]);
+    EXPECT_NE((*batch[0])->GetArena(), nullptr);
+    EXPECT_NE((*batch[0])->GetArena(), (*single)->GetArena());
+    EXPECT_EQ((*batch[0])->connector().dimensions_size(), 32);
+    EXPECT_FALSE(batch[1].has_value() && *batch[1]);
+}
+
+TEST_F(UnitTest, SQLiteRegistryStore_Snapshot_RoundTripsAndRejectsCorruptFiles)
+{
+    const auto storage_path = makeTestPath("sqlite_registry_snapshot");
+    PathScope storage_scope(storage_path);
+    ASSERT_TRUE(prepareStorageLayout(storage_path));
+    const auto snapshot_path = storage_path / "registry.snapshot";
+
+    const chain::Address owner_a = makeAddressFromByte(0x91);
+    const chain::Address owner_b = makeAddressFromByte(0x92);
+    evmc::bytes32 format_x{};
+    format_x.bytes[31] = 0x11;
+    evmc::bytes32 path_hash{};
+    path_hash.bytes[0] = 0x22;
+    const std::vector<registry::ScalarLabel> labels{
+        registry::ScalarLabel{.scalar = "TIME", .path_hash = path_hash, .tail_id = 0},
+        registry::ScalarLabel{.scalar = "PITCH", .path_hash = path_hash, .tail_id = 1}};
+
+    {
+        registry::SQLiteRegistryStore source((storage_path / "source.sqlite").string());
+        for(int i = 0; i < 50; ++i)
+        {
+            ASSERT_TRUE(source.addTransformation(
+                makeAddressFromByte(static_cast<std::uint8_t>(i)),
+                makeTransformationRecord("SnapTx" + std::to_string(i), evmc::hex(i % 2 == 0 ? owner_a : owner_b))));
+        }
+        ASSERT_TRUE(source.addCondition(makeAddressFromByte(0x93), makeConditionRecord("SnapCond", evmc::hex(owner_b))));
+        ASSERT_TRUE(source.addConnector(makeAddressFromByte(0x94), makeConnectorRecord("SnapConn", evmc::hex(owner_a)), format_x, labels));
+        ASSERT_TRUE(source.exportSnapshot(snapshot_path));
+    }
+
+    {
+        registry::SQLiteRegistryStore restored((storage_path / "restored.sqlite").string());
+        ASSERT_TRUE(restored.importSnapshot(snapshot_path));
+
+        EXPECT_EQ(restored.getTransformationsCount(), 50u);
+        EXPECT_EQ(restored.getConditionsCount(), 1u);
+        EXPECT_EQ(restored.getConnectorsCount(), 1u);
+        EXPECT_EQ(restored.getAccountsCount(), 2u);
+        EXPECT_EQ(restored.getFormatsCount(), 1u);
+        EXPECT_EQ(restored.getFormatConnectorNamesCount(format_x), 1u);
+        EXPECT_EQ(restored.getOwnedTransformationsCursor(owner_a, std::nullopt, 100).entries.size(), 25u);
+
+        const auto connector = restored.getConnectorRecordHandle("SnapConn");
+        ASSERT_TRUE(connector.has_value() && *connector);
+        EXPECT_EQ((*connector)->owner(), evmc::hex(owner_a));
+        EXPECT_EQ(restored.getConnectorFormatHash("SnapConn"), format_x);
+
+        const auto restored_labels = restored.getScalarLabelsByFormatHash(format_x);
+        ASSERT_TRUE(restored_labels.has_value());
+        EXPECT_EQ(restored_labels->size(), 2u);
+
+        // A second import would duplicate rows, so a populated store refuses it.
+        EXPECT_FALSE(restored.importSnapshot(snapshot_path));
+    }
+
+    {
+        std::fstream file(snapshot_path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(64);
+        file.put('\x5A');
+    }
+
+    registry::SQLiteRegistryStore corrupted_target((storage_path / "corrupted.sqlite").string());
+    EXPECT_FALSE(corrupted_target.importSnapshot(snapshot_path));
+    EXPECT_EQ(corrupted_target.getTransformationsCount(), 0u);
+    EXPECT_EQ(corrupted_target.getAccountsCount(), 0u);
+}
@@ -113,6 +113,124 @@ TEST_F(UnitTest, Events_Archive_PrunesOnlyAfterExportedRowsExist)
     events_sql::expectRowCount(paths.hot_db, "feed_items_hot", 0);
 }
 
+TEST_F(UnitTest, Events_Archive_PruneBatches_AreBoundedPerTransaction)
+{
+    const auto paths = makeTempEventsPaths("archive_prune_batches");
+    asio::io_context store_io_context;
+    events::SQLiteHotStore store(paths.hot_db, paths.archive_root, 60 * 60 * 1000, CHAIN_ID);
+
+    const events::DecodedEvent first = makeDecodedEvent(104, 0, 1, 0xF4, 0x34, events::EventType::CONNECTOR_ADDED, events::EventState::OBSERVED, 1'600'000'004);
+    const events::DecodedEvent second = makeDecodedEvent(105, 0, 1, 0xF5, 0x35, events::EventType::CONDITION_ADDED, events::EventState::OBSERVED, 1'600'000'005);
+    finalizeAndProject(store_io_context, store, first, 1'700'001'004'200);
+    finalizeAndProject(store_io_context, store, second, 1'700'001'005'200);
+
+    ASSERT_TRUE(store.exportArchiveMonths(CHAIN_ID, 1'700'001'140'000));
+    events_sql::expectRowCount(paths.hot_db, "normalized_events_hot", 2);
+
+    EXPECT_EQ(store.pruneArchivedBatch(CHAIN_ID, 0, 1'900'000'000'000, 1), std::optional<std::size_t>(1));
+    events_sql::expectRowCount(paths.hot_db, "normalized_events_hot", 1);
+    events_sql::expectRowCount(paths.hot_db, "feed_items_hot", 1);
+
+    EXPECT_EQ(store.pruneArchivedBatch(CHAIN_ID, 0, 1'900'000'000'000, 1), std::optional<std::size_t>(1));
+    EXPECT_EQ(store.pruneArchivedBatch(CHAIN_ID, 0, 1'900'000'000'000, 1), std::optional<std::size_t>(0));
+    events_sql::expectRowCount(paths.hot_db, "raw_events_hot", 0);
+    events_sql::expectRowCount(paths.hot_db, "normalized_events_hot", 0);
+    events_sql::expectRowCount(paths.hot_db, "feed_items_hot", 0);
+}
+
+TEST_F(UnitTest, Events_Archive_OffStrandExport_OnlyCommitTouchesHotStore)
+{
+    const auto paths = makeTempEventsPaths("archive_off_strand_export");
+    asio::io_context store_io_context;
+    events::SQLiteHotStore store(paths.hot_db, paths.archive_root, 60 * 60 * 1000, CHAIN_ID);
+
+    const events::DecodedEvent event = makeDecodedEvent(106, 0, 1, 0xF6, 0x36, events::EventType::TRANSFORMATION_ADDED, events::EventState::OBSERVED, 1'700'001'006);
+    finalizeAndProject(store_io_context, store, event, 1'700'001'006'200);
+
+    const std::optional<std::vector<std::string>> months = store.pendingArchiveMonths(CHAIN_ID);
+    ASSERT_TRUE(months.has_value());
+    ASSERT_EQ(months->size(), 1u);
+
+    const std::optional<events::ArchiveShardExport> shard = store.exportArchiveShard(CHAIN_ID, months->front());
+    ASSERT_TRUE(shard.has_value());
+    EXPECT_FALSE(shard->empty());
+    EXPECT_EQ(shard->normalized_rows, 1u);
+    EXPECT_EQ(shard->feed_rows, 1u);
+    EXPECT_GT(shard->shard_bytes, 0u);
+    EXPECT_TRUE(std::filesystem::exists(shard->archive_path));
+
+    {
+        SqliteReadonly db(paths.hot_db);
+        EXPECT_EQ(db.scalarInt64("SELECT exported FROM normalized_events_hot LIMIT 1;"), 0);
+        EXPECT_EQ(db.scalarInt64("SELECT COUNT(1) FROM shard_catalog;"), 0);
+    }
+
+    ASSERT_TRUE(store.commitArchiveShard(*shard, 1'700'001'150'000));
+
+    SqliteReadonly db(paths.hot_db);
+    EXPECT_EQ(db.scalarInt64("SELECT exported FROM normalized_events_hot LIMIT 1;"), 1);
+    EXPECT_EQ(db.scalarInt64("SELECT exported FROM feed_items_hot LIMIT 1;"), 1);
+    EXPECT_EQ(db.scalarInt64("SELECT COUNT(1) FROM shard_catalog WHERE state='READY';"), 1);
+}
+
+TEST_F(UnitTest, Events_Archive_PruneCursor_ResumesAfterLastScannedEvent)
+{
+    const auto paths = makeTempEventsPaths("archive_prune_cursor");
+    asio::io_context store_io_context;
+    events::SQLiteHotStore store(paths.hot_db, paths.archive_root, 60 * 60 * 1000, CHAIN_ID);
+
+    const events::DecodedEvent first = makeDecodedEvent(108, 0, 1, 0xF8, 0x38, events::EventType::CONNECTOR_ADDED, events::EventState::OBSERVED, 1'600'000'008);
+    const events::DecodedEvent second = makeDecodedEvent(109, 0, 1, 0xF9, 0x39, events::EventType::CONDITION_ADDED, events::EventState::OBSERVED, 1'600'000'009);
+    finalizeAndProject(store_io_context, store, first, 1'700'001'008'200);
+    finalizeAndProject(store_io_context, store, second, 1'700'001'009'200);
+    ASSERT_TRUE(store.exportArchiveMonths(CHAIN_ID, 1'700'001'170'000));
+
+    std::optional<events::ArchivePruneCursor> cursor;
+    EXPECT_EQ(store.pruneArchivedBatch(CHAIN_ID, 0, 1'900'000'000'000, 1, cursor), std::optional<std::size_t>(1));
+    ASSERT_TRUE(cursor.has_value());
+    EXPECT_EQ(cursor->block_time, 1'600'000'008);
+
+    // A cursor past every remaining event ends the pass without rescanning them.
+    std::optional<events::ArchivePruneCursor> exhausted = events::ArchivePruneCursor{.block_time = 1'600'000'010};
+    EXPECT_EQ(store.pruneArchivedBatch(CHAIN_ID, 0, 1'900'000'000'000, 1, exhausted), std::optional<std::size_t>(0));
+    events_sql::expectRowCount(paths.hot_db, "normalized_events_hot", 1);
+
+    EXPECT_EQ(store.pruneArchivedBatch(CHAIN_ID, 0, 1'900'000'000'000, 1, cursor), std::optional<std::size_t>(1));
+    EXPECT_EQ(cursor->block_time, 1'600'000'009);
+    EXPECT_EQ(store.pruneArchivedBatch(CHAIN_ID, 0, 1'900'000'000'000, 1, cursor), std::optional<std::size_t>(0));
+    events_sql::expectRowCount(paths.hot_db, "normalized_events_hot", 0);
+}
+
+TEST_F(UnitTest, Events_Archive_ShardKeepsOnlyFeedPageIndexes)
+{
+    const auto paths = makeTempEventsPaths("archive_compact_shard");
+    asio::io_context store_io_context;
+    events::SQLiteHotStore store(paths.hot_db, paths.archive_root, 60 * 60 * 1000, CHAIN_ID);
+
+    const events::DecodedEvent event = makeDecodedEvent(107, 0, 1, 0xF7, 0x37, events::EventType::CONNECTOR_ADDED, events::EventState::OBSERVED, 1'700'001'007);
+    finalizeAndProject(store_io_context, store, event, 1'700'001'007'200);
+    ASSERT_TRUE(awaitRunArchiveCycle(store_io_context, store, CHAIN_ID, 36500, 1'700'001'160'000));
+
+    std::filesystem::path shard_path;
+    {
+        SqliteReadonly db(paths.hot_db);
+        shard_path = db.scalarText("SELECT path FROM shard_catalog LIMIT 1;");
+    }
+
+    SqliteReadonly shard(shard_path);
+    EXPECT_EQ(
+        shard.scalarInt64(
+            "SELECT COUNT(1) FROM sqlite_master WHERE type='index' AND tbl_name='feed_items_archive' "
+            "AND name NOT LIKE 'sqlite_autoindex%';"),
+        2);
+    EXPECT_EQ(
+        shard.scalarInt64(
+            "SELECT COUNT(1) FROM sqlite_master WHERE type='index' AND name='idx_archive_feed_type_updated_order';"),
+        1);
+    EXPECT_EQ(shard.scalarInt64("PRAGMA auto_vacuum;"), 2);
+    EXPECT_EQ(shard.scalarInt64("SELECT COUNT(1) FROM feed_items_archive;"), 1);
+}
+
 TEST_F(UnitTest, Events_Archive_IsNotReplayAuthority_GlobalOutboxRemainsSource)
 {
     const auto paths = makeTempEventsPaths("archive_not_replay_authority");
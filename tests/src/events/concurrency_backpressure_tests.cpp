@@ -253,7 +253,7 @@ TEST_F(UnitTest, Events_Runtime_TransportPath_NotExecutedOnHotWriteStrand)
             .registry_address = hexAddress(0xAB),
             .rpc_timeout_ms = 100,
             .poll_interval_ms = 20,
-            .projector_interval_ms = 20,
+            .projection_job_grace_ms = 20,
             .archive_interval_ms = 5'000,
             .wal_checkpoint_interval_ms = 5'000
         });
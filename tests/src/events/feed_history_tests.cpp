@@ -336,3 +336,47 @@ TEST_F(UnitTest, Events_History_OrderingReadsArchiveEvenWhenHotExceedsLimit)
     ASSERT_EQ(page.items.size(), 1u);
     EXPECT_EQ(page.items.front().block_number, 50);
 }
+
+TEST_F(UnitTest, Events_History_FeedItemPayload_IsStoredTextVerbatim)
+{
+    const auto paths = makeTempEventsPaths("history_payload_verbatim");
+    asio::io_context store_io_context;
+    events::SQLiteHotStore store(paths.hot_db, paths.archive_root, 60 * 60 * 1000, CHAIN_ID);
+
+    const events::DecodedEvent first = makeDecodedEvent(120, 0, 1, 0xE4, 0x24, events::EventType::CONNECTOR_ADDED, events::EventState::OBSERVED, 1'700'300'000);
+    const events::DecodedEvent second = makeDecodedEvent(121, 0, 1, 0xE5, 0x25, events::EventType::TRANSFORMATION_ADDED, events::EventState::OBSERVED, 1'700'300'001);
+    ASSERT_TRUE(awaitIngestBatch(
+        store_io_context,
+        store,
+        CHAIN_ID,
+        {first, second},
+        {
+            makeBlockInfo(120, first.raw.block_hash, hexBytes(0x6B, 32), 1'700'300'000, 1'700'300'000'100),
+            makeBlockInfo(121, second.raw.block_hash, hexBytes(0x6A, 32), 1'700'300'001, 1'700'300'001'100)
+        },
+        122,
+        1'700'300'001'200));
+    EXPECT_EQ(projectAll(store_io_context, store, 1'700'300'001'300), 2u);
+
+    std::string stored_payload;
+    {
+        SqliteReadonly db(paths.hot_db);
+        stored_payload = db.scalarText("SELECT payload_json FROM feed_items_hot WHERE block_number=121;");
+    }
+    ASSERT_FALSE(stored_payload.empty());
+
+    {
+        SqliteWritable db(paths.hot_db);
+        db.exec("UPDATE feed_items_hot SET payload_json='{not json' WHERE block_number=120;");
+    }
+
+    const events::FeedPage page = store.getFeedPage(events::FeedQuery{
+        .limit = 10,
+        .include_unfinalized = true
+    });
+    ASSERT_EQ(page.items.size(), 2u);
+    EXPECT_EQ(page.items.at(0).payload_json, stored_payload);
+    EXPECT_TRUE(page.items.at(0).payload().is_object());
+    EXPECT_EQ(page.items.at(1).payload_json, "{}");
+    EXPECT_TRUE(page.items.at(1).payload().empty());
+}
@@ -381,7 +381,7 @@ TEST_F(UnitTest, Events_Projector_ReplayedLocalEmission_DeduplicatesByTypeNameOw
     EXPECT_EQ(db.scalarText("SELECT feed_id FROM feed_items_hot LIMIT 1;").rfind("eth:1:", 0), 0u);
 }
 
-TEST_F(UnitTest, Events_Projector_OrphanJobs_AreCleanedBeforeProjection)
+TEST_F(UnitTest, Events_Projector_OrphanJobs_AreRemovedByMaintenanceSweep)
 {
     const auto paths = makeTempEventsPaths("project_orphan_cleanup");
     asio::io_context store_io_context;
@@ -395,5 +395,58 @@ TEST_F(UnitTest, Events_Projector_OrphanJobs_AreCleanedBeforeProjection)
     }
 
     EXPECT_EQ(awaitProjectBatch(store_io_context, store, 64, 1'700'000'000'500), 0u);
+    events_sql::expectRowCount(paths.hot_db, "projection_jobs", 1);
+
+    const events::ProjectionSweepStats young_sweep = store.sweepProjectionJobs(1'700'000'000'000);
+    EXPECT_EQ(young_sweep.removed_orphans, 0u);
+    events_sql::expectRowCount(paths.hot_db, "projection_jobs", 1);
+
+    const events::ProjectionSweepStats sweep = store.sweepProjectionJobs(1'700'000'001'000);
+    EXPECT_EQ(sweep.removed_orphans, 1u);
+    EXPECT_EQ(sweep.stale_jobs, 0u);
+    events_sql::expectRowCount(paths.hot_db, "projection_jobs", 0);
+    EXPECT_TRUE(store.takeProjectionRanges().empty());
+}
+
+TEST_F(UnitTest, Events_Projector_CommittedIngest_PublishesProjectionRange)
+{
+    const auto paths = makeTempEventsPaths("project_ranges");
+    asio::io_context store_io_context;
+    events::SQLiteHotStore store(
+        paths.hot_db,
+        paths.archive_root,
+        7LL * 24 * 60 * 60 * 1000,
+        CHAIN_ID);
+
+    EXPECT_TRUE(store.takeProjectionRanges().empty());
+
+    const events::DecodedEvent first = makeDecodedEvent(70, 0, 1, 0xB7, 0xD7, events::EventType::CONNECTOR_ADDED, events::EventState::OBSERVED, 1'700'000'700);
+    const events::DecodedEvent second = makeDecodedEvent(72, 0, 1, 0xB8, 0xD8, events::EventType::CONNECTOR_ADDED, events::EventState::OBSERVED, 1'700'000'720);
+    const events::ChainBlockInfo first_block = makeBlockInfo(70, first.raw.block_hash, hexBytes(0x70, 32), 1'700'000'700, 1'700'000'701'000);
+    const events::ChainBlockInfo second_block = makeBlockInfo(72, second.raw.block_hash, hexBytes(0x71, 32), 1'700'000'720, 1'700'000'721'000);
+    ASSERT_TRUE(awaitIngestBatch(store_io_context, store, CHAIN_ID, {first, second}, {first_block, second_block}, 73, 1'700'000'721'100));
+
+    const std::vector<events::ProjectionRange> ranges = store.takeProjectionRanges();
+    ASSERT_EQ(ranges.size(), 1u);
+    EXPECT_EQ(ranges.front().chain_id, CHAIN_ID);
+    EXPECT_EQ(ranges.front().from_block, 70);
+    EXPECT_EQ(ranges.front().to_block, 72);
+    EXPECT_TRUE(store.takeProjectionRanges().empty());
+
+    const events::ProjectionRange first_only{.chain_id = CHAIN_ID, .from_block = 70, .to_block = 70};
+    EXPECT_EQ(store.projectBatch(64, 1'700'000'721'200, first_only), 1u);
+    events_sql::expectRowCount(paths.hot_db, "projection_jobs", 1);
+
+    // The remaining job is older than the sweep cutoff, so maintenance re-announces its range.
+    const events::ProjectionSweepStats sweep = store.sweepProjectionJobs(1'700'000'800'000);
+    EXPECT_EQ(sweep.removed_orphans, 0u);
+    EXPECT_EQ(sweep.stale_jobs, 1u);
+
+    const std::vector<events::ProjectionRange> stale_ranges = store.takeProjectionRanges();
+    ASSERT_EQ(stale_ranges.size(), 1u);
+    EXPECT_EQ(stale_ranges.front().from_block, 72);
+    EXPECT_EQ(stale_ranges.front().to_block, 72);
+    EXPECT_EQ(store.projectBatch(64, 1'700'000'800'100, stale_ranges.front()), 1u);
     events_sql::expectRowCount(paths.hot_db, "projection_jobs", 0);
+    events_sql::expectRowCount(paths.hot_db, "feed_items_hot", 2);
 }
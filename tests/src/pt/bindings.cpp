@@ -6,6 +6,7 @@
 #include <expected>
 #include <filesystem>
 #include <format>
+#include <fstream>
 #include <future>
 #include <optional>
 #include <string>
@@ -212,10 +213,11 @@ namespace
         const std::string & name,
         const std::string & cache_key)
     {
-        const auto local_build_dir = storage_path / entity_dir / "build";
-        const auto local_bin = local_build_dir / (name + ".bin");
-        const auto local_abi = local_build_dir / (name + ".abi");
-        if(!std::filesystem::exists(local_bin) || !std::filesystem::exists(local_abi))
+        // Deployed artifacts live in the pack of the build directory, not in loose files.
+        auto & artifacts = storage::pack::PackStore::forDirectory(storage_path / entity_dir / "build");
+        const auto bin = artifacts.get(name + ".bin");
+        const auto abi = artifacts.get(name + ".abi");
+        if(!bin || !abi)
         {
             return;
         }
@@ -228,20 +230,20 @@ namespace
 
         const auto cached_bin = makeCachedArtifactPath(cache_root, entity_dir, name, cache_key, ".bin");
         const auto cached_abi = makeCachedArtifactPath(cache_root, entity_dir, name, cache_key, ".abi");
-        std::error_code ec;
 
-        std::filesystem::copy_file(local_bin, cached_bin, std::filesystem::copy_options::overwrite_existing, ec);
-        if(ec)
+        std::ofstream bin_out(cached_bin, std::ios::binary | std::ios::trunc);
+        bin_out << *bin;
+        if(!bin_out.good())
         {
-            spdlog::warn("Failed to cache bin '{}' -> '{}': {}", local_bin.string(), cached_bin.string(), ec.message());
+            spdlog::warn("Failed to cache bin '{}'", cached_bin.string());
             return;
         }
 
-        ec.clear();
-        std::filesystem::copy_file(local_abi, cached_abi, std::filesystem::copy_options::overwrite_existing, ec);
-        if(ec)
+        std::ofstream abi_out(cached_abi, std::ios::binary | std::ios::trunc);
+        abi_out << *abi;
+        if(!abi_out.good())
         {
-            spdlog::warn("Failed to cache abi '{}' -> '{}': {}", local_abi.string(), cached_abi.string(), ec.message());
+            spdlog::warn("Failed to cache abi '{}'", cached_abi.string());
         }
     }
 
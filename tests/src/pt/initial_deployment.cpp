@@ -3,6 +3,7 @@
 #include <cstring>
 #include <filesystem>
 #include <format>
+#include <fstream>
 #include <future>
 #include <mutex>
 #include <ranges>
@@ -172,3 +173,251 @@ TEST_F(UnitTest, PT_InitialDeployment_SetsGenesisOwnerForCoreContracts)
     EXPECT_EQ(snapshot.registry_owner, expected_owner);
     EXPECT_EQ(snapshot.runner_owner, expected_owner);
 }
+
+TEST_F(UnitTest, EVM_CompileService_BoundsConcurrencyAndKillsTimedOutJobs)
+{
+#if defined(WIN32)
+    GTEST_SKIP() << "solc timeouts are not enforced on Windows";
+#endif
+
+    const auto solc_path = solcPath();
+    const auto pt_path = ptPath();
+    if(!std::filesystem::exists(solc_path) || !std::filesystem::exists(pt_path / "contracts"))
+    {
+        GTEST_SKIP() << "solc or PT contracts are not available";
+    }
+
+    asio::io_context io_context;
+    evm::CompileService service(io_context, solc_path, evm::CompileServiceConfig{
+        .max_concurrent_jobs = 2,
+        .job_timeout = std::chrono::milliseconds(1)
+    });
+
+    const auto out_dir = std::filesystem::temp_directory_path() / "dcn_compile_service_test";
+    std::vector<std::future<evm::CompileOutcome>> version_jobs;
+    for(int i = 0; i < 6; ++i)
+    {
+        version_jobs.push_back(asio::co_spawn(io_context, service.run({"--version"}), asio::use_future));
+    }
+
+    // A --via-ir build of the registry cannot finish within a millisecond.
+    auto slow_job = asio::co_spawn(io_context, service.run({
+            "--via-ir", "--optimize", "--bin", "--overwrite",
+            "-o", out_dir.string(),
+            "--base-path", (pt_path / "contracts").string(),
+            "--include-path", (pt_path / "node_modules").string(),
+            (pt_path / "contracts" / "registry" / "RegistryBase.sol").string()}),
+        asio::use_future);
+
+    io_context.run();
+
+    for(auto & job : version_jobs)
+    {
+        const auto outcome = job.get();
+        // `--version` also finishes well within a millisecond on most machines, but not reliably.
+        EXPECT_TRUE(outcome.status == evm::CompileStatus::OK || outcome.status == evm::CompileStatus::TIMED_OUT);
+        if(outcome.status == evm::CompileStatus::OK)
+        {
+            EXPECT_NE(outcome.output.find("Version"), std::string::npos);
+        }
+    }
+
+    const auto slow_outcome = slow_job.get();
+    EXPECT_EQ(slow_outcome.status, evm::CompileStatus::TIMED_OUT);
+
+    const auto stats = service.stats();
+    EXPECT_EQ(stats.completed + stats.timed_out, 7u);
+    EXPECT_GE(stats.timed_out, 1u);
+    EXPECT_LE(stats.peak_running, 2u);
+    EXPECT_EQ(stats.running, 0u);
+    EXPECT_EQ(stats.queued, 0u);
+
+    std::error_code ec;
+    std::filesystem::remove_all(out_dir, ec);
+}
+
+TEST_F(UnitTest, EVM_CompileCache_SharesArtifactsByContentAndEvictsLeastRecentlyUsed)
+{
+    const auto root = std::filesystem::temp_directory_path() / "dcn_compile_cache_test";
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+
+    const auto write_file = [](const std::filesystem::path & path, const std::string & content)
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << content;
+    };
+
+    const std::vector<std::string> flags = {"--via-ir", "--optimize"};
+    const std::string key_a = evm::CompileCache::makeKey("contract A {}", "solc 0.8", flags, "tree");
+    const std::string key_b = evm::CompileCache::makeKey("contract B {}", "solc 0.8", flags, "tree");
+    EXPECT_NE(key_a, evm::CompileCache::makeKey("contract A {}", "solc 0.9", flags, "tree"));
+    EXPECT_NE(key_a, evm::CompileCache::makeKey("contract A {}", "solc 0.8", {"--via-ir"}, "tree"));
+    EXPECT_NE(key_a, evm::CompileCache::makeKey("contract A {}", "solc 0.8", flags, "other-tree"));
+
+    {
+        evm::CompileCache cache(evm::CompileCacheConfig{.root = root, .max_bytes = 64});
+        ASSERT_TRUE(cache.enabled());
+        EXPECT_FALSE(cache.fetch(key_a, root / "out_a"));
+
+        const auto staging = cache.makeStagingDir(key_a);
+        write_file(staging / "A.bin", std::string(20, 'a'));
+        write_file(staging / "A.abi", "[]");
+        ASSERT_TRUE(cache.store(key_a, staging, root / "out_a"));
+        EXPECT_FALSE(std::filesystem::exists(staging));
+        EXPECT_TRUE(std::filesystem::exists(root / "out_a" / "A.bin"));
+    }
+
+    // A second instance over the same directory stands in for another node on a shared volume.
+    evm::CompileCache cache(evm::CompileCacheConfig{.root = root, .max_bytes = 64});
+    EXPECT_EQ(cache.stats().entries, 1u);
+    ASSERT_TRUE(cache.fetch(key_a, root / "out_copy"));
+    EXPECT_TRUE(std::filesystem::exists(root / "out_copy" / "A.bin"));
+    EXPECT_TRUE(std::filesystem::exists(root / "out_copy" / "A.abi"));
+
+    const auto staging_b = cache.makeStagingDir(key_b);
+    write_file(staging_b / "B.bin", std::string(60, 'b'));
+    ASSERT_TRUE(cache.store(key_b, staging_b, root / "out_b"));
+
+    // 22 + 60 bytes exceed the 64 byte budget, so the older entry A goes.
+    EXPECT_FALSE(cache.fetch(key_a, root / "out_evicted"));
+    EXPECT_TRUE(cache.fetch(key_b, root / "out_b_again"));
+
+    const auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.stores, 1u);
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.entries, 1u);
+    EXPECT_EQ(stats.bytes, 60u);
+
+    std::filesystem::remove_all(root, ec);
+}
+
+TEST_F(UnitTest, EVM_CompileBatch_CompilesSourcesInOneRunAndIsolatesBrokenOnes)
+{
+    const auto solc_path = solcPath();
+    const auto pt_path = ptPath();
+    if(!std::filesystem::exists(solc_path) || !std::filesystem::exists(pt_path / "contracts"))
+    {
+        GTEST_SKIP() << "solc or PT contracts are not available";
+    }
+
+    const auto make_source = [](const std::string & name, const std::string & body)
+    {
+        Transformation transformation;
+        transformation.set_name(name);
+        transformation.set_sol_src(body);
+        const auto code = constructTransformationSolidityCode(transformation);
+        EXPECT_TRUE(code.has_value());
+        return evm::SoliditySource{.name = name, .code = code.value_or("")};
+    };
+
+    std::vector<evm::SoliditySource> sources = {
+        make_source("BatchAdd", "return x + args[0];"),
+        make_source("BatchBroken", "return x +;"),
+        make_source("BatchMul", "return x * args[0] * args[1];")
+    };
+
+    const auto out_dir = std::filesystem::temp_directory_path() / "dcn_compile_batch_test";
+    std::error_code ec;
+    std::filesystem::remove_all(out_dir, ec);
+
+    asio::io_context io_context;
+    evm::EVM evm(io_context, EVMC_SHANGHAI, solc_path, pt_path);
+    io_context.run();
+
+    auto compiled_future = asio::co_spawn(
+        io_context,
+        evm.compileBatch(std::move(sources), out_dir, pt_path / "contracts", pt_path / "node_modules"),
+        asio::use_future);
+    io_context.restart();
+    io_context.run();
+
+    const std::vector<bool> compiled = compiled_future.get();
+    ASSERT_EQ(compiled.size(), 3u);
+    EXPECT_TRUE(compiled[0]);
+    EXPECT_FALSE(compiled[1]);
+    EXPECT_TRUE(compiled[2]);
+
+    EXPECT_GT(std::filesystem::file_size(out_dir / "BatchAdd.bin"), 0u);
+    EXPECT_TRUE(std::filesystem::exists(out_dir / "BatchAdd.abi"));
+    EXPECT_GT(std::filesystem::file_size(out_dir / "BatchMul.bin"), 0u);
+    EXPECT_FALSE(std::filesystem::exists(out_dir / "BatchBroken.bin"));
+    // Only the contracts defined in the batch are written, not the PT bases they import.
+    EXPECT_FALSE(std::filesystem::exists(out_dir / "TransformationBase.bin"));
+
+    std::filesystem::remove_all(out_dir, ec);
+}
+
+TEST_F(UnitTest, EVM_StateSnapshot_RestoresDeployedPTAndRejectsCorruptFiles)
+{
+    const auto solc_path = solcPath();
+    const auto pt_path = ptPath();
+    if(!std::filesystem::exists(solc_path) || !std::filesystem::exists(pt_path / "contracts"))
+    {
+        GTEST_SKIP() << "solc or PT contracts are not available";
+    }
+
+    const auto snapshot_path = std::filesystem::temp_directory_path() / "dcn_evm_state_test.snapshot";
+    std::error_code ec;
+    std::filesystem::remove(snapshot_path, ec);
+
+    const auto snapshot_config = [&snapshot_path](std::string tag)
+    {
+        return evm::StateSnapshotConfig{
+            .path = snapshot_path,
+            .tag = [tag]() -> asio::awaitable<std::string> { co_return tag; }
+        };
+    };
+
+    chain::Address registry_address{};
+    chain::Address runner_address{};
+    {
+        asio::io_context io_context;
+        evm::EVM evm(io_context, EVMC_SHANGHAI, solc_path, pt_path, {}, {}, snapshot_config("v1"));
+        io_context.run();
+
+        registry_address = evm.getRegistryAddress();
+        runner_address = evm.getRunnerAddress();
+
+        auto closed = asio::co_spawn(io_context, evm.close(), asio::use_future);
+        io_context.restart();
+        io_context.run();
+        ASSERT_TRUE(closed.get());
+    }
+
+    const auto snapshot = evm::readStateSnapshot(snapshot_path);
+    ASSERT_TRUE(snapshot.has_value());
+    EXPECT_EQ(snapshot->header.tag, "v1");
+    EXPECT_EQ(snapshot->header.registry_address, registry_address);
+
+    {
+        // An empty PT path fails loadPT, so success proves the state came from the snapshot.
+        asio::io_context io_context;
+        evm::EVM evm(io_context, EVMC_SHANGHAI, solc_path, std::filesystem::path{}, {}, {}, snapshot_config("v1"));
+        io_context.run();
+
+        EXPECT_EQ(evm.getRegistryAddress(), registry_address);
+        EXPECT_EQ(evm.getRunnerAddress(), runner_address);
+
+        auto owner = asio::co_spawn(io_context, evm::fetchOwner(evm, registry_address), asio::use_future);
+        io_context.restart();
+        io_context.run();
+
+        const auto owner_result = owner.get();
+        ASSERT_TRUE(owner_result.has_value());
+        EXPECT_EQ(chain::readAddressWord(owner_result.value()).value_or(chain::Address{}), expectedGenesisAddress());
+    }
+
+    {
+        std::fstream file(snapshot_path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(-1, std::ios::end);
+        const char last = static_cast<char>(file.get());
+        file.seekp(-1, std::ios::end);
+        file.put(static_cast<char>(last ^ 0x01));
+    }
+    EXPECT_FALSE(evm::readStateSnapshot(snapshot_path).has_value());
+
+    std::filesystem::remove(snapshot_path, ec);
+}
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -565,3 +566,305 @@ TEST_F(UnitTest, Registry_AddCondition_IsIdempotentForExactDuplicateAndRejectsCo
     EXPECT_TRUE(runAwaitable(io_context, registry.addCondition(condition_address, different_name_same_address)));
 }
 
+
+TEST_F(UnitTest, Registry_HotCache_ScanDoesNotFlushFrequentlyUsedEntries)
+{
+    registry::HotCache<std::string, int> cache;
+    cache.setCapacityBytes(1000);
+
+    for(int i = 0; i < 5; ++i)
+    {
+        const std::string key = "hot_" + std::to_string(i);
+        EXPECT_EQ(cache.get(key), nullptr);
+        ASSERT_TRUE(cache.put(key, i, 100));
+        for(int hit = 0; hit < 4; ++hit)
+        {
+            ASSERT_NE(cache.get(key), nullptr);
+        }
+    }
+
+    for(int i = 0; i < 1000; ++i)
+    {
+        const std::string key = "scan_" + std::to_string(i);
+        if(cache.get(key) == nullptr)
+        {
+            (void)cache.put(key, i, 100);
+        }
+    }
+
+    for(int i = 0; i < 5; ++i)
+    {
+        const int * cached = cache.get("hot_" + std::to_string(i));
+        ASSERT_NE(cached, nullptr);
+        EXPECT_EQ(*cached, i);
+    }
+
+    const registry::HotCacheStats stats = cache.stats();
+    EXPECT_LE(stats.bytes, stats.capacity_bytes);
+    EXPECT_GT(stats.rejected_admissions, 0u);
+}
+
+TEST_F(UnitTest, Registry_HotCache_ChargesEntriesByBytes)
+{
+    registry::HotCache<std::string, int> cache;
+    cache.setCapacityBytes(1000);
+
+    EXPECT_FALSE(cache.put("too_large", 1, 1001));
+
+    ASSERT_TRUE(cache.put("small_a", 1, 100));
+    ASSERT_TRUE(cache.put("small_b", 2, 100));
+    ASSERT_TRUE(cache.put("small_a", 3, 700));
+
+    const registry::HotCacheStats stats = cache.stats();
+    EXPECT_EQ(stats.entries, 2u);
+    EXPECT_EQ(stats.bytes, 800u);
+    EXPECT_EQ(stats.rejected_admissions, 1u);
+    ASSERT_NE(cache.get("small_a"), nullptr);
+    EXPECT_EQ(*cache.get("small_a"), 3);
+}
+
+TEST_F(UnitTest, Registry_CacheStats_CountHitsAndMissesPerCache)
+{
+    asio::io_context io_context;
+    registry::Registry registry(io_context);
+
+    const std::string owner_hex = evmc::hex(makeAddressFromByte(0x6A));
+    ASSERT_TRUE(runAwaitable(
+        io_context,
+        registry.addTransformation(makeAddressFromByte(0x6B), makeTransformationRecord("CACHE_STATS_TX", owner_hex))));
+
+    EXPECT_TRUE(runAwaitable(io_context, registry.getTransformationRecordHandle("CACHE_STATS_TX")).has_value());
+    EXPECT_FALSE(runAwaitable(io_context, registry.hasTransformation("CACHE_STATS_MISSING")));
+
+    const std::vector<registry::HotCacheStats> stats = registry.cacheStats();
+    const auto it = std::find_if(stats.begin(), stats.end(), [](const registry::HotCacheStats & entry)
+    {
+        return entry.name == "transformation-record";
+    });
+    ASSERT_NE(it, stats.end());
+    EXPECT_EQ(it->hits, 1u);
+    // The missing name is answered by the name filter and never reaches the cache.
+    EXPECT_EQ(it->misses, 0u);
+    EXPECT_EQ(it->entries, 1u);
+    EXPECT_GT(it->capacity_bytes, 0u);
+}
+
+TEST_F(UnitTest, Registry_NameFilter_HasNoFalseNegativesAndFewFalsePositives)
+{
+    registry::NameFilter filter("test");
+    EXPECT_TRUE(filter.mayContain("anything"));
+
+    constexpr std::size_t kNames = 2000;
+    filter.rebuild(kNames, [](const std::function<void(const std::string &)> & visitor)
+    {
+        for(std::size_t i = 0; i < kNames; ++i)
+        {
+            visitor("PRESENT_" + std::to_string(i));
+        }
+        return true;
+    });
+
+    for(std::size_t i = 0; i < kNames; ++i)
+    {
+        EXPECT_TRUE(filter.mayContain("PRESENT_" + std::to_string(i)));
+    }
+
+    filter.add("ADDED_LATER");
+    EXPECT_TRUE(filter.mayContain("ADDED_LATER"));
+
+    std::size_t false_positives = 0;
+    constexpr std::size_t kProbes = 20000;
+    for(std::size_t i = 0; i < kProbes; ++i)
+    {
+        if(filter.mayContain("ABSENT_" + std::to_string(i)))
+        {
+            ++false_positives;
+        }
+    }
+    EXPECT_LT(false_positives, kProbes / 100);
+
+    const registry::NameFilterStats stats = filter.stats();
+    EXPECT_EQ(stats.inserted, kNames + 1);
+    EXPECT_GE(stats.capacity, kNames * 2);
+    EXPECT_GT(stats.memory_bytes, 0u);
+    EXPECT_LT(stats.estimated_false_positive_rate, 0.01);
+    EXPECT_EQ(stats.definite_negatives, kProbes - false_positives);
+    EXPECT_FALSE(filter.needsGrowth());
+}
+
+TEST_F(UnitTest, Registry_NameFilter_ShortCircuitsMissingNamesAndKeepsAddedOnes)
+{
+    asio::io_context io_context;
+    registry::Registry registry(io_context);
+
+    const std::string owner_hex = evmc::hex(makeAddressFromByte(0x6C));
+    ASSERT_TRUE(runAwaitable(
+        io_context,
+        registry.addTransformation(makeAddressFromByte(0x6D), makeTransformationRecord("FILTER_TX", owner_hex))));
+    ASSERT_TRUE(runAwaitable(
+        io_context,
+        registry.addCondition(makeAddressFromByte(0x6E), makeConditionRecord("FILTER_COND", owner_hex))));
+
+    EXPECT_TRUE(runAwaitable(io_context, registry.hasTransformation("FILTER_TX")));
+    EXPECT_TRUE(runAwaitable(io_context, registry.hasCondition("FILTER_COND")));
+    EXPECT_FALSE(runAwaitable(io_context, registry.hasTransformation("FILTER_TX_MISSING")));
+    EXPECT_FALSE(runAwaitable(io_context, registry.getConditionRecordHandle("FILTER_COND_MISSING")).has_value());
+    EXPECT_FALSE(runAwaitable(io_context, registry.getFormatHash("FILTER_CONNECTOR_MISSING")).has_value());
+
+    const std::vector<registry::NameFilterStats> stats = registry.filterStats();
+    ASSERT_EQ(stats.size(), 3u);
+    std::uint64_t definite_negatives = 0;
+    for(const registry::NameFilterStats & filter_stats : stats)
+    {
+        // A probe can still land on a false positive, which falls through to the store.
+        EXPECT_LE(filter_stats.definite_negatives, 1u) << filter_stats.name;
+        EXPECT_GT(filter_stats.memory_bytes, 0u) << filter_stats.name;
+        definite_negatives += filter_stats.definite_negatives;
+    }
+    EXPECT_GE(definite_negatives, 2u);
+}
+
+TEST_F(UnitTest, Registry_BatchGet_ReturnsHandlesInInputOrderAcrossCacheAndStore)
+{
+    asio::io_context io_context;
+    registry::Registry registry(io_context);
+
+    const std::string owner_hex = evmc::hex(makeAddressFromByte(0x70));
+    std::vector<std::pair<chain::Address, TransformationRecord>> transformations;
+    for(std::size_t i = 0; i < 300; ++i)
+    {
+        transformations.emplace_back(
+            makeAddressFromByte(static_cast<std::uint8_t>(i)),
+            makeTransformationRecord("BATCH_TX_" + std::to_string(i), owner_hex));
+    }
+    ASSERT_TRUE(runAwaitable(io_context, registry.addTransformationsBatch(std::move(transformations))));
+
+    // Warm one entry so the batch mixes cache hits with store fetches.
+    ASSERT_TRUE(runAwaitable(io_context, registry.getTransformationRecordHandle("BATCH_TX_7")).has_value());
+
+    std::vector<std::string> names;
+    for(std::size_t i = 300; i-- > 0;)
+    {
+        names.push_back("BATCH_TX_" + std::to_string(i));
+    }
+    names.push_back("BATCH_TX_MISSING");
+    names.push_back("BATCH_TX_7");
+
+    const auto handles = runAwaitable(io_context, registry.getTransformationRecordHandles(names));
+    ASSERT_EQ(handles.size(), names.size());
+    for(std::size_t i = 0; i < names.size(); ++i)
+    {
+        if(names[i] == "BATCH_TX_MISSING")
+        {
+            EXPECT_FALSE(handles[i].has_value() && *handles[i]);
+            continue;
+        }
+
+        ASSERT_TRUE(handles[i].has_value() && *handles[i]) << names[i];
+        EXPECT_EQ((*handles[i])->transformation().name(), names[i]);
+    }
+
+    const std::vector<std::string> connector_names{"BATCH_CONNECTOR_MISSING"};
+    const auto connector_handles = runAwaitable(io_context, registry.getConnectorRecordHandles(connector_names));
+    ASSERT_EQ(connector_handles.size(), 1u);
+    EXPECT_FALSE(connector_handles[0].has_value());
+
+    EXPECT_TRUE(runAwaitable(io_context, registry.getConditionRecordHandles({})).empty());
+}
+
+TEST_F(UnitTest, Registry_GroupCommit_ConcurrentSingleAddsGetIndividualResults)
+{
+    asio::io_context io_context;
+    registry::Registry registry(
+        io_context,
+        ":memory:",
+        {},
+        registry::RegistryWriteConfig{
+            .group_commit_window = std::chrono::microseconds(1000),
+            .group_commit_max_batch = 8
+        });
+
+    const std::string owner_hex = evmc::hex(makeAddressFromByte(0x71));
+    const std::string other_owner_hex = evmc::hex(makeAddressFromByte(0x72));
+
+    constexpr std::size_t unique_count = 21;
+    std::vector<std::optional<bool>> results(unique_count + 2);
+    for(std::size_t i = 0; i < unique_count; ++i)
+    {
+        asio::co_spawn(
+            io_context,
+            registry.addTransformation(
+                makeAddressFromByte(static_cast<std::uint8_t>(i)),
+                makeTransformationRecord("GROUP_TX_" + std::to_string(i), owner_hex)),
+            [&results, i](std::exception_ptr, bool inserted) { results[i] = inserted; });
+    }
+
+    // Same name as a queued add: an identical record is accepted, a conflicting one is rejected.
+    asio::co_spawn(
+        io_context,
+        registry.addTransformation(makeAddressFromByte(0), makeTransformationRecord("GROUP_TX_0", owner_hex)),
+        [&results](std::exception_ptr, bool inserted) { results[unique_count] = inserted; });
+    asio::co_spawn(
+        io_context,
+        registry.addTransformation(makeAddressFromByte(1), makeTransformationRecord("GROUP_TX_1", other_owner_hex)),
+        [&results](std::exception_ptr, bool inserted) { results[unique_count + 1] = inserted; });
+
+    io_context.run();
+
+    for(std::size_t i = 0; i < unique_count; ++i)
+    {
+        ASSERT_TRUE(results[i].has_value()) << i;
+        EXPECT_TRUE(*results[i]) << i;
+
+        const auto handle = runAwaitable(
+            io_context, registry.getTransformationRecordHandle("GROUP_TX_" + std::to_string(i)));
+        ASSERT_TRUE(handle.has_value()) << i;
+        EXPECT_EQ((*handle)->owner(), owner_hex);
+    }
+    ASSERT_TRUE(results[unique_count].has_value());
+    EXPECT_TRUE(*results[unique_count]);
+    ASSERT_TRUE(results[unique_count + 1].has_value());
+    EXPECT_FALSE(*results[unique_count + 1]);
+}
+
+TEST_F(UnitTest, Registry_PostingBitmap_IntersectsArrayAndBitmapContainers)
+{
+    registry::PostingBitmap evens;
+    registry::PostingBitmap threes;
+    for(std::uint32_t id = 0; id < 200000; id += 2)
+    {
+        evens.add(id);
+    }
+    for(std::uint32_t id = 0; id < 200000; id += 3)
+    {
+        threes.add(id);
+    }
+    threes.add(3);
+
+    registry::PostingBitmap sparse;
+    for(const std::uint32_t id : {6u, 7u, 65544u, 131076u, 199998u})
+    {
+        sparse.add(id);
+    }
+
+    EXPECT_EQ(evens.cardinality(), 100000u);
+    EXPECT_EQ(threes.cardinality(), 66667u);
+    EXPECT_TRUE(evens.contains(131072u));
+    EXPECT_FALSE(evens.contains(131073u));
+
+    const registry::PostingBitmap sixes = evens.intersect(threes);
+    EXPECT_EQ(sixes.cardinality(), 33334u);
+    std::size_t visited = 0;
+    bool all_multiples = true;
+    sixes.forEach([&](std::uint32_t id)
+    {
+        ++visited;
+        all_multiples = all_multiples && id % 6 == 0;
+    });
+    EXPECT_EQ(visited, 33334u);
+    EXPECT_TRUE(all_multiples);
+
+    std::vector<std::uint32_t> sparse_hits;
+    sparse.intersect(sixes).forEach([&](std::uint32_t id) { sparse_hits.push_back(id); });
+    EXPECT_EQ(sparse_hits, (std::vector<std::uint32_t>{6u, 65544u, 131076u, 199998u}));
+}
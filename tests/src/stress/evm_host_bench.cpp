@@ -0,0 +1,199 @@
+#include "unit-tests.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+using namespace dcn;
+using namespace dcn::tests;
+
+namespace
+{
+    std::size_t readEnvSizeOrDefault(const char * env_name, const std::size_t default_value)
+    {
+        const char * raw = std::getenv(env_name);
+        if(raw == nullptr || raw[0] == '\0')
+        {
+            return default_value;
+        }
+
+        std::size_t parsed = 0;
+        const auto [ptr, ec] = std::from_chars(raw, raw + std::strlen(raw), parsed, 10);
+        if(ec != std::errc{} || ptr != raw + std::strlen(raw) || parsed == 0)
+        {
+            return default_value;
+        }
+        return parsed;
+    }
+
+    chain::Address makeAddressFromIndex(std::uint64_t index)
+    {
+        chain::Address address{};
+        for(std::size_t i = 0; i < 8; ++i)
+        {
+            address.bytes[12 + i] = static_cast<std::uint8_t>((index >> ((7 - i) * 8)) & 0xFFu);
+        }
+        return address;
+    }
+
+    // Runtime code repeating `body` `count` times, wrapped in init code that returns it.
+    std::vector<std::uint8_t> makeRepeatingContract(const std::vector<std::uint8_t> & body, std::size_t count)
+    {
+        std::vector<std::uint8_t> runtime;
+        runtime.reserve(body.size() * count + 1);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            runtime.insert(runtime.end(), body.begin(), body.end());
+        }
+        runtime.push_back(0x00); // STOP
+
+        constexpr std::uint8_t INIT_SIZE = 13;
+        const auto size_hi = static_cast<std::uint8_t>(runtime.size() >> 8);
+        const auto size_lo = static_cast<std::uint8_t>(runtime.size() & 0xFF);
+        std::vector<std::uint8_t> init = {
+            0x61, size_hi, size_lo,     // PUSH2 size
+            0x61, 0x00, INIT_SIZE,      // PUSH2 offset
+            0x5f,                       // PUSH0
+            0x39,                       // CODECOPY
+            0x61, size_hi, size_lo,     // PUSH2 size
+            0x5f,                       // PUSH0
+            0xf3                        // RETURN
+        };
+        init.insert(init.end(), runtime.begin(), runtime.end());
+        return init;
+    }
+
+    double nanosPer(std::chrono::steady_clock::duration elapsed, std::size_t count)
+    {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / static_cast<double>(count);
+    }
+}
+
+TEST_F(StressTest, Stress_EVMStorage_HostCallbackCostPerOpcode)
+{
+    const std::size_t account_count = readEnvSizeOrDefault("DCN_STRESS_EVM_ACCOUNTS", 10'000);
+    const std::size_t opcodes_per_call = std::min<std::size_t>(readEnvSizeOrDefault("DCN_STRESS_EVM_OPCODES", 2'000), 8'000);
+    const std::size_t call_count = readEnvSizeOrDefault("DCN_STRESS_EVM_CALLS", 200);
+    const std::size_t callback_count = readEnvSizeOrDefault("DCN_STRESS_EVM_CALLBACKS", 5'000'000);
+
+    evmc::VM vm(evmc_create_evmone());
+    ASSERT_TRUE(vm);
+    evm::EVMStorage storage(vm, EVMC_SHANGHAI);
+
+    // Filler accounts give the account map the size of a populated PT state.
+    for(std::size_t i = 0; i < account_count; ++i)
+    {
+        ASSERT_TRUE(storage.add_account(makeAddressFromIndex(1'000 + i)));
+    }
+    const chain::Address sender = makeAddressFromIndex(1);
+    ASSERT_TRUE(storage.add_account(sender));
+    storage.set_balance(sender, evm::DEFAULT_GAS_LIMIT);
+
+    const auto deploy = [&](const std::vector<std::uint8_t> & body) -> std::optional<chain::Address>
+    {
+        const std::vector<std::uint8_t> init_code = makeRepeatingContract(body, opcodes_per_call);
+        evmc_message msg{};
+        msg.kind = EVMC_CREATE;
+        msg.gas = evm::DEFAULT_GAS_LIMIT;
+        msg.sender = sender;
+        msg.input_data = init_code.data();
+        msg.input_size = init_code.size();
+        const evmc::Result result = storage.call(msg);
+        if(result.status_code != EVMC_SUCCESS)
+        {
+            return std::nullopt;
+        }
+        return chain::Address{result.create_address};
+    };
+
+    const auto timeCalls = [&](const chain::Address & contract) -> std::optional<std::chrono::steady_clock::duration>
+    {
+        evmc_message msg{};
+        msg.kind = EVMC_CALL;
+        msg.gas = evm::DEFAULT_GAS_LIMIT;
+        msg.sender = sender;
+        msg.recipient = contract;
+
+        const auto started_at = std::chrono::steady_clock::now();
+        for(std::size_t i = 0; i < call_count; ++i)
+        {
+            if(storage.call(msg).status_code != EVMC_SUCCESS)
+            {
+                return std::nullopt;
+            }
+        }
+        return std::chrono::steady_clock::now() - started_at;
+    };
+
+    // PUSH0 POP prepares and drops the operand of every opcode below; its time is subtracted from theirs.
+    const auto baseline_contract = deploy({0x5f, 0x50});
+    ASSERT_TRUE(baseline_contract.has_value());
+    const auto baseline = timeCalls(*baseline_contract);
+    ASSERT_TRUE(baseline.has_value());
+
+    struct OpcodeCase
+    {
+        const char * name;
+        std::vector<std::uint8_t> body;
+    };
+    const std::vector<OpcodeCase> opcode_cases = {
+        {"SLOAD",       {0x5f, 0x54, 0x50}},    // PUSH0 SLOAD POP
+        {"SSTORE",      {0x5f, 0x5f, 0x55}},    // PUSH0 PUSH0 SSTORE
+        {"BALANCE",     {0x30, 0x31, 0x50}},    // ADDRESS BALANCE POP
+        {"EXTCODESIZE", {0x30, 0x3b, 0x50}},    // ADDRESS EXTCODESIZE POP
+    };
+
+    const std::size_t opcode_count = call_count * opcodes_per_call;
+    for(const OpcodeCase & opcode_case : opcode_cases)
+    {
+        const auto contract = deploy(opcode_case.body);
+        ASSERT_TRUE(contract.has_value()) << opcode_case.name;
+        const auto elapsed = timeCalls(*contract);
+        ASSERT_TRUE(elapsed.has_value()) << opcode_case.name;
+
+        spdlog::info(
+            "EVM host {}: {:.1f} ns/opcode ({:.1f} ns with interpreter overhead), {} accounts",
+            opcode_case.name,
+            nanosPer(*elapsed - *baseline, opcode_count),
+            nanosPer(*elapsed, opcode_count),
+            account_count);
+    }
+
+    // The callbacks alone, as evmone issues them for the opcodes above.
+    const chain::Address contract = *baseline_contract;
+    const evmc::bytes32 slot{};
+    std::size_t sink = 0;
+
+    auto started_at = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < callback_count; ++i)
+    {
+        sink += storage.get_storage(contract, slot).bytes[31];
+    }
+    const double get_storage_ns = nanosPer(std::chrono::steady_clock::now() - started_at, callback_count);
+
+    started_at = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < callback_count; ++i)
+    {
+        sink += storage.account_exists(contract) ? 1 : 0;
+    }
+    const double account_exists_ns = nanosPer(std::chrono::steady_clock::now() - started_at, callback_count);
+
+    started_at = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < callback_count; ++i)
+    {
+        sink += storage.get_code_size(contract);
+    }
+    const double code_size_ns = nanosPer(std::chrono::steady_clock::now() - started_at, callback_count);
+
+    spdlog::info(
+        "EVM host callbacks: get_storage={:.1f}ns account_exists={:.1f}ns get_code_size={:.1f}ns",
+        get_storage_ns,
+        account_exists_ns,
+        code_size_ns);
+    EXPECT_GT(sink, 0u);
+}